@@ -0,0 +1,83 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "bench_util.h"
+
+static uint64_t g_alloc_count;
+
+#ifdef BENCH_COUNT_ALLOCS
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t count, size_t size);
+void* __wrap_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    return __real_realloc(ptr, size);
+}
+#endif
+
+static int compare_samples(const void* left, const void* right)
+{
+    uint64_t left_value = *(const uint64_t*)left;
+    uint64_t right_value = *(const uint64_t*)right;
+    return (left_value > right_value) - (left_value < right_value);
+}
+
+uint64_t bench_now_ns(void)
+{
+    struct timespec curr_time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return (uint64_t)curr_time.tv_sec * 1000000000ull + (uint64_t)curr_time.tv_nsec;
+}
+
+uint64_t bench_alloc_count(void)
+{
+    return __atomic_load_n(&g_alloc_count, __ATOMIC_RELAXED);
+}
+
+bool bench_alloc_count_enabled(void)
+{
+#ifdef BENCH_COUNT_ALLOCS
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t bench_percentile(uint64_t* samples, size_t count, double fraction)
+{
+    uint64_t result;
+    if (count == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        qsort(samples, count, sizeof(uint64_t), compare_samples);
+        size_t index = (size_t)(fraction * (double)(count - 1) + 0.5);
+        result = samples[index < count ? index : count - 1];
+    }
+    return result;
+}
@@ -0,0 +1,21 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Monotonic clock in nanoseconds
+uint64_t bench_now_ns(void);
+
+// Number of malloc, calloc and realloc calls made so far by the process, counting is
+// only available when the benchmark is linked with the allocator wrapped
+uint64_t bench_alloc_count(void);
+bool bench_alloc_count_enabled(void);
+
+// Sorts the samples in place and returns the value at the given fraction, 0.99 for p99
+uint64_t bench_percentile(uint64_t* samples, size_t count, double fraction);
+
+#endif // BENCH_UTIL_H
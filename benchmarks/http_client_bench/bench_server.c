@@ -0,0 +1,441 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "bench_server.h"
+
+#define MAX_SERVER_CONNECTIONS      256
+#define RECV_BUFFER_SIZE            (64*1024)
+#define CONTENT_LENGTH_TOKEN        "content-length:"
+#define CONTENT_LENGTH_TOKEN_LEN    15
+
+typedef struct SERVER_CONNECTION_TAG
+{
+    int socket;
+    unsigned char recv_buffer[RECV_BUFFER_SIZE];
+    size_t recv_len;
+
+    // Number of response bytes still to write for answered requests
+    size_t pending_responses;
+    size_t send_offset;
+} SERVER_CONNECTION;
+
+typedef struct BENCH_SERVER_INFO_TAG
+{
+    int listen_socket;
+    // Removed when the server stops, empty for tcp
+    char socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    int stop_pipe[2];
+    pthread_t thread;
+
+    unsigned char* response;
+    size_t response_len;
+
+    SERVER_CONNECTION* conn_list[MAX_SERVER_CONNECTIONS];
+    size_t conn_count;
+} BENCH_SERVER_INFO;
+
+static int build_response(BENCH_SERVER_INFO* server, const BENCH_SERVER_CONFIG* config)
+{
+    int result;
+    char head[128];
+    int head_len;
+    size_t chunk_size = config->chunk_size == 0 ? config->payload_size : config->chunk_size;
+
+    if (config->chunked)
+    {
+        head_len = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nTransfer-Encoding: chunked\r\n\r\n");
+    }
+    else
+    {
+        head_len = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: %zu\r\n\r\n", config->payload_size);
+    }
+
+    // Each chunk carries at most 16 hex digits and two CRLFs of framing
+    size_t chunk_count = chunk_size == 0 ? 0 : (config->payload_size + chunk_size - 1) / chunk_size;
+    size_t max_len = (size_t)head_len + config->payload_size + (chunk_count * 20) + 8;
+    if ((server->response = (unsigned char*)malloc(max_len)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        size_t length = (size_t)head_len;
+        memcpy(server->response, head, length);
+        if (config->chunked)
+        {
+            size_t remaining = config->payload_size;
+            while (remaining > 0)
+            {
+                size_t curr_chunk = remaining < chunk_size ? remaining : chunk_size;
+                length += (size_t)sprintf((char*)server->response + length, "%zx\r\n", curr_chunk);
+                memset(server->response + length, 'a', curr_chunk);
+                length += curr_chunk;
+                memcpy(server->response + length, "\r\n", 2);
+                length += 2;
+                remaining -= curr_chunk;
+            }
+            memcpy(server->response + length, "0\r\n\r\n", 5);
+            length += 5;
+        }
+        else
+        {
+            memset(server->response + length, 'a', config->payload_size);
+            length += config->payload_size;
+        }
+        server->response_len = length;
+        result = 0;
+    }
+    return result;
+}
+
+// Returns the length of the first complete request in the buffer or 0 if more data is needed
+static size_t get_request_length(const unsigned char* buffer, size_t length)
+{
+    size_t result = 0;
+    for (size_t index = 3; index < length; index++)
+    {
+        if (buffer[index] == '\n' && buffer[index - 1] == '\r' && buffer[index - 2] == '\n' && buffer[index - 3] == '\r')
+        {
+            size_t head_len = index + 1;
+            size_t body_len = 0;
+            for (size_t line = 0; line + CONTENT_LENGTH_TOKEN_LEN < head_len; line++)
+            {
+                if ((line == 0 || buffer[line - 1] == '\n') && strncasecmp((const char*)buffer + line, CONTENT_LENGTH_TOKEN, CONTENT_LENGTH_TOKEN_LEN) == 0)
+                {
+                    body_len = (size_t)strtoul((const char*)buffer + line + CONTENT_LENGTH_TOKEN_LEN, NULL, 10);
+                    break;
+                }
+            }
+            if (head_len + body_len <= length)
+            {
+                result = head_len + body_len;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+static void close_connection(BENCH_SERVER_INFO* server, size_t index)
+{
+    close(server->conn_list[index]->socket);
+    free(server->conn_list[index]);
+    server->conn_count--;
+    server->conn_list[index] = server->conn_list[server->conn_count];
+}
+
+static void accept_connection(BENCH_SERVER_INFO* server)
+{
+    int client_socket = accept(server->listen_socket, NULL, NULL);
+    if (client_socket >= 0)
+    {
+        SERVER_CONNECTION* conn;
+        int flag = 1;
+        if (server->conn_count == MAX_SERVER_CONNECTIONS || (conn = (SERVER_CONNECTION*)calloc(1, sizeof(SERVER_CONNECTION))) == NULL)
+        {
+            close(client_socket);
+        }
+        else
+        {
+            if (server->socket_path[0] == '\0')
+            {
+                (void)setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+            }
+            (void)fcntl(client_socket, F_SETFL, fcntl(client_socket, F_GETFL, 0) | O_NONBLOCK);
+            conn->socket = client_socket;
+            server->conn_list[server->conn_count++] = conn;
+        }
+    }
+}
+
+static bool flush_responses(BENCH_SERVER_INFO* server, SERVER_CONNECTION* conn)
+{
+    bool result = true;
+    while (conn->pending_responses > 0)
+    {
+        ssize_t sent = send(conn->socket, server->response + conn->send_offset, server->response_len - conn->send_offset, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            result = (errno == EAGAIN || errno == EWOULDBLOCK);
+            break;
+        }
+        conn->send_offset += (size_t)sent;
+        if (conn->send_offset == server->response_len)
+        {
+            conn->send_offset = 0;
+            conn->pending_responses--;
+        }
+    }
+    return result;
+}
+
+static bool read_requests(BENCH_SERVER_INFO* server, SERVER_CONNECTION* conn)
+{
+    bool result = true;
+    ssize_t recv_len = recv(conn->socket, conn->recv_buffer + conn->recv_len, RECV_BUFFER_SIZE - conn->recv_len, 0);
+    if (recv_len == 0 || (recv_len < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+    {
+        result = false;
+    }
+    else if (recv_len > 0)
+    {
+        conn->recv_len += (size_t)recv_len;
+
+        // Pipelined requests are answered in the order they arrived
+        size_t offset = 0;
+        size_t request_len;
+        while ((request_len = get_request_length(conn->recv_buffer + offset, conn->recv_len - offset)) > 0)
+        {
+            offset += request_len;
+            conn->pending_responses++;
+        }
+        memmove(conn->recv_buffer, conn->recv_buffer + offset, conn->recv_len - offset);
+        conn->recv_len -= offset;
+
+        if (conn->recv_len == RECV_BUFFER_SIZE)
+        {
+            // A request larger than the buffer is not something the benchmark sends
+            result = false;
+        }
+        else
+        {
+            result = flush_responses(server, conn);
+        }
+    }
+    return result;
+}
+
+static void* server_thread(void* context)
+{
+    BENCH_SERVER_INFO* server = (BENCH_SERVER_INFO*)context;
+    struct pollfd poll_list[MAX_SERVER_CONNECTIONS + 2];
+    bool running = true;
+
+    while (running)
+    {
+        poll_list[0].fd = server->stop_pipe[0];
+        poll_list[0].events = POLLIN;
+        poll_list[1].fd = server->listen_socket;
+        poll_list[1].events = POLLIN;
+        for (size_t index = 0; index < server->conn_count; index++)
+        {
+            poll_list[index + 2].fd = server->conn_list[index]->socket;
+            poll_list[index + 2].events = POLLIN | (server->conn_list[index]->pending_responses > 0 ? POLLOUT : 0);
+        }
+        size_t poll_count = server->conn_count + 2;
+
+        if (poll(poll_list, poll_count, -1) < 0)
+        {
+            running = (errno == EINTR);
+        }
+        else if (poll_list[0].revents != 0)
+        {
+            running = false;
+        }
+        else
+        {
+            // Walk backwards so closing a connection does not skip one
+            for (size_t index = poll_count - 2; index > 0; index--)
+            {
+                short revents = poll_list[index + 1].revents;
+                SERVER_CONNECTION* conn = server->conn_list[index - 1];
+                bool keep_open = true;
+                if (revents & (POLLERR | POLLNVAL))
+                {
+                    keep_open = false;
+                }
+                else
+                {
+                    if (revents & POLLOUT)
+                    {
+                        keep_open = flush_responses(server, conn);
+                    }
+                    // A hang up is seen as a zero length read
+                    if (keep_open && (revents & (POLLIN | POLLHUP)))
+                    {
+                        keep_open = read_requests(server, conn);
+                    }
+                }
+                if (!keep_open)
+                {
+                    close_connection(server, index - 1);
+                }
+            }
+            if (poll_list[1].revents & POLLIN)
+            {
+                accept_connection(server);
+            }
+        }
+    }
+    return NULL;
+}
+
+static int listen_tcp(BENCH_SERVER_INFO* server, uint16_t* port)
+{
+    int result;
+    struct sockaddr_in address;
+    socklen_t address_len = sizeof(address);
+    int reuse = 1;
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    if ((server->listen_socket = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+    {
+        (void)printf("Failure creating listen socket\n");
+        result = __LINE__;
+    }
+    else if (setsockopt(server->listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(server->listen_socket, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(server->listen_socket, MAX_SERVER_CONNECTIONS) != 0 ||
+        getsockname(server->listen_socket, (struct sockaddr*)&address, &address_len) != 0)
+    {
+        (void)printf("Failure listening on loopback\n");
+        close(server->listen_socket);
+        result = __LINE__;
+    }
+    else
+    {
+        *port = ntohs(address.sin_port);
+        result = 0;
+    }
+    return result;
+}
+
+static int listen_unix(BENCH_SERVER_INFO* server, const char* socket_path, uint16_t* port)
+{
+    int result;
+    struct sockaddr_un address;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        (void)printf("Failure socket path %s is too long\n", socket_path);
+        result = __LINE__;
+    }
+    else if ((server->listen_socket = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+    {
+        (void)printf("Failure creating listen socket\n");
+        result = __LINE__;
+    }
+    else
+    {
+        // A socket file left by an earlier run would fail the bind
+        strcpy(address.sun_path, socket_path);
+        (void)unlink(socket_path);
+        if (bind(server->listen_socket, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(server->listen_socket, MAX_SERVER_CONNECTIONS) != 0)
+        {
+            (void)printf("Failure listening on %s\n", socket_path);
+            close(server->listen_socket);
+            (void)unlink(socket_path);
+            result = __LINE__;
+        }
+        else
+        {
+            strcpy(server->socket_path, socket_path);
+            *port = 0;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static void close_listen_socket(BENCH_SERVER_INFO* server)
+{
+    close(server->listen_socket);
+    if (server->socket_path[0] != '\0')
+    {
+        (void)unlink(server->socket_path);
+    }
+}
+
+BENCH_SERVER_HANDLE bench_server_start(const BENCH_SERVER_CONFIG* config, uint16_t* port)
+{
+    BENCH_SERVER_INFO* result;
+    if (config == NULL || port == NULL)
+    {
+        result = NULL;
+    }
+    else if ((result = (BENCH_SERVER_INFO*)calloc(1, sizeof(BENCH_SERVER_INFO))) == NULL)
+    {
+        (void)printf("Failure allocating bench server\n");
+    }
+    else
+    {
+        if (build_response(result, config) != 0)
+        {
+            (void)printf("Failure building bench response\n");
+            free(result);
+            result = NULL;
+        }
+        else if ((config->socket_path != NULL && listen_unix(result, config->socket_path, port) != 0) ||
+            (config->socket_path == NULL && listen_tcp(result, port) != 0))
+        {
+            free(result->response);
+            free(result);
+            result = NULL;
+        }
+        else if (pipe(result->stop_pipe) != 0)
+        {
+            (void)printf("Failure creating stop pipe\n");
+            close_listen_socket(result);
+            free(result->response);
+            free(result);
+            result = NULL;
+        }
+        else if (pthread_create(&result->thread, NULL, server_thread, result) != 0)
+        {
+            (void)printf("Failure starting server thread\n");
+            close(result->stop_pipe[0]);
+            close(result->stop_pipe[1]);
+            close_listen_socket(result);
+            free(result->response);
+            free(result);
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+void bench_server_stop(BENCH_SERVER_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        unsigned char stop = 1;
+        if (write(handle->stop_pipe[1], &stop, 1) == 1)
+        {
+            (void)pthread_join(handle->thread, NULL);
+        }
+        while (handle->conn_count > 0)
+        {
+            close_connection(handle, handle->conn_count - 1);
+        }
+        close(handle->stop_pipe[0]);
+        close(handle->stop_pipe[1]);
+        close_listen_socket(handle);
+        free(handle->response);
+        free(handle);
+    }
+}
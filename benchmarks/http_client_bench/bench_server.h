@@ -0,0 +1,27 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef BENCH_SERVER_H
+#define BENCH_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct BENCH_SERVER_INFO_TAG* BENCH_SERVER_HANDLE;
+
+typedef struct BENCH_SERVER_CONFIG_TAG
+{
+    size_t payload_size;
+    bool chunked;
+    // Size of each chunk when the body is chunked
+    size_t chunk_size;
+    // Listens on this unix domain socket path instead of tcp when set, port is then 0
+    const char* socket_path;
+} BENCH_SERVER_CONFIG;
+
+// Starts a loopback HTTP/1.1 server on 127.0.0.1, or on the config socket path, that answers
+// every request with the same response, the listening port is returned in port
+BENCH_SERVER_HANDLE bench_server_start(const BENCH_SERVER_CONFIG* config, uint16_t* port);
+void bench_server_stop(BENCH_SERVER_HANDLE handle);
+
+#endif // BENCH_SERVER_H
@@ -0,0 +1,492 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "http_client/http_client.h"
+#include "http_client/http_headers.h"
+
+#include "bench_util.h"
+#include "bench_server.h"
+
+#define BENCH_HOSTNAME              "127.0.0.1"
+#define BENCH_RELATIVE_PATH         "/bench"
+#define BENCH_SOCKET_PATH_FORMAT    "/tmp/http_client_bench_%d.sock"
+#define OPEN_TIMEOUT_NS             (5ull * 1000000000ull)
+#define RUN_TIMEOUT_NS              (120ull * 1000000000ull)
+#define CLOSE_TIMEOUT_NS            (1ull * 1000000000ull)
+
+typedef struct BENCH_SCENARIO_TAG
+{
+    const char* name;
+    size_t payload_size;
+    bool chunked;
+    size_t chunk_size;
+    size_t pipeline_depth;
+    size_t connection_count;
+    size_t request_count;
+
+    // Send from a prepared request template instead of rebuilding the headers every request
+    bool prepared;
+
+    // Connect over a unix domain socket instead of tcp on 127.0.0.1
+    bool unix_socket;
+
+    // Run the connections on one shared io_uring ring instead of the socket cord
+    bool uring;
+} BENCH_SCENARIO;
+
+static const BENCH_SCENARIO DEFAULT_SCENARIOS[] =
+{
+    { "64B",                     64,             false,  0,      1,  1,  20000,  false,  false,  false },
+    { "64B prepared",            64,             false,  0,      1,  1,  20000,  true,   false,  false },
+    { "64B depth 16",            64,             false,  0,      16, 1,  50000,  false,  false,  false },
+    { "64B 8 connections",       64,             false,  0,      1,  8,  50000,  false,  false,  false },
+    { "64B unix",                64,             false,  0,      1,  1,  20000,  false,  true,   false },
+    { "64B depth 16 unix",       64,             false,  0,      16, 1,  50000,  false,  true,   false },
+    { "64B 8 connections unix",  64,             false,  0,      1,  8,  50000,  false,  true,   false },
+    { "64B uring",               64,             false,  0,      1,  1,  20000,  false,  false,  true },
+    { "64B depth 16 uring",      64,             false,  0,      16, 1,  50000,  false,  false,  true },
+    { "64B 8 connections uring", 64,             false,  0,      1,  8,  50000,  false,  false,  true },
+    { "64B chunked",             64,             true,   16,     1,  1,  20000,  false,  false,  false },
+    { "4KB",                     4096,           false,  0,      1,  1,  20000,  false,  false,  false },
+    { "4KB unix",                4096,           false,  0,      1,  1,  20000,  false,  true,   false },
+    { "4KB uring",               4096,           false,  0,      1,  1,  20000,  false,  false,  true },
+    { "4KB chunked",             4096,           true,   512,    1,  1,  20000,  false,  false,  false },
+    { "64KB 4 connections",      65536,          false,  0,      1,  4,  5000,   false,  false,  false },
+    { "1MB chunked",             1024*1024,      true,   16384,  1,  1,  500,    false,  false,  false }
+};
+
+typedef struct BENCH_CONNECTION_TAG
+{
+    struct BENCH_RUN_TAG* run;
+    HTTP_CLIENT_HANDLE client;
+    HTTP_PREPARED_REQUEST_HANDLE prepared;
+    bool is_open;
+    bool is_closed;
+
+    // Send times of the requests in flight, the responses come back in the same order
+    uint64_t* start_times;
+    size_t start_head;
+    size_t start_count;
+} BENCH_CONNECTION;
+
+typedef struct BENCH_RUN_TAG
+{
+    const BENCH_SCENARIO* scenario;
+    HTTP_URING_HANDLE uring;
+    BENCH_CONNECTION* conn_list;
+    size_t open_count;
+    size_t issued;
+    size_t completed;
+    size_t failed;
+    uint64_t body_bytes;
+    uint64_t* latency_list;
+    bool has_error;
+} BENCH_RUN;
+
+static void issue_request(BENCH_CONNECTION* conn);
+
+static void on_request_complete(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+    HTTP_HEADERS_HANDLE response_headers)
+{
+    BENCH_CONNECTION* conn = (BENCH_CONNECTION*)callback_ctx;
+    BENCH_RUN* run = conn->run;
+    (void)content;
+    (void)response_headers;
+
+    if (conn->start_count > 0)
+    {
+        uint64_t start_time = conn->start_times[conn->start_head];
+        conn->start_head = (conn->start_head + 1) % run->scenario->pipeline_depth;
+        conn->start_count--;
+        run->latency_list[run->completed + run->failed] = bench_now_ns() - start_time;
+    }
+
+    if (request_result != HTTP_CLIENT_OK || status_code != 200 || content_length != run->scenario->payload_size)
+    {
+        run->failed++;
+    }
+    else
+    {
+        run->completed++;
+        run->body_bytes += content_length;
+    }
+    issue_request(conn);
+}
+
+static void issue_request(BENCH_CONNECTION* conn)
+{
+    BENCH_RUN* run = conn->run;
+    while (!run->has_error && run->issued < run->scenario->request_count && conn->start_count < run->scenario->pipeline_depth)
+    {
+        size_t slot = (conn->start_head + conn->start_count) % run->scenario->pipeline_depth;
+        conn->start_times[slot] = bench_now_ns();
+        int execute_result;
+        if (conn->prepared != NULL)
+        {
+            execute_result = http_client_execute_prepared_request(conn->client, conn->prepared, NULL, 0, on_request_complete, conn);
+        }
+        else
+        {
+            execute_result = http_client_execute_request(conn->client, HTTP_CLIENT_REQUEST_GET, BENCH_RELATIVE_PATH, NULL, NULL, 0, on_request_complete, conn);
+        }
+        if (execute_result != 0)
+        {
+            (void)printf("Failure executing request\n");
+            run->has_error = true;
+        }
+        else
+        {
+            conn->start_count++;
+            run->issued++;
+        }
+    }
+}
+
+static void on_open_complete(void* callback_ctx, HTTP_CLIENT_RESULT open_result)
+{
+    BENCH_CONNECTION* conn = (BENCH_CONNECTION*)callback_ctx;
+    if (open_result == HTTP_CLIENT_OK)
+    {
+        conn->is_open = true;
+        conn->run->open_count++;
+    }
+    else
+    {
+        (void)printf("Failure opening connection %d\n", (int)open_result);
+        conn->run->has_error = true;
+    }
+}
+
+static void on_error(void* callback_ctx, HTTP_CLIENT_RESULT error_result)
+{
+    BENCH_CONNECTION* conn = (BENCH_CONNECTION*)callback_ctx;
+    (void)printf("Connection error %d\n", (int)error_result);
+    conn->run->has_error = true;
+}
+
+static void on_close_complete(void* callback_ctx)
+{
+    BENCH_CONNECTION* conn = (BENCH_CONNECTION*)callback_ctx;
+    conn->is_closed = true;
+}
+
+static void process_connections(BENCH_RUN* run)
+{
+    for (size_t index = 0; index < run->scenario->connection_count; index++)
+    {
+        http_client_process_item(run->conn_list[index].client);
+    }
+    if (run->uring != NULL)
+    {
+        (void)http_uring_process(run->uring);
+    }
+}
+
+static void close_connections(BENCH_RUN* run)
+{
+    for (size_t index = 0; index < run->scenario->connection_count; index++)
+    {
+        BENCH_CONNECTION* conn = &run->conn_list[index];
+        if (conn->client == NULL || http_client_close(conn->client, on_close_complete, conn) != 0)
+        {
+            conn->is_closed = true;
+        }
+    }
+
+    uint64_t close_start = bench_now_ns();
+    size_t closed_count = 0;
+    while (closed_count < run->scenario->connection_count && bench_now_ns() - close_start < CLOSE_TIMEOUT_NS)
+    {
+        closed_count = 0;
+        for (size_t index = 0; index < run->scenario->connection_count; index++)
+        {
+            BENCH_CONNECTION* conn = &run->conn_list[index];
+            if (conn->client != NULL && !conn->is_closed)
+            {
+                http_client_process_item(conn->client);
+            }
+            closed_count += conn->is_closed ? 1 : 0;
+        }
+        if (run->uring != NULL)
+        {
+            (void)http_uring_process(run->uring);
+        }
+    }
+
+    for (size_t index = 0; index < run->scenario->connection_count; index++)
+    {
+        http_client_destroy_prepared_request(run->conn_list[index].prepared);
+        http_client_destroy(run->conn_list[index].client);
+        free(run->conn_list[index].start_times);
+    }
+}
+
+static int open_connections(BENCH_RUN* run, uint16_t port, const char* socket_path)
+{
+    int result = 0;
+    HTTP_ADDRESS http_address = {0};
+    http_address.hostname = BENCH_HOSTNAME;
+    http_address.port = port;
+    http_address.socket_path = socket_path;
+
+    for (size_t index = 0; index < run->scenario->connection_count && result == 0; index++)
+    {
+        BENCH_CONNECTION* conn = &run->conn_list[index];
+        conn->run = run;
+        if ((conn->start_times = (uint64_t*)malloc(run->scenario->pipeline_depth * sizeof(uint64_t))) == NULL)
+        {
+            (void)printf("Failure allocating connection timings\n");
+            result = __LINE__;
+        }
+        else if ((conn->client = http_client_create()) == NULL)
+        {
+            (void)printf("Failure creating http client\n");
+            result = __LINE__;
+        }
+        else if (http_client_set_pipeline_depth(conn->client, run->scenario->pipeline_depth) != 0)
+        {
+            (void)printf("Failure setting pipeline depth\n");
+            result = __LINE__;
+        }
+        else if (run->uring != NULL && http_client_set_uring(conn->client, run->uring) != 0)
+        {
+            (void)printf("Failure setting uring\n");
+            result = __LINE__;
+        }
+        else if (http_client_open(conn->client, &http_address, on_open_complete, conn, on_error, conn) != 0)
+        {
+            (void)printf("Failure opening http client\n");
+            result = __LINE__;
+        }
+    }
+
+    uint64_t open_start = bench_now_ns();
+    while (result == 0 && run->open_count < run->scenario->connection_count)
+    {
+        process_connections(run);
+        if (run->has_error || bench_now_ns() - open_start > OPEN_TIMEOUT_NS)
+        {
+            (void)printf("Failure opening connections to the bench server\n");
+            result = __LINE__;
+        }
+    }
+
+    for (size_t index = 0; index < run->scenario->connection_count && result == 0 && run->scenario->prepared; index++)
+    {
+        BENCH_CONNECTION* conn = &run->conn_list[index];
+        if ((conn->prepared = http_client_prepare_request(conn->client, HTTP_CLIENT_REQUEST_GET, BENCH_RELATIVE_PATH, NULL)) == NULL)
+        {
+            (void)printf("Failure preparing request\n");
+            result = __LINE__;
+        }
+    }
+    return result;
+}
+
+static int run_scenario(const BENCH_SCENARIO* scenario)
+{
+    int result;
+    BENCH_SERVER_CONFIG server_config;
+    BENCH_SERVER_HANDLE server;
+    uint16_t port;
+    BENCH_RUN run;
+    char socket_path[64];
+
+    memset(&run, 0, sizeof(run));
+    run.scenario = scenario;
+    server_config.payload_size = scenario->payload_size;
+    server_config.chunked = scenario->chunked;
+    server_config.chunk_size = scenario->chunk_size;
+    server_config.socket_path = NULL;
+    if (scenario->unix_socket)
+    {
+        (void)snprintf(socket_path, sizeof(socket_path), BENCH_SOCKET_PATH_FORMAT, (int)getpid());
+        server_config.socket_path = socket_path;
+    }
+
+    if (scenario->uring && !http_uring_is_available())
+    {
+        (void)printf("%-24s skipped: io_uring is not available\n", scenario->name);
+        result = 0;
+    }
+    else if (scenario->uring && (run.uring = http_uring_create((uint32_t)(scenario->connection_count * scenario->pipeline_depth * 4), NULL)) == NULL)
+    {
+        (void)printf("Failure creating uring\n");
+        result = __LINE__;
+    }
+    else if ((server = bench_server_start(&server_config, &port)) == NULL)
+    {
+        http_uring_destroy(run.uring);
+        result = __LINE__;
+    }
+    else
+    {
+        if ((run.conn_list = (BENCH_CONNECTION*)calloc(scenario->connection_count, sizeof(BENCH_CONNECTION))) == NULL ||
+            (run.latency_list = (uint64_t*)malloc(scenario->request_count * sizeof(uint64_t))) == NULL)
+        {
+            (void)printf("Failure allocating bench run\n");
+            result = __LINE__;
+        }
+        else if (open_connections(&run, port, server_config.socket_path) != 0)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            uint64_t alloc_start = bench_alloc_count();
+            uint64_t run_start = bench_now_ns();
+            for (size_t index = 0; index < scenario->connection_count; index++)
+            {
+                issue_request(&run.conn_list[index]);
+            }
+            while (!run.has_error && run.completed + run.failed < scenario->request_count && bench_now_ns() - run_start < RUN_TIMEOUT_NS)
+            {
+                process_connections(&run);
+            }
+            uint64_t elapsed_ns = bench_now_ns() - run_start;
+            uint64_t alloc_total = bench_alloc_count() - alloc_start;
+            size_t sample_count = run.completed + run.failed;
+
+            if (run.has_error || sample_count < scenario->request_count || run.failed > 0)
+            {
+                (void)printf("%-24s failed: %zu of %zu requests completed, %zu failed\n", scenario->name, run.completed, scenario->request_count, run.failed);
+                result = __LINE__;
+            }
+            else
+            {
+                double elapsed_sec = (double)elapsed_ns / 1e9;
+                (void)printf("%-24s %12.0f %10.2f %10.1f %10.1f %10.1f ", scenario->name,
+                    (double)sample_count / elapsed_sec,
+                    (double)run.body_bytes / elapsed_sec / 1e6,
+                    (double)bench_percentile(run.latency_list, sample_count, 0.50) / 1e3,
+                    (double)bench_percentile(run.latency_list, sample_count, 0.99) / 1e3,
+                    (double)bench_percentile(run.latency_list, sample_count, 0.999) / 1e3);
+                if (bench_alloc_count_enabled())
+                {
+                    (void)printf("%10.1f\n", (double)alloc_total / (double)sample_count);
+                }
+                else
+                {
+                    (void)printf("%10s\n", "n/a");
+                }
+                result = 0;
+            }
+        }
+        if (run.conn_list != NULL)
+        {
+            close_connections(&run);
+        }
+        free(run.conn_list);
+        free(run.latency_list);
+        http_uring_destroy(run.uring);
+        bench_server_stop(server);
+    }
+    return result;
+}
+
+static void print_usage(const char* app_name)
+{
+    (void)printf("Usage: %s [--size bytes] [--chunked] [--chunk-size bytes] [--depth n] [--connections n] [--requests n] [--prepared] [--unix] [--uring]\n", app_name);
+    (void)printf("With no options a default set of scenarios is run\n");
+}
+
+static int parse_scenario(int argc, char* argv[], BENCH_SCENARIO* scenario)
+{
+    int result = 0;
+    for (int index = 1; index < argc && result == 0; index++)
+    {
+        const char* value = index + 1 < argc ? argv[index + 1] : NULL;
+        if (strcmp(argv[index], "--chunked") == 0)
+        {
+            scenario->chunked = true;
+        }
+        else if (strcmp(argv[index], "--prepared") == 0)
+        {
+            scenario->prepared = true;
+        }
+        else if (strcmp(argv[index], "--unix") == 0)
+        {
+            scenario->unix_socket = true;
+        }
+        else if (strcmp(argv[index], "--uring") == 0)
+        {
+            scenario->uring = true;
+        }
+        else if (value == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            size_t number = (size_t)strtoull(value, NULL, 10);
+            if (strcmp(argv[index], "--size") == 0)
+            {
+                scenario->payload_size = number;
+            }
+            else if (strcmp(argv[index], "--chunk-size") == 0)
+            {
+                scenario->chunk_size = number;
+            }
+            else if (strcmp(argv[index], "--depth") == 0)
+            {
+                scenario->pipeline_depth = number;
+            }
+            else if (strcmp(argv[index], "--connections") == 0)
+            {
+                scenario->connection_count = number;
+            }
+            else if (strcmp(argv[index], "--requests") == 0)
+            {
+                scenario->request_count = number;
+            }
+            else
+            {
+                result = __LINE__;
+            }
+            index++;
+        }
+    }
+    if (result == 0 && (scenario->pipeline_depth == 0 || scenario->connection_count == 0 || scenario->request_count == 0))
+    {
+        result = __LINE__;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_SCENARIO custom_scenario = { "custom", 64, false, 0, 1, 1,  20000,  false,  false,  false };
+
+    if (argc > 1 && parse_scenario(argc, argv, &custom_scenario) != 0)
+    {
+        print_usage(argv[0]);
+        result = 1;
+    }
+    else
+    {
+        (void)printf("%-24s %12s %10s %10s %10s %10s %10s\n", "scenario", "req/s", "MB/s", "p50 us", "p99 us", "p999 us", "allocs/req");
+        if (argc > 1)
+        {
+            result = run_scenario(&custom_scenario) == 0 ? 0 : 1;
+        }
+        else
+        {
+            for (size_t index = 0; index < sizeof(DEFAULT_SCENARIOS) / sizeof(DEFAULT_SCENARIOS[0]); index++)
+            {
+                if (run_scenario(&DEFAULT_SCENARIOS[index]) != 0)
+                {
+                    result = 1;
+                }
+            }
+        }
+    }
+    return result;
+}
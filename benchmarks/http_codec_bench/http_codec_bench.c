@@ -0,0 +1,323 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "http_client/http_codec.h"
+#include "http_client/http_scan.h"
+
+#include "bench_util.h"
+
+// Each corpus and split is replayed until this much data went through the codec or the
+// time limit is hit, whichever comes first
+#define MIN_REPLAY_BYTES            (16u * 1024u * 1024u)
+#define MAX_REPLAY_NS               (2ull * 1000000000ull)
+
+#define HEADER_HEAVY_COUNT          40
+#define LARGE_BODY_SIZE             (256u * 1024u)
+#define SMALL_CHUNK_COUNT           2048
+
+// Read sizes fed to the codec, 0 hands over the whole message in one call
+static const size_t SPLIT_SIZES[] = { 1, 16, 256, 1460, 16384, 0 };
+
+MU_DEFINE_ENUM_STRINGS(HTTP_SCAN_KERNEL, HTTP_SCAN_KERNEL_VALUES)
+
+static const char SMALL_JSON_RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Mon, 12 Oct 2020 18:31:52 GMT\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 125\r\n"
+    "Connection: keep-alive\r\n"
+    "Server: gunicorn/19.9.0\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Access-Control-Allow-Credentials: true\r\n"
+    "\r\n"
+    "{\"id\": 1842, \"name\": \"sensor-17\", \"status\": \"online\", \"reading\": 23.75, \"unit\": \"celsius\", \"updated\": \"2020-10-12T18:31:52Z\"}";
+
+typedef struct CODEC_CORPUS_TAG
+{
+    const char* name;
+    unsigned char* data;
+    size_t length;
+} CODEC_CORPUS;
+
+typedef struct REPLAY_RESULT_TAG
+{
+    size_t message_count;
+    size_t error_count;
+} REPLAY_RESULT;
+
+static void on_codec_data(void* callback_ctx, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data)
+{
+    REPLAY_RESULT* replay = (REPLAY_RESULT*)callback_ctx;
+    (void)http_recv_data;
+    if (result == HTTP_CODEC_CB_RESULT_OK)
+    {
+        replay->message_count++;
+    }
+    else
+    {
+        replay->error_count++;
+    }
+}
+
+static int append_text(unsigned char* buffer, size_t capacity, size_t* length, const char* text, size_t text_len)
+{
+    int result;
+    if (*length + text_len > capacity)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(buffer + *length, text, text_len);
+        *length += text_len;
+        result = 0;
+    }
+    return result;
+}
+
+static int build_small_json(CODEC_CORPUS* corpus)
+{
+    int result;
+    corpus->length = sizeof(SMALL_JSON_RESPONSE) - 1;
+    if ((corpus->data = (unsigned char*)malloc(corpus->length)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(corpus->data, SMALL_JSON_RESPONSE, corpus->length);
+        result = 0;
+    }
+    return result;
+}
+
+static int build_header_heavy(CODEC_CORPUS* corpus)
+{
+    int result = 0;
+    size_t capacity = 8192;
+    char line[160];
+
+    corpus->length = 0;
+    if ((corpus->data = (unsigned char*)malloc(capacity)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        result = append_text(corpus->data, capacity, &corpus->length, "HTTP/1.1 200 OK\r\n", 17);
+        for (size_t index = 0; index < HEADER_HEAVY_COUNT && result == 0; index++)
+        {
+            int line_len;
+            if (index % 4 == 0)
+            {
+                line_len = snprintf(line, sizeof(line), "Set-Cookie: session_%zu=7f3a9c2e4b1d8f6a0e5c3b9d2a7f4e1c; Path=/; HttpOnly; Secure\r\n", index);
+            }
+            else
+            {
+                line_len = snprintf(line, sizeof(line), "X-Backend-Trace-%zu: edge-%zu.region-west.example.net; rtt=%zums\r\n", index, index * 7, index + 3);
+            }
+            result = append_text(corpus->data, capacity, &corpus->length, line, (size_t)line_len);
+        }
+        if (result == 0)
+        {
+            static const char tail[] = "Content-Length: 2\r\n\r\nok";
+            result = append_text(corpus->data, capacity, &corpus->length, tail, sizeof(tail) - 1);
+        }
+    }
+    return result;
+}
+
+static int build_large_content_length(CODEC_CORPUS* corpus)
+{
+    int result;
+    char head[96];
+    int head_len = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: %u\r\n\r\n", LARGE_BODY_SIZE);
+
+    corpus->length = (size_t)head_len + LARGE_BODY_SIZE;
+    if ((corpus->data = (unsigned char*)malloc(corpus->length)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(corpus->data, head, (size_t)head_len);
+        memset(corpus->data + head_len, 'b', LARGE_BODY_SIZE);
+        result = 0;
+    }
+    return result;
+}
+
+static int build_many_small_chunks(CODEC_CORPUS* corpus)
+{
+    int result = 0;
+    static const char head[] = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nTransfer-Encoding: chunked\r\n\r\n";
+    // 16 byte chunks
+    static const char chunk[] = "10\r\nabcdefghijklmnop\r\n";
+    size_t capacity = sizeof(head) + (SMALL_CHUNK_COUNT * sizeof(chunk)) + 8;
+
+    corpus->length = 0;
+    if ((corpus->data = (unsigned char*)malloc(capacity)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        result = append_text(corpus->data, capacity, &corpus->length, head, sizeof(head) - 1);
+        for (size_t index = 0; index < SMALL_CHUNK_COUNT && result == 0; index++)
+        {
+            result = append_text(corpus->data, capacity, &corpus->length, chunk, sizeof(chunk) - 1);
+        }
+        if (result == 0)
+        {
+            result = append_text(corpus->data, capacity, &corpus->length, "0\r\n\r\n", 5);
+        }
+    }
+    return result;
+}
+
+static int replay_corpus(const CODEC_CORPUS* corpus, size_t split_size)
+{
+    int result;
+    REPLAY_RESULT replay = {0};
+    HTTP_CODEC_HANDLE codec;
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    size_t read_size = split_size == 0 || split_size > corpus->length ? corpus->length : split_size;
+
+    if ((codec = http_codec_create(on_codec_data, &replay)) == NULL)
+    {
+        (void)printf("Failure creating codec\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t fed_messages = 0;
+        uint64_t fed_bytes = 0;
+        uint64_t alloc_start = bench_alloc_count();
+        uint64_t replay_start = bench_now_ns();
+        uint64_t elapsed_ns = 0;
+
+        do
+        {
+            for (size_t offset = 0; offset < corpus->length; offset += read_size)
+            {
+                size_t curr_len = corpus->length - offset < read_size ? corpus->length - offset : read_size;
+                on_bytes_recv(codec, corpus->data + offset, curr_len);
+            }
+            fed_messages++;
+            fed_bytes += corpus->length;
+            elapsed_ns = bench_now_ns() - replay_start;
+        } while (fed_bytes < MIN_REPLAY_BYTES && elapsed_ns < MAX_REPLAY_NS);
+
+        uint64_t alloc_total = bench_alloc_count() - alloc_start;
+
+        if (replay.message_count != fed_messages || replay.error_count != 0)
+        {
+            (void)printf("%-24s %8zu failed: %zu of %zu messages parsed, %zu errors\n", corpus->name, read_size, replay.message_count, fed_messages, replay.error_count);
+            result = __LINE__;
+        }
+        else
+        {
+            char split_name[24];
+            if (split_size == 0)
+            {
+                (void)snprintf(split_name, sizeof(split_name), "whole");
+            }
+            else
+            {
+                (void)snprintf(split_name, sizeof(split_name), "%zu", split_size);
+            }
+            (void)printf("%-24s %8s %10zu %10.2f %10.1f ", corpus->name, split_name, fed_messages,
+                (double)elapsed_ns / (double)fed_bytes, (double)fed_bytes / ((double)elapsed_ns / 1e9) / 1e6);
+            if (bench_alloc_count_enabled())
+            {
+                (void)printf("%12.1f\n", (double)alloc_total / (double)fed_messages);
+            }
+            else
+            {
+                (void)printf("%12s\n", "n/a");
+            }
+            result = 0;
+        }
+        http_codec_destroy(codec);
+    }
+    return result;
+}
+
+static int parse_kernel(int argc, char* argv[])
+{
+    int result;
+    if (argc != 3 || strcmp(argv[1], "--kernel") != 0)
+    {
+        result = __LINE__;
+    }
+    else if (strcmp(argv[2], "scalar") == 0)
+    {
+        result = http_scan_set_kernel(HTTP_SCAN_KERNEL_SCALAR);
+    }
+    else if (strcmp(argv[2], "sse42") == 0)
+    {
+        result = http_scan_set_kernel(HTTP_SCAN_KERNEL_SSE42);
+    }
+    else if (strcmp(argv[2], "avx2") == 0)
+    {
+        result = http_scan_set_kernel(HTTP_SCAN_KERNEL_AVX2);
+    }
+    else
+    {
+        result = __LINE__;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    CODEC_CORPUS corpus_list[] =
+    {
+        { "small json", NULL, 0 },
+        { "header heavy", NULL, 0 },
+        { "large content-length", NULL, 0 },
+        { "many small chunks", NULL, 0 }
+    };
+    size_t corpus_count = sizeof(corpus_list) / sizeof(corpus_list[0]);
+
+    if (argc > 1 && parse_kernel(argc, argv) != 0)
+    {
+        (void)printf("Usage: %s [--kernel scalar|sse42|avx2]\n", argv[0]);
+        (void)printf("With no options the fastest scan kernel the machine supports is used\n");
+        result = 1;
+    }
+    else if (build_small_json(&corpus_list[0]) != 0 || build_header_heavy(&corpus_list[1]) != 0 ||
+        build_large_content_length(&corpus_list[2]) != 0 || build_many_small_chunks(&corpus_list[3]) != 0)
+    {
+        (void)printf("Failure building codec corpora\n");
+        result = 1;
+    }
+    else
+    {
+        (void)printf("scan kernel: %s\n", MU_ENUM_TO_STRING(HTTP_SCAN_KERNEL, http_scan_get_kernel()));
+        (void)printf("%-24s %8s %10s %10s %10s %12s\n", "corpus", "split", "messages", "ns/byte", "MB/s", "allocs/msg");
+        for (size_t corpus = 0; corpus < corpus_count; corpus++)
+        {
+            for (size_t split = 0; split < sizeof(SPLIT_SIZES) / sizeof(SPLIT_SIZES[0]); split++)
+            {
+                if (replay_corpus(&corpus_list[corpus], SPLIT_SIZES[split]) != 0)
+                {
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    for (size_t corpus = 0; corpus < corpus_count; corpus++)
+    {
+        free(corpus_list[corpus].data);
+    }
+    return result;
+}
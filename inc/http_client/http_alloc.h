@@ -0,0 +1,41 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_ALLOC_H
+#define HTTP_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif /* __cplusplus */
+
+typedef void*(*HTTP_ALLOC_FUNC)(void* alloc_ctx, size_t size);
+typedef void*(*HTTP_REALLOC_FUNC)(void* alloc_ctx, void* ptr, size_t size);
+typedef void(*HTTP_FREE_FUNC)(void* alloc_ctx, void* ptr);
+
+// Memory functions used by the library, alloc_ctx is handed back on every call.  Like free,
+// free_func is called with NULL
+typedef struct HTTP_ALLOCATOR_TAG
+{
+    HTTP_ALLOC_FUNC alloc_func;
+    HTTP_REALLOC_FUNC realloc_func;
+    HTTP_FREE_FUNC free_func;
+    void* alloc_ctx;
+} HTTP_ALLOCATOR;
+
+// Replaces the allocator used when none is given, NULL goes back to malloc and free.  The
+// allocator is copied, set it before any handle is created and not while handles are alive
+extern int http_alloc_set_default(const HTTP_ALLOCATOR* allocator);
+extern const HTTP_ALLOCATOR* http_alloc_get_default(void);
+
+// A NULL allocator uses the default one
+extern void* http_alloc_malloc(const HTTP_ALLOCATOR* allocator, size_t size);
+extern void* http_alloc_realloc(const HTTP_ALLOCATOR* allocator, void* ptr, size_t size);
+extern void http_alloc_free(const HTTP_ALLOCATOR* allocator, void* ptr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_ALLOC_H
@@ -0,0 +1,123 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_ATOMIC_H
+#define HTTP_ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+// Acquire loads, release stores, a compare exchange on size_t and a full fence for the lock free queues.
+// GCC and Clang use their __atomic builtins, MSVC the Interlocked functions and other
+// C11 compilers <stdatomic.h>
+
+#if defined(_MSC_VER)
+
+#include <windows.h>
+
+static __inline size_t http_atomic_load_relaxed(const volatile size_t* value)
+{
+    return *value;
+}
+
+static __inline size_t http_atomic_load_acquire(const volatile size_t* value)
+{
+    size_t result = *value;
+    MemoryBarrier();
+    return result;
+}
+
+static __inline void http_atomic_store_release(volatile size_t* value, size_t desired)
+{
+    MemoryBarrier();
+    *value = desired;
+}
+
+// On failure expected is updated to the current value
+static __inline bool http_atomic_compare_exchange(volatile size_t* value, size_t* expected, size_t desired)
+{
+    size_t previous = (size_t)InterlockedCompareExchangePointer((PVOID volatile*)value, (PVOID)desired, (PVOID)*expected);
+    bool result = previous == *expected;
+    *expected = previous;
+    return result;
+}
+
+// Orders the stores before it against the loads after it, a release store followed by an acquire load does not
+static __inline void http_atomic_thread_fence(void)
+{
+    MemoryBarrier();
+}
+
+#elif defined(__GNUC__) || defined(__clang__)
+
+static inline size_t http_atomic_load_relaxed(const volatile size_t* value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static inline size_t http_atomic_load_acquire(const volatile size_t* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline void http_atomic_store_release(volatile size_t* value, size_t desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+// On failure expected is updated to the current value
+static inline bool http_atomic_compare_exchange(volatile size_t* value, size_t* expected, size_t desired)
+{
+    return __atomic_compare_exchange_n(value, expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+// Orders the stores before it against the loads after it, a release store followed by an acquire load does not
+static inline void http_atomic_thread_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+static inline size_t http_atomic_load_relaxed(const volatile size_t* value)
+{
+    return atomic_load_explicit((const volatile _Atomic size_t*)value, memory_order_relaxed);
+}
+
+static inline size_t http_atomic_load_acquire(const volatile size_t* value)
+{
+    return atomic_load_explicit((const volatile _Atomic size_t*)value, memory_order_acquire);
+}
+
+static inline void http_atomic_store_release(volatile size_t* value, size_t desired)
+{
+    atomic_store_explicit((volatile _Atomic size_t*)value, desired, memory_order_release);
+}
+
+// On failure expected is updated to the current value
+static inline bool http_atomic_compare_exchange(volatile size_t* value, size_t* expected, size_t desired)
+{
+    return atomic_compare_exchange_weak_explicit((volatile _Atomic size_t*)value, expected, desired, memory_order_relaxed, memory_order_relaxed);
+}
+
+// Orders the stores before it against the loads after it, a release store followed by an acquire load does not
+static inline void http_atomic_thread_fence(void)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+#else
+#error "http_atomic.h needs GCC or Clang builtins, MSVC or C11 atomics"
+#endif
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_ATOMIC_H
@@ -16,7 +16,10 @@ extern "C" {
 #include "azure_macro_utils/macro_utils.h"
 #include "umock_c/umock_c_prod.h"
 #include "patchcords/patchcord_client.h"
+#include "http_client/http_alloc.h"
 #include "http_client/http_headers.h"
+#include "http_client/http_tls.h"
+#include "http_client/http_uring.h"
 
 typedef enum HTTP_CLIENT_RESULT_TAG
 {
@@ -29,7 +32,8 @@ typedef enum HTTP_CLIENT_RESULT_TAG
     HTTP_CLIENT_HTTP_HEADERS_FAILED,
     HTTP_CLIENT_INVALID_STATE,
     HTTP_CLIENT_DISCONNECTION,
-    HTTP_CLIENT_MEMORY
+    HTTP_CLIENT_MEMORY,
+    HTTP_CLIENT_TIMEOUT
 } HTTP_CLIENT_RESULT;
 
 typedef enum HTTP_CLIENT_REQUEST_TYPE_TAG
@@ -48,17 +52,58 @@ typedef struct HTTP_ADDRESS_TAG
     const char* hostname;
     uint16_t port;
     bool is_secure;
+
+    // Connects to the unix domain socket at this path when set, hostname and port then only
+    // fill the Host header
+    const char* socket_path;
 } HTTP_ADDRESS;
 
+// Monotonic timestamps in nanoseconds of one request, a point the request never reached is 0
+typedef struct HTTP_REQUEST_TIMING_TAG
+{
+    uint64_t enqueued;
+    uint64_t dequeued;
+    uint64_t send_complete;
+    uint64_t first_byte;
+    uint64_t headers_complete;
+    uint64_t body_complete;
+} HTTP_REQUEST_TIMING;
+
 typedef struct HTTP_CLIENT_INFO_TAG* HTTP_CLIENT_HANDLE;
+typedef struct HTTP_PREPARED_REQUEST_INFO_TAG* HTTP_PREPARED_REQUEST_HANDLE;
 
 typedef void(*ON_HTTP_OPEN_COMPLETE_CALLBACK)(void* callback_ctx, HTTP_CLIENT_RESULT open_result);
 typedef void(*ON_HTTP_ERROR_CALLBACK)(void* callback_ctx, HTTP_CLIENT_RESULT error_result);
 typedef void(*ON_HTTP_REQUEST_CALLBACK)(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
     HTTP_HEADERS_HANDLE response_headers);
 typedef void(*ON_HTTP_CLIENT_CLOSE)(void* callback_context);
+typedef void(*ON_HTTP_CLIENT_WAKE)(void* wake_ctx);
+
+// Streaming callbacks, the body is delivered in fragments as it arrives instead of in a single buffer
+typedef void(*ON_HTTP_HEADERS_COMPLETE)(void* callback_ctx, unsigned int status_code, HTTP_HEADERS_HANDLE response_headers);
+typedef void(*ON_HTTP_BODY_FRAGMENT)(void* callback_ctx, const unsigned char* fragment, size_t fragment_len);
+typedef void(*ON_HTTP_MESSAGE_COMPLETE)(void* callback_ctx, HTTP_CLIENT_RESULT request_result);
+
+// One request of http_client_execute_batch, http_header, content and on_request_callback can be NULL
+typedef struct HTTP_BATCH_REQUEST_TAG
+{
+    HTTP_CLIENT_REQUEST_TYPE request_type;
+    const char* relative_path;
+    HTTP_HEADERS_HANDLE http_header;
+    const unsigned char* content;
+    size_t content_length;
+    ON_HTTP_REQUEST_CALLBACK on_request_callback;
+    void* callback_ctx;
+} HTTP_BATCH_REQUEST;
+
+// Called after the last request of the batch is reported, failed_count are the requests
+// that did not complete with HTTP_CLIENT_OK
+typedef void(*ON_HTTP_BATCH_COMPLETE)(void* callback_ctx, size_t request_count, size_t failed_count);
 
 MOCKABLE_FUNCTION(, HTTP_CLIENT_HANDLE, http_client_create);
+// The client, its codec, requests and prepared templates are allocated from allocator, NULL is
+// the default allocator.  Buffers grown inside lib-util-c still use malloc
+MOCKABLE_FUNCTION(, HTTP_CLIENT_HANDLE, http_client_create_with_allocator, const HTTP_ALLOCATOR*, allocator);
 MOCKABLE_FUNCTION(, void, http_client_destroy, HTTP_CLIENT_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, int, http_client_open, HTTP_CLIENT_HANDLE, handle, const HTTP_ADDRESS*, http_address, ON_HTTP_OPEN_COMPLETE_CALLBACK, on_open_complete_cb, void*, user_ctx, ON_HTTP_ERROR_CALLBACK, on_error_cb, void*, err_user_ctx);
@@ -66,9 +111,105 @@ MOCKABLE_FUNCTION(, int, http_client_close, HTTP_CLIENT_HANDLE, handle, ON_HTTP_
 
 MOCKABLE_FUNCTION(, int, http_client_execute_request, HTTP_CLIENT_HANDLE, handle, HTTP_CLIENT_REQUEST_TYPE, request_type, const char*, relative_path,
     HTTP_HEADERS_HANDLE, http_header, const unsigned char*, content, size_t, content_length, ON_HTTP_REQUEST_CALLBACK, on_request_callback, void*, callback_ctx);
+MOCKABLE_FUNCTION(, int, http_client_execute_stream_request, HTTP_CLIENT_HANDLE, handle, HTTP_CLIENT_REQUEST_TYPE, request_type, const char*, relative_path,
+    HTTP_HEADERS_HANDLE, http_header, const unsigned char*, content, size_t, content_length, ON_HTTP_HEADERS_COMPLETE, on_headers_complete,
+    ON_HTTP_BODY_FRAGMENT, on_body_fragment, ON_HTTP_MESSAGE_COMPLETE, on_message_complete, void*, callback_ctx);
+
+// Serializes the request line and headers once so repeated requests only add the content length
+// and body.  The Host line is taken from the open connection, so prepare after http_client_open and
+// only execute the template on the client it was prepared on
+MOCKABLE_FUNCTION(, HTTP_PREPARED_REQUEST_HANDLE, http_client_prepare_request, HTTP_CLIENT_HANDLE, handle, HTTP_CLIENT_REQUEST_TYPE, request_type, const char*, relative_path,
+    HTTP_HEADERS_HANDLE, http_header);
+// Requests already queued from the template keep it alive until they are sent
+MOCKABLE_FUNCTION(, void, http_client_destroy_prepared_request, HTTP_PREPARED_REQUEST_HANDLE, prepared);
+MOCKABLE_FUNCTION(, int, http_client_execute_prepared_request, HTTP_CLIENT_HANDLE, handle, HTTP_PREPARED_REQUEST_HANDLE, prepared, const unsigned char*, content,
+    size_t, content_length, ON_HTTP_REQUEST_CALLBACK, on_request_callback, void*, callback_ctx);
+
+// Queues all of the requests or none of them.  Their paths, content and bookkeeping share one
+// allocation and a request with the same headers as the one before it reuses its serialized
+// header block.  The requests array is not used after the call and on_batch_complete can be NULL
+MOCKABLE_FUNCTION(, int, http_client_execute_batch, HTTP_CLIENT_HANDLE, handle, const HTTP_BATCH_REQUEST*, requests, size_t, request_count,
+    ON_HTTP_BATCH_COMPLETE, on_batch_complete, void*, batch_ctx);
 
 MOCKABLE_FUNCTION(, void, http_client_process_item, HTTP_CLIENT_HANDLE, handle);
 
+// True while the client is connecting, closing or has requests queued or waiting on a response
+MOCKABLE_FUNCTION(, bool, http_client_has_pending_work, HTTP_CLIENT_HANDLE, handle);
+
+// Sleeps until the client has something to process or timeout_ms passes and then runs
+// http_client_process_item, use it in place of a process_item and sleep loop.  Returns at once
+// when requests are queued, submitted requests cut the sleep short and a pending connect or
+// request deadline ends it in time.  The socket cord does not hand out its socket so a client
+// waiting on it wakes every millisecond, on a ring it sleeps until the ring has completions
+MOCKABLE_FUNCTION(, int, http_client_wait, HTTP_CLIENT_HANDLE, handle, uint32_t, timeout_ms);
+
+// The pieces of http_client_wait for callers that sleep on many clients at once.  The wait fd
+// is readable when the client's ring has completions, it is -1 on the socket cord which does
+// not hand out its socket.  Set the ring before asking for it
+MOCKABLE_FUNCTION(, int, http_client_get_wait_fd, HTTP_CLIENT_HANDLE, handle);
+// Submits what was queued on the client's ring since it was last processed and dispatches its
+// completions to every client on the ring, call it before sleeping on the wait fd
+MOCKABLE_FUNCTION(, int, http_client_flush, HTTP_CLIENT_HANDLE, handle);
+// http_client_process_item without driving the connection, for callers that flush a shared ring
+// once for all of its clients and then only run the clients it reported ready
+MOCKABLE_FUNCTION(, void, http_client_process_work, HTTP_CLIENT_HANDLE, handle);
+// Called on the thread driving the client when a completion or work queued on that thread needs
+// http_client_process_item, http_reactor_register uses it to run only the clients with work
+MOCKABLE_FUNCTION(, int, http_client_set_ready_callback, HTTP_CLIENT_HANDLE, handle, ON_HTTP_CLIENT_WAKE, on_ready, void*, ready_ctx);
+// Milliseconds, at most timeout_ms, before http_client_process_item has something to do, 0 when
+// it has work now.  Covers the queued requests and the connect and request deadlines, a client
+// waiting on the socket cord gets at most 1 as its socket cannot be waited on
+MOCKABLE_FUNCTION(, int, http_client_get_wait_time, HTTP_CLIENT_HANDLE, handle, uint32_t, timeout_ms);
+
 MOCKABLE_FUNCTION(, int, http_client_set_trace, HTTP_CLIENT_HANDLE, handle, bool, set_trace);
 
+// Maximum number of requests sent ahead of their responses on the connection, defaults to 1
+MOCKABLE_FUNCTION(, int, http_client_set_pipeline_depth, HTTP_CLIENT_HANDLE, handle, size_t, max_depth);
+
+// Largest response buffer kept between responses on the connection, see http_codec_set_buffer_retention
+MOCKABLE_FUNCTION(, int, http_client_set_buffer_retention, HTTP_CLIENT_HANDLE, handle, size_t, max_retained_size);
+
+// Sends Accept-Encoding: gzip, deflate on every request and hands over the decoded body.
+// Fails when the library was built without zlib (http_client_zlib)
+MOCKABLE_FUNCTION(, int, http_client_set_content_decoding, HTTP_CLIENT_HANDLE, handle, bool, decode_content);
+
+// Deadlines in milliseconds for an open to complete and for a request to get its response
+// counted from when it is queued, 0 waits forever and is the default.  An expired open deadline
+// fails everything pending with HTTP_CLIENT_TIMEOUT.  A request that times out before it is sent
+// fails on its own, one that was sent drops the connection and fails the requests sent on it with
+// HTTP_CLIENT_TIMEOUT, the ones not sent yet go out once the connection opens again.  The
+// deadlines are checked in http_client_process_item
+MOCKABLE_FUNCTION(, int, http_client_set_timeouts, HTTP_CLIENT_HANDLE, handle, uint32_t, connect_timeout_ms, uint32_t, request_timeout_ms);
+
+// Records the timing of every request queued while enabled, off by default
+MOCKABLE_FUNCTION(, int, http_client_set_request_timing, HTTP_CLIENT_HANDLE, handle, bool, enable_timing);
+// Copies the timing of the request being reported, only valid from inside its
+// ON_HTTP_REQUEST_CALLBACK or ON_HTTP_MESSAGE_COMPLETE
+MOCKABLE_FUNCTION(, int, http_client_get_request_timing, HTTP_CLIENT_HANDLE, handle, HTTP_REQUEST_TIMING*, timing);
+
+// Creates the lock free queue behind http_client_submit_request holding up to queue_size requests
+// that http_client_process_item has not picked up yet.  Enable, and set the wake callback,
+// before the client is shared with other threads
+MOCKABLE_FUNCTION(, int, http_client_enable_submit_queue, HTTP_CLIENT_HANDLE, handle, size_t, queue_size);
+// Called on the submitting thread after each request is queued so the thread driving the
+// client stops waiting, http_reactor_register points this at the reactor
+MOCKABLE_FUNCTION(, int, http_client_set_wake_callback, HTTP_CLIENT_HANDLE, handle, ON_HTTP_CLIENT_WAKE, on_wake, void*, wake_ctx);
+// http_client_execute_request that any number of threads can call while one thread runs
+// http_client_process_item.  Fails when the submit queue is full, the client allocator must be
+// safe to call from the submitting threads.  The callback runs from http_client_process_item
+MOCKABLE_FUNCTION(, int, http_client_submit_request, HTTP_CLIENT_HANDLE, handle, HTTP_CLIENT_REQUEST_TYPE, request_type, const char*, relative_path,
+    HTTP_HEADERS_HANDLE, http_header, const unsigned char*, content, size_t, content_length, ON_HTTP_REQUEST_CALLBACK, on_request_callback, void*, callback_ctx);
+
+// Trust settings and resumable sessions for addresses with is_secure set, the client holds a
+// reference.  Share one cache between the clients connecting to the same hosts so their
+// reconnects resume, without one the client creates its own on the first secure open that
+// trusts the system certificates
+MOCKABLE_FUNCTION(, int, http_client_set_tls_cache, HTTP_CLIENT_HANDLE, handle, HTTP_TLS_CACHE_HANDLE, tls_cache);
+
+// Runs the connection on an io_uring ring instead of the socket cord, the client holds a
+// reference.  Set it before the first open, clients sharing a ring submit their sends together
+// when http_uring_process is called after processing them.  http_uring_create returns NULL
+// where io_uring is not available, the client then keeps the socket cord
+MOCKABLE_FUNCTION(, int, http_client_set_uring, HTTP_CLIENT_HANDLE, handle, HTTP_URING_HANDLE, uring);
+
 #endif // HTTP_CLIENT_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_CLIENT_POOL_H
+#define HTTP_CLIENT_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "http_client/http_client.h"
+#include "http_client/http_headers.h"
+
+typedef struct HTTP_CLIENT_POOL_INFO_TAG* HTTP_CLIENT_POOL_HANDLE;
+
+// A value of 0 selects the default for that setting
+typedef struct HTTP_CLIENT_POOL_CONFIG_TAG
+{
+    size_t max_connections_per_host;
+    size_t max_connections;
+    size_t idle_timeout_sec;
+    // Shared by the secure connections so a replaced connection resumes the session of the
+    // one before it, NULL has the pool create one trusting the system certificates
+    HTTP_TLS_CACHE_HANDLE tls_cache;
+    // Runs the connections on one io_uring ring where the system supports it, they use the
+    // socket cord otherwise
+    bool use_uring;
+} HTTP_CLIENT_POOL_CONFIG;
+
+MOCKABLE_FUNCTION(, HTTP_CLIENT_POOL_HANDLE, http_client_pool_create, const HTTP_CLIENT_POOL_CONFIG*, config);
+MOCKABLE_FUNCTION(, void, http_client_pool_destroy, HTTP_CLIENT_POOL_HANDLE, handle);
+
+// Runs the request on an idle keep-alive connection to http_address, opening a new one when
+// none is idle and the limits allow it, otherwise the request waits for a connection to free up
+MOCKABLE_FUNCTION(, int, http_client_pool_execute_request, HTTP_CLIENT_POOL_HANDLE, handle, const HTTP_ADDRESS*, http_address, HTTP_CLIENT_REQUEST_TYPE, request_type,
+    const char*, relative_path, HTTP_HEADERS_HANDLE, http_header, const unsigned char*, content, size_t, content_length, ON_HTTP_REQUEST_CALLBACK, on_request_callback, void*, callback_ctx);
+
+MOCKABLE_FUNCTION(, void, http_client_pool_process_item, HTTP_CLIENT_POOL_HANDLE, handle);
+
+MOCKABLE_FUNCTION(, size_t, http_client_pool_get_connection_count, HTTP_CLIENT_POOL_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, http_client_pool_get_idle_count, HTTP_CLIENT_POOL_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_CLIENT_POOL_H
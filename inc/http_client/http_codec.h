@@ -13,6 +13,7 @@ extern "C" {
 #include "azure_macro_utils/macro_utils.h"
 #include "umock_c/umock_c_prod.h"
 #include "patchcords/patchcord_client.h"
+#include "http_client/http_alloc.h"
 #include "http_client/http_headers.h"
 
 typedef struct HTTP_CODEC_INFO_TAG* HTTP_CODEC_HANDLE;
@@ -32,14 +33,36 @@ typedef struct HTTP_RECV_DATA_TAG
 
 typedef void(*ON_HTTP_DATA_CALLBACK)(void* callback_ctx, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data);
 
+// Called once the headers of a response are parsed, returning true streams the body of
+// that response through ON_HTTP_BODY_FRAGMENT_CALLBACK instead of buffering it.  The
+// ON_HTTP_DATA_CALLBACK of a streamed response carries no content.
+typedef bool(*ON_HTTP_HEADERS_CALLBACK)(void* callback_ctx, const HTTP_RECV_DATA* http_recv_data);
+typedef void(*ON_HTTP_BODY_FRAGMENT_CALLBACK)(void* callback_ctx, const unsigned char* fragment, size_t fragment_len);
+// Called when the first byte of a response is parsed, including each pipelined response in a read
+typedef void(*ON_HTTP_MESSAGE_BEGIN_CALLBACK)(void* callback_ctx);
+
 MOCKABLE_FUNCTION(, HTTP_CODEC_HANDLE, http_codec_create, ON_HTTP_DATA_CALLBACK, data_callback, void*, user_ctx);
+// The codec itself is allocated from allocator, NULL is the default allocator
+MOCKABLE_FUNCTION(, HTTP_CODEC_HANDLE, http_codec_create_with_allocator, ON_HTTP_DATA_CALLBACK, data_callback, void*, user_ctx, const HTTP_ALLOCATOR*, allocator);
 MOCKABLE_FUNCTION(, void, http_codec_destroy, HTTP_CODEC_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, int, http_codec_reintialize, HTTP_CODEC_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, ON_BYTES_RECEIVED, http_codec_get_recv_function);
 
+MOCKABLE_FUNCTION(, int, http_codec_set_stream_callbacks, HTTP_CODEC_HANDLE, handle, ON_HTTP_HEADERS_CALLBACK, headers_callback, ON_HTTP_BODY_FRAGMENT_CALLBACK, body_fragment_callback);
+
+MOCKABLE_FUNCTION(, int, http_codec_set_message_begin_callback, HTTP_CODEC_HANDLE, handle, ON_HTTP_MESSAGE_BEGIN_CALLBACK, message_begin_callback);
+
 MOCKABLE_FUNCTION(, int, http_codec_set_trace, HTTP_CODEC_HANDLE, handle, bool, set_trace);
 
+// The receive storage of a response is reused for the next one unless it grew past
+// max_retained_size, 0 releases it after every response.  Defaults to 64KB
+MOCKABLE_FUNCTION(, int, http_codec_set_buffer_retention, HTTP_CODEC_HANDLE, handle, size_t, max_retained_size);
+
+// Decodes gzip and deflate bodies before they are handed over, streamed bodies are decoded
+// fragment by fragment.  Fails when the library was built without zlib
+MOCKABLE_FUNCTION(, int, http_codec_set_content_decoding, HTTP_CODEC_HANDLE, handle, bool, decode_content);
+
 
 #endif // HTTP_CODEC_H
@@ -0,0 +1,53 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_CONTENT_DECODER_H
+#define HTTP_CONTENT_DECODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+typedef struct HTTP_CONTENT_DECODER_INFO_TAG* HTTP_CONTENT_DECODER_HANDLE;
+
+#define HTTP_CONTENT_ENCODING_VALUES        \
+    HTTP_CONTENT_ENCODING_IDENTITY,         \
+    HTTP_CONTENT_ENCODING_GZIP,             \
+    HTTP_CONTENT_ENCODING_DEFLATE,          \
+    HTTP_CONTENT_ENCODING_UNSUPPORTED
+
+MU_DEFINE_ENUM(HTTP_CONTENT_ENCODING, HTTP_CONTENT_ENCODING_VALUES);
+
+// Value sent in Accept-Encoding for the encodings that can be decoded
+#define HTTP_CONTENT_DECODER_ACCEPT_ENCODING    "gzip, deflate"
+
+typedef void(*ON_CONTENT_DECODED)(void* user_ctx, const unsigned char* decoded, size_t decoded_len);
+
+// False when the library was built without zlib, every decoder then fails to be created
+MOCKABLE_FUNCTION(, bool, http_content_decoder_is_available);
+
+// Maps a Content-Encoding header value to an encoding, NULL is identity
+MOCKABLE_FUNCTION(, HTTP_CONTENT_ENCODING, http_content_decoder_get_encoding, const char*, encoding_value);
+
+MOCKABLE_FUNCTION(, HTTP_CONTENT_DECODER_HANDLE, http_content_decoder_create, HTTP_CONTENT_ENCODING, encoding);
+MOCKABLE_FUNCTION(, void, http_content_decoder_destroy, HTTP_CONTENT_DECODER_HANDLE, handle);
+
+// Starts a new body so the decoder can be reused across responses
+MOCKABLE_FUNCTION(, int, http_content_decoder_reset, HTTP_CONTENT_DECODER_HANDLE, handle, HTTP_CONTENT_ENCODING, encoding);
+
+// Decodes the next part of the body, the body can be split anywhere.  The decoded data is
+// handed to on_decoded in blocks before the call returns, bytes after the end of the
+// compressed stream are ignored
+MOCKABLE_FUNCTION(, int, http_content_decoder_decode, HTTP_CONTENT_DECODER_HANDLE, handle, const unsigned char*, encoded, size_t, encoded_len, ON_CONTENT_DECODED, on_decoded, void*, user_ctx);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_CONTENT_DECODER_H
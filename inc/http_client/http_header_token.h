@@ -0,0 +1,47 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_HEADER_TOKEN_H
+#define HTTP_HEADER_TOKEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+// Header names the client and codec act on, anything else is HTTP_HEADER_TOKEN_UNKNOWN
+#define HTTP_HEADER_TOKEN_VALUES                \
+    HTTP_HEADER_TOKEN_UNKNOWN,                  \
+    HTTP_HEADER_TOKEN_CACHE_CONTROL,            \
+    HTTP_HEADER_TOKEN_CONNECTION,               \
+    HTTP_HEADER_TOKEN_CONTENT_ENCODING,         \
+    HTTP_HEADER_TOKEN_CONTENT_LENGTH,           \
+    HTTP_HEADER_TOKEN_CONTENT_TYPE,             \
+    HTTP_HEADER_TOKEN_DATE,                     \
+    HTTP_HEADER_TOKEN_ETAG,                     \
+    HTTP_HEADER_TOKEN_EXPIRES,                  \
+    HTTP_HEADER_TOKEN_KEEP_ALIVE,               \
+    HTTP_HEADER_TOKEN_LAST_MODIFIED,            \
+    HTTP_HEADER_TOKEN_LOCATION,                 \
+    HTTP_HEADER_TOKEN_RETRY_AFTER,              \
+    HTTP_HEADER_TOKEN_SERVER,                   \
+    HTTP_HEADER_TOKEN_SET_COOKIE,               \
+    HTTP_HEADER_TOKEN_TRANSFER_ENCODING,        \
+    HTTP_HEADER_TOKEN_WWW_AUTHENTICATE
+
+MU_DEFINE_ENUM(HTTP_HEADER_TOKEN, HTTP_HEADER_TOKEN_VALUES);
+
+#define HTTP_HEADER_TOKEN_COUNT     (HTTP_HEADER_TOKEN_WWW_AUTHENTICATE + 1)
+
+// Maps a header name to its token with a single probe of a perfect hash table, case insensitive
+MOCKABLE_FUNCTION(, HTTP_HEADER_TOKEN, http_header_token_lookup, const char*, name, size_t, name_len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_HEADER_TOKEN_H
@@ -5,10 +5,14 @@
 
 #include "azure_macro_utils/macro_utils.h"
 #include "umock_c/umock_c_prod.h"
+#include "http_client/http_alloc.h"
+#include "http_client/http_header_token.h"
 
 typedef struct HTTP_HEADERS_INFO_TAG* HTTP_HEADERS_HANDLE;
 
 MOCKABLE_FUNCTION(, HTTP_HEADERS_HANDLE, http_header_create);
+// The header, its entries and the arena holding the names and values come from allocator, NULL uses the default
+MOCKABLE_FUNCTION(, HTTP_HEADERS_HANDLE, http_header_create_with_allocator, const HTTP_ALLOCATOR*, allocator);
 MOCKABLE_FUNCTION(, void, http_header_destroy, HTTP_HEADERS_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, int, http_header_add, HTTP_HEADERS_HANDLE, handle, const char*, name, const char*, value);
@@ -16,6 +20,8 @@ MOCKABLE_FUNCTION(, int, http_header_add_partial, HTTP_HEADERS_HANDLE, handle, c
 MOCKABLE_FUNCTION(, int, http_header_remove, HTTP_HEADERS_HANDLE, handle, const char*, name);
 
 MOCKABLE_FUNCTION(, const char*, http_header_get_value, HTTP_HEADERS_HANDLE, handle, const char*, name);
+// Looks up a well known header without comparing names
+MOCKABLE_FUNCTION(, const char*, http_header_get_known_value, HTTP_HEADERS_HANDLE, handle, HTTP_HEADER_TOKEN, token);
 
 MOCKABLE_FUNCTION(, size_t, http_header_get_count, HTTP_HEADERS_HANDLE, handle);
 MOCKABLE_FUNCTION(, int, http_header_get_name_value_pair, HTTP_HEADERS_HANDLE, handle, size_t, index, const char**, name, const char**, value);
@@ -0,0 +1,36 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_MPSC_RING_H
+#define HTTP_MPSC_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "http_client/http_alloc.h"
+
+typedef struct HTTP_MPSC_RING_INFO_TAG* HTTP_MPSC_RING_HANDLE;
+
+// Bounded lock free queue of fixed size items, any number of threads push and a single
+// thread pops.  capacity is rounded up to a power of 2, allocator NULL is the default allocator
+MOCKABLE_FUNCTION(, HTTP_MPSC_RING_HANDLE, http_mpsc_ring_create, size_t, capacity, size_t, item_size, const HTTP_ALLOCATOR*, allocator);
+MOCKABLE_FUNCTION(, void, http_mpsc_ring_destroy, HTTP_MPSC_RING_HANDLE, handle);
+
+// Safe from any thread, copies item_size bytes of item into the ring and fails when it is full
+MOCKABLE_FUNCTION(, int, http_mpsc_ring_push, HTTP_MPSC_RING_HANDLE, handle, const void*, item);
+
+// Consumer thread only, copies the oldest item out and returns false when there is none
+MOCKABLE_FUNCTION(, bool, http_mpsc_ring_pop, HTTP_MPSC_RING_HANDLE, handle, void*, item);
+MOCKABLE_FUNCTION(, bool, http_mpsc_ring_is_empty, HTTP_MPSC_RING_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_MPSC_RING_H
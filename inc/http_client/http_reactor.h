@@ -0,0 +1,47 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_REACTOR_H
+#define HTTP_REACTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "http_client/http_client.h"
+
+typedef struct HTTP_REACTOR_INFO_TAG* HTTP_REACTOR_HANDLE;
+
+MOCKABLE_FUNCTION(, HTTP_REACTOR_HANDLE, http_reactor_create);
+MOCKABLE_FUNCTION(, void, http_reactor_destroy, HTTP_REACTOR_HANDLE, handle);
+
+// A registered client is driven by the reactor, the caller no longer calls http_client_process_item on it.
+// Requests submitted to it from other threads wake the reactor up.  The ring of a client set up with
+// http_client_set_uring is waited on with epoll, set it before registering.  The socket cord does not
+// hand out its socket so a client on it is run every millisecond while it waits on the network
+MOCKABLE_FUNCTION(, int, http_reactor_register, HTTP_REACTOR_HANDLE, handle, HTTP_CLIENT_HANDLE, client);
+// Called on the thread running the reactor, no other thread may submit requests to the client while it is unregistered
+MOCKABLE_FUNCTION(, int, http_reactor_unregister, HTTP_REACTOR_HANDLE, handle, HTTP_CLIENT_HANDLE, client);
+
+// Runs only the clients that were woken, had completions or reached their deadline, flushes each ring
+// once and then sleeps until a ring is readable, a wake up is received, the nearest deadline or
+// timeout_ms passes.  A pass costs the clients with work, not the clients registered
+MOCKABLE_FUNCTION(, int, http_reactor_run_once, HTTP_REACTOR_HANDLE, handle, uint32_t, timeout_ms);
+
+// Safe to call from any thread, cuts short the sleep of http_reactor_run_once
+MOCKABLE_FUNCTION(, int, http_reactor_wake, HTTP_REACTOR_HANDLE, handle);
+
+MOCKABLE_FUNCTION(, size_t, http_reactor_get_client_count, HTTP_REACTOR_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_REACTOR_H
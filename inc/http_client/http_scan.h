@@ -0,0 +1,45 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_SCAN_H
+#define HTTP_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#define HTTP_SCAN_MAX_DELIMS        4
+
+// The set of bytes a scan stops on, at most HTTP_SCAN_MAX_DELIMS
+typedef struct HTTP_SCAN_SET_TAG
+{
+    unsigned char delims[HTTP_SCAN_MAX_DELIMS];
+    size_t count;
+} HTTP_SCAN_SET;
+
+#define HTTP_SCAN_KERNEL_VALUES     \
+    HTTP_SCAN_KERNEL_SCALAR,        \
+    HTTP_SCAN_KERNEL_SSE42,         \
+    HTTP_SCAN_KERNEL_AVX2
+
+MU_DEFINE_ENUM(HTTP_SCAN_KERNEL, HTTP_SCAN_KERNEL_VALUES);
+
+// Returns the index of the first byte of buffer that is in delim_set or length if there is none.
+// The fastest kernel the CPU supports is picked on the first call
+MOCKABLE_FUNCTION(, size_t, http_scan_find, const HTTP_SCAN_SET*, delim_set, const unsigned char*, buffer, size_t, length);
+
+MOCKABLE_FUNCTION(, HTTP_SCAN_KERNEL, http_scan_get_kernel);
+
+// Forces a kernel, fails if the CPU or the compiler does not support it
+MOCKABLE_FUNCTION(, int, http_scan_set_kernel, HTTP_SCAN_KERNEL, kernel);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_SCAN_H
@@ -0,0 +1,48 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_TIMER_WHEEL_H
+#define HTTP_TIMER_WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "http_client/http_alloc.h"
+
+typedef struct HTTP_TIMER_WHEEL_INFO_TAG* HTTP_TIMER_WHEEL_HANDLE;
+typedef struct HTTP_TIMER_INFO_TAG* HTTP_TIMER_HANDLE;
+
+typedef void(*ON_HTTP_TIMER_EXPIRED)(void* timer_ctx);
+
+// Hierarchical timer wheel with a 1 millisecond tick, times are absolute milliseconds on
+// the clock the caller advances the wheel with.  Timers are allocated from allocator, NULL
+// is the default allocator
+MOCKABLE_FUNCTION(, HTTP_TIMER_WHEEL_HANDLE, http_timer_wheel_create, uint64_t, start_ms, const HTTP_ALLOCATOR*, allocator);
+// Pending timers are released without being called
+MOCKABLE_FUNCTION(, void, http_timer_wheel_destroy, HTTP_TIMER_WHEEL_HANDLE, handle);
+
+// The timer is released before on_expired is called, the handle must not be used after that
+MOCKABLE_FUNCTION(, HTTP_TIMER_HANDLE, http_timer_wheel_add, HTTP_TIMER_WHEEL_HANDLE, handle, uint64_t, expire_ms, ON_HTTP_TIMER_EXPIRED, on_expired, void*, timer_ctx);
+MOCKABLE_FUNCTION(, void, http_timer_wheel_cancel, HTTP_TIMER_WHEEL_HANDLE, handle, HTTP_TIMER_HANDLE, timer);
+
+// Calls every timer that expires at or before now_ms
+MOCKABLE_FUNCTION(, void, http_timer_wheel_advance, HTTP_TIMER_WHEEL_HANDLE, handle, uint64_t, now_ms);
+
+MOCKABLE_FUNCTION(, size_t, http_timer_wheel_get_count, HTTP_TIMER_WHEEL_HANDLE, handle);
+
+// The earliest expire time of the pending timers so a caller can sleep until it,
+// UINT64_MAX when there are none
+MOCKABLE_FUNCTION(, uint64_t, http_timer_wheel_get_next_expiry, HTTP_TIMER_WHEEL_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_TIMER_WHEEL_H
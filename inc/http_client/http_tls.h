@@ -0,0 +1,71 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_TLS_H
+#define HTTP_TLS_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "patchcords/patchcord_client.h"
+
+typedef struct HTTP_TLS_CACHE_INFO_TAG* HTTP_TLS_CACHE_HANDLE;
+typedef struct HTTP_TLS_INFO_TAG* HTTP_TLS_HANDLE;
+
+// Hands encrypted records to the transport, on_send_complete is NULL for the records the
+// connection sends on its own such as the handshake
+typedef int(*ON_HTTP_TLS_SEND)(void* send_ctx, const unsigned char* data, size_t length, ON_SEND_COMPLETE on_send_complete, void* callback_ctx);
+
+typedef struct HTTP_TLS_CALLBACK_INFO_TAG
+{
+    ON_HTTP_TLS_SEND on_send;
+    void* on_send_ctx;
+    // Receives the decrypted bytes
+    ON_BYTES_RECEIVED on_bytes_received;
+    void* on_bytes_received_ctx;
+    ON_IO_ERROR on_io_error;
+    void* on_io_error_ctx;
+} HTTP_TLS_CALLBACK_INFO;
+
+// False when the library was built without OpenSSL, every cache then fails to be created
+MOCKABLE_FUNCTION(, bool, http_tls_is_available);
+
+// Trust settings and the sessions of past connections keyed by host and port so a reconnect
+// resumes with an abbreviated handshake.  trusted_certs is PEM text with the certificates
+// peers are verified against, NULL uses the system trust store
+MOCKABLE_FUNCTION(, HTTP_TLS_CACHE_HANDLE, http_tls_cache_create, const char*, trusted_certs);
+// Releases a reference, the cache is freed when the last connection using it is destroyed
+MOCKABLE_FUNCTION(, void, http_tls_cache_destroy, HTTP_TLS_CACHE_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, http_tls_cache_add_ref, HTTP_TLS_CACHE_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, http_tls_cache_get_count, HTTP_TLS_CACHE_HANDLE, handle);
+
+// One connection to hostname, the peer certificate must be valid for it
+MOCKABLE_FUNCTION(, HTTP_TLS_HANDLE, http_tls_create, HTTP_TLS_CACHE_HANDLE, cache, const char*, hostname, uint16_t, port, const HTTP_TLS_CALLBACK_INFO*, callback_info);
+MOCKABLE_FUNCTION(, void, http_tls_destroy, HTTP_TLS_HANDLE, handle);
+
+// Starts the handshake once the transport is open, resuming a cached session when there is
+// one.  on_open_complete is called from http_tls_on_bytes_received when it finishes
+MOCKABLE_FUNCTION(, int, http_tls_open, HTTP_TLS_HANDLE, handle, ON_IO_OPEN_COMPLETE, on_open_complete, void*, on_open_complete_ctx);
+
+// Transport receive callback, context is the tls handle
+MOCKABLE_FUNCTION(, void, http_tls_on_bytes_received, void*, context, const unsigned char*, buffer, size_t, size);
+
+// Encrypts data and sends it in a single call to on_send, only after the handshake completed
+MOCKABLE_FUNCTION(, int, http_tls_send, HTTP_TLS_HANDLE, handle, const unsigned char*, data, size_t, length, ON_SEND_COMPLETE, on_send_complete, void*, callback_ctx);
+
+// True when the handshake resumed a cached session
+MOCKABLE_FUNCTION(, bool, http_tls_is_resumed, HTTP_TLS_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_TLS_H
@@ -0,0 +1,61 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_URING_H
+#define HTTP_URING_H
+
+#ifdef __cplusplus
+extern "C" {
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "patchcords/patchcord_client.h"
+#include "patchcords/cord_socket_client.h"
+#include "http_client/http_alloc.h"
+
+typedef struct HTTP_URING_INFO_TAG* HTTP_URING_HANDLE;
+typedef struct HTTP_URING_CONN_INFO_TAG* HTTP_URING_CONN_HANDLE;
+
+// False when the library was built without io_uring or the kernel lacks multishot receive,
+// connections then stay on the patchcord socket cord
+MOCKABLE_FUNCTION(, bool, http_uring_is_available);
+
+// One ring shared by many connections so their sends and receives are submitted and reaped
+// together.  allocator NULL is the default allocator
+MOCKABLE_FUNCTION(, HTTP_URING_HANDLE, http_uring_create, uint32_t, queue_depth, const HTTP_ALLOCATOR*, allocator);
+// Releases a reference, the ring is freed when the last connection using it is destroyed
+MOCKABLE_FUNCTION(, void, http_uring_destroy, HTTP_URING_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, http_uring_add_ref, HTTP_URING_HANDLE, handle);
+
+// Submits the queued sends of every connection and dispatches the completions, nothing is
+// called into the kernel when there is nothing to submit.  Sends queued by the completion
+// callbacks are submitted before it returns
+MOCKABLE_FUNCTION(, int, http_uring_process, HTTP_URING_HANDLE, handle);
+
+// Readable when completions are waiting, for callers that sleep in poll or epoll
+MOCKABLE_FUNCTION(, int, http_uring_get_fd, HTTP_URING_HANDLE, handle);
+
+// A socket connection that behaves like a patchcord client created with the socket cord
+MOCKABLE_FUNCTION(, HTTP_URING_CONN_HANDLE, http_uring_conn_create, HTTP_URING_HANDLE, uring, const SOCKETIO_CONFIG*, config, const PATCHCORD_CALLBACK_INFO*, callback_info);
+MOCKABLE_FUNCTION(, void, http_uring_conn_destroy, HTTP_URING_CONN_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, http_uring_conn_open, HTTP_URING_CONN_HANDLE, handle, ON_IO_OPEN_COMPLETE, on_open_complete, void*, on_open_complete_ctx);
+MOCKABLE_FUNCTION(, int, http_uring_conn_close, HTTP_URING_CONN_HANDLE, handle, ON_IO_CLOSE_COMPLETE, on_close_complete, void*, on_close_complete_ctx);
+
+// The data is copied, sends made before the next submission go out as one linked chain
+MOCKABLE_FUNCTION(, int, http_uring_conn_send, HTTP_URING_CONN_HANDLE, handle, const void*, buffer, size_t, size, ON_SEND_COMPLETE, on_send_complete, void*, callback_ctx);
+
+// Runs http_uring_process on the connection's ring
+MOCKABLE_FUNCTION(, void, http_uring_conn_process_item, HTTP_URING_CONN_HANDLE, handle);
+MOCKABLE_FUNCTION(, const char*, http_uring_conn_query_endpoint, HTTP_URING_CONN_HANDLE, handle, uint16_t*, port);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // HTTP_URING_H
@@ -5,8 +5,6 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include "lib-util-c/thread_mgr.h"
-
 #include "http_client/http_client.h"
 
 typedef struct SAMPLE_DATA_TAG
@@ -74,7 +72,7 @@ int main()
 
         do
         {
-            http_client_process_item(http_client);
+            (void)http_client_wait(http_client, 100);
 
             if (data.socket_open > 0)
             {
@@ -100,7 +98,6 @@ int main()
             {
                 break;
             }
-            thread_mgr_sleep(5);
         } while (data.keep_running == 0);
         http_client_destroy(http_client);
     }
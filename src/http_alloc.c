@@ -0,0 +1,83 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+
+static void* crt_alloc(void* alloc_ctx, size_t size)
+{
+    (void)alloc_ctx;
+    return malloc(size);
+}
+
+static void* crt_realloc(void* alloc_ctx, void* ptr, size_t size)
+{
+    (void)alloc_ctx;
+    return realloc(ptr, size);
+}
+
+static void crt_free(void* alloc_ctx, void* ptr)
+{
+    (void)alloc_ctx;
+    free(ptr);
+}
+
+static const HTTP_ALLOCATOR CRT_ALLOCATOR = { crt_alloc, crt_realloc, crt_free, NULL };
+static HTTP_ALLOCATOR g_default_allocator = { crt_alloc, crt_realloc, crt_free, NULL };
+
+int http_alloc_set_default(const HTTP_ALLOCATOR* allocator)
+{
+    int result;
+    if (allocator == NULL)
+    {
+        g_default_allocator = CRT_ALLOCATOR;
+        result = 0;
+    }
+    else if (allocator->alloc_func == NULL || allocator->realloc_func == NULL || allocator->free_func == NULL)
+    {
+        log_error("Invalid argument specified alloc_func: %p, realloc_func: %p, free_func: %p", allocator->alloc_func, allocator->realloc_func, allocator->free_func);
+        result = __LINE__;
+    }
+    else
+    {
+        g_default_allocator = *allocator;
+        result = 0;
+    }
+    return result;
+}
+
+const HTTP_ALLOCATOR* http_alloc_get_default(void)
+{
+    return &g_default_allocator;
+}
+
+void* http_alloc_malloc(const HTTP_ALLOCATOR* allocator, size_t size)
+{
+    if (allocator == NULL)
+    {
+        allocator = &g_default_allocator;
+    }
+    return allocator->alloc_func(allocator->alloc_ctx, size);
+}
+
+void* http_alloc_realloc(const HTTP_ALLOCATOR* allocator, void* ptr, size_t size)
+{
+    if (allocator == NULL)
+    {
+        allocator = &g_default_allocator;
+    }
+    return allocator->realloc_func(allocator->alloc_ctx, ptr, size);
+}
+
+void http_alloc_free(const HTTP_ALLOCATOR* allocator, void* ptr)
+{
+    if (allocator == NULL)
+    {
+        allocator = &g_default_allocator;
+    }
+    allocator->free_func(allocator->alloc_ctx, ptr);
+}
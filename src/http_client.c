@@ -4,6 +4,22 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <limits.h>
+
+// The clock and http_client_wait are the only platform specific parts of the client,
+// Linux waits on an eventfd and the ring descriptor, other platforms sleep
+#if defined(__linux__)
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/app_logging.h"
@@ -14,14 +30,41 @@
 #include "patchcords/patchcord_client.h"
 #include "patchcords/cord_socket_client.h"
 
+#include "http_client/http_alloc.h"
 #include "http_client/http_client.h"
 #include "http_client/http_headers.h"
 #include "http_client/http_codec.h"
+#include "http_client/http_content_decoder.h"
+#include "http_client/http_timer_wheel.h"
+#include "http_client/http_mpsc_ring.h"
+#include "http_client/http_tls.h"
+#include "http_client/http_uring.h"
 
 static const char* HTTP_HOST = "Host";
 static const char* HTTP_CONTENT_LEN = "content-length";
+static const char* HTTP_ACCEPT_ENCODING = "Accept-Encoding";
 static const char* HTTP_CRLF_VALUE = "\r\n";
-static const char* HTTP_REQUEST_LINE_FMT = "%s %s HTTP/1.1\r\n%s";
+static const char* HTTP_VERSION_LINE = " HTTP/1.1\r\n";
+static const char* HTTP_FIELD_SEPARATOR = ": ";
+static const char* DEFAULT_SOCKET_HOST = "localhost";
+
+#define HTTP_VERSION_LEN            11
+#define HTTP_FIELD_SEPARATOR_LEN    2
+#define HTTP_CRLF_LEN               2
+#define HTTP_CONTENT_LEN_LEN        14
+
+// First allocation of a header block, it doubles when a block does not fit
+#define HEADER_LINE_INITIAL_SIZE    256
+
+// Room for the content length value and the blank line ending the header block
+#define CONTENT_LEN_VALUE_SIZE      32
+
+// Only one request on the wire at a time unless pipelining is enabled
+#define DEFAULT_PIPELINE_DEPTH      1
+
+// The socket cord does not hand out its socket, so http_client_wait checks a client
+// waiting on it again after this interval instead of on readiness
+#define WAIT_POLL_INTERVAL_MS       1
 
 typedef enum HTTP_CLIENT_STATE_TAG
 {
@@ -31,11 +74,16 @@ typedef enum HTTP_CLIENT_STATE_TAG
     CLIENT_STATE_OPEN,
     CLIENT_STATE_CLOSING,
     CLIENT_STATE_CLOSED,
-    CLIENT_STATE_ERROR
+    CLIENT_STATE_ERROR,
+    // A request timed out, the connection is gone and opens again in process_item
+    CLIENT_STATE_TIMED_OUT
 } HTTP_CLIENT_STATE;
 
 typedef struct HTTP_CLIENT_INFO_TAG
 {
+    // Used for the client, its codec, requests and prepared templates
+    HTTP_ALLOCATOR allocator;
+
     PATCH_INSTANCE_HANDLE xio_handle;
     HTTP_CODEC_HANDLE codec_handle;
 
@@ -57,8 +105,73 @@ typedef struct HTTP_CLIENT_INFO_TAG
     bool logging_enabled;
     uint16_t port;
 
+    // Requests sent that are still waiting on their response
+    size_t pipeline_depth;
+    size_t in_flight;
+
+    // Advertise the encodings the codec decodes on every request
+    bool accept_encoding;
+
+    // Requests are timed in their response info, send_done counts the responses at the front
+    // of recv_callback_list whose request finished sending and send_late the sends that finish
+    // after their response was already reported
+    bool request_timing;
+    size_t send_done;
+    size_t send_late;
+
+    // Response info handed to the caller while its callback runs
+    const struct HTTP_RESP_INFO_TAG* reporting;
+
+    // Created once a deadline is set, driven from http_client_process_item
+    HTTP_TIMER_WHEEL_HANDLE timer_wheel;
+    uint32_t connect_timeout_ms;
+    uint32_t request_timeout_ms;
+    HTTP_TIMER_HANDLE connect_timer;
+
+    // Requests submitted from other threads, drained in http_client_process_item
+    HTTP_MPSC_RING_HANDLE submit_ring;
+    ON_HTTP_CLIENT_WAKE on_wake;
+    void* wake_ctx;
+    // Called on the driving thread when a completion or queued work needs process_item
+    ON_HTTP_CLIENT_WAKE on_ready;
+    void* ready_ctx;
+    // Created with the submit queue, signalled on each submit to end http_client_wait, -1 without eventfd
+    int wait_fd;
+
+    // Secure connections sit on top of xio_handle, the cache is held for the client's lifetime
+    HTTP_TLS_CACHE_HANDLE tls_cache;
+    HTTP_TLS_HANDLE tls_handle;
+
+    // Host header of a unix domain socket connection, the cord only knows the path
+    char* socket_host;
+
+    // Copied from http_client_open so a connection dropped by a request timeout can open again
+    char* hostname;
+    char* socket_path;
+    bool is_secure;
+    // Set while that connection opens, the caller already saw the first open complete
+    bool reopening;
+
+    // With a ring set the connection runs on uring_conn in place of xio_handle
+    HTTP_URING_HANDLE uring;
+    HTTP_URING_CONN_HANDLE uring_conn;
+
+    // Batches with responses left to report, the ones left over are freed with the client
+    struct HTTP_BATCH_INFO_TAG* batch_list;
 } HTTP_CLIENT_INFO;
 
+typedef struct HTTP_PREPARED_REQUEST_INFO_TAG
+{
+    // Request line and header block up to the content length value
+    STRING_BUFFER head;
+
+    // Held by the caller and every queued request sent from the template
+    size_t ref_count;
+
+    // The template can outlive the client it was prepared on
+    HTTP_ALLOCATOR allocator;
+} HTTP_PREPARED_REQUEST_INFO;
+
 typedef struct HTTP_REQUEST_INFO_TAG
 {
     HTTP_CLIENT_INFO* client_info;
@@ -69,627 +182,2710 @@ typedef struct HTTP_REQUEST_INFO_TAG
     char* relative_path;
     STRING_BUFFER header_line;
     BYTE_BUFFER payload;
+
+    // Set when the request line and headers come from a prepared template
+    HTTP_PREPARED_REQUEST_INFO* prepared;
+
+    // Set when the request lives in a batch allocation, only the header line is its own
+    bool in_batch;
 } HTTP_REQUEST_INFO;
 
+typedef struct HTTP_BATCH_ITEM_TAG
+{
+    struct HTTP_BATCH_INFO_TAG* batch;
+    ON_HTTP_REQUEST_CALLBACK on_request_cb;
+    void* on_request_ctx;
+    HTTP_REQUEST_INFO request_info;
+} HTTP_BATCH_ITEM;
+
+// The items follow the batch in the same allocation and the paths and content follow the items,
+// it is freed once the last response is reported
+typedef struct HTTP_BATCH_INFO_TAG
+{
+    struct HTTP_BATCH_INFO_TAG* prev;
+    struct HTTP_BATCH_INFO_TAG* next;
+    HTTP_CLIENT_INFO* client_info;
+    ON_HTTP_BATCH_COMPLETE on_batch_complete;
+    void* batch_ctx;
+    size_t request_count;
+    size_t remaining_count;
+    size_t failed_count;
+    HTTP_BATCH_ITEM* items;
+} HTTP_BATCH_INFO;
+
 typedef struct HTTP_RESP_INFO_TAG
 {
+    HTTP_CLIENT_INFO* client_info;
     ON_HTTP_REQUEST_CALLBACK on_request_cb;
     void* on_request_ctx;
+
+    // Set when the response body is streamed to the caller
+    ON_HTTP_HEADERS_COMPLETE on_headers_complete;
+    ON_HTTP_BODY_FRAGMENT on_body_fragment;
+    ON_HTTP_MESSAGE_COMPLETE on_message_complete;
+
+    HTTP_REQUEST_TIMING timing;
+
+    // Deadline of the request, NULL when it has none
+    HTTP_TIMER_HANDLE request_timer;
 } HTTP_RESP_INFO;
 
-static int construct_header_line(HTTP_REQUEST_INFO* request_info, HTTP_HEADERS_HANDLE http_header, size_t content_len, const char* hostname, uint16_t port)
+// A request built on the submitting thread, the fields that need the connection are
+// added when it is drained from the submit queue
+typedef struct HTTP_SUBMIT_INFO_TAG
 {
-    int result = 0;
-    bool add_hostname = true;
-    size_t header_cnt = http_header_get_count(http_header);
-    for (size_t index = 0; index < header_cnt; index++)
+    HTTP_REQUEST_INFO* request_info;
+    HTTP_RESP_INFO resp_info;
+    bool has_hostname;
+    bool has_accept_encoding;
+} HTTP_SUBMIT_INFO;
+
+#if defined(__linux__)
+static uint64_t get_monotonic_ns(void)
+{
+    struct timespec curr_time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return (uint64_t)curr_time.tv_sec * 1000000000 + (uint64_t)curr_time.tv_nsec;
+}
+
+static int create_wait_event(HTTP_CLIENT_INFO* client_info)
+{
+    int result;
+    if ((client_info->wait_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
     {
-        const char* name;
-        const char* value;
-        if (http_header_get_name_value_pair(http_header, index, &name, &value) != 0)
-        {
-            log_error("Failure allocating buffer value");
-            result = __LINE__;
-        }
-        else
-        {
-            if (strcmp(name, HTTP_HOST) == 0)
-            {
-                add_hostname = false;
-            }
-            if (string_buffer_construct_sprintf(&request_info->header_line, "%s: %s\r\n", name, value) != 0)
-            {
-                log_error("Failure allocating buffer value");
-                result = __LINE__;
-            }
-        }
+        result = __LINE__;
     }
-    if (result == 0 && add_hostname)
+    else
     {
-        // Add the hostname header
-        if (string_buffer_construct_sprintf(&request_info->header_line, "%s: %s:%d\r\n", HTTP_HOST, hostname, port) != 0)
-        {
-            free(request_info->header_line.payload);
-            log_error("Failure allocating host line");
-            result = __LINE__;
-        }
+        result = 0;
     }
-    if (result == 0)
+    return result;
+}
+
+static void destroy_wait_event(HTTP_CLIENT_INFO* client_info)
+{
+    if (client_info->wait_fd >= 0)
     {
-        // Add content length
-        if (string_buffer_construct_sprintf(&request_info->header_line, "%s: %u%s%s", HTTP_CONTENT_LEN, (unsigned int)content_len, HTTP_CRLF_VALUE, HTTP_CRLF_VALUE) != 0)
-        {
-            free(request_info->header_line.payload);
-            log_error("Failure allocating host line");
-            result = __LINE__;
-        }
+        close(client_info->wait_fd);
+        client_info->wait_fd = -1;
     }
-    return result;
 }
 
-static void on_open_complete(void* context, IO_OPEN_RESULT open_result)
+static void signal_wait_event(HTTP_CLIENT_INFO* client_info)
 {
-    if (context != NULL)
+    if (client_info->wait_fd >= 0)
     {
-        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
-        if (open_result == IO_OPEN_OK)
+        uint64_t wake_count = 1;
+        if (write(client_info->wait_fd, &wake_count, sizeof(wake_count)) != (ssize_t)sizeof(wake_count))
         {
-            client_info->state = CLIENT_STATE_OPENED;
-        }
-        else
-        {
-            client_info->state = CLIENT_STATE_ERROR;
-            client_info->curr_result = HTTP_CLIENT_OPEN_FAILED;
-            log_error("Failure opening http client: %d", open_result);
+            log_warning("Failure signaling the client wait");
         }
     }
 }
 
-static void on_close_complete(void* context)
+// Sleeps on the ring and the wait event until either is readable or wait_ms passes
+static int wait_on_client(HTTP_CLIENT_INFO* client_info, int wait_ms)
 {
-    if (context != NULL)
+    int result;
+    struct pollfd wait_list[2];
+    nfds_t wait_count = 0;
+    if (client_info->uring_conn != NULL)
     {
-        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
-        client_info->state = CLIENT_STATE_CLOSED;
+        wait_list[wait_count].fd = http_uring_get_fd(client_info->uring);
+        wait_list[wait_count].events = POLLIN;
+        wait_list[wait_count].revents = 0;
+        wait_count++;
     }
-    else
+    if (client_info->submit_ring != NULL && client_info->wait_fd >= 0)
     {
-        log_error("Failure context NULL on closed complete");
+        wait_list[wait_count].fd = client_info->wait_fd;
+        wait_list[wait_count].events = POLLIN;
+        wait_list[wait_count].revents = 0;
+        wait_count++;
     }
-}
 
-static void on_error(void* context, IO_ERROR_RESULT error_result)
-{
-    if (context != NULL)
+    int ready_count = wait_ms == 0 ? 0 : poll(wait_list, wait_count, wait_ms);
+    if (ready_count < 0 && errno != EINTR)
     {
-        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
-        if (client_info->on_error_cb != NULL)
+        log_error("Failure waiting on the client");
+        result = __LINE__;
+    }
+    else
+    {
+        if (ready_count > 0 && client_info->submit_ring != NULL && client_info->wait_fd >= 0 && (wait_list[wait_count - 1].revents & POLLIN))
         {
-            HTTP_CLIENT_RESULT http_error;
-            switch (error_result)
+            uint64_t wake_count;
+            if (read(client_info->wait_fd, &wake_count, sizeof(wake_count)) != (ssize_t)sizeof(wake_count))
             {
-                case IO_ERROR_MEMORY:
-                    http_error = HTTP_CLIENT_MEMORY;
-                    break;
-                case IO_ERROR_ENDPOINT_DISCONN:
-                    http_error = HTTP_CLIENT_DISCONNECTION;
-                    break;
-                default:
-                    http_error = HTTP_CLIENT_ERROR;
-                    break;
+                log_warning("Client wake up could not be read");
             }
-            client_info->on_error_cb(client_info->err_user_ctx, http_error);
         }
+        result = 0;
     }
-    else
+    return result;
+}
+#else
+static uint64_t get_monotonic_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    (void)QueryPerformanceFrequency(&frequency);
+    (void)QueryPerformanceCounter(&counter);
+    // Split so the multiply does not overflow on a long uptime
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000 / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec curr_time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return (uint64_t)curr_time.tv_sec * 1000000000 + (uint64_t)curr_time.tv_nsec;
+#endif
+}
+
+// Without an event to wait on http_client_wait checks the submit queue every interval instead
+static int create_wait_event(HTTP_CLIENT_INFO* client_info)
+{
+    client_info->wait_fd = -1;
+    return 0;
+}
+
+static void destroy_wait_event(HTTP_CLIENT_INFO* client_info)
+{
+    (void)client_info;
+}
+
+static void signal_wait_event(HTTP_CLIENT_INFO* client_info)
+{
+    (void)client_info;
+}
+
+// There is no ring off Linux, so nothing can end the sleep early
+static int wait_on_client(HTTP_CLIENT_INFO* client_info, int wait_ms)
+{
+    (void)client_info;
+    if (wait_ms > 0)
     {
-        log_error("Failure context NULL on on_error");
+#if defined(_WIN32)
+        Sleep((DWORD)wait_ms);
+#else
+        struct timespec sleep_time;
+        sleep_time.tv_sec = wait_ms / 1000;
+        sleep_time.tv_nsec = (long)(wait_ms % 1000) * 1000000;
+        (void)nanosleep(&sleep_time, NULL);
+#endif
     }
+    return 0;
 }
+#endif
 
-static void on_send_complete(void* context, IO_SEND_RESULT send_result)
+static uint64_t get_monotonic_ms(void)
 {
-    if (context != NULL)
+    return get_monotonic_ns() / 1000000;
+}
+
+static void record_time(const HTTP_CLIENT_INFO* client_info, uint64_t* timestamp)
+{
+    if (client_info->request_timing)
     {
-        // Only report failures
-        if (send_result != IO_SEND_OK)
-        {
-            HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
-            client_info->state = CLIENT_STATE_ERROR;
-            client_info->curr_result = HTTP_CLIENT_SEND_FAILED;
-            log_error("Failure sending request");
-        }
+        *timestamp = get_monotonic_ns();
+    }
+}
+
+// Only looks up the response info when requests are timed
+static HTTP_RESP_INFO* get_timed_resp_info(HTTP_CLIENT_INFO* client_info, size_t index)
+{
+    HTTP_RESP_INFO* result;
+    if (client_info->request_timing)
+    {
+        result = (HTTP_RESP_INFO*)item_list_get_item(client_info->recv_callback_list, index);
     }
     else
     {
-        log_error("Failure context NULL on send complete");
+        result = NULL;
     }
+    return result;
 }
 
-static int construct_http_data(const HTTP_REQUEST_INFO* request_info, STRING_BUFFER* http_req_line)
+static int append_header_text(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, const char* text, size_t length)
 {
-    int result = 0;
-    const char* method;
-    switch (request_info->request_type)
-    {
-        case HTTP_CLIENT_REQUEST_OPTIONS:
-            method = "OPTION";
-            break;
-        case HTTP_CLIENT_REQUEST_GET:
-            method = "GET";
-            break;
-        case HTTP_CLIENT_REQUEST_POST:
-            method = "POST";
-            break;
-        case HTTP_CLIENT_REQUEST_PUT:
-            method = "PUT";
-            break;
-        case HTTP_CLIENT_REQUEST_DELETE:
-            method = "DELETE";
-            break;
-        case HTTP_CLIENT_REQUEST_PATCH:
-            method = "PATCH";
-            break;
-        case HTTP_CLIENT_REQUEST_TYPE_INVALID:
-        default:
-            result = __LINE__;
-            method = "";
-            break;
-    }
-    if (result == 0)
+    int result;
+    size_t required = header_line->payload_size + length + 1;
+    if (header_line->payload == NULL || required > header_line->alloc_size)
     {
-        if (string_buffer_construct_sprintf(http_req_line, HTTP_REQUEST_LINE_FMT, method, request_info->relative_path, request_info->header_line.payload) != 0)
+        size_t alloc_size = header_line->payload == NULL || header_line->alloc_size == 0 ? HEADER_LINE_INITIAL_SIZE : header_line->alloc_size;
+        while (alloc_size < required)
+        {
+            alloc_size *= 2;
+        }
+
+        char* payload;
+        if (header_line->payload == NULL)
+        {
+            payload = (char*)http_alloc_malloc(allocator, alloc_size);
+        }
+        else
+        {
+            payload = (char*)http_alloc_realloc(allocator, header_line->payload, alloc_size);
+        }
+        if (payload == NULL)
         {
-            log_error("Failure constructing request line");
+            log_error("Failure allocating header line");
             result = __LINE__;
         }
         else
         {
+            header_line->payload = payload;
+            header_line->alloc_size = alloc_size;
             result = 0;
         }
     }
+    else
+    {
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        memcpy(header_line->payload + header_line->payload_size, text, length);
+        header_line->payload_size += length;
+        header_line->payload[header_line->payload_size] = '\0';
+    }
     return result;
 }
 
-static int write_http_text(HTTP_CLIENT_INFO* client_info, const char* text)
+static int append_field(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, const char* name, size_t name_len, const char* value, size_t value_len)
 {
     int result;
-
-    if (text == NULL)
-    {
-        log_warning("writing Text is NULL");
-    }
-
-    if (patchcord_client_send(client_info->xio_handle, text, strlen(text), on_send_complete, client_info) != 0)
+    if (append_header_text(allocator, header_line, name, name_len) != 0 ||
+        append_header_text(allocator, header_line, HTTP_FIELD_SEPARATOR, HTTP_FIELD_SEPARATOR_LEN) != 0 ||
+        append_header_text(allocator, header_line, value, value_len) != 0 ||
+        append_header_text(allocator, header_line, HTTP_CRLF_VALUE, HTTP_CRLF_LEN) != 0)
     {
-        log_error("Failure sending client data");
         result = __LINE__;
     }
     else
     {
-        if (client_info->logging_enabled)
-        {
-            log_trace("==> %s", text);
-        }
         result = 0;
     }
     return result;
 }
 
-static int send_http_request(HTTP_CLIENT_INFO* client_info, const HTTP_REQUEST_INFO* request_info)
+// Writes the decimal digits of value without a terminator and returns their count
+static size_t format_decimal(char* buffer, size_t value)
 {
-    int result;
+    char digits[CONTENT_LEN_VALUE_SIZE];
+    size_t digit_count = 0;
+    do
+    {
+        digits[digit_count++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
 
-    STRING_BUFFER request_line = {0};
-    if (construct_http_data(request_info, &request_line) != 0)
+    for (size_t index = 0; index < digit_count; index++)
     {
-        log_error("Failure sending client data");
-        result = __LINE__;
+        buffer[index] = digits[digit_count - index - 1];
     }
-    else
+    return digit_count;
+}
+
+// Copies the caller's headers and reports the ones the client would otherwise add
+static int append_header_fields(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, HTTP_HEADERS_HANDLE http_header, bool* has_hostname, bool* has_accept_encoding)
+{
+    int result = 0;
+    size_t header_cnt = http_header_get_count(http_header);
+    *has_hostname = false;
+    *has_accept_encoding = false;
+    for (size_t index = 0; index < header_cnt; index++)
     {
-        // Send the header information
-        if (write_http_text(client_info, request_line.payload) != 0)
-        {
-            log_error("Failure sending client data");
-            result = __LINE__;
-        }
-        // Send the Data
-        else if (request_info->payload.payload_size > 0 && patchcord_client_send(client_info->xio_handle, request_info->payload.payload, request_info->payload.payload_size, on_send_complete, client_info) != 0)
+        const char* name;
+        const char* value;
+        if (http_header_get_name_value_pair(http_header, index, &name, &value) != 0)
         {
-            log_error("Failure sending client data");
+            log_error("Failure allocating buffer value");
             result = __LINE__;
         }
         else
         {
-            // write trace line
-            if (client_info->logging_enabled && request_info->payload.payload_size > 0)
+            if (strcmp(name, HTTP_HOST) == 0)
             {
-                log_trace("==> %s", request_info->payload.payload);
+                *has_hostname = true;
+            }
+            else if (strcmp(name, HTTP_ACCEPT_ENCODING) == 0)
+            {
+                *has_accept_encoding = true;
+            }
+            if (append_field(allocator, header_line, name, strlen(name), value, strlen(value)) != 0)
+            {
+                log_error("Failure allocating buffer value");
+                result = __LINE__;
             }
-            result = 0;
         }
-        free(request_line.payload);
     }
     return result;
 }
 
-static void on_codec_recv_callback(void* context, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data)
+static int append_default_fields(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, const char* hostname, uint16_t port, bool add_hostname, bool add_accept_encoding)
 {
-    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
-    if (client_info == NULL)
-    {
-        log_error("Failure invalid user context in codec recieve callback");
-    }
-    else
+    int result = 0;
+    if (add_hostname)
     {
-        HTTP_RESP_INFO* resp_info = (HTTP_RESP_INFO*)item_list_get_front(client_info->recv_callback_list);
-        if (resp_info != NULL)
+        // Add the hostname header, a unix domain socket address may have no port
+        char port_value[CONTENT_LEN_VALUE_SIZE];
+        size_t port_len = 0;
+        if (port != 0)
         {
-            HTTP_CLIENT_RESULT request_res = HTTP_CLIENT_OK;
-            if (result != HTTP_CODEC_CB_RESULT_OK)
-            {
-                request_res = HTTP_CLIENT_ERROR;
-            }
-            resp_info->on_request_cb(resp_info->on_request_ctx, request_res, http_recv_data->http_content.payload, http_recv_data->http_content.payload_size,
-                http_recv_data->status_code, http_recv_data->recv_header);
+            port_value[port_len++] = ':';
+            port_len += format_decimal(port_value + port_len, port);
         }
-        else
+        if (hostname == NULL)
         {
-            log_error("Could not retrieve http response info");
+            log_error("Failure the client endpoint is unknown");
+            result = __LINE__;
+        }
+        else if (append_header_text(allocator, header_line, HTTP_HOST, strlen(HTTP_HOST)) != 0 ||
+            append_header_text(allocator, header_line, HTTP_FIELD_SEPARATOR, HTTP_FIELD_SEPARATOR_LEN) != 0 ||
+            append_header_text(allocator, header_line, hostname, strlen(hostname)) != 0 ||
+            append_header_text(allocator, header_line, port_value, port_len) != 0 ||
+            append_header_text(allocator, header_line, HTTP_CRLF_VALUE, HTTP_CRLF_LEN) != 0)
+        {
+            log_error("Failure allocating host line");
+            result = __LINE__;
+        }
+    }
+    if (result == 0 && add_accept_encoding)
+    {
+        if (append_field(allocator, header_line, HTTP_ACCEPT_ENCODING, strlen(HTTP_ACCEPT_ENCODING), HTTP_CONTENT_DECODER_ACCEPT_ENCODING, strlen(HTTP_CONTENT_DECODER_ACCEPT_ENCODING)) != 0)
+        {
+            log_error("Failure allocating accept encoding line");
+            result = __LINE__;
         }
     }
+    return result;
 }
 
-static void request_list_destroy_cb(void* user_ctx, void* remove_item)
+static const char* get_endpoint_host(HTTP_CLIENT_INFO* client_info)
 {
-    (void)user_ctx;
-    HTTP_REQUEST_INFO* request_info = (HTTP_REQUEST_INFO*)remove_item;
-    if (request_info == NULL)
+    const char* result;
+    uint16_t port;
+    if (client_info->socket_host != NULL)
     {
-        log_error("Failure invalid user context in list destroy");
+        result = client_info->socket_host;
+    }
+    else if (client_info->uring_conn != NULL)
+    {
+        result = http_uring_conn_query_endpoint(client_info->uring_conn, &port);
     }
     else
     {
-        free(request_info->payload.payload);
-        free(request_info->header_line.payload);
-        free(request_info->relative_path);
-        free(request_info);
+        result = patchcord_client_query_endpoint(client_info->xio_handle, &port);
     }
+    return result;
 }
 
-static int create_connection(HTTP_CLIENT_INFO* client_info, const HTTP_ADDRESS* http_address)
+static int construct_header_fields(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, HTTP_HEADERS_HANDLE http_header, const char* hostname, uint16_t port, bool accept_encoding)
 {
     int result;
-    SOCKETIO_CONFIG config = {0};
+    bool has_hostname;
+    bool has_accept_encoding;
+    if (append_header_fields(allocator, header_line, http_header, &has_hostname, &has_accept_encoding) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        result = append_default_fields(allocator, header_line, hostname, port, !has_hostname, accept_encoding && !has_accept_encoding);
+    }
+    return result;
+}
+
+// The content length value and the blank line ending the header block
+static size_t format_content_length_value(char* buffer, size_t content_len)
+{
+    size_t result = format_decimal(buffer, content_len);
+    memcpy(buffer + result, HTTP_CRLF_VALUE, HTTP_CRLF_LEN);
+    memcpy(buffer + result + HTTP_CRLF_LEN, HTTP_CRLF_VALUE, HTTP_CRLF_LEN);
+    return result + HTTP_CRLF_LEN * 2;
+}
+
+// Ends the header block
+static int append_content_length(const HTTP_ALLOCATOR* allocator, STRING_BUFFER* header_line, size_t content_len)
+{
+    char value[CONTENT_LEN_VALUE_SIZE];
+    size_t value_len = format_content_length_value(value, content_len);
+    int result;
+    if (append_header_text(allocator, header_line, HTTP_CONTENT_LEN, HTTP_CONTENT_LEN_LEN) != 0 ||
+        append_header_text(allocator, header_line, HTTP_FIELD_SEPARATOR, HTTP_FIELD_SEPARATOR_LEN) != 0 ||
+        append_header_text(allocator, header_line, value, value_len) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static int construct_header_line(HTTP_REQUEST_INFO* request_info, HTTP_HEADERS_HANDLE http_header, size_t content_len, const char* hostname, uint16_t port, bool accept_encoding)
+{
+    int result;
+    const HTTP_ALLOCATOR* allocator = &request_info->client_info->allocator;
+    if (construct_header_fields(allocator, &request_info->header_line, http_header, hostname, port, accept_encoding) != 0)
+    {
+        log_error("Failure constructing header fields");
+        http_alloc_free(allocator, request_info->header_line.payload);
+        result = __LINE__;
+    }
+    // Add content length
+    else if (append_content_length(allocator, &request_info->header_line, content_len) != 0)
+    {
+        http_alloc_free(allocator, request_info->header_line.payload);
+        log_error("Failure allocating host line");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static void release_prepared_request(HTTP_PREPARED_REQUEST_INFO* prepared)
+{
+    if (--prepared->ref_count == 0)
+    {
+        HTTP_ALLOCATOR allocator = prepared->allocator;
+        http_alloc_free(&allocator, prepared->head.payload);
+        http_alloc_free(&allocator, prepared);
+    }
+}
+
+static void cancel_timer(HTTP_CLIENT_INFO* client_info, HTTP_TIMER_HANDLE* timer)
+{
+    if (*timer != NULL)
+    {
+        http_timer_wheel_cancel(client_info->timer_wheel, *timer);
+        *timer = NULL;
+    }
+}
+
+static void release_transport(HTTP_CLIENT_INFO* client_info)
+{
+    if (client_info->xio_handle != NULL)
+    {
+        patchcord_client_destroy(client_info->xio_handle);
+        client_info->xio_handle = NULL;
+    }
+    if (client_info->uring_conn != NULL)
+    {
+        http_uring_conn_destroy(client_info->uring_conn);
+        client_info->uring_conn = NULL;
+    }
+    if (client_info->tls_handle != NULL)
+    {
+        http_tls_destroy(client_info->tls_handle);
+        client_info->tls_handle = NULL;
+    }
+}
+
+static void drop_connection(HTTP_CLIENT_INFO* client_info, HTTP_CLIENT_STATE drop_state, HTTP_CLIENT_RESULT drop_result)
+{
+    // Nothing the old connection delivers after this can reach the client,
+    // a late open or a late response would otherwise land on the next use
+    release_transport(client_info);
+    (void)http_codec_reintialize(client_info->codec_handle);
+    client_info->state = drop_state;
+    client_info->curr_result = drop_result;
+}
+
+static void notify_ready(HTTP_CLIENT_INFO* client_info)
+{
+    if (client_info->on_ready != NULL)
+    {
+        client_info->on_ready(client_info->ready_ctx);
+    }
+}
+
+static void on_connect_timeout(void* context)
+{
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+
+    // The wheel released the timer
+    client_info->connect_timer = NULL;
+    if (client_info->state == CLIENT_STATE_OPENING)
+    {
+        log_error("Timed out opening the connection");
+        drop_connection(client_info, CLIENT_STATE_ERROR, HTTP_CLIENT_TIMEOUT);
+    }
+}
+
+static void report_failure(HTTP_CLIENT_INFO* client_info, HTTP_RESP_INFO* resp_info, HTTP_CLIENT_RESULT fail_result)
+{
+    cancel_timer(client_info, &resp_info->request_timer);
+    client_info->reporting = resp_info;
+    if (resp_info->on_message_complete != NULL)
+    {
+        resp_info->on_message_complete(resp_info->on_request_ctx, fail_result);
+    }
+    else if (resp_info->on_request_cb != NULL)
+    {
+        resp_info->on_request_cb(resp_info->on_request_ctx, fail_result, NULL, 0, 0, NULL);
+    }
+    client_info->reporting = NULL;
+}
+
+// Fails the first fail_count response infos, a callback is free to queue a new request
+static void fail_front_requests(HTTP_CLIENT_INFO* client_info, size_t fail_count, HTTP_CLIENT_RESULT fail_result)
+{
+    for (size_t index = 0; index < fail_count; index++)
+    {
+        const HTTP_RESP_INFO* pending = (const HTTP_RESP_INFO*)item_list_get_item(client_info->recv_callback_list, 0);
+        if (pending == NULL)
+        {
+            log_error("Could not retrieve http response info");
+            break;
+        }
+        else
+        {
+            HTTP_RESP_INFO resp_info = *pending;
+            (void)item_list_remove_item(client_info->recv_callback_list, 0);
+            report_failure(client_info, &resp_info, fail_result);
+        }
+    }
+}
+
+static void fail_pending_requests(HTTP_CLIENT_INFO* client_info, HTTP_CLIENT_RESULT fail_result)
+{
+    // Anything partially parsed belongs to a connection that is gone
+    (void)http_codec_reintialize(client_info->codec_handle);
+    (void)item_list_clear(client_info->request_list);
+    client_info->in_flight = 0;
+    client_info->send_done = 0;
+    client_info->send_late = 0;
+
+    // Only fail the callbacks that are queued now
+    fail_front_requests(client_info, item_list_item_count(client_info->recv_callback_list), fail_result);
+}
+
+// The requests not sent yet stay queued for the next connection
+static void fail_sent_requests(HTTP_CLIENT_INFO* client_info, HTTP_CLIENT_RESULT fail_result)
+{
+    size_t sent_count = client_info->in_flight;
+    client_info->in_flight = 0;
+    client_info->send_done = 0;
+    client_info->send_late = 0;
+    fail_front_requests(client_info, sent_count, fail_result);
+}
+
+static int find_resp_info(HTTP_CLIENT_INFO* client_info, const HTTP_RESP_INFO* resp_info, size_t* found_index)
+{
+    int result = __LINE__;
+    size_t pending_count = item_list_item_count(client_info->recv_callback_list);
+    for (size_t index = 0; index < pending_count; index++)
+    {
+        if (item_list_get_item(client_info->recv_callback_list, index) == resp_info)
+        {
+            *found_index = index;
+            result = 0;
+            break;
+        }
+    }
+    return result;
+}
+
+static void on_request_timeout(void* context)
+{
+    HTTP_RESP_INFO* resp_info = (HTTP_RESP_INFO*)context;
+    HTTP_CLIENT_INFO* client_info = resp_info->client_info;
+    size_t index;
+
+    // The wheel released the timer
+    resp_info->request_timer = NULL;
+
+    // Once closing or in error everything pending fails with the connection
+    if (client_info->state != CLIENT_STATE_CLOSING && client_info->state != CLIENT_STATE_CLOSED && client_info->state != CLIENT_STATE_ERROR)
+    {
+        if (find_resp_info(client_info, resp_info, &index) != 0)
+        {
+            log_error("Could not find the timed out response info");
+        }
+        else if (index >= client_info->in_flight)
+        {
+            // Its request is still queued, the entries past the ones in flight line up with request_list
+            HTTP_RESP_INFO timed_out = *resp_info;
+            log_error("Request timed out waiting to be sent");
+            (void)item_list_remove_item(client_info->request_list, index - client_info->in_flight);
+            (void)item_list_remove_item(client_info->recv_callback_list, index);
+            report_failure(client_info, &timed_out, HTTP_CLIENT_TIMEOUT);
+        }
+        else if (client_info->state != CLIENT_STATE_TIMED_OUT)
+        {
+            // The responses owed on the connection arrive in order and can not be skipped, so the
+            // connection is dropped, the requests sent on it fail and the rest go out on a new one
+            log_error("Request timed out waiting on its response");
+            drop_connection(client_info, CLIENT_STATE_TIMED_OUT, HTTP_CLIENT_TIMEOUT);
+        }
+    }
+}
+
+static int start_connect_timer(HTTP_CLIENT_INFO* client_info)
+{
+    int result;
+    if (client_info->connect_timeout_ms == 0)
+    {
+        result = 0;
+    }
+    else if ((client_info->connect_timer = http_timer_wheel_add(client_info->timer_wheel, get_monotonic_ms() + client_info->connect_timeout_ms, on_connect_timeout, client_info)) == NULL)
+    {
+        log_error("Failure starting connect timer");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+// Starts the deadline of the response info that was added last
+static int start_request_timer(HTTP_CLIENT_INFO* client_info)
+{
+    int result;
+    if (client_info->request_timeout_ms == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t item_count = item_list_item_count(client_info->recv_callback_list);
+        HTTP_RESP_INFO* resp_info;
+        if (item_count == 0 || (resp_info = (HTTP_RESP_INFO*)item_list_get_item(client_info->recv_callback_list, item_count - 1)) == NULL)
+        {
+            log_error("Could not retrieve http response info");
+            result = __LINE__;
+        }
+        else if ((resp_info->request_timer = http_timer_wheel_add(client_info->timer_wheel, get_monotonic_ms() + client_info->request_timeout_ms, on_request_timeout, resp_info)) == NULL)
+        {
+            log_error("Failure starting request timer");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static void remove_last_resp_info(HTTP_CLIENT_INFO* client_info)
+{
+    size_t item_count = item_list_item_count(client_info->recv_callback_list);
+    if (item_count > 0)
+    {
+        HTTP_RESP_INFO* resp_info = (HTTP_RESP_INFO*)item_list_get_item(client_info->recv_callback_list, item_count - 1);
+        if (resp_info != NULL)
+        {
+            cancel_timer(client_info, &resp_info->request_timer);
+        }
+        (void)item_list_remove_item(client_info->recv_callback_list, item_count - 1);
+    }
+}
+
+static void on_tls_open_complete(void* context, IO_OPEN_RESULT open_result)
+{
+    if (context != NULL)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        if (client_info->state != CLIENT_STATE_OPENING)
+        {
+            // The open was abandoned by a timeout or a close
+            log_error("Ignoring open completion outside of opening: %d", open_result);
+        }
+        else
+        {
+            cancel_timer(client_info, &client_info->connect_timer);
+            if (open_result == IO_OPEN_OK)
+            {
+                client_info->state = CLIENT_STATE_OPENED;
+            }
+            else
+            {
+                client_info->state = CLIENT_STATE_ERROR;
+                client_info->curr_result = HTTP_CLIENT_OPEN_FAILED;
+                log_error("Failure opening http client: %d", open_result);
+            }
+            notify_ready(client_info);
+        }
+    }
+}
+
+static void on_open_complete(void* context, IO_OPEN_RESULT open_result)
+{
+    if (context != NULL)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        if (client_info->state != CLIENT_STATE_OPENING)
+        {
+            log_error("Ignoring open completion outside of opening: %d", open_result);
+        }
+        else if (open_result != IO_OPEN_OK || client_info->tls_handle == NULL)
+        {
+            on_tls_open_complete(client_info, open_result);
+        }
+        // The connect deadline keeps running through the handshake
+        else if (http_tls_open(client_info->tls_handle, on_tls_open_complete, client_info) != 0)
+        {
+            on_tls_open_complete(client_info, IO_OPEN_ERROR);
+        }
+    }
+}
+
+static void on_close_complete(void* context)
+{
+    if (context != NULL)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        client_info->state = CLIENT_STATE_CLOSED;
+        notify_ready(client_info);
+    }
+    else
+    {
+        log_error("Failure context NULL on closed complete");
+    }
+}
+
+static void on_error(void* context, IO_ERROR_RESULT error_result)
+{
+    if (context != NULL)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        HTTP_CLIENT_RESULT http_error;
+        switch (error_result)
+        {
+            case IO_ERROR_MEMORY:
+                http_error = HTTP_CLIENT_MEMORY;
+                break;
+            case IO_ERROR_ENDPOINT_DISCONN:
+                http_error = HTTP_CLIENT_DISCONNECTION;
+                break;
+            default:
+                http_error = HTTP_CLIENT_ERROR;
+                break;
+        }
+        fail_pending_requests(client_info, http_error);
+        if (client_info->on_error_cb != NULL)
+        {
+            client_info->on_error_cb(client_info->err_user_ctx, http_error);
+        }
+        notify_ready(client_info);
+    }
+    else
+    {
+        log_error("Failure context NULL on on_error");
+    }
+}
+
+static void on_send_complete(void* context, IO_SEND_RESULT send_result)
+{
+    if (context != NULL)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        // Only report failures
+        if (send_result != IO_SEND_OK)
+        {
+            client_info->state = CLIENT_STATE_ERROR;
+            client_info->curr_result = HTTP_CLIENT_SEND_FAILED;
+            log_error("Failure sending request");
+            notify_ready(client_info);
+        }
+        else if (client_info->send_late > 0)
+        {
+            client_info->send_late--;
+        }
+        else
+        {
+            // Sends complete in order, this one belongs to the first response still waiting on it
+            HTTP_RESP_INFO* resp_info = get_timed_resp_info(client_info, client_info->send_done);
+            if (resp_info != NULL)
+            {
+                resp_info->timing.send_complete = get_monotonic_ns();
+            }
+            client_info->send_done++;
+        }
+    }
+    else
+    {
+        log_error("Failure context NULL on send complete");
+    }
+}
+
+static void on_tls_record_sent(void* context, IO_SEND_RESULT send_result)
+{
+    if (context != NULL && send_result != IO_SEND_OK)
+    {
+        HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+        client_info->curr_result = client_info->state == CLIENT_STATE_OPENING ? HTTP_CLIENT_OPEN_FAILED : HTTP_CLIENT_SEND_FAILED;
+        client_info->state = CLIENT_STATE_ERROR;
+        log_error("Failure sending tls records");
+        notify_ready(client_info);
+    }
+}
+
+static int send_transport_data(HTTP_CLIENT_INFO* client_info, const void* data, size_t length, ON_SEND_COMPLETE on_send_complete_cb, void* callback_ctx)
+{
+    int result;
+    if (client_info->uring_conn != NULL)
+    {
+        result = http_uring_conn_send(client_info->uring_conn, data, length, on_send_complete_cb, callback_ctx);
+    }
+    else
+    {
+        result = patchcord_client_send(client_info->xio_handle, data, length, on_send_complete_cb, callback_ctx);
+    }
+    return result;
+}
+
+static int close_transport(HTTP_CLIENT_INFO* client_info)
+{
+    int result;
+    if (client_info->uring_conn != NULL)
+    {
+        result = http_uring_conn_close(client_info->uring_conn, on_close_complete, client_info);
+    }
+    else
+    {
+        result = patchcord_client_close(client_info->xio_handle, on_close_complete, client_info);
+    }
+    return result;
+}
+
+static int on_tls_send(void* context, const unsigned char* data, size_t length, ON_SEND_COMPLETE on_send_complete_cb, void* callback_ctx)
+{
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+    // Records the connection sends on its own are not counted against the requests
+    if (on_send_complete_cb == NULL)
+    {
+        on_send_complete_cb = on_tls_record_sent;
+        callback_ctx = client_info;
+    }
+    return send_transport_data(client_info, data, length, on_send_complete_cb, callback_ctx);
+}
+
+static int send_request_data(HTTP_CLIENT_INFO* client_info, const unsigned char* request_data, size_t request_len, ON_SEND_COMPLETE on_send_complete_cb)
+{
+    int result;
+    if (client_info->tls_handle != NULL)
+    {
+        result = http_tls_send(client_info->tls_handle, request_data, request_len, on_send_complete_cb, client_info);
+    }
+    else
+    {
+        result = send_transport_data(client_info, request_data, request_len, on_send_complete_cb, client_info);
+    }
+    return result;
+}
+
+// The head is built by the caller, the body is copied behind it so the request goes out in one send
+static int send_request_parts(HTTP_CLIENT_INFO* client_info, const HTTP_REQUEST_INFO* request_info, unsigned char* request_data, size_t head_len)
+{
+    int result;
+    size_t body_len = request_info->payload.payload_size;
+    if (body_len > 0)
+    {
+        memcpy(request_data + head_len, request_info->payload.payload, body_len);
+    }
+
+    if (send_request_data(client_info, request_data, head_len + body_len, on_send_complete) != 0)
+    {
+        log_error("Failure sending client data");
+        result = __LINE__;
+    }
+    else
+    {
+        if (client_info->logging_enabled)
+        {
+            log_trace("==> %.*s", (int)head_len, (const char*)request_data);
+            if (body_len > 0)
+            {
+                log_trace("==> %.*s", (int)body_len, (const char*)request_info->payload.payload);
+            }
+        }
+        result = 0;
+    }
+    return result;
+}
+
+static const char* get_request_method(HTTP_CLIENT_REQUEST_TYPE request_type)
+{
+    const char* result;
+    switch (request_type)
+    {
+        case HTTP_CLIENT_REQUEST_OPTIONS:
+            result = "OPTION";
+            break;
+        case HTTP_CLIENT_REQUEST_GET:
+            result = "GET";
+            break;
+        case HTTP_CLIENT_REQUEST_POST:
+            result = "POST";
+            break;
+        case HTTP_CLIENT_REQUEST_PUT:
+            result = "PUT";
+            break;
+        case HTTP_CLIENT_REQUEST_DELETE:
+            result = "DELETE";
+            break;
+        case HTTP_CLIENT_REQUEST_PATCH:
+            result = "PATCH";
+            break;
+        case HTTP_CLIENT_REQUEST_TYPE_INVALID:
+        default:
+            result = NULL;
+            break;
+    }
+    return result;
+}
+
+static int send_prepared_request(HTTP_CLIENT_INFO* client_info, const HTTP_REQUEST_INFO* request_info)
+{
+    int result;
+    char content_len_value[CONTENT_LEN_VALUE_SIZE];
+    const STRING_BUFFER* head = &request_info->prepared->head;
+
+    // Only the content length is patched in behind the serialized head
+    size_t value_len = format_content_length_value(content_len_value, request_info->payload.payload_size);
+    size_t head_len = head->payload_size + value_len;
+    unsigned char* request_data;
+
+    if ((request_data = (unsigned char*)http_alloc_malloc(&client_info->allocator, head_len + request_info->payload.payload_size)) == NULL)
+    {
+        log_error("Failure allocating request data");
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(request_data, head->payload, head->payload_size);
+        memcpy(request_data + head->payload_size, content_len_value, value_len);
+        result = send_request_parts(client_info, request_info, request_data, head_len);
+        http_alloc_free(&client_info->allocator, request_data);
+    }
+    return result;
+}
+
+static int send_http_request(HTTP_CLIENT_INFO* client_info, const HTTP_REQUEST_INFO* request_info)
+{
+    int result;
+    const char* method;
+
+    if (request_info->prepared != NULL)
+    {
+        result = send_prepared_request(client_info, request_info);
+    }
+    else if ((method = get_request_method(request_info->request_type)) == NULL)
+    {
+        log_error("Invalid request type specified %d", (int)request_info->request_type);
+        result = __LINE__;
+    }
+    else
+    {
+        // Lay out the request line, header block and body back to back so the request is one send
+        size_t method_len = strlen(method);
+        size_t path_len = strlen(request_info->relative_path);
+        size_t head_len = method_len + 1 + path_len + HTTP_VERSION_LEN + request_info->header_line.payload_size;
+        unsigned char* request_data;
+
+        if ((request_data = (unsigned char*)http_alloc_malloc(&client_info->allocator, head_len + request_info->payload.payload_size)) == NULL)
+        {
+            log_error("Failure allocating request data");
+            result = __LINE__;
+        }
+        else
+        {
+            unsigned char* iterator = request_data;
+            memcpy(iterator, method, method_len);
+            iterator += method_len;
+            *iterator++ = ' ';
+            memcpy(iterator, request_info->relative_path, path_len);
+            iterator += path_len;
+            memcpy(iterator, HTTP_VERSION_LINE, HTTP_VERSION_LEN);
+            iterator += HTTP_VERSION_LEN;
+            if (request_info->header_line.payload_size > 0)
+            {
+                memcpy(iterator, request_info->header_line.payload, request_info->header_line.payload_size);
+            }
+            result = send_request_parts(client_info, request_info, request_data, head_len);
+            http_alloc_free(&client_info->allocator, request_data);
+        }
+    }
+    return result;
+}
+
+static void on_codec_recv_callback(void* context, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data)
+{
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+    if (client_info == NULL)
+    {
+        log_error("Failure invalid user context in codec recieve callback");
+    }
+    else
+    {
+        HTTP_RESP_INFO* resp_info = (HTTP_RESP_INFO*)item_list_get_front(client_info->recv_callback_list);
+        if (resp_info != NULL)
+        {
+            HTTP_CLIENT_RESULT request_res = HTTP_CLIENT_OK;
+            if (result != HTTP_CODEC_CB_RESULT_OK)
+            {
+                request_res = HTTP_CLIENT_ERROR;
+            }
+            record_time(client_info, &resp_info->timing.body_complete);
+            cancel_timer(client_info, &resp_info->request_timer);
+            client_info->reporting = resp_info;
+            if (resp_info->on_message_complete != NULL)
+            {
+                resp_info->on_message_complete(resp_info->on_request_ctx, request_res);
+            }
+            else
+            {
+                resp_info->on_request_cb(resp_info->on_request_ctx, request_res, http_recv_data->http_content.payload, http_recv_data->http_content.payload_size,
+                    http_recv_data->status_code, http_recv_data->recv_header);
+            }
+            client_info->reporting = NULL;
+
+            // The response is done, the next one on this connection belongs to the next request
+            (void)item_list_remove_item(client_info->recv_callback_list, 0);
+            if (client_info->in_flight > 0)
+            {
+                client_info->in_flight--;
+            }
+            if (client_info->send_done > 0)
+            {
+                client_info->send_done--;
+            }
+            else
+            {
+                client_info->send_late++;
+            }
+            // A pipeline slot opened up for the next queued request
+            notify_ready(client_info);
+        }
+        else
+        {
+            log_error("Could not retrieve http response info");
+        }
+    }
+}
+
+static bool on_codec_headers_callback(void* context, const HTTP_RECV_DATA* http_recv_data)
+{
+    bool result;
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+    if (client_info == NULL)
+    {
+        log_error("Failure invalid user context in codec headers callback");
+        result = false;
+    }
+    else
+    {
+        HTTP_RESP_INFO* resp_info = (HTTP_RESP_INFO*)item_list_get_front(client_info->recv_callback_list);
+        if (resp_info != NULL)
+        {
+            record_time(client_info, &resp_info->timing.headers_complete);
+        }
+        if (resp_info != NULL && resp_info->on_body_fragment != NULL)
+        {
+            if (resp_info->on_headers_complete != NULL)
+            {
+                resp_info->on_headers_complete(resp_info->on_request_ctx, http_recv_data->status_code, http_recv_data->recv_header);
+            }
+            result = true;
+        }
+        else
+        {
+            result = false;
+        }
+    }
+    return result;
+}
+
+static void on_codec_body_fragment_callback(void* context, const unsigned char* fragment, size_t fragment_len)
+{
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+    if (client_info == NULL)
+    {
+        log_error("Failure invalid user context in codec body fragment callback");
+    }
+    else
+    {
+        const HTTP_RESP_INFO* resp_info = (const HTTP_RESP_INFO*)item_list_get_front(client_info->recv_callback_list);
+        if (resp_info != NULL && resp_info->on_body_fragment != NULL)
+        {
+            resp_info->on_body_fragment(resp_info->on_request_ctx, fragment, fragment_len);
+        }
+        else
+        {
+            log_error("Could not retrieve http response info");
+        }
+    }
+}
+
+static void on_codec_message_begin(void* context)
+{
+    HTTP_CLIENT_INFO* client_info = (HTTP_CLIENT_INFO*)context;
+    if (client_info == NULL)
+    {
+        log_error("Failure invalid user context in codec message begin callback");
+    }
+    else
+    {
+        HTTP_RESP_INFO* resp_info = get_timed_resp_info(client_info, 0);
+        if (resp_info != NULL)
+        {
+            resp_info->timing.first_byte = get_monotonic_ns();
+        }
+    }
+}
+
+static void request_list_destroy_cb(void* user_ctx, void* remove_item)
+{
+    (void)user_ctx;
+    HTTP_REQUEST_INFO* request_info = (HTTP_REQUEST_INFO*)remove_item;
+    if (request_info == NULL)
+    {
+        log_error("Failure invalid user context in list destroy");
+    }
+    else if (request_info->in_batch)
+    {
+        http_alloc_free(&request_info->client_info->allocator, request_info->header_line.payload);
+    }
+    else
+    {
+        if (request_info->prepared != NULL)
+        {
+            release_prepared_request(request_info->prepared);
+        }
+        free(request_info->payload.payload);
+        http_alloc_free(&request_info->client_info->allocator, request_info->header_line.payload);
+        free(request_info->relative_path);
+        http_alloc_free(&request_info->client_info->allocator, request_info);
+    }
+}
+
+// Puts the tls connection between the socket and the codec
+static int create_tls_connection(HTTP_CLIENT_INFO* client_info, const HTTP_ADDRESS* http_address, PATCHCORD_CALLBACK_INFO* callback_info)
+{
+    int result;
+    HTTP_TLS_CALLBACK_INFO tls_callback_info;
+    tls_callback_info.on_send = on_tls_send;
+    tls_callback_info.on_send_ctx = client_info;
+    tls_callback_info.on_bytes_received = callback_info->on_bytes_received;
+    tls_callback_info.on_bytes_received_ctx = callback_info->on_bytes_received_ctx;
+    tls_callback_info.on_io_error = on_error;
+    tls_callback_info.on_io_error_ctx = client_info;
+
+    if (client_info->tls_cache == NULL && (client_info->tls_cache = http_tls_cache_create(NULL)) == NULL)
+    {
+        log_error("Failure creating tls cache");
+        result = __LINE__;
+    }
+    else if ((client_info->tls_handle = http_tls_create(client_info->tls_cache, http_address->hostname, http_address->port, &tls_callback_info)) == NULL)
+    {
+        log_error("Failure creating tls connection");
+        result = __LINE__;
+    }
+    else
+    {
+        callback_info->on_bytes_received = http_tls_on_bytes_received;
+        callback_info->on_bytes_received_ctx = client_info->tls_handle;
+        result = 0;
+    }
+    return result;
+}
+
+static int create_connection(HTTP_CLIENT_INFO* client_info, const HTTP_ADDRESS* http_address)
+{
+    int result;
+    SOCKETIO_CONFIG config = {0};
     config.hostname = http_address->hostname;
     config.port = http_address->port;
     config.address_type = ADDRESS_TYPE_IP;
+    if (http_address->socket_path != NULL)
+    {
+        config.hostname = http_address->socket_path;
+        config.port = 0;
+        config.address_type = ADDRESS_TYPE_DOMAIN_SOCKET;
+    }
+
+    PATCHCORD_CALLBACK_INFO callback_info;
+    callback_info.on_bytes_received = http_codec_get_recv_function();
+    callback_info.on_bytes_received_ctx = client_info->codec_handle;
+    callback_info.on_io_error = on_error;
+    callback_info.on_io_error_ctx = client_info;
+
+    // A connection dropped after an error is released when the client opens again
+    release_transport(client_info);
+    if (client_info->socket_host != NULL)
+    {
+        free(client_info->socket_host);
+        client_info->socket_host = NULL;
+    }
+
+    if (http_address->socket_path != NULL &&
+        clone_string(&client_info->socket_host, http_address->hostname != NULL ? http_address->hostname : DEFAULT_SOCKET_HOST) != 0)
+    {
+        log_error("Failure allocating socket host");
+        result = __LINE__;
+    }
+    else if (http_address->is_secure && create_tls_connection(client_info, http_address, &callback_info) != 0)
+    {
+        log_error("Failure creating tls connection");
+        result = __LINE__;
+    }
+    else if (client_info->uring != NULL)
+    {
+        if ((client_info->uring_conn = http_uring_conn_create(client_info->uring, &config, &callback_info)) == NULL)
+        {
+            log_error("Failure creating uring connection");
+            result = __LINE__;
+        }
+        else if (http_uring_conn_open(client_info->uring_conn, on_open_complete, client_info) != 0)
+        {
+            log_error("Failure opening http client");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    else if ((client_info->xio_handle = patchcord_client_create(cord_socket_get_interface(), &config, &callback_info)) == NULL)
+    {
+        log_error("Failure creating client connection");
+        result = __LINE__;
+    }
+    else if (patchcord_client_open(client_info->xio_handle, on_open_complete, client_info) != 0)
+    {
+        log_error("Failure opening http client");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static int save_address(HTTP_CLIENT_INFO* client_info, const HTTP_ADDRESS* http_address)
+{
+    int result;
+    if (client_info->hostname != NULL)
+    {
+        free(client_info->hostname);
+        client_info->hostname = NULL;
+    }
+    if (client_info->socket_path != NULL)
+    {
+        free(client_info->socket_path);
+        client_info->socket_path = NULL;
+    }
+
+    if (http_address->hostname != NULL && clone_string(&client_info->hostname, http_address->hostname) != 0)
+    {
+        log_error("Failure copying the hostname");
+        result = __LINE__;
+    }
+    else if (http_address->socket_path != NULL && clone_string(&client_info->socket_path, http_address->socket_path) != 0)
+    {
+        log_error("Failure copying the socket path");
+        result = __LINE__;
+    }
+    else
+    {
+        client_info->port = http_address->port;
+        client_info->is_secure = http_address->is_secure;
+        result = 0;
+    }
+    return result;
+}
+
+// Opens the address saved by http_client_open on a new connection
+static int reopen_connection(HTTP_CLIENT_INFO* client_info)
+{
+    int result;
+    HTTP_ADDRESS http_address = {0};
+    http_address.hostname = client_info->hostname;
+    http_address.port = client_info->port;
+    http_address.is_secure = client_info->is_secure;
+    http_address.socket_path = client_info->socket_path;
+
+    // Set before connecting so an open that completes inline is accepted
+    client_info->state = CLIENT_STATE_OPENING;
+    client_info->reopening = true;
+    if (start_connect_timer(client_info) != 0)
+    {
+        log_error("Failure starting the connect deadline");
+        result = __LINE__;
+    }
+    else if (create_connection(client_info, &http_address) != 0)
+    {
+        log_error("Failure attempting to connect to client");
+        cancel_timer(client_info, &client_info->connect_timer);
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+HTTP_CLIENT_HANDLE http_client_create(void)
+{
+    return http_client_create_with_allocator(NULL);
+}
+
+HTTP_CLIENT_HANDLE http_client_create_with_allocator(const HTTP_ALLOCATOR* allocator)
+{
+    HTTP_CLIENT_INFO* result;
+    if (allocator == NULL)
+    {
+        allocator = http_alloc_get_default();
+    }
+    if ((result = (HTTP_CLIENT_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_CLIENT_INFO))) == NULL)
+    {
+        log_error("Failure allocating http client info");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_CLIENT_INFO));
+        result->allocator = *allocator;
+        result->pipeline_depth = DEFAULT_PIPELINE_DEPTH;
+        if ((result->codec_handle = http_codec_create_with_allocator(on_codec_recv_callback, result, &result->allocator)) == NULL)
+        {
+            log_error("Failure creating request list");
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+        else if (http_codec_set_stream_callbacks(result->codec_handle, on_codec_headers_callback, on_codec_body_fragment_callback) != 0)
+        {
+            log_error("Failure setting codec stream callbacks");
+            http_codec_destroy(result->codec_handle);
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+        else if ((result->request_list = item_list_create(request_list_destroy_cb, NULL) ) == NULL)
+        {
+            log_error("Failure creating request list");
+
+            http_codec_destroy(result->codec_handle);
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+        else if ((result->recv_callback_list = item_list_create(NULL, NULL) ) == NULL)
+        {
+            log_error("Failure creating request list");
+
+            http_codec_destroy(result->codec_handle);
+            item_list_destroy(result->request_list);
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+void http_client_destroy(HTTP_CLIENT_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        patchcord_client_destroy(handle->xio_handle);
+        if (handle->uring_conn != NULL)
+        {
+            http_uring_conn_destroy(handle->uring_conn);
+        }
+        if (handle->uring != NULL)
+        {
+            http_uring_destroy(handle->uring);
+        }
+        if (handle->tls_handle != NULL)
+        {
+            http_tls_destroy(handle->tls_handle);
+        }
+        if (handle->tls_cache != NULL)
+        {
+            http_tls_cache_destroy(handle->tls_cache);
+        }
+        if (handle->socket_host != NULL)
+        {
+            free(handle->socket_host);
+        }
+        if (handle->hostname != NULL)
+        {
+            free(handle->hostname);
+        }
+        if (handle->socket_path != NULL)
+        {
+            free(handle->socket_path);
+        }
+        http_codec_destroy(handle->codec_handle);
+        item_list_destroy(handle->recv_callback_list);
+        item_list_destroy(handle->request_list);
+        while (handle->batch_list != NULL)
+        {
+            HTTP_BATCH_INFO* batch = handle->batch_list;
+            handle->batch_list = batch->next;
+            http_alloc_free(&handle->allocator, batch);
+        }
+        if (handle->timer_wheel != NULL)
+        {
+            http_timer_wheel_destroy(handle->timer_wheel);
+        }
+        if (handle->submit_ring != NULL)
+        {
+            // Submitted requests that were never picked up are dropped like the queued ones
+            HTTP_SUBMIT_INFO submit_info;
+            while (http_mpsc_ring_pop(handle->submit_ring, &submit_info))
+            {
+                request_list_destroy_cb(NULL, submit_info.request_info);
+            }
+            http_mpsc_ring_destroy(handle->submit_ring);
+            destroy_wait_event(handle);
+        }
+        http_alloc_free(&handle->allocator, handle);
+    }
+}
+
+int http_client_open(HTTP_CLIENT_HANDLE handle, const HTTP_ADDRESS* http_address, ON_HTTP_OPEN_COMPLETE_CALLBACK on_open_complete_cb, void* open_user_ctx, ON_HTTP_ERROR_CALLBACK on_error_cb, void* err_user_ctx)
+{
+    int result;
+    if (handle == NULL || http_address == NULL)
+    {
+        log_error("Invalid paramenter handle: %p, http_address: %p", handle, http_address);
+        result = __LINE__;
+    }
+    else if (handle->state != CLIENT_STATE_NOT_CONN)
+    {
+        log_error("Open attempt on a client that is not closed");
+        result = __LINE__;
+    }
+    else if (save_address(handle, http_address) != 0)
+    {
+        log_error("Failure saving the address");
+        result = __LINE__;
+    }
+    else if (start_connect_timer(handle) != 0)
+    {
+        log_error("Failure starting the connect deadline");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->reopening = false;
+        handle->on_open_complete_cb = on_open_complete_cb;
+        handle->open_complete_ctx = open_user_ctx;
+        handle->on_error_cb = on_error_cb;
+        handle->err_user_ctx = err_user_ctx;
+        // Set before connecting so an open that completes inline is accepted
+        handle->state = CLIENT_STATE_OPENING;
+        if (create_connection(handle, http_address) != 0)
+        {
+            log_error("Failure attempting to connect to client");
+            cancel_timer(handle, &handle->connect_timer);
+            handle->state = CLIENT_STATE_NOT_CONN;
+            result = __LINE__;
+        }
+        else
+        {
+            notify_ready(handle);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int http_client_close(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_CLOSE on_close_cb, void* user_ctx)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid paramenter handle is NULL");
+        result = __LINE__;
+    }
+    else if (handle->state == CLIENT_STATE_NOT_CONN)
+    {
+        log_error("Close attempt on a client that is not open");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->on_close_cb = on_close_cb;
+        handle->close_user_ctx = user_ctx;
+        cancel_timer(handle, &handle->connect_timer);
+        if (handle->state == CLIENT_STATE_OPEN || handle->state == CLIENT_STATE_OPENING || handle->state == CLIENT_STATE_OPENED)
+        {
+            if (close_transport(handle) != 0)
+            {
+                log_error("Failure on close attempt");
+                handle->curr_result = HTTP_CLIENT_ERROR;
+                handle->state = CLIENT_STATE_ERROR;
+                result = __LINE__;
+            }
+            else
+            {
+                handle->state = CLIENT_STATE_CLOSING;
+                result = 0;
+            }
+        }
+        else if (handle->state == CLIENT_STATE_TIMED_OUT)
+        {
+            // The connection is already gone, process_item reports the close
+            handle->state = CLIENT_STATE_CLOSED;
+            result = 0;
+        }
+        else
+        {
+            handle->state = CLIENT_STATE_NOT_CONN;
+            result = 0;
+        }
+        notify_ready(handle);
+    }
+    return result;
+}
+
+static int queue_request(HTTP_CLIENT_INFO* handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+    HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, const HTTP_RESP_INFO* resp_info)
+{
+    int result;
+    HTTP_REQUEST_INFO* execute_req;
+    if ((execute_req = (HTTP_REQUEST_INFO*)http_alloc_malloc(&handle->allocator, sizeof(HTTP_REQUEST_INFO))) == NULL)
+    {
+        log_error("Failure allocating request");
+        result = __LINE__;
+    }
+    else
+    {
+        memset(execute_req, 0, sizeof(HTTP_REQUEST_INFO));
+        bool create_header = false;
+        execute_req->request_type = request_type;
+        execute_req->client_info = handle;
+
+        if (http_header == NULL)
+        {
+            if ((http_header = http_header_create()) == NULL)
+            {
+                log_error("Failure allocating request");
+                result = __LINE__;
+            }
+            else
+            {
+                result = 0;
+                create_header = true;
+            }
+        }
+        else
+        {
+            result = 0;
+        }
+
+        if (result == 0)
+        {
+            if (clone_string(&execute_req->relative_path, relative_path) != 0)
+            {
+                log_error("Failure allocating request");
+                http_alloc_free(&handle->allocator, execute_req);
+                result = __LINE__;
+            }
+            else if (content_length != 0 && byte_buffer_construct(&execute_req->payload, content, content_length) != 0)
+            {
+                log_error("Failure allocating request");
+                free(execute_req->relative_path);
+                http_alloc_free(&handle->allocator, execute_req);
+                result = __LINE__;
+            }
+            else if (construct_header_line(execute_req, http_header, content_length, get_endpoint_host(handle), handle->port, handle->accept_encoding) != 0)
+            {
+                log_error("Failure allocating header line");
+                free(execute_req->payload.payload);
+                free(execute_req->relative_path);
+                http_alloc_free(&handle->allocator, execute_req);
+                result = __LINE__;
+            }
+            else if (item_list_add_copy(handle->recv_callback_list, resp_info, sizeof(HTTP_RESP_INFO) ) != 0)
+            {
+                log_error("Failure adding to response list");
+                free(execute_req->payload.payload);
+                http_alloc_free(&handle->allocator, execute_req->header_line.payload);
+                free(execute_req->relative_path);
+                http_alloc_free(&handle->allocator, execute_req);
+                result = __LINE__;
+            }
+            else if (start_request_timer(handle) != 0 || item_list_add_item(handle->request_list, execute_req) != 0)
+            {
+                log_error("Failure adding to request list");
+                free(execute_req->payload.payload);
+                http_alloc_free(&handle->allocator, execute_req->header_line.payload);
+                free(execute_req->relative_path);
+                remove_last_resp_info(handle);
+                http_alloc_free(&handle->allocator, execute_req);
+                result = __LINE__;
+            }
+            else
+            {
+                notify_ready(handle);
+                result = 0;
+            }
+        }
+
+        if (create_header)
+        {
+            http_header_destroy(http_header);
+        }
+    }
+    return result;
+}
+
+static void drain_submit_queue(HTTP_CLIENT_INFO* client_info)
+{
+    HTTP_SUBMIT_INFO submit_info;
+    while (http_mpsc_ring_pop(client_info->submit_ring, &submit_info))
+    {
+        HTTP_REQUEST_INFO* request_info = submit_info.request_info;
+        bool add_accept_encoding = client_info->accept_encoding && !submit_info.has_accept_encoding;
+        bool queued = false;
+
+        if (append_default_fields(&client_info->allocator, &request_info->header_line, get_endpoint_host(client_info), client_info->port, !submit_info.has_hostname, add_accept_encoding) != 0 ||
+            append_content_length(&client_info->allocator, &request_info->header_line, request_info->payload.payload_size) != 0)
+        {
+            log_error("Failure allocating header line");
+        }
+        else if (item_list_add_copy(client_info->recv_callback_list, &submit_info.resp_info, sizeof(HTTP_RESP_INFO)) != 0)
+        {
+            log_error("Failure adding to response list");
+        }
+        else if (start_request_timer(client_info) != 0 || item_list_add_item(client_info->request_list, request_info) != 0)
+        {
+            log_error("Failure adding to request list");
+            remove_last_resp_info(client_info);
+        }
+        else
+        {
+            queued = true;
+        }
+
+        // The submitter already returned, so a request that can not be queued is failed through its callback
+        if (!queued)
+        {
+            request_list_destroy_cb(NULL, request_info);
+            submit_info.resp_info.on_request_cb(submit_info.resp_info.on_request_ctx, HTTP_CLIENT_ERROR, NULL, 0, 0, NULL);
+        }
+    }
+}
+
+int http_client_execute_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+    HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid paramenter handle is NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        HTTP_RESP_INFO resp_info = {0};
+        resp_info.on_request_cb = on_request_callback;
+        resp_info.client_info = handle;
+        resp_info.on_request_ctx = callback_ctx;
+        record_time(handle, &resp_info.timing.enqueued);
+        result = queue_request(handle, request_type, relative_path, http_header, content, content_length, &resp_info);
+    }
+    return result;
+}
+
+int http_client_execute_stream_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+    HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, ON_HTTP_HEADERS_COMPLETE on_headers_complete,
+    ON_HTTP_BODY_FRAGMENT on_body_fragment, ON_HTTP_MESSAGE_COMPLETE on_message_complete, void* callback_ctx)
+{
+    int result;
+    if (handle == NULL || on_body_fragment == NULL || on_message_complete == NULL)
+    {
+        log_error("Invalid paramenter handle: %p, on_body_fragment: %p, on_message_complete: %p", handle, on_body_fragment, on_message_complete);
+        result = __LINE__;
+    }
+    else
+    {
+        HTTP_RESP_INFO resp_info = {0};
+        resp_info.on_headers_complete = on_headers_complete;
+        resp_info.on_body_fragment = on_body_fragment;
+        resp_info.on_message_complete = on_message_complete;
+        resp_info.client_info = handle;
+        resp_info.on_request_ctx = callback_ctx;
+        record_time(handle, &resp_info.timing.enqueued);
+        result = queue_request(handle, request_type, relative_path, http_header, content, content_length, &resp_info);
+    }
+    return result;
+}
+
+HTTP_PREPARED_REQUEST_HANDLE http_client_prepare_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path, HTTP_HEADERS_HANDLE http_header)
+{
+    HTTP_PREPARED_REQUEST_INFO* result;
+    const char* method;
+    const char* hostname;
+    if (handle == NULL || relative_path == NULL || (method = get_request_method(request_type)) == NULL)
+    {
+        log_error("Invalid paramenter handle: %p, relative_path: %p, request_type: %d", handle, relative_path, (int)request_type);
+        result = NULL;
+    }
+    else if ((hostname = get_endpoint_host(handle)) == NULL)
+    {
+        log_error("Failure the client endpoint is unknown, open the client before preparing requests");
+        result = NULL;
+    }
+    else if ((result = (HTTP_PREPARED_REQUEST_INFO*)http_alloc_malloc(&handle->allocator, sizeof(HTTP_PREPARED_REQUEST_INFO))) == NULL)
+    {
+        log_error("Failure allocating prepared request");
+    }
+    else
+    {
+        HTTP_HEADERS_HANDLE empty_header = NULL;
+        memset(result, 0, sizeof(HTTP_PREPARED_REQUEST_INFO));
+        result->ref_count = 1;
+        result->allocator = handle->allocator;
+
+        if (http_header == NULL && (http_header = empty_header = http_header_create()) == NULL)
+        {
+            log_error("Failure allocating request header");
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
+        }
+        else if (append_header_text(&handle->allocator, &result->head, method, strlen(method)) != 0 ||
+            append_header_text(&handle->allocator, &result->head, " ", 1) != 0 ||
+            append_header_text(&handle->allocator, &result->head, relative_path, strlen(relative_path)) != 0 ||
+            append_header_text(&handle->allocator, &result->head, HTTP_VERSION_LINE, HTTP_VERSION_LEN) != 0)
+        {
+            log_error("Failure allocating request line");
+            http_alloc_free(&handle->allocator, result->head.payload);
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
+        }
+        else if (construct_header_fields(&handle->allocator, &result->head, http_header, hostname, handle->port, handle->accept_encoding) != 0)
+        {
+            log_error("Failure constructing header fields");
+            http_alloc_free(&handle->allocator, result->head.payload);
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
+        }
+        else if (append_header_text(&handle->allocator, &result->head, HTTP_CONTENT_LEN, HTTP_CONTENT_LEN_LEN) != 0 ||
+            append_header_text(&handle->allocator, &result->head, HTTP_FIELD_SEPARATOR, HTTP_FIELD_SEPARATOR_LEN) != 0)
+        {
+            log_error("Failure allocating content length line");
+            http_alloc_free(&handle->allocator, result->head.payload);
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
+        }
+
+        if (empty_header != NULL)
+        {
+            http_header_destroy(empty_header);
+        }
+    }
+    return result;
+}
+
+void http_client_destroy_prepared_request(HTTP_PREPARED_REQUEST_HANDLE prepared)
+{
+    if (prepared != NULL)
+    {
+        release_prepared_request(prepared);
+    }
+}
+
+int http_client_execute_prepared_request(HTTP_CLIENT_HANDLE handle, HTTP_PREPARED_REQUEST_HANDLE prepared, const unsigned char* content, size_t content_length,
+    ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+{
+    int result;
+    HTTP_REQUEST_INFO* execute_req;
+    if (handle == NULL || prepared == NULL || (content == NULL && content_length != 0))
+    {
+        log_error("Invalid paramenter handle: %p, prepared: %p, content: %p", handle, prepared, content);
+        result = __LINE__;
+    }
+    else if ((execute_req = (HTTP_REQUEST_INFO*)http_alloc_malloc(&handle->allocator, sizeof(HTTP_REQUEST_INFO))) == NULL)
+    {
+        log_error("Failure allocating request");
+        result = __LINE__;
+    }
+    else
+    {
+        HTTP_RESP_INFO resp_info = {0};
+        resp_info.on_request_cb = on_request_callback;
+        resp_info.client_info = handle;
+        resp_info.on_request_ctx = callback_ctx;
+        record_time(handle, &resp_info.timing.enqueued);
+
+        memset(execute_req, 0, sizeof(HTTP_REQUEST_INFO));
+        execute_req->client_info = handle;
+
+        if (content_length != 0 && byte_buffer_construct(&execute_req->payload, content, content_length) != 0)
+        {
+            log_error("Failure allocating request");
+            http_alloc_free(&handle->allocator, execute_req);
+            result = __LINE__;
+        }
+        else if (item_list_add_copy(handle->recv_callback_list, &resp_info, sizeof(HTTP_RESP_INFO)) != 0)
+        {
+            log_error("Failure adding to response list");
+            free(execute_req->payload.payload);
+            http_alloc_free(&handle->allocator, execute_req);
+            result = __LINE__;
+        }
+        else if (start_request_timer(handle) != 0 || item_list_add_item(handle->request_list, execute_req) != 0)
+        {
+            log_error("Failure adding to request list");
+            free(execute_req->payload.payload);
+            remove_last_resp_info(handle);
+            http_alloc_free(&handle->allocator, execute_req);
+            result = __LINE__;
+        }
+        else
+        {
+            // The queued request keeps the template alive until it is sent
+            execute_req->prepared = prepared;
+            prepared->ref_count++;
+            notify_ready(handle);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static void unlink_batch(HTTP_CLIENT_INFO* client_info, HTTP_BATCH_INFO* batch)
+{
+    if (batch->prev != NULL)
+    {
+        batch->prev->next = batch->next;
+    }
+    else
+    {
+        client_info->batch_list = batch->next;
+    }
+    if (batch->next != NULL)
+    {
+        batch->next->prev = batch->prev;
+    }
+}
+
+static void on_batch_request_callback(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+    HTTP_HEADERS_HANDLE response_headers)
+{
+    HTTP_BATCH_ITEM* batch_item = (HTTP_BATCH_ITEM*)callback_ctx;
+    HTTP_BATCH_INFO* batch = batch_item->batch;
+    if (request_result != HTTP_CLIENT_OK)
+    {
+        batch->failed_count++;
+    }
+    if (batch_item->on_request_cb != NULL)
+    {
+        batch_item->on_request_cb(batch_item->on_request_ctx, request_result, content, content_length, status_code, response_headers);
+    }
+    if (--batch->remaining_count == 0)
+    {
+        // Freed first so the batch callback is free to destroy the client
+        ON_HTTP_BATCH_COMPLETE on_batch_complete = batch->on_batch_complete;
+        void* batch_ctx = batch->batch_ctx;
+        size_t request_count = batch->request_count;
+        size_t failed_count = batch->failed_count;
+        unlink_batch(batch->client_info, batch);
+        http_alloc_free(&batch->client_info->allocator, batch);
+        if (on_batch_complete != NULL)
+        {
+            on_batch_complete(batch_ctx, request_count, failed_count);
+        }
+    }
+}
+
+// Paths and content are copied behind the items, the header lines are the only allocations per request
+static HTTP_BATCH_INFO* create_batch(HTTP_CLIENT_INFO* client_info, const HTTP_BATCH_REQUEST* requests, size_t request_count)
+{
+    HTTP_BATCH_INFO* result;
+    size_t alloc_size = sizeof(HTTP_BATCH_INFO) + request_count * sizeof(HTTP_BATCH_ITEM);
+    for (size_t index = 0; index < request_count; index++)
+    {
+        alloc_size += strlen(requests[index].relative_path) + 1 + requests[index].content_length;
+    }
 
-    PATCHCORD_CALLBACK_INFO callback_info;
-    callback_info.on_bytes_received = http_codec_get_recv_function();
-    callback_info.on_bytes_received_ctx = client_info->codec_handle;
-    callback_info.on_io_error = on_error;
-    callback_info.on_io_error_ctx = client_info;
+    if ((result = (HTTP_BATCH_INFO*)http_alloc_malloc(&client_info->allocator, alloc_size)) == NULL)
+    {
+        log_error("Failure allocating batch");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_BATCH_INFO) + request_count * sizeof(HTTP_BATCH_ITEM));
+        result->client_info = client_info;
+        result->request_count = request_count;
+        result->remaining_count = request_count;
+        result->items = (HTTP_BATCH_ITEM*)(result + 1);
+
+        const char* hostname = get_endpoint_host(client_info);
+        unsigned char* data = (unsigned char*)(result->items + request_count);
+        size_t fields_len = 0;
+        size_t index;
+        for (index = 0; index < request_count; index++)
+        {
+            HTTP_BATCH_ITEM* batch_item = &result->items[index];
+            HTTP_REQUEST_INFO* request_info = &batch_item->request_info;
+            size_t path_len = strlen(requests[index].relative_path) + 1;
+            int header_result;
+
+            batch_item->batch = result;
+            batch_item->on_request_cb = requests[index].on_request_callback;
+            batch_item->on_request_ctx = requests[index].callback_ctx;
+            request_info->client_info = client_info;
+            request_info->request_type = requests[index].request_type;
+            request_info->in_batch = true;
+            request_info->relative_path = (char*)data;
+            memcpy(data, requests[index].relative_path, path_len);
+            data += path_len;
+            if (requests[index].content_length > 0)
+            {
+                request_info->payload.payload = data;
+                request_info->payload.payload_size = requests[index].content_length;
+                memcpy(data, requests[index].content, requests[index].content_length);
+                data += requests[index].content_length;
+            }
+
+            // Fan out requests usually share their headers, they are only walked when they change
+            if (index > 0 && requests[index].http_header == requests[index - 1].http_header)
+            {
+                header_result = append_header_text(&client_info->allocator, &request_info->header_line, result->items[index - 1].request_info.header_line.payload, fields_len);
+            }
+            else if (requests[index].http_header == NULL)
+            {
+                header_result = append_default_fields(&client_info->allocator, &request_info->header_line, hostname, client_info->port, true, client_info->accept_encoding);
+            }
+            else
+            {
+                header_result = construct_header_fields(&client_info->allocator, &request_info->header_line, requests[index].http_header, hostname, client_info->port, client_info->accept_encoding);
+            }
+            fields_len = request_info->header_line.payload_size;
+
+            if (header_result != 0 || append_content_length(&client_info->allocator, &request_info->header_line, requests[index].content_length) != 0)
+            {
+                log_error("Failure constructing batch header line");
+                http_alloc_free(&client_info->allocator, request_info->header_line.payload);
+                break;
+            }
+        }
+
+        if (index < request_count)
+        {
+            while (index > 0)
+            {
+                http_alloc_free(&client_info->allocator, result->items[--index].request_info.header_line.payload);
+            }
+            http_alloc_free(&client_info->allocator, result);
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+int http_client_execute_batch(HTTP_CLIENT_HANDLE handle, const HTTP_BATCH_REQUEST* requests, size_t request_count, ON_HTTP_BATCH_COMPLETE on_batch_complete, void* batch_ctx)
+{
+    int result;
+    size_t index;
+    for (index = 0; requests != NULL && index < request_count; index++)
+    {
+        if (requests[index].relative_path == NULL || (requests[index].content == NULL && requests[index].content_length != 0))
+        {
+            break;
+        }
+    }
+
+    HTTP_BATCH_INFO* batch;
+    if (handle == NULL || requests == NULL || request_count == 0 || request_count > (SIZE_MAX - sizeof(HTTP_BATCH_INFO)) / sizeof(HTTP_BATCH_ITEM))
+    {
+        log_error("Invalid paramenter handle: %p, requests: %p, request_count: %zu", handle, requests, request_count);
+        result = __LINE__;
+    }
+    else if (index < request_count)
+    {
+        log_error("Invalid batch request %zu", index);
+        result = __LINE__;
+    }
+    else if ((batch = create_batch(handle, requests, request_count)) == NULL)
+    {
+        log_error("Failure creating batch");
+        result = __LINE__;
+    }
+    else
+    {
+        batch->on_batch_complete = on_batch_complete;
+        batch->batch_ctx = batch_ctx;
+
+        HTTP_RESP_INFO resp_info = {0};
+        resp_info.on_request_cb = on_batch_request_callback;
+        resp_info.client_info = handle;
+        record_time(handle, &resp_info.timing.enqueued);
+        for (index = 0; index < request_count; index++)
+        {
+            resp_info.on_request_ctx = &batch->items[index];
+            if (item_list_add_copy(handle->recv_callback_list, &resp_info, sizeof(HTTP_RESP_INFO)) != 0)
+            {
+                log_error("Failure adding to response list");
+                break;
+            }
+            else if (start_request_timer(handle) != 0 || item_list_add_item(handle->request_list, &batch->items[index].request_info) != 0)
+            {
+                log_error("Failure adding to request list");
+                remove_last_resp_info(handle);
+                break;
+            }
+        }
+
+        if (index < request_count)
+        {
+            // Nothing of the batch stays queued, the requests taken back free their own header lines
+            for (size_t remaining = index; remaining < request_count; remaining++)
+            {
+                http_alloc_free(&handle->allocator, batch->items[remaining].request_info.header_line.payload);
+            }
+            while (index > 0)
+            {
+                remove_last_resp_info(handle);
+                (void)item_list_remove_item(handle->request_list, item_list_item_count(handle->request_list) - 1);
+                index--;
+            }
+            http_alloc_free(&handle->allocator, batch);
+            result = __LINE__;
+        }
+        else
+        {
+            batch->next = handle->batch_list;
+            if (handle->batch_list != NULL)
+            {
+                handle->batch_list->prev = batch;
+            }
+            handle->batch_list = batch;
+            notify_ready(handle);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+// Everything process_item does once the connection has been driven
+static void process_client_work(HTTP_CLIENT_INFO* handle)
+{
+    if (handle->timer_wheel != NULL)
+    {
+        http_timer_wheel_advance(handle->timer_wheel, get_monotonic_ms());
+    }
+    if (handle->submit_ring != NULL)
+    {
+        drain_submit_queue(handle);
+    }
+    switch (handle->state)
+    {
+        case CLIENT_STATE_OPENING:
+        case CLIENT_STATE_CLOSING:
+            break;
+        case CLIENT_STATE_OPENED:
+            if (!handle->reopening && handle->on_open_complete_cb != NULL)
+            {
+                handle->on_open_complete_cb(handle->open_complete_ctx, HTTP_CLIENT_OK);
+            }
+            handle->reopening = false;
+            handle->state = CLIENT_STATE_OPEN;
+            break;
+        case CLIENT_STATE_OPEN:
+        {
+            const HTTP_REQUEST_INFO* execute_req;
+            while ((execute_req = item_list_get_front(handle->request_list)) != NULL && handle->in_flight < handle->pipeline_depth)
+            {
+                // The responses of the requests in flight are ahead of this one
+                HTTP_RESP_INFO* resp_info = get_timed_resp_info(handle, handle->in_flight);
+                if (resp_info != NULL)
+                {
+                    resp_info->timing.dequeued = get_monotonic_ns();
+                }
+
+                // Send the item
+                if (send_http_request(handle, execute_req) != 0)
+                {
+                    handle->state = CLIENT_STATE_ERROR;
+                    handle->curr_result = HTTP_CLIENT_SEND_FAILED;
+                    log_error("Failure sending http request");
+                    break;
+                }
+                else if (item_list_remove_item(handle->request_list, 0) != 0)
+                {
+                    handle->state = CLIENT_STATE_ERROR;
+                    handle->curr_result = HTTP_CLIENT_ERROR;
+                    log_error("Invalid paramenter handle is NULL");
+                    break;
+                }
+                else
+                {
+                    handle->in_flight++;
+                }
+            }
+            break;
+        }
+        case CLIENT_STATE_CLOSED:
+            fail_pending_requests(handle, HTTP_CLIENT_DISCONNECTION);
+            if (handle->on_close_cb != NULL)
+            {
+                handle->on_close_cb(handle->close_user_ctx);
+            }
+            handle->state = CLIENT_STATE_NOT_CONN;
+            break;
+        case CLIENT_STATE_TIMED_OUT:
+            fail_sent_requests(handle, HTTP_CLIENT_TIMEOUT);
+            // A callback may have closed the client
+            if (handle->state == CLIENT_STATE_TIMED_OUT && reopen_connection(handle) != 0)
+            {
+                handle->state = CLIENT_STATE_ERROR;
+                handle->curr_result = HTTP_CLIENT_OPEN_FAILED;
+            }
+            break;
+        case CLIENT_STATE_NOT_CONN:
+        default:
+            break;
+        case CLIENT_STATE_ERROR:
+            fail_pending_requests(handle, handle->curr_result);
+            if (handle->on_error_cb)
+            {
+                handle->on_error_cb(handle->err_user_ctx, handle->curr_result);
+            }
+            handle->state = CLIENT_STATE_NOT_CONN;
+            break;
+    }
+}
+
+void http_client_process_item(HTTP_CLIENT_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        log_error("Invalid paramenter handle is NULL");
+    }
+    else
+    {
+        if (handle->uring_conn != NULL)
+        {
+            http_uring_conn_process_item(handle->uring_conn);
+        }
+        else
+        {
+            patchcord_client_process_item(handle->xio_handle);
+        }
+        process_client_work(handle);
+    }
+}
+
+void http_client_process_work(HTTP_CLIENT_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        log_error("Invalid paramenter handle is NULL");
+    }
+    else
+    {
+        process_client_work(handle);
+    }
+}
+
+bool http_client_has_pending_work(HTTP_CLIENT_HANDLE handle)
+{
+    bool result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = false;
+    }
+    else if (handle->submit_ring != NULL && !http_mpsc_ring_is_empty(handle->submit_ring))
+    {
+        result = true;
+    }
+    else if (handle->state == CLIENT_STATE_NOT_CONN)
+    {
+        result = false;
+    }
+    else if (handle->state == CLIENT_STATE_OPEN)
+    {
+        result = item_list_item_count(handle->request_list) > 0 || item_list_item_count(handle->recv_callback_list) > 0;
+    }
+    else
+    {
+        // Connecting, closing and errors all complete in process_item
+        result = true;
+    }
+    return result;
+}
+
+// Milliseconds the caller can sleep before process_item has something to do
+static int get_wait_time(HTTP_CLIENT_INFO* client_info, uint32_t timeout_ms)
+{
+    int result = timeout_ms > INT_MAX ? INT_MAX : (int)timeout_ms;
+    bool waits_on_network;
+    if (client_info->submit_ring != NULL && !http_mpsc_ring_is_empty(client_info->submit_ring))
+    {
+        result = 0;
+        waits_on_network = false;
+    }
+    else if (client_info->state == CLIENT_STATE_OPENED || client_info->state == CLIENT_STATE_CLOSED || client_info->state == CLIENT_STATE_ERROR ||
+        client_info->state == CLIENT_STATE_TIMED_OUT ||
+        (client_info->state == CLIENT_STATE_OPEN && item_list_item_count(client_info->request_list) > 0 && client_info->in_flight < client_info->pipeline_depth))
+    {
+        // Completes in process_item without the network
+        result = 0;
+        waits_on_network = false;
+    }
+    else
+    {
+        waits_on_network = client_info->state != CLIENT_STATE_NOT_CONN && (client_info->state != CLIENT_STATE_OPEN || client_info->in_flight > 0);
+    }
+
+    if ((waits_on_network && client_info->uring_conn == NULL) ||
+        (client_info->submit_ring != NULL && client_info->wait_fd < 0))
+    {
+        if (result > WAIT_POLL_INTERVAL_MS)
+        {
+            result = WAIT_POLL_INTERVAL_MS;
+        }
+    }
+
+    // Wake in time for the next deadline, process_item runs the timers
+    if (result > 0 && client_info->timer_wheel != NULL)
+    {
+        uint64_t next_expiry = http_timer_wheel_get_next_expiry(client_info->timer_wheel);
+        if (next_expiry != UINT64_MAX)
+        {
+            uint64_t now_ms = get_monotonic_ms();
+            uint64_t expiry_wait = next_expiry > now_ms ? next_expiry - now_ms : 0;
+            if (expiry_wait < (uint64_t)result)
+            {
+                result = (int)expiry_wait;
+            }
+        }
+    }
+    return result;
+}
+
+int http_client_get_wait_fd(HTTP_CLIENT_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = -1;
+    }
+    else if (handle->uring != NULL)
+    {
+        result = http_uring_get_fd(handle->uring);
+    }
+    else
+    {
+        // The socket cord keeps its socket to itself
+        result = -1;
+    }
+    return result;
+}
+
+int http_client_flush(HTTP_CLIENT_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        // Sends, opens and closes queued since the last process_item have to reach the ring before it is waited
+        // on, the ring is processed even when this client has no connection on it
+        if (handle->uring != NULL)
+        {
+            (void)http_uring_process(handle->uring);
+        }
+        result = 0;
+    }
+    return result;
+}
+
+int http_client_get_wait_time(HTTP_CLIENT_HANDLE handle, uint32_t timeout_ms)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = 0;
+    }
+    else
+    {
+        result = get_wait_time(handle, timeout_ms);
+    }
+    return result;
+}
+
+int http_client_wait(HTTP_CLIENT_HANDLE handle, uint32_t timeout_ms)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        (void)http_client_flush(handle);
+        if (wait_on_client(handle, get_wait_time(handle, timeout_ms)) != 0)
+        {
+            log_error("Failure waiting on the client");
+            result = __LINE__;
+        }
+        else
+        {
+            http_client_process_item(handle);
+            result = 0;
+        }
+    }
+    return result;
+}
 
-    if ((client_info->xio_handle = patchcord_client_create(cord_socket_get_interface(), &config, &callback_info)) == NULL)
+int http_client_set_trace(HTTP_CLIENT_HANDLE handle, bool set_trace)
+{
+    int result;
+    if (handle == NULL)
     {
-        log_error("Failure creating client connection");
         result = __LINE__;
+        log_error("Invalid argument specified handle: NULL");
     }
-    else if (patchcord_client_open(client_info->xio_handle, on_open_complete, client_info) != 0)
+    else
     {
-        log_error("Failure opening http client");
+        handle->logging_enabled = set_trace;
+        result = http_codec_set_trace(handle->codec_handle, handle->logging_enabled);
+    }
+    return result;
+}
+
+int http_client_set_pipeline_depth(HTTP_CLIENT_HANDLE handle, size_t max_depth)
+{
+    int result;
+    if (handle == NULL || max_depth == 0)
+    {
+        log_error("Invalid argument specified handle: %p, max_depth: %u", handle, (unsigned int)max_depth);
         result = __LINE__;
     }
     else
     {
+        handle->pipeline_depth = max_depth;
         result = 0;
     }
     return result;
 }
 
-HTTP_CLIENT_HANDLE http_client_create(void)
+int http_client_set_buffer_retention(HTTP_CLIENT_HANDLE handle, size_t max_retained_size)
 {
-    HTTP_CLIENT_INFO* result;
-    if ((result = (HTTP_CLIENT_INFO*)malloc(sizeof(HTTP_CLIENT_INFO))) == NULL)
+    int result;
+    if (handle == NULL)
     {
-        log_error("Failure allocating http client info");
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
     }
     else
     {
-        memset(result, 0, sizeof(HTTP_CLIENT_INFO));
-        if ((result->codec_handle = http_codec_create(on_codec_recv_callback, result)) == NULL)
-        {
-            log_error("Failure creating request list");
-            free(result);
-            result = NULL;
-        }
-        else if ((result->request_list = item_list_create(request_list_destroy_cb, NULL) ) == NULL)
-        {
-            log_error("Failure creating request list");
+        result = http_codec_set_buffer_retention(handle->codec_handle, max_retained_size);
+    }
+    return result;
+}
 
-            http_codec_destroy(result->codec_handle);
-            free(result);
-            result = NULL;
-        }
-        else if ((result->recv_callback_list = item_list_create(NULL, NULL) ) == NULL)
-        {
-            log_error("Failure creating request list");
+int http_client_set_content_decoding(HTTP_CLIENT_HANDLE handle, bool decode_content)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else if (http_codec_set_content_decoding(handle->codec_handle, decode_content) != 0)
+    {
+        log_error("Failure setting content decoding");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->accept_encoding = decode_content;
+        result = 0;
+    }
+    return result;
+}
 
-            http_codec_destroy(result->codec_handle);
-            item_list_destroy(result->request_list);
-            free(result);
-            result = NULL;
-        }
+int http_client_set_request_timing(HTTP_CLIENT_HANDLE handle, bool enable_timing)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else if (http_codec_set_message_begin_callback(handle->codec_handle, enable_timing ? on_codec_message_begin : NULL) != 0)
+    {
+        log_error("Failure setting codec message begin callback");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->request_timing = enable_timing;
+        result = 0;
     }
     return result;
 }
 
-void http_client_destroy(HTTP_CLIENT_HANDLE handle)
+int http_client_get_request_timing(HTTP_CLIENT_HANDLE handle, HTTP_REQUEST_TIMING* timing)
 {
-    if (handle != NULL)
+    int result;
+    if (handle == NULL || timing == NULL)
     {
-        patchcord_client_destroy(handle->xio_handle);
-        http_codec_destroy(handle->codec_handle);
-        item_list_destroy(handle->recv_callback_list);
-        item_list_destroy(handle->request_list);
-        free(handle);
+        log_error("Invalid argument specified handle: %p, timing: %p", handle, timing);
+        result = __LINE__;
+    }
+    else if (handle->reporting == NULL)
+    {
+        log_error("No request is being reported");
+        result = __LINE__;
+    }
+    else
+    {
+        *timing = handle->reporting->timing;
+        result = 0;
     }
+    return result;
 }
 
-int http_client_open(HTTP_CLIENT_HANDLE handle, const HTTP_ADDRESS* http_address, ON_HTTP_OPEN_COMPLETE_CALLBACK on_open_complete_cb, void* open_user_ctx, ON_HTTP_ERROR_CALLBACK on_error_cb, void* err_user_ctx)
+int http_client_set_timeouts(HTTP_CLIENT_HANDLE handle, uint32_t connect_timeout_ms, uint32_t request_timeout_ms)
 {
     int result;
-    if (handle == NULL || http_address == NULL)
+    if (handle == NULL)
     {
-        log_error("Invalid paramenter handle: %p, http_address: %p", handle, http_address);
+        log_error("Invalid argument specified handle: NULL");
         result = __LINE__;
     }
-    else if (handle->state != CLIENT_STATE_NOT_CONN)
+    else if ((connect_timeout_ms > 0 || request_timeout_ms > 0) && handle->timer_wheel == NULL &&
+        (handle->timer_wheel = http_timer_wheel_create(get_monotonic_ms(), &handle->allocator)) == NULL)
     {
-        log_error("Open attempt on a client that is not closed");
+        log_error("Failure creating timer wheel");
         result = __LINE__;
     }
-    else if (create_connection(handle, http_address) != 0)
+    else
     {
-        log_error("Failure attempting to connect to client");
+        // Applies to opens and requests from here on
+        handle->connect_timeout_ms = connect_timeout_ms;
+        handle->request_timeout_ms = request_timeout_ms;
+        result = 0;
+    }
+    return result;
+}
+
+int http_client_enable_submit_queue(HTTP_CLIENT_HANDLE handle, size_t queue_size)
+{
+    int result;
+    if (handle == NULL || queue_size == 0)
+    {
+        log_error("Invalid argument specified handle: %p, queue_size: %zu", handle, queue_size);
+        result = __LINE__;
+    }
+    else if (handle->submit_ring != NULL)
+    {
+        log_error("Submit queue is already enabled");
+        result = __LINE__;
+    }
+    else if ((handle->submit_ring = http_mpsc_ring_create(queue_size, sizeof(HTTP_SUBMIT_INFO), &handle->allocator)) == NULL)
+    {
+        log_error("Failure creating submit queue");
+        result = __LINE__;
+    }
+    else if (create_wait_event(handle) != 0)
+    {
+        log_error("Failure creating submit queue wake up event");
+        http_mpsc_ring_destroy(handle->submit_ring);
+        handle->submit_ring = NULL;
         result = __LINE__;
     }
     else
     {
-        handle->port = http_address->port;
-        handle->on_open_complete_cb = on_open_complete_cb;
-        handle->open_complete_ctx = open_user_ctx;
-        handle->on_error_cb = on_error_cb;
-        handle->err_user_ctx = err_user_ctx;
-        handle->state = CLIENT_STATE_OPENING;
         result = 0;
     }
     return result;
 }
 
-int http_client_close(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_CLOSE on_close_cb, void* user_ctx)
+int http_client_set_wake_callback(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_WAKE on_wake, void* wake_ctx)
 {
     int result;
     if (handle == NULL)
     {
-        log_error("Invalid paramenter handle is NULL");
+        log_error("Invalid argument specified handle: NULL");
         result = __LINE__;
     }
-    else if (handle->state == CLIENT_STATE_NOT_CONN)
+    else
     {
-        log_error("Close attempt on a client that is not open");
+        handle->on_wake = on_wake;
+        handle->wake_ctx = wake_ctx;
+        result = 0;
+    }
+    return result;
+}
+
+int http_client_set_ready_callback(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_WAKE on_ready, void* ready_ctx)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
         result = __LINE__;
     }
     else
     {
-        handle->on_close_cb = on_close_cb;
-        handle->close_user_ctx = user_ctx;
-        if (handle->state == CLIENT_STATE_OPEN || handle->state == CLIENT_STATE_OPENING || handle->state == CLIENT_STATE_OPENED)
+        handle->on_ready = on_ready;
+        handle->ready_ctx = ready_ctx;
+        result = 0;
+    }
+    return result;
+}
+
+// Everything that does not need the connection is done on the submitting thread
+static HTTP_REQUEST_INFO* create_submit_request(HTTP_CLIENT_INFO* handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+    HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, HTTP_SUBMIT_INFO* submit_info)
+{
+    HTTP_REQUEST_INFO* result;
+    if ((result = (HTTP_REQUEST_INFO*)http_alloc_malloc(&handle->allocator, sizeof(HTTP_REQUEST_INFO))) == NULL)
+    {
+        log_error("Failure allocating request");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_REQUEST_INFO));
+        result->request_type = request_type;
+        result->client_info = handle;
+        if (clone_string(&result->relative_path, relative_path) != 0)
         {
-            if (patchcord_client_close(handle->xio_handle, on_close_complete, handle) != 0)
-            {
-                log_error("Failure on close attempt");
-                handle->curr_result = HTTP_CLIENT_ERROR;
-                handle->state = CLIENT_STATE_ERROR;
-                result = __LINE__;
-            }
-            else
-            {
-                handle->state = CLIENT_STATE_CLOSING;
-                result = 0;
-            }
+            log_error("Failure allocating request");
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
         }
-        else
+        else if (content_length != 0 && byte_buffer_construct(&result->payload, content, content_length) != 0)
         {
-            handle->state = CLIENT_STATE_NOT_CONN;
-            result = 0;
+            log_error("Failure allocating request");
+            free(result->relative_path);
+            http_alloc_free(&handle->allocator, result);
+            result = NULL;
+        }
+        else if (http_header != NULL && append_header_fields(&handle->allocator, &result->header_line, http_header, &submit_info->has_hostname, &submit_info->has_accept_encoding) != 0)
+        {
+            log_error("Failure allocating header line");
+            request_list_destroy_cb(NULL, result);
+            result = NULL;
         }
     }
     return result;
 }
 
-int http_client_execute_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+int http_client_submit_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
     HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
 {
     int result;
-    if (handle == NULL)
+    if (handle == NULL || relative_path == NULL || on_request_callback == NULL)
     {
-        log_error("Invalid paramenter handle is NULL");
+        log_error("Invalid paramenter handle: %p, relative_path: %p, on_request_callback: %p", handle, relative_path, on_request_callback);
+        result = __LINE__;
+    }
+    else if (handle->submit_ring == NULL)
+    {
+        log_error("Submit queue is not enabled on the client");
         result = __LINE__;
     }
     else
     {
-        HTTP_RESP_INFO resp_info;
-        HTTP_REQUEST_INFO* execute_req;
-        if ((execute_req = (HTTP_REQUEST_INFO*)malloc(sizeof(HTTP_REQUEST_INFO))) == NULL)
+        HTTP_SUBMIT_INFO submit_info = {0};
+        submit_info.resp_info.on_request_cb = on_request_callback;
+        submit_info.resp_info.client_info = handle;
+        submit_info.resp_info.on_request_ctx = callback_ctx;
+        record_time(handle, &submit_info.resp_info.timing.enqueued);
+        if ((submit_info.request_info = create_submit_request(handle, request_type, relative_path, http_header, content, content_length, &submit_info)) == NULL)
         {
-            log_error("Failure allocating request");
+            log_error("Failure creating submitted request");
+            result = __LINE__;
+        }
+        else if (http_mpsc_ring_push(handle->submit_ring, &submit_info) != 0)
+        {
+            log_error("Submit queue is full");
+            request_list_destroy_cb(NULL, submit_info.request_info);
             result = __LINE__;
         }
         else
         {
-            memset(execute_req, 0, sizeof(HTTP_REQUEST_INFO));
-            uint16_t port;
-            bool create_header = false;
-            execute_req->request_type = request_type;
-            execute_req->client_info = handle;
-
-            if (http_header == NULL)
-            {
-                if ((http_header = http_header_create()) == NULL)
-                {
-                    log_error("Failure allocating request");
-                    result = __LINE__;
-                }
-                else
-                {
-                    result = 0;
-                    create_header = true;
-                }
-            }
-            else
-            {
-                result = 0;
-            }
-
-            if (result == 0)
-            {
-                resp_info.on_request_cb = on_request_callback;
-                resp_info.on_request_ctx = callback_ctx;
-                if (clone_string(&execute_req->relative_path, relative_path) != 0)
-                {
-                    log_error("Failure allocating request");
-                    free(execute_req);
-                    result = __LINE__;
-                }
-                else if (content_length != 0 && byte_buffer_construct(&execute_req->payload, content, content_length) != 0)
-                {
-                    log_error("Failure allocating request");
-                    free(execute_req->relative_path);
-                    free(execute_req);
-                    result = __LINE__;
-                }
-                else if (construct_header_line(execute_req, http_header, content_length, patchcord_client_query_endpoint(handle->xio_handle, &port), handle->port) != 0)
-                {
-                    log_error("Failure allocating header line");
-                    free(execute_req->payload.payload);
-                    free(execute_req->relative_path);
-                    free(execute_req);
-                    result = __LINE__;
-                }
-                else if (item_list_add_copy(handle->recv_callback_list, &resp_info, sizeof(HTTP_RESP_INFO) ) != 0)
-                {
-                    log_error("Failure adding to response list");
-                    free(execute_req->payload.payload);
-                    free(execute_req->header_line.payload);
-                    free(execute_req->relative_path);
-                    free(execute_req);
-                    result = __LINE__;
-                }
-                else if (item_list_add_item(handle->request_list, execute_req) != 0)
-                {
-                    log_error("Failure adding to request list");
-                    free(execute_req->payload.payload);
-                    free(execute_req->header_line.payload);
-                    free(execute_req->relative_path);
-                    size_t remove_index = item_list_item_count(handle->recv_callback_list);
-                    (void)item_list_remove_item(handle->recv_callback_list, remove_index);
-                    free(execute_req);
-                    result = __LINE__;
-                }
-                else
-                {
-                    result = 0;
-                }
-            }
-
-            if (create_header)
+            if (handle->on_wake != NULL)
             {
-                http_header_destroy(http_header);
+                handle->on_wake(handle->wake_ctx);
             }
+            signal_wait_event(handle);
+            result = 0;
         }
     }
     return result;
 }
 
-void http_client_process_item(HTTP_CLIENT_HANDLE handle)
+int http_client_set_tls_cache(HTTP_CLIENT_HANDLE handle, HTTP_TLS_CACHE_HANDLE tls_cache)
 {
-    if (handle == NULL)
+    int result;
+    if (handle == NULL || tls_cache == NULL)
     {
-        log_error("Invalid paramenter handle is NULL");
+        log_error("Invalid argument specified handle: %p, tls_cache: %p", handle, tls_cache);
+        result = __LINE__;
+    }
+    else if (http_tls_cache_add_ref(tls_cache) != 0)
+    {
+        log_error("Failure referencing tls cache");
+        result = __LINE__;
     }
     else
     {
-        patchcord_client_process_item(handle->xio_handle);
-        switch (handle->state)
+        // An open connection keeps the cache it was created with
+        if (handle->tls_cache != NULL)
         {
-            case CLIENT_STATE_OPENING:
-            case CLIENT_STATE_CLOSING:
-                break;
-            case CLIENT_STATE_OPENED:
-                if (handle->on_open_complete_cb != NULL)
-                {
-                    handle->on_open_complete_cb(handle->open_complete_ctx, HTTP_CLIENT_OK);
-                }
-                handle->state = CLIENT_STATE_OPEN;
-                break;
-            case CLIENT_STATE_OPEN:
-            {
-                const HTTP_REQUEST_INFO* execute_req;
-                while ((execute_req = item_list_get_front(handle->request_list)) != NULL)
-                {
-                    // Send the item
-                    if (send_http_request(handle, execute_req) != 0)
-                    {
-                        handle->state = CLIENT_STATE_ERROR;
-                        handle->curr_result = HTTP_CLIENT_SEND_FAILED;
-                        log_error("Failure sending http request");
-                        break;
-                    }
-                    else if (item_list_remove_item(handle->request_list, 0) != 0)
-                    {
-                        handle->state = CLIENT_STATE_ERROR;
-                        handle->curr_result = HTTP_CLIENT_ERROR;
-                        log_error("Invalid paramenter handle is NULL");
-                    }
-                }
-                break;
-            }
-            case CLIENT_STATE_CLOSED:
-                if (handle->on_close_cb != NULL)
-                {
-                    handle->on_close_cb(handle->close_user_ctx);
-                }
-                handle->state = CLIENT_STATE_NOT_CONN;
-                break;
-            case CLIENT_STATE_NOT_CONN:
-            default:
-                break;
-            case CLIENT_STATE_ERROR:
-                if (handle->on_error_cb)
-                {
-                    handle->on_error_cb(handle->err_user_ctx, handle->curr_result);
-                }
-                handle->state = CLIENT_STATE_NOT_CONN;
-                break;
+            http_tls_cache_destroy(handle->tls_cache);
         }
+        handle->tls_cache = tls_cache;
+        result = 0;
     }
+    return result;
 }
 
-int http_client_set_trace(HTTP_CLIENT_HANDLE handle, bool set_trace)
+int http_client_set_uring(HTTP_CLIENT_HANDLE handle, HTTP_URING_HANDLE uring)
 {
     int result;
-    if (handle == NULL)
+    if (handle == NULL || uring == NULL)
     {
+        log_error("Invalid argument specified handle: %p, uring: %p", handle, uring);
+        result = __LINE__;
+    }
+    else if (handle->uring_conn != NULL)
+    {
+        log_error("Invalid state the ring of a client that was opened cannot be changed");
+        result = __LINE__;
+    }
+    else if (http_uring_add_ref(uring) != 0)
+    {
+        log_error("Failure referencing uring");
         result = __LINE__;
-        log_error("Invalid argument specified handle: NULL");
     }
     else
     {
-        handle->logging_enabled = set_trace;
-        result = http_codec_set_trace(handle->codec_handle, handle->logging_enabled);
+        if (handle->uring != NULL)
+        {
+            http_uring_destroy(handle->uring);
+        }
+        handle->uring = uring;
+        result = 0;
     }
     return result;
 }
@@ -0,0 +1,823 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/crt_extensions.h"
+#include "lib-util-c/buffer_alloc.h"
+#include "lib-util-c/alarm_timer.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_client.h"
+#include "http_client/http_headers.h"
+#include "http_client/http_client_pool.h"
+#include "http_client/http_tls.h"
+#include "http_client/http_uring.h"
+
+#define DEFAULT_MAX_CONNECTIONS_PER_HOST    6
+#define DEFAULT_MAX_CONNECTIONS             64
+#define DEFAULT_IDLE_TIMEOUT_SEC            60
+#define DEFAULT_URING_QUEUE_DEPTH           256
+
+static const char* HTTP_CONNECTION_CLOSE = "close";
+
+typedef enum POOL_CONNECTION_STATE_TAG
+{
+    POOL_CONNECTION_LEASED,
+    POOL_CONNECTION_IDLE,
+    POOL_CONNECTION_CLOSED
+} POOL_CONNECTION_STATE;
+
+typedef struct POOL_REQUEST_TAG
+{
+    HTTP_CLIENT_REQUEST_TYPE request_type;
+    char* relative_path;
+    HTTP_HEADERS_HANDLE http_header;
+    BYTE_BUFFER content;
+    ON_HTTP_REQUEST_CALLBACK on_request_cb;
+    void* on_request_ctx;
+    struct POOL_REQUEST_TAG* next;
+} POOL_REQUEST;
+
+// Connections are shared by every request to the same hostname, port, scheme and socket path
+typedef struct POOL_HOST_TAG
+{
+    // NULL for a socket path address that leaves the Host header to the client
+    char* hostname;
+    uint16_t port;
+    bool is_secure;
+    char* socket_path;
+    size_t conn_count;
+
+    // Requests waiting for a connection in the order they were made
+    POOL_REQUEST* pending_head;
+    POOL_REQUEST* pending_tail;
+    struct POOL_HOST_TAG* next;
+} POOL_HOST;
+
+typedef struct POOL_CONNECTION_TAG
+{
+    struct HTTP_CLIENT_POOL_INFO_TAG* pool;
+    POOL_HOST* host;
+    HTTP_CLIENT_HANDLE client;
+    POOL_CONNECTION_STATE state;
+    bool keep_alive;
+    ALARM_TIMER_INFO idle_timer;
+
+    ON_HTTP_REQUEST_CALLBACK on_request_cb;
+    void* on_request_ctx;
+    struct POOL_CONNECTION_TAG* next;
+} POOL_CONNECTION;
+
+typedef struct HTTP_CLIENT_POOL_INFO_TAG
+{
+    HTTP_CLIENT_POOL_CONFIG config;
+    POOL_HOST* host_list;
+    POOL_CONNECTION* conn_list;
+
+    // Connections that are not closed
+    size_t conn_count;
+
+    // Created on the first secure connection unless the config has one
+    HTTP_TLS_CACHE_HANDLE tls_cache;
+
+    // Shared by every connection when use_uring is set and the system supports it
+    HTTP_URING_HANDLE uring;
+} HTTP_CLIENT_POOL_INFO;
+
+static bool is_hostname_equal(const char* host_name, const char* address_name)
+{
+    bool result;
+    // Only a socket path address goes without a hostname
+    if (host_name == NULL || address_name == NULL)
+    {
+        result = (host_name == address_name);
+    }
+    else
+    {
+        // Hostnames are not case sensitive
+        const unsigned char* left = (const unsigned char*)host_name;
+        const unsigned char* right = (const unsigned char*)address_name;
+        while (*left != '\0' && (*left == *right || (*left | 0x20) == (*right | 0x20)))
+        {
+            left++;
+            right++;
+        }
+        result = (*left == '\0' && *right == '\0');
+    }
+    return result;
+}
+
+static bool is_host_equal(const POOL_HOST* host, const HTTP_ADDRESS* http_address)
+{
+    bool result;
+    if (host->port != http_address->port || host->is_secure != http_address->is_secure)
+    {
+        result = false;
+    }
+    else if ((host->socket_path == NULL) != (http_address->socket_path == NULL) ||
+        (host->socket_path != NULL && strcmp(host->socket_path, http_address->socket_path) != 0))
+    {
+        result = false;
+    }
+    else
+    {
+        // The hostname fills the Host header on a socket path so it still separates entries
+        result = is_hostname_equal(host->hostname, http_address->hostname);
+    }
+    return result;
+}
+
+static bool is_connection_close(HTTP_HEADERS_HANDLE http_header)
+{
+    bool result = false;
+    const char* value;
+    if (http_header != NULL && (value = http_header_get_known_value(http_header, HTTP_HEADER_TOKEN_CONNECTION)) != NULL)
+    {
+        // The value is a comma separated list of tokens
+        size_t close_len = strlen(HTTP_CONNECTION_CLOSE);
+        const char* iterator = value;
+        while (*iterator != '\0' && !result)
+        {
+            while (*iterator == ' ' || *iterator == ',' || *iterator == '\t')
+            {
+                iterator++;
+            }
+            size_t token_len = 0;
+            while (iterator[token_len] != '\0' && iterator[token_len] != ',' && iterator[token_len] != ' ' && iterator[token_len] != '\t')
+            {
+                token_len++;
+            }
+            if (token_len == close_len)
+            {
+                result = true;
+                for (size_t index = 0; index < token_len; index++)
+                {
+                    if ((iterator[index] | 0x20) != HTTP_CONNECTION_CLOSE[index])
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            iterator += token_len;
+        }
+    }
+    return result;
+}
+
+static void close_connection(POOL_CONNECTION* conn)
+{
+    // The client is destroyed on the next process_item, it might be the one calling us
+    if (conn->state != POOL_CONNECTION_CLOSED)
+    {
+        conn->state = POOL_CONNECTION_CLOSED;
+        conn->host->conn_count--;
+        conn->pool->conn_count--;
+    }
+}
+
+static void on_connection_request_complete(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+    HTTP_HEADERS_HANDLE response_headers)
+{
+    POOL_CONNECTION* conn = (POOL_CONNECTION*)callback_ctx;
+    if (conn == NULL)
+    {
+        log_error("Failure invalid context in pool request callback");
+    }
+    else
+    {
+        ON_HTTP_REQUEST_CALLBACK on_request_cb = conn->on_request_cb;
+        void* on_request_ctx = conn->on_request_ctx;
+        conn->on_request_cb = NULL;
+        conn->on_request_ctx = NULL;
+
+        if (conn->state == POOL_CONNECTION_LEASED)
+        {
+            if (request_result == HTTP_CLIENT_OK && conn->keep_alive && !is_connection_close(response_headers))
+            {
+                conn->state = POOL_CONNECTION_IDLE;
+                (void)alarm_timer_start(&conn->idle_timer, conn->pool->config.idle_timeout_sec);
+            }
+            else
+            {
+                close_connection(conn);
+            }
+        }
+
+        if (on_request_cb != NULL)
+        {
+            on_request_cb(on_request_ctx, request_result, content, content_length, status_code, response_headers);
+        }
+    }
+}
+
+static void on_connection_error(void* callback_ctx, HTTP_CLIENT_RESULT error_result)
+{
+    POOL_CONNECTION* conn = (POOL_CONNECTION*)callback_ctx;
+    if (conn == NULL)
+    {
+        log_error("Failure invalid context in pool error callback");
+    }
+    else
+    {
+        ON_HTTP_REQUEST_CALLBACK on_request_cb = conn->on_request_cb;
+        void* on_request_ctx = conn->on_request_ctx;
+        conn->on_request_cb = NULL;
+        conn->on_request_ctx = NULL;
+
+        close_connection(conn);
+
+        // Fail the request that was waiting on this connection
+        if (on_request_cb != NULL)
+        {
+            on_request_cb(on_request_ctx, error_result, NULL, 0, 0, NULL);
+        }
+    }
+}
+
+static int lease_connection(POOL_CONNECTION* conn, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path, HTTP_HEADERS_HANDLE http_header,
+    const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+{
+    int result;
+    POOL_CONNECTION_STATE prev_state = conn->state;
+
+    conn->state = POOL_CONNECTION_LEASED;
+    conn->keep_alive = !is_connection_close(http_header);
+    conn->on_request_cb = on_request_callback;
+    conn->on_request_ctx = callback_ctx;
+    if (http_client_execute_request(conn->client, request_type, relative_path, http_header, content, content_length, on_connection_request_complete, conn) != 0)
+    {
+        log_error("Failure executing request on pooled connection");
+        conn->state = prev_state;
+        conn->on_request_cb = NULL;
+        conn->on_request_ctx = NULL;
+        if (prev_state == POOL_CONNECTION_IDLE)
+        {
+            (void)alarm_timer_start(&conn->idle_timer, conn->pool->config.idle_timeout_sec);
+        }
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static POOL_CONNECTION* find_idle_connection(HTTP_CLIENT_POOL_INFO* pool_info, const POOL_HOST* host)
+{
+    POOL_CONNECTION* result = NULL;
+    for (POOL_CONNECTION* conn = pool_info->conn_list; conn != NULL; conn = conn->next)
+    {
+        if (conn->host == host && conn->state == POOL_CONNECTION_IDLE)
+        {
+            result = conn;
+            break;
+        }
+    }
+    return result;
+}
+
+static bool can_open_connection(HTTP_CLIENT_POOL_INFO* pool_info, const POOL_HOST* host)
+{
+    bool result;
+    if (host->conn_count >= pool_info->config.max_connections_per_host)
+    {
+        result = false;
+    }
+    else if (pool_info->conn_count < pool_info->config.max_connections)
+    {
+        result = true;
+    }
+    else
+    {
+        // At the global limit, make room by dropping an idle connection to another host
+        result = false;
+        for (POOL_CONNECTION* conn = pool_info->conn_list; conn != NULL; conn = conn->next)
+        {
+            if (conn->state == POOL_CONNECTION_IDLE)
+            {
+                close_connection(conn);
+                result = true;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+static int set_connection_tls_cache(HTTP_CLIENT_POOL_INFO* pool_info, HTTP_CLIENT_HANDLE client)
+{
+    int result;
+    if (pool_info->tls_cache == NULL && (pool_info->tls_cache = http_tls_cache_create(NULL)) == NULL)
+    {
+        log_error("Failure creating tls cache");
+        result = __LINE__;
+    }
+    else if (http_client_set_tls_cache(client, pool_info->tls_cache) != 0)
+    {
+        log_error("Failure setting tls cache");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static POOL_CONNECTION* open_connection(HTTP_CLIENT_POOL_INFO* pool_info, POOL_HOST* host)
+{
+    POOL_CONNECTION* result;
+    if ((result = (POOL_CONNECTION*)http_alloc_malloc(NULL, sizeof(POOL_CONNECTION))) == NULL)
+    {
+        log_error("Failure allocating pool connection");
+    }
+    else
+    {
+        HTTP_ADDRESS http_address;
+        http_address.hostname = host->hostname;
+        http_address.port = host->port;
+        http_address.is_secure = host->is_secure;
+        http_address.socket_path = host->socket_path;
+
+        memset(result, 0, sizeof(POOL_CONNECTION));
+        result->pool = pool_info;
+        result->host = host;
+        result->state = POOL_CONNECTION_IDLE;
+        if ((result->client = http_client_create()) == NULL)
+        {
+            log_error("Failure creating pool connection");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (host->is_secure && set_connection_tls_cache(pool_info, result->client) != 0)
+        {
+            http_client_destroy(result->client);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (pool_info->uring != NULL && http_client_set_uring(result->client, pool_info->uring) != 0)
+        {
+            log_error("Failure setting uring");
+            http_client_destroy(result->client);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (alarm_timer_init(&result->idle_timer) != 0)
+        {
+            log_error("Failure initializing idle timer");
+            http_client_destroy(result->client);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (http_client_open(result->client, &http_address, NULL, NULL, on_connection_error, result) != 0)
+        {
+            log_error("Failure opening pool connection");
+            http_client_destroy(result->client);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            result->next = pool_info->conn_list;
+            pool_info->conn_list = result;
+            host->conn_count++;
+            pool_info->conn_count++;
+        }
+    }
+    return result;
+}
+
+static POOL_HOST* find_host(HTTP_CLIENT_POOL_INFO* pool_info, const HTTP_ADDRESS* http_address)
+{
+    POOL_HOST* result = NULL;
+    for (POOL_HOST* host = pool_info->host_list; host != NULL; host = host->next)
+    {
+        if (is_host_equal(host, http_address))
+        {
+            result = host;
+            break;
+        }
+    }
+    return result;
+}
+
+static void destroy_host(POOL_HOST* host)
+{
+    if (host->socket_path != NULL)
+    {
+        free(host->socket_path);
+    }
+    if (host->hostname != NULL)
+    {
+        free(host->hostname);
+    }
+    http_alloc_free(NULL, host);
+}
+
+static POOL_HOST* create_host(HTTP_CLIENT_POOL_INFO* pool_info, const HTTP_ADDRESS* http_address)
+{
+    POOL_HOST* result;
+    if ((result = (POOL_HOST*)http_alloc_malloc(NULL, sizeof(POOL_HOST))) == NULL)
+    {
+        log_error("Failure allocating pool host");
+    }
+    else
+    {
+        memset(result, 0, sizeof(POOL_HOST));
+        if (http_address->hostname != NULL && clone_string(&result->hostname, http_address->hostname) != 0)
+        {
+            log_error("Failure allocating pool hostname");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (http_address->socket_path != NULL && clone_string(&result->socket_path, http_address->socket_path) != 0)
+        {
+            log_error("Failure allocating pool socket path");
+            if (result->hostname != NULL)
+            {
+                free(result->hostname);
+            }
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            result->port = http_address->port;
+            result->is_secure = http_address->is_secure;
+            result->next = pool_info->host_list;
+            pool_info->host_list = result;
+        }
+    }
+    return result;
+}
+
+static HTTP_HEADERS_HANDLE copy_headers(HTTP_HEADERS_HANDLE http_header)
+{
+    HTTP_HEADERS_HANDLE result;
+    if ((result = http_header_create()) == NULL)
+    {
+        log_error("Failure creating pending request header");
+    }
+    else
+    {
+        size_t header_count = http_header_get_count(http_header);
+        for (size_t index = 0; index < header_count; index++)
+        {
+            const char* name;
+            const char* value;
+            if (http_header_get_name_value_pair(http_header, index, &name, &value) != 0 ||
+                http_header_add(result, name, value) != 0)
+            {
+                log_error("Failure copying pending request header");
+                http_header_destroy(result);
+                result = NULL;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+static void destroy_pending_request(POOL_REQUEST* request)
+{
+    if (request->http_header != NULL)
+    {
+        http_header_destroy(request->http_header);
+    }
+    free(request->content.payload);
+    free(request->relative_path);
+    http_alloc_free(NULL, request);
+}
+
+static int queue_pending_request(POOL_HOST* host, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path, HTTP_HEADERS_HANDLE http_header,
+    const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+{
+    int result;
+    POOL_REQUEST* request;
+    if ((request = (POOL_REQUEST*)http_alloc_malloc(NULL, sizeof(POOL_REQUEST))) == NULL)
+    {
+        log_error("Failure allocating pending request");
+        result = __LINE__;
+    }
+    else
+    {
+        memset(request, 0, sizeof(POOL_REQUEST));
+        request->request_type = request_type;
+        request->on_request_cb = on_request_callback;
+        request->on_request_ctx = callback_ctx;
+
+        // The caller owns everything passed in, keep copies until a connection frees up
+        if (clone_string(&request->relative_path, relative_path) != 0)
+        {
+            log_error("Failure allocating pending request path");
+            http_alloc_free(NULL, request);
+            result = __LINE__;
+        }
+        else if (content_length != 0 && byte_buffer_construct(&request->content, content, content_length) != 0)
+        {
+            log_error("Failure allocating pending request content");
+            free(request->relative_path);
+            http_alloc_free(NULL, request);
+            result = __LINE__;
+        }
+        else if (http_header != NULL && (request->http_header = copy_headers(http_header)) == NULL)
+        {
+            log_error("Failure allocating pending request header");
+            free(request->content.payload);
+            free(request->relative_path);
+            http_alloc_free(NULL, request);
+            result = __LINE__;
+        }
+        else
+        {
+            if (host->pending_tail == NULL)
+            {
+                host->pending_head = request;
+            }
+            else
+            {
+                host->pending_tail->next = request;
+            }
+            host->pending_tail = request;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static POOL_CONNECTION* acquire_connection(HTTP_CLIENT_POOL_INFO* pool_info, POOL_HOST* host)
+{
+    POOL_CONNECTION* result;
+    if ((result = find_idle_connection(pool_info, host)) == NULL && can_open_connection(pool_info, host))
+    {
+        result = open_connection(pool_info, host);
+    }
+    return result;
+}
+
+static void dispatch_pending_requests(HTTP_CLIENT_POOL_INFO* pool_info)
+{
+    for (POOL_HOST* host = pool_info->host_list; host != NULL; host = host->next)
+    {
+        while (host->pending_head != NULL)
+        {
+            POOL_REQUEST* request = host->pending_head;
+            POOL_CONNECTION* conn;
+            if ((conn = acquire_connection(pool_info, host)) == NULL)
+            {
+                break;
+            }
+
+            host->pending_head = request->next;
+            if (host->pending_head == NULL)
+            {
+                host->pending_tail = NULL;
+            }
+
+            if (lease_connection(conn, request->request_type, request->relative_path, request->http_header, request->content.payload,
+                request->content.payload_size, request->on_request_cb, request->on_request_ctx) != 0)
+            {
+                log_error("Failure dispatching pending request");
+                request->on_request_cb(request->on_request_ctx, HTTP_CLIENT_ERROR, NULL, 0, 0, NULL);
+            }
+            destroy_pending_request(request);
+        }
+    }
+}
+
+static void sweep_closed_connections(HTTP_CLIENT_POOL_INFO* pool_info)
+{
+    POOL_CONNECTION** iterator = &pool_info->conn_list;
+    while (*iterator != NULL)
+    {
+        POOL_CONNECTION* conn = *iterator;
+        if (conn->state == POOL_CONNECTION_IDLE && alarm_timer_is_expired(&conn->idle_timer))
+        {
+            close_connection(conn);
+        }
+
+        if (conn->state == POOL_CONNECTION_CLOSED)
+        {
+            *iterator = conn->next;
+            http_client_destroy(conn->client);
+            http_alloc_free(NULL, conn);
+        }
+        else
+        {
+            iterator = &conn->next;
+        }
+    }
+
+    // Forget hosts that have nothing left
+    POOL_HOST** host_iterator = &pool_info->host_list;
+    while (*host_iterator != NULL)
+    {
+        POOL_HOST* host = *host_iterator;
+        if (host->conn_count == 0 && host->pending_head == NULL)
+        {
+            *host_iterator = host->next;
+            destroy_host(host);
+        }
+        else
+        {
+            host_iterator = &host->next;
+        }
+    }
+}
+
+HTTP_CLIENT_POOL_HANDLE http_client_pool_create(const HTTP_CLIENT_POOL_CONFIG* config)
+{
+    HTTP_CLIENT_POOL_INFO* result;
+    if ((result = (HTTP_CLIENT_POOL_INFO*)http_alloc_malloc(NULL, sizeof(HTTP_CLIENT_POOL_INFO))) == NULL)
+    {
+        log_error("Failure allocating http client pool");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_CLIENT_POOL_INFO));
+        if (config != NULL)
+        {
+            result->config = *config;
+        }
+        if (result->config.max_connections_per_host == 0)
+        {
+            result->config.max_connections_per_host = DEFAULT_MAX_CONNECTIONS_PER_HOST;
+        }
+        if (result->config.max_connections == 0)
+        {
+            result->config.max_connections = DEFAULT_MAX_CONNECTIONS;
+        }
+        if (result->config.idle_timeout_sec == 0)
+        {
+            result->config.idle_timeout_sec = DEFAULT_IDLE_TIMEOUT_SEC;
+        }
+        if (result->config.tls_cache != NULL && http_tls_cache_add_ref(result->config.tls_cache) != 0)
+        {
+            log_error("Failure referencing tls cache");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            result->tls_cache = result->config.tls_cache;
+            // Without io_uring the connections stay on the socket cord
+            if (result->config.use_uring && http_uring_is_available() &&
+                (result->uring = http_uring_create(DEFAULT_URING_QUEUE_DEPTH, NULL)) == NULL)
+            {
+                log_error("Failure creating uring, connections use the socket cord");
+            }
+        }
+    }
+    return result;
+}
+
+void http_client_pool_destroy(HTTP_CLIENT_POOL_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        POOL_CONNECTION* conn = handle->conn_list;
+        while (conn != NULL)
+        {
+            POOL_CONNECTION* next = conn->next;
+            http_client_destroy(conn->client);
+            http_alloc_free(NULL, conn);
+            conn = next;
+        }
+
+        POOL_HOST* host = handle->host_list;
+        while (host != NULL)
+        {
+            POOL_HOST* next = host->next;
+            POOL_REQUEST* request = host->pending_head;
+            while (request != NULL)
+            {
+                POOL_REQUEST* next_request = request->next;
+                destroy_pending_request(request);
+                request = next_request;
+            }
+            destroy_host(host);
+            host = next;
+        }
+        if (handle->tls_cache != NULL)
+        {
+            http_tls_cache_destroy(handle->tls_cache);
+        }
+        if (handle->uring != NULL)
+        {
+            http_uring_destroy(handle->uring);
+        }
+        http_alloc_free(NULL, handle);
+    }
+}
+
+int http_client_pool_execute_request(HTTP_CLIENT_POOL_HANDLE handle, const HTTP_ADDRESS* http_address, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+    HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+{
+    int result;
+    // A socket path address may leave the hostname NULL, the client then fills in a default Host
+    if (handle == NULL || http_address == NULL || (http_address->hostname == NULL && http_address->socket_path == NULL) || relative_path == NULL || on_request_callback == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, http_address: %p, relative_path: %p, on_request_callback: %p", handle, http_address, relative_path, on_request_callback);
+        result = __LINE__;
+    }
+    else
+    {
+        POOL_HOST* host;
+        POOL_CONNECTION* conn;
+        if ((host = find_host(handle, http_address)) == NULL && (host = create_host(handle, http_address)) == NULL)
+        {
+            log_error("Failure creating pool host");
+            result = __LINE__;
+        }
+        // Earlier requests to this host go first
+        else if (host->pending_head == NULL && (conn = find_idle_connection(handle, host)) != NULL)
+        {
+            result = lease_connection(conn, request_type, relative_path, http_header, content, content_length, on_request_callback, callback_ctx);
+        }
+        else if (host->pending_head == NULL && can_open_connection(handle, host))
+        {
+            if ((conn = open_connection(handle, host)) == NULL)
+            {
+                log_error("Failure opening connection to %s:%d", http_address->socket_path != NULL ? http_address->socket_path : http_address->hostname, (int)http_address->port);
+                result = __LINE__;
+            }
+            else
+            {
+                result = lease_connection(conn, request_type, relative_path, http_header, content, content_length, on_request_callback, callback_ctx);
+            }
+        }
+        else
+        {
+            result = queue_pending_request(host, request_type, relative_path, http_header, content, content_length, on_request_callback, callback_ctx);
+        }
+    }
+    return result;
+}
+
+void http_client_pool_process_item(HTTP_CLIENT_POOL_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle is NULL");
+    }
+    else
+    {
+        for (POOL_CONNECTION* conn = handle->conn_list; conn != NULL; conn = conn->next)
+        {
+            if (conn->state != POOL_CONNECTION_CLOSED)
+            {
+                http_client_process_item(conn->client);
+            }
+        }
+        // The sends the connections queued go to the kernel together
+        if (handle->uring != NULL)
+        {
+            (void)http_uring_process(handle->uring);
+        }
+        sweep_closed_connections(handle);
+        dispatch_pending_requests(handle);
+    }
+}
+
+size_t http_client_pool_get_connection_count(HTTP_CLIENT_POOL_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle is NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->conn_count;
+    }
+    return result;
+}
+
+size_t http_client_pool_get_idle_count(HTTP_CLIENT_POOL_HANDLE handle)
+{
+    size_t result = 0;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle is NULL");
+    }
+    else
+    {
+        for (POOL_CONNECTION* conn = handle->conn_list; conn != NULL; conn = conn->next)
+        {
+            if (conn->state == POOL_CONNECTION_IDLE)
+            {
+                result++;
+            }
+        }
+    }
+    return result;
+}
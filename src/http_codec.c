@@ -3,7 +3,6 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdbool.h>
-#include <ctype.h>
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/app_logging.h"
@@ -12,16 +11,24 @@
 
 #include "patchcords/patchcord_client.h"
 
+#include "http_client/http_alloc.h"
 #include "http_client/http_headers.h"
+#include "http_client/http_header_token.h"
 #include "http_client/http_codec.h"
+#include "http_client/http_scan.h"
+#include "http_client/http_content_decoder.h"
 
-static const char* HTTP_TRANSFER_ENCODING = "transfer-encoding";
-static const char* HTTP_CONTENT_LEN = "content-length";
-#define HTTP_CONTENT_LENGTH_LEN     14
-#define HTTP_TRANSFER_ENCODING_LEN  17
-#define HTTP_END_TOKEN_LEN          4
 #define HTTP_CRLF_LEN               2
 
+// Receive storage up to this size is kept for the next response on the connection
+#define DEFAULT_MAX_RETAINED_SIZE   (64 * 1024)
+
+// Bytes the status and header parsers act on, everything between them is skipped by the scanner
+static const HTTP_SCAN_SET STATUS_LINE_DELIMS = { { ' ', '\n' }, 2 };
+static const HTTP_SCAN_SET HEADER_KEY_DELIMS = { { ':', '\r', '\n' }, 3 };
+static const HTTP_SCAN_SET HEADER_VALUE_DELIMS = { { '\r', '\n' }, 2 };
+static const HTTP_SCAN_SET CHUNK_LINE_DELIMS = { { '\n' }, 1 };
+
 typedef enum RESPONSE_MESSAGE_STATE_TAG
 {
     state_initial,
@@ -40,6 +47,14 @@ typedef enum RESPONSE_MESSAGE_STATE_TAG
     state_error
 } RESPONSE_MESSAGE_STATE;
 
+typedef enum CHUNK_STATE_TAG
+{
+    chunk_state_size_line,
+    chunk_state_data,
+    chunk_state_data_end,
+    chunk_state_trailer
+} CHUNK_STATE;
+
 typedef enum PARSE_RESULT_TAG
 {
     result_success,
@@ -50,6 +65,9 @@ typedef enum PARSE_RESULT_TAG
 typedef struct HTTP_INCOMING_DATA_TAG
 {
     // Parse Data
+    // recv_msg holds every byte of the current message and is never compacted,
+    // buffer_offset is the position of the first unparsed byte in recv_msg and
+    // buffer_length is the number of unparsed bytes that follow it
     BYTE_BUFFER recv_msg;
     size_t buffer_length;
     size_t buffer_offset;
@@ -59,62 +77,47 @@ typedef struct HTTP_INCOMING_DATA_TAG
     HTTP_HEADERS_HANDLE recv_header;
     uint32_t status_code;
     bool is_chunked;
+    bool headers_complete;
+
+    // Streaming the body hands each fragment to the user as soon as it
+    // is parsed and lets the receive storage be reused for the next read
+    bool is_streaming;
+
+    // A chunked body is decoded in place, the data of each chunk is moved down
+    // over the chunk size lines so the body ends up contiguous at content_offset
+    // in recv_msg with content_info.payload_size bytes decoded so far
+    CHUNK_STATE chunk_state;
+    size_t chunk_remaining;
+    size_t content_offset;
+
+    // The body carries a Content-Encoding that is decoded before it reaches the user
+    bool is_encoded;
+    bool decode_failed;
 } HTTP_INCOMING_DATA;
 
 typedef struct HTTP_CODEC_INFO_TAG
 {
+    HTTP_ALLOCATOR allocator;
+
     ON_HTTP_DATA_CALLBACK data_callback;
+    ON_HTTP_HEADERS_CALLBACK headers_callback;
+    ON_HTTP_BODY_FRAGMENT_CALLBACK body_fragment_callback;
+    ON_HTTP_MESSAGE_BEGIN_CALLBACK message_begin_callback;
     void* user_ctx;
 
     bool trace_on;
+    size_t max_retained_size;
+
+    // Decoding of gzip and deflate bodies, the decoder and the storage of the
+    // decoded content are kept for the next response on the connection
+    bool decode_content;
+    HTTP_CONTENT_DECODER_HANDLE decoder;
+    BYTE_BUFFER decoded_content;
 
     RESPONSE_MESSAGE_STATE recv_state;
     HTTP_INCOMING_DATA recv_data;
 } HTTP_CODEC_INFO;
 
-static void reduce_wasted_space(BYTE_BUFFER* recv_msg, size_t reduce_offset)
-{
-    for (size_t index = 0; index < recv_msg->payload_size; index++)
-    {
-        if (index < recv_msg->payload_size-reduce_offset)
-        {
-            recv_msg->payload[index] = recv_msg->payload[reduce_offset+index];
-        }
-        else
-        {
-            break;
-            //recv_msg->payload[index] = '\0';
-        }
-    }
-    recv_msg->payload_size -= reduce_offset;
-}
-
-static int string_compare_no_case(const char* str1, size_t str1_len, const char* str2, size_t str2_len)
-{
-    int result = 0;
-    if (str1 != NULL && str2 == NULL)
-    {
-        result = 1;
-    }
-    else if (str1 == NULL && str2 != NULL)
-    {
-        result = -1;
-    }
-    else
-    {
-        size_t min_len = str1_len < str2_len ? str1_len : str2_len;
-        for (size_t index = 0; index < min_len; index++)
-        {
-            result = tolower(*(str1+index)) - tolower(*(str2+index));
-            if (result != 0)
-            {
-                break;
-            }
-        }
-    }
-    return result;
-}
-
 static int convert_char_to_hex(const unsigned char* hexText, size_t len)
 {
     int result = 0;
@@ -152,12 +155,33 @@ static int convert_char_to_hex(const unsigned char* hexText, size_t len)
     return result;
 }
 
-static int initialize_received_data(HTTP_INCOMING_DATA* recv_data, const unsigned char* buffer, size_t length)
+// Returns the length of the trailer section that follows the last chunk, including
+// the empty line that ends it, or 0 if the empty line has not been received yet
+static size_t get_trailer_length(const unsigned char* content_data, size_t content_len)
+{
+    size_t result = 0;
+    size_t line_start = 0;
+    for (size_t index = 0; index < content_len; index++)
+    {
+        if (content_data[index] == '\n')
+        {
+            if (index == line_start || (index == line_start + 1 && content_data[line_start] == '\r'))
+            {
+                result = index + 1;
+                break;
+            }
+            line_start = index + 1;
+        }
+    }
+    return result;
+}
+
+static int initialize_received_data(HTTP_INCOMING_DATA* recv_data, const HTTP_ALLOCATOR* allocator, const unsigned char* buffer, size_t length)
 {
     int result;
     if (recv_data->recv_header == NULL)
     {
-        if ((recv_data->recv_header = http_header_create()) == NULL)
+        if ((recv_data->recv_header = http_header_create_with_allocator(allocator)) == NULL)
         {
             log_error("Failure allocating http receive header");
             result = __LINE__;
@@ -175,12 +199,8 @@ static int initialize_received_data(HTTP_INCOMING_DATA* recv_data, const unsigne
 
     if (result == 0)
     {
-        if (recv_data->recv_msg.payload != NULL)
-        {
-            free(recv_data->recv_msg.payload);
-            memset(&recv_data->recv_msg, 0, sizeof(BYTE_BUFFER));
-        }
-
+        // Storage kept from the previous response is filled from the start
+        recv_data->recv_msg.payload_size = 0;
         if (byte_buffer_construct(&recv_data->recv_msg, buffer, length) != 0)
         {
             log_error("Failure allocating recieve message buffer");
@@ -192,6 +212,9 @@ static int initialize_received_data(HTTP_INCOMING_DATA* recv_data, const unsigne
             recv_data->content_info.payload = NULL;
             recv_data->content_info.payload_size = 0;
             recv_data->buffer_length = length;
+            recv_data->chunk_state = chunk_state_size_line;
+            recv_data->chunk_remaining = 0;
+            recv_data->content_offset = 0;
             result = 0;
         }
     }
@@ -204,9 +227,15 @@ static PARSE_RESULT process_status_code_line(const unsigned char* content_data,
     int space_found = 0;
     char temp_status_code[4];
     const char* initial_space = NULL;
-    for (size_t index = 0; index < content_len; index++)
+    size_t index = 0;
+    while (index < content_len)
     {
-        if (content_data[index] == ' ')
+        index += http_scan_find(&STATUS_LINE_DELIMS, content_data+index, content_len-index);
+        if (index == content_len)
+        {
+            break;
+        }
+        else if (content_data[index] == ' ')
         {
             if (space_found == 1)
             {
@@ -224,17 +253,13 @@ static PARSE_RESULT process_status_code_line(const unsigned char* content_data,
         {
             /* code */
             *status_code = (uint32_t)atol(initial_space);
-            if (index < content_len)
-            {
-                *position = index+1;
-            }
-            else
-            {
-                *position = index;
-            }
+            // Leave the \n for the header parser so a response without
+            // headers is seen as an empty line right after the status line
+            *position = index;
             result = result_complete;
             break;
         }
+        index++;
     }
     return result;
 }
@@ -250,9 +275,22 @@ static PARSE_RESULT process_header_line(HTTP_HEADERS_HANDLE recv_header, const u
     size_t header_key_len = 0;
     const unsigned char* target_pos = content_data;
 
-    for (size_t index = 0; index < content_len && continue_processing; index++)
+    size_t index = 0;
+    while (index < content_len && continue_processing)
     {
-        if (content_data[index] == ':' && !colon_encountered)
+        // Once the key is known a colon is part of the value
+        size_t skipped = http_scan_find(colon_encountered ? &HEADER_VALUE_DELIMS : &HEADER_KEY_DELIMS, content_data+index, content_len-index);
+        if (skipped > 0)
+        {
+            crlf_encounted = false;
+            index += skipped;
+        }
+
+        if (index == content_len)
+        {
+            break;
+        }
+        else if (content_data[index] == ':' && !colon_encountered)
         {
             colon_encountered = true;
             size_t key_len = (&content_data[index])-target_pos;
@@ -282,15 +320,18 @@ static PARSE_RESULT process_header_line(HTTP_HEADERS_HANDLE recv_header, const u
                 }
                 else
                 {
-                    if (string_compare_no_case(header_key, header_key_len, HTTP_CONTENT_LEN, HTTP_CONTENT_LENGTH_LEN) == 0)
-                    {
-                        *is_chunked = false;
-                        *content_header_len = atol(header_value);
-                    }
-                    else if (string_compare_no_case(header_key, header_key_len, HTTP_TRANSFER_ENCODING, HTTP_TRANSFER_ENCODING_LEN) == 0)
+                    switch (http_header_token_lookup(header_key, header_key_len))
                     {
-                        *is_chunked = true;
-                        *content_header_len = 0;
+                        case HTTP_HEADER_TOKEN_CONTENT_LENGTH:
+                            *is_chunked = false;
+                            *content_header_len = atol(header_value);
+                            break;
+                        case HTTP_HEADER_TOKEN_TRANSFER_ENCODING:
+                            *is_chunked = true;
+                            *content_header_len = 0;
+                            break;
+                        default:
+                            break;
                     }
                     if (index < content_len)
                     {
@@ -326,30 +367,295 @@ static PARSE_RESULT process_header_line(HTTP_HEADERS_HANDLE recv_header, const u
                 target_pos = content_data+index+1;
             }
         }
-        else
+        index++;
+    }
+    return result;
+}
+
+static void reset_received_data(HTTP_CODEC_INFO* codec_info)
+{
+    // The header set and the receive storage are kept for the next response,
+    // unless a large response grew the storage past the retained size
+    HTTP_HEADERS_HANDLE recv_header = codec_info->recv_data.recv_header;
+    BYTE_BUFFER recv_msg = codec_info->recv_data.recv_msg;
+    if (recv_msg.alloc_size > codec_info->max_retained_size)
+    {
+        free(recv_msg.payload);
+        memset(&recv_msg, 0, sizeof(BYTE_BUFFER));
+    }
+    recv_msg.payload_size = 0;
+    recv_msg.default_alloc = 0;
+
+    memset(&codec_info->recv_data, 0, sizeof(HTTP_INCOMING_DATA));
+    codec_info->recv_data.recv_header = recv_header;
+    codec_info->recv_data.recv_msg = recv_msg;
+
+    if (codec_info->decoded_content.alloc_size > codec_info->max_retained_size)
+    {
+        free(codec_info->decoded_content.payload);
+        memset(&codec_info->decoded_content, 0, sizeof(BYTE_BUFFER));
+    }
+}
+
+static int start_content_decoding(HTTP_CODEC_INFO* codec_info)
+{
+    int result = 0;
+    if (codec_info->decode_content)
+    {
+        // Identity and encodings that can not be decoded are handed over as received
+        HTTP_CONTENT_ENCODING encoding = http_content_decoder_get_encoding(http_header_get_known_value(codec_info->recv_data.recv_header, HTTP_HEADER_TOKEN_CONTENT_ENCODING));
+        if (encoding == HTTP_CONTENT_ENCODING_GZIP || encoding == HTTP_CONTENT_ENCODING_DEFLATE)
         {
-            crlf_encounted = false;
+            if (codec_info->decoder == NULL)
+            {
+                if ((codec_info->decoder = http_content_decoder_create(encoding)) == NULL)
+                {
+                    log_error("Failure creating content decoder");
+                    result = __LINE__;
+                }
+            }
+            else if (http_content_decoder_reset(codec_info->decoder, encoding) != 0)
+            {
+                log_error("Failure resetting content decoder");
+                result = __LINE__;
+            }
+
+            if (result == 0)
+            {
+                codec_info->recv_data.is_encoded = true;
+            }
         }
     }
     return result;
 }
 
-static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_t length)
+static void on_decoded_fragment(void* user_ctx, const unsigned char* decoded, size_t decoded_len)
 {
-    HTTP_CODEC_INFO* codec_info = (HTTP_CODEC_INFO*)context;
-    if (codec_info != NULL && buffer != NULL && length > 0 && codec_info->recv_state != state_error)
+    HTTP_CODEC_INFO* codec_info = (HTTP_CODEC_INFO*)user_ctx;
+    codec_info->body_fragment_callback(codec_info->user_ctx, decoded, decoded_len);
+}
+
+static void on_decoded_content(void* user_ctx, const unsigned char* decoded, size_t decoded_len)
+{
+    HTTP_CODEC_INFO* codec_info = (HTTP_CODEC_INFO*)user_ctx;
+    if (!codec_info->recv_data.decode_failed && byte_buffer_construct(&codec_info->decoded_content, decoded, decoded_len) != 0)
+    {
+        log_error("Failure allocating decoded content buffer");
+        codec_info->recv_data.decode_failed = true;
+    }
+}
+
+// Streamed bodies are decoded fragment by fragment as they arrive
+static void deliver_body_fragment(HTTP_CODEC_INFO* codec_info, const unsigned char* fragment, size_t fragment_len)
+{
+    if (!codec_info->recv_data.is_encoded)
+    {
+        codec_info->body_fragment_callback(codec_info->user_ctx, fragment, fragment_len);
+    }
+    else if (!codec_info->recv_data.decode_failed && http_content_decoder_decode(codec_info->decoder, fragment, fragment_len, on_decoded_fragment, codec_info) != 0)
+    {
+        log_error("Failure decoding body fragment");
+        codec_info->recv_data.decode_failed = true;
+    }
+}
+
+// A buffered body is decoded once it is complete, the decoded content replaces it
+static void decode_buffered_content(HTTP_CODEC_INFO* codec_info)
+{
+    HTTP_INCOMING_DATA* recv_data = &codec_info->recv_data;
+    codec_info->decoded_content.payload_size = 0;
+    if (http_content_decoder_decode(codec_info->decoder, recv_data->content_info.payload, recv_data->content_info.payload_size, on_decoded_content, codec_info) != 0)
+    {
+        log_error("Failure decoding body");
+        recv_data->decode_failed = true;
+    }
+    else if (!recv_data->decode_failed)
+    {
+        recv_data->content_info.payload = codec_info->decoded_content.payload;
+        recv_data->content_info.payload_size = codec_info->decoded_content.payload_size;
+    }
+}
+
+static void notify_headers_complete(HTTP_CODEC_INFO* codec_info)
+{
+    if (!codec_info->recv_data.headers_complete)
+    {
+        codec_info->recv_data.headers_complete = true;
+        if (codec_info->headers_callback != NULL && codec_info->body_fragment_callback != NULL)
+        {
+            HTTP_RECV_DATA http_recv_data = {0};
+            http_recv_data.recv_header = codec_info->recv_data.recv_header;
+            http_recv_data.status_code = codec_info->recv_data.status_code;
+            codec_info->recv_data.is_streaming = codec_info->headers_callback(codec_info->user_ctx, &http_recv_data);
+        }
+    }
+}
+
+static void release_streamed_data(HTTP_INCOMING_DATA* recv_data, size_t consumed)
+{
+    recv_data->buffer_offset += consumed;
+    recv_data->buffer_length -= consumed;
+    if (recv_data->buffer_length == 0)
+    {
+        // Everything received so far belongs to the user, start filling the
+        // storage from the beginning again
+        recv_data->recv_msg.payload_size = 0;
+        recv_data->buffer_offset = 0;
+    }
+}
+
+static void consume_chunked_data(HTTP_INCOMING_DATA* recv_data, size_t consumed)
+{
+    if (recv_data->is_streaming)
+    {
+        release_streamed_data(recv_data, consumed);
+    }
+    else
+    {
+        recv_data->buffer_offset += consumed;
+        recv_data->buffer_length -= consumed;
+    }
+}
+
+// Decodes as much of a chunked body as has been received. The parse resumes
+// where it stopped on the previous read, a size line or trailer that is not
+// complete yet is left in place until the rest of it arrives
+static void process_chunked_body(HTTP_CODEC_INFO* codec_info)
+{
+    HTTP_INCOMING_DATA* recv_data = &codec_info->recv_data;
+    bool need_more_data = false;
+
+    while (!need_more_data && codec_info->recv_state == state_process_chunked_body)
+    {
+        unsigned char* parse_pos = recv_data->recv_msg.payload + recv_data->buffer_offset;
+        if (recv_data->buffer_length == 0)
+        {
+            need_more_data = true;
+        }
+        else if (recv_data->chunk_state == chunk_state_size_line)
+        {
+            size_t line_len = http_scan_find(&CHUNK_LINE_DELIMS, parse_pos, recv_data->buffer_length);
+            if (line_len == recv_data->buffer_length)
+            {
+                need_more_data = true;
+            }
+            else
+            {
+                size_t hex_len = line_len;
+                if (hex_len > 0 && parse_pos[hex_len - 1] == '\r')
+                {
+                    hex_len--;
+                }
+                recv_data->chunk_remaining = (size_t)convert_char_to_hex(parse_pos, hex_len);
+                // The last chunk has a size of 0 and is followed by the trailer
+                recv_data->chunk_state = recv_data->chunk_remaining == 0 ? chunk_state_trailer : chunk_state_data;
+                consume_chunked_data(recv_data, line_len + 1);
+            }
+        }
+        else if (recv_data->chunk_state == chunk_state_data)
+        {
+            size_t data_len = recv_data->buffer_length < recv_data->chunk_remaining ? recv_data->buffer_length : recv_data->chunk_remaining;
+            if (recv_data->is_streaming)
+            {
+                deliver_body_fragment(codec_info, parse_pos, data_len);
+            }
+            else
+            {
+                unsigned char* content_end = recv_data->recv_msg.payload + recv_data->content_offset + recv_data->content_info.payload_size;
+                if (content_end != parse_pos)
+                {
+                    memmove(content_end, parse_pos, data_len);
+                }
+                recv_data->content_info.payload_size += data_len;
+            }
+            recv_data->chunk_remaining -= data_len;
+            if (recv_data->chunk_remaining == 0)
+            {
+                recv_data->chunk_state = chunk_state_data_end;
+            }
+            consume_chunked_data(recv_data, data_len);
+        }
+        else if (recv_data->chunk_state == chunk_state_data_end)
+        {
+            // Skip the CRLF that closes the chunk data
+            if (*parse_pos == '\n')
+            {
+                recv_data->chunk_state = chunk_state_size_line;
+            }
+            consume_chunked_data(recv_data, 1);
+        }
+        else
+        {
+            size_t trailer_len = get_trailer_length(parse_pos, recv_data->buffer_length);
+            if (trailer_len == 0)
+            {
+                need_more_data = true;
+            }
+            else
+            {
+                consume_chunked_data(recv_data, trailer_len);
+                if (!recv_data->is_streaming && recv_data->content_info.payload_size > 0)
+                {
+                    recv_data->content_info.payload = recv_data->recv_msg.payload + recv_data->content_offset;
+                }
+                codec_info->recv_state = state_send_user_callback;
+            }
+        }
+    }
+
+    if (codec_info->recv_state == state_process_chunked_body && !recv_data->is_streaming)
+    {
+        // Drop the chunk framing that was parsed so the next read is appended
+        // right behind the decoded data
+        size_t content_end = recv_data->content_offset + recv_data->content_info.payload_size;
+        if (recv_data->buffer_offset != content_end)
+        {
+            memmove(recv_data->recv_msg.payload + content_end, recv_data->recv_msg.payload + recv_data->buffer_offset, recv_data->buffer_length);
+            recv_data->buffer_offset = content_end;
+            recv_data->recv_msg.payload_size = content_end + recv_data->buffer_length;
+        }
+
+        // Grow the storage by the rest of a large chunk in one go
+        if (recv_data->chunk_state == chunk_state_data && recv_data->chunk_remaining > 0)
+        {
+            recv_data->recv_msg.default_alloc = recv_data->chunk_remaining;
+        }
+    }
+}
+
+// Parses the bytes of a single response and returns how many bytes at the end of
+// buffer were not part of it, those are the start of the next pipelined response
+static size_t parse_response_bytes(HTTP_CODEC_INFO* codec_info, const unsigned char* buffer, size_t length)
+{
+    size_t result = 0;
+    if (codec_info->recv_state == state_initial || codec_info->recv_state == state_open)
+    {
+        // The end of the previous message can trail in after it was reported,
+        // empty lines in front of a status line are ignored
+        while (length > 0 && (*buffer == '\r' || *buffer == '\n'))
+        {
+            buffer++;
+            length--;
+        }
+    }
+
+    if (length > 0 && codec_info->recv_state != state_error)
     {
         PARSE_RESULT parse_res;
 
         if (codec_info->recv_state == state_initial || codec_info->recv_state == state_open)
         {
-            if (initialize_received_data(&codec_info->recv_data, buffer, length) != 0)
+            if (initialize_received_data(&codec_info->recv_data, &codec_info->allocator, buffer, length) != 0)
             {
                 codec_info->recv_state = state_error;
             }
             else
             {
                 codec_info->recv_state = state_process_status_line;
+                if (codec_info->message_begin_callback != NULL)
+                {
+                    codec_info->message_begin_callback(codec_info->user_ctx);
+                }
             }
         }
         else
@@ -374,14 +680,10 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
                 parse_res = process_status_code_line(codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset, codec_info->recv_data.buffer_length, &buff_index, &codec_info->recv_data.status_code);
                 if (parse_res == result_complete && codec_info->recv_data.status_code > 0)
                 {
-                    // Shrink the buffer
+                    // Move past the status line, the bytes stay where they are
                     codec_info->recv_data.buffer_offset += buff_index;
                     codec_info->recv_data.buffer_length -= buff_index;
                     codec_info->recv_state = state_process_headers;
-
-                    // Reduce the buffer space
-                    reduce_wasted_space(&codec_info->recv_data.recv_msg, codec_info->recv_data.buffer_offset);
-                    codec_info->recv_data.buffer_offset = 0;
                 }
                 else if (parse_res == result_failure)
                 {
@@ -396,6 +698,15 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
                 parse_res = process_header_line(codec_info->recv_data.recv_header, codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset, codec_info->recv_data.buffer_length, &buff_index, &codec_info->recv_data.content_info.payload_size, &codec_info->recv_data.is_chunked);
                 if (parse_res == result_complete)
                 {
+                    notify_headers_complete(codec_info);
+
+                    // A body that can not be decoded is still parsed so the
+                    // connection stays in step, the response reports the error
+                    if (start_content_decoding(codec_info) != 0)
+                    {
+                        codec_info->recv_data.decode_failed = true;
+                    }
+
                     if (codec_info->recv_data.content_info.payload_size == 0)
                     {
                         if (codec_info->recv_data.is_chunked)
@@ -411,14 +722,19 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
                     else
                     {
                         codec_info->recv_state = state_process_body;
+
+                        // Grow the receive buffer by the rest of the body in one go so the
+                        // content is appended without being reallocated on every read
+                        if (!codec_info->recv_data.is_streaming && codec_info->recv_data.content_info.payload_size > codec_info->recv_data.buffer_length - buff_index)
+                        {
+                            codec_info->recv_data.recv_msg.default_alloc = codec_info->recv_data.content_info.payload_size - (codec_info->recv_data.buffer_length - buff_index);
+                        }
                     }
 
-                    // If we're not sending the user infor
+                    // The body starts right after the headers
                     codec_info->recv_data.buffer_offset += buff_index;
                     codec_info->recv_data.buffer_length -= buff_index;
-
-                    reduce_wasted_space(&codec_info->recv_data.recv_msg, codec_info->recv_data.buffer_offset);
-                    codec_info->recv_data.buffer_offset = 0;
+                    codec_info->recv_data.content_offset = codec_info->recv_data.buffer_offset;
                 }
                 else if (parse_res == result_failure)
                 {
@@ -434,119 +750,40 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
 
             if (codec_info->recv_state == state_process_body)
             {
-                if (codec_info->recv_data.content_info.payload_size > 0)
+                if (codec_info->recv_data.is_streaming)
                 {
-                    if ((codec_info->recv_data.content_info.payload_size == codec_info->recv_data.buffer_length) ||
-                        (codec_info->recv_data.content_info.payload_size == (codec_info->recv_data.buffer_length - HTTP_END_TOKEN_LEN)))
+                    // content_info.payload_size counts down the body bytes still to come
+                    size_t fragment_len = codec_info->recv_data.buffer_length;
+                    if (fragment_len > codec_info->recv_data.content_info.payload_size)
+                    {
+                        fragment_len = codec_info->recv_data.content_info.payload_size;
+                    }
+                    if (fragment_len > 0)
+                    {
+                        deliver_body_fragment(codec_info, codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset, fragment_len);
+                        codec_info->recv_data.content_info.payload_size -= fragment_len;
+                    }
+                    release_streamed_data(&codec_info->recv_data, fragment_len);
+                    if (codec_info->recv_data.content_info.payload_size == 0)
                     {
-                        codec_info->recv_data.content_info.payload = codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset;
                         codec_info->recv_state = state_send_user_callback;
                     }
-                    else if (codec_info->recv_data.buffer_length > codec_info->recv_data.content_info.payload_size)
+                }
+                else if (codec_info->recv_data.content_info.payload_size > 0)
+                {
+                    if (codec_info->recv_data.buffer_length >= codec_info->recv_data.content_info.payload_size)
                     {
-                        log_error("Failure attempting to parse header line");
-                        codec_info->recv_state = state_error;
+                        codec_info->recv_data.content_info.payload = codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset;
+                        codec_info->recv_data.buffer_offset += codec_info->recv_data.content_info.payload_size;
+                        codec_info->recv_data.buffer_length -= codec_info->recv_data.content_info.payload_size;
+                        codec_info->recv_state = state_send_user_callback;
                     }
                 }
             }
 
             if (codec_info->recv_state == state_process_chunked_body)
             {
-                const unsigned char* iterator = codec_info->recv_data.recv_msg.payload+codec_info->recv_data.buffer_offset;
-                const unsigned char* initial_pos = iterator;
-                const unsigned char* begin = iterator;
-                const unsigned char* end = iterator;
-                BYTE_BUFFER chunk_msg = { 0 };
-                chunk_msg.default_alloc = codec_info->recv_data.recv_msg.payload_size;
-
-                while (iterator < (initial_pos + codec_info->recv_data.buffer_length))
-                {
-                    if (*iterator == '\r')
-                    {
-                        // Don't need anything
-                        end = iterator;
-                        iterator++;
-                    }
-                    else if (*iterator == '\n')
-                    {
-                        size_t data_length = 0;
-
-                        size_t hex_len = end - begin;
-                        if ((data_length = convert_char_to_hex(begin, hex_len)) == 0)
-                        {
-                            if (codec_info->recv_data.buffer_length - (iterator - initial_pos + 1) <= HTTP_END_TOKEN_LEN)
-                            {
-                                codec_info->recv_state = state_send_user_callback;
-                            }
-                            else
-                            {
-                                // Need to continue parsing
-                                codec_info->recv_state = state_process_headers;
-                            }
-                            break;
-                        }
-                        else if ((data_length + HTTP_CRLF_LEN) < codec_info->recv_data.buffer_length - (iterator - initial_pos))
-                        {
-                            iterator += 1;
-                            if (byte_buffer_construct(&chunk_msg, iterator, data_length) != 0)
-                            {
-                                log_error("Failure building buffer for chunked data");
-                                codec_info->recv_state = state_error;
-                                break;
-                            }
-                            else
-                            {
-                                if (iterator + (data_length + HTTP_CRLF_LEN) > initial_pos + codec_info->recv_data.buffer_length)
-                                {
-                                    log_error("Failure Invalid length specified");
-                                    codec_info->recv_state = state_error;
-                                    break;
-                                }
-                                else if (iterator + (data_length + HTTP_CRLF_LEN) == initial_pos + codec_info->recv_data.buffer_length)
-                                {
-                                    free(chunk_msg.payload);
-                                    break;
-                                }
-                                else
-                                {
-                                    // Move the iterator beyond the data we read and the /r/n
-                                    iterator += (data_length + HTTP_CRLF_LEN);
-                                }
-
-                                if (*iterator == '0' && (codec_info->recv_data.buffer_length - (iterator - initial_pos + 1) <= HTTP_END_TOKEN_LEN))
-                                {
-                                    if (codec_info->recv_data.buffer_length - (iterator - initial_pos + 1) <= HTTP_END_TOKEN_LEN)
-                                    {
-                                        free(codec_info->recv_data.recv_msg.payload);
-                                        codec_info->recv_data.content_info.payload = codec_info->recv_data.recv_msg.payload = chunk_msg.payload;
-                                        codec_info->recv_data.content_info.payload_size = codec_info->recv_data.recv_msg.payload_size = chunk_msg.payload_size;
-                                        codec_info->recv_data.recv_msg.alloc_size = chunk_msg.alloc_size;
-                                        codec_info->recv_state = state_send_user_callback;
-                                    }
-                                    else
-                                    {
-                                        // Need to continue parsing
-                                        codec_info->recv_state = state_process_headers;
-                                    }
-                                    break;
-                                }
-                                else
-                                {
-                                }
-                            }
-                            begin = end = iterator;
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        end = iterator;
-                        iterator++;
-                    }
-                }
+                process_chunked_body(codec_info);
             }
 
             if (codec_info->recv_state == state_send_user_callback || codec_info->recv_state == state_error)
@@ -554,6 +791,16 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
                 HTTP_RECV_DATA http_recv_data = {0};
                 HTTP_CODEC_CB_RESULT operation_result = HTTP_CODEC_CB_RESULT_OK;
 
+                if (codec_info->recv_data.is_encoded && !codec_info->recv_data.is_streaming && !codec_info->recv_data.decode_failed &&
+                    codec_info->recv_state == state_send_user_callback && codec_info->recv_data.content_info.payload_size > 0)
+                {
+                    decode_buffered_content(codec_info);
+                }
+                if (codec_info->recv_data.decode_failed)
+                {
+                    operation_result = HTTP_CODEC_CB_RESULT_ERROR;
+                }
+
                 if (codec_info->trace_on)
                 {
                     log_trace("\r\n<== HTTP Status: %d\r\n", codec_info->recv_data.status_code);
@@ -583,10 +830,13 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
 
             if (codec_info->recv_state == state_parse_complete )
             {
-                http_header_destroy(codec_info->recv_data.recv_header);
-                free(codec_info->recv_data.recv_msg.payload);
+                // Whatever was not parsed belongs to the next response
+                result = codec_info->recv_data.buffer_length;
+
+                reset_received_data(codec_info);
 
-                memset(&codec_info->recv_data, 0, sizeof(HTTP_INCOMING_DATA));
+                // Ready for the next response on a kept alive connection
+                codec_info->recv_state = state_initial;
             }
         }
         else
@@ -595,30 +845,59 @@ static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_
             codec_info->recv_state = state_parse_complete;
         }
     }
+    return result;
+}
+
+static void on_http_bytes_recv(void* context, const unsigned char* buffer, size_t length)
+{
+    HTTP_CODEC_INFO* codec_info = (HTTP_CODEC_INFO*)context;
+    if (codec_info != NULL && buffer != NULL)
+    {
+        // Pipelined responses can arrive back to back in a single read
+        size_t remaining = length;
+        while (remaining > 0)
+        {
+            size_t next_remaining = parse_response_bytes(codec_info, buffer + (length - remaining), remaining);
+            if (next_remaining >= remaining)
+            {
+                break;
+            }
+            remaining = next_remaining;
+        }
+    }
 }
 
 static void deinit_data(HTTP_INCOMING_DATA* data_obj)
 {
     http_header_destroy(data_obj->recv_header);
-    data_obj->recv_header = NULL;
-    free(data_obj->content_info.payload);
-    data_obj->content_info.payload = NULL;
+    // The content always points into recv_msg
     free(data_obj->recv_msg.payload);
-    data_obj->recv_msg.payload = NULL;
+    memset(data_obj, 0, sizeof(HTTP_INCOMING_DATA));
 }
 
 HTTP_CODEC_HANDLE http_codec_create(ON_HTTP_DATA_CALLBACK data_callback, void* user_ctx)
+{
+    return http_codec_create_with_allocator(data_callback, user_ctx, NULL);
+}
+
+HTTP_CODEC_HANDLE http_codec_create_with_allocator(ON_HTTP_DATA_CALLBACK data_callback, void* user_ctx, const HTTP_ALLOCATOR* allocator)
 {
     HTTP_CODEC_INFO* result;
-    if ((result = (HTTP_CODEC_INFO*)malloc(sizeof(HTTP_CODEC_INFO))) == NULL)
+    if (allocator == NULL)
+    {
+        allocator = http_alloc_get_default();
+    }
+    if ((result = (HTTP_CODEC_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_CODEC_INFO))) == NULL)
     {
         log_error("Failure allocating http client info");
     }
     else
     {
         memset(result, 0, sizeof(HTTP_CODEC_INFO));
+        result->allocator = *allocator;
         result->data_callback = data_callback;
         result->user_ctx = user_ctx;
+        result->max_retained_size = DEFAULT_MAX_RETAINED_SIZE;
     }
     return result;
 }
@@ -627,14 +906,20 @@ void http_codec_destroy(HTTP_CODEC_HANDLE handle)
 {
     if (handle != NULL)
     {
+        HTTP_ALLOCATOR allocator = handle->allocator;
         deinit_data(&handle->recv_data);
-        free(handle);
+        if (handle->decoder != NULL)
+        {
+            http_content_decoder_destroy(handle->decoder);
+        }
+        free(handle->decoded_content.payload);
+        http_alloc_free(&allocator, handle);
     }
 }
 
 int http_codec_reintialize(HTTP_CODEC_HANDLE handle)
 {
-    int result;
+    int result = 0;
     if (handle == NULL)
     {
         log_error("Invalid argument specified handle: NULL");
@@ -653,6 +938,39 @@ ON_BYTES_RECEIVED http_codec_get_recv_function(void)
     return on_http_bytes_recv;
 }
 
+int http_codec_set_stream_callbacks(HTTP_CODEC_HANDLE handle, ON_HTTP_HEADERS_CALLBACK headers_callback, ON_HTTP_BODY_FRAGMENT_CALLBACK body_fragment_callback)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->headers_callback = headers_callback;
+        handle->body_fragment_callback = body_fragment_callback;
+        result = 0;
+    }
+    return result;
+}
+
+int http_codec_set_message_begin_callback(HTTP_CODEC_HANDLE handle, ON_HTTP_MESSAGE_BEGIN_CALLBACK message_begin_callback)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->message_begin_callback = message_begin_callback;
+        result = 0;
+    }
+    return result;
+}
+
 int http_codec_set_trace(HTTP_CODEC_HANDLE handle, bool set_trace)
 {
     int result;
@@ -667,4 +985,41 @@ int http_codec_set_trace(HTTP_CODEC_HANDLE handle, bool set_trace)
         result = 0;
     }
     return result;
+}
+
+int http_codec_set_buffer_retention(HTTP_CODEC_HANDLE handle, size_t max_retained_size)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->max_retained_size = max_retained_size;
+        result = 0;
+    }
+    return result;
+}
+
+int http_codec_set_content_decoding(HTTP_CODEC_HANDLE handle, bool decode_content)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else if (decode_content && !http_content_decoder_is_available())
+    {
+        log_error("Content decoding is not available, the library was built without zlib");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->decode_content = decode_content;
+        result = 0;
+    }
+    return result;
 }
\ No newline at end of file
@@ -0,0 +1,302 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_content_decoder.h"
+
+#ifdef HTTP_CLIENT_USE_ZLIB
+#include <limits.h>
+#include <zlib.h>
+
+#define DECODE_BLOCK_SIZE       (16 * 1024)
+
+// zlib window bits, 16 more expects the gzip wrapper and a negative value raw deflate
+#define ZLIB_WINDOW_BITS        15
+#define GZIP_WINDOW_BITS        (ZLIB_WINDOW_BITS + 16)
+#define RAW_WINDOW_BITS         (-ZLIB_WINDOW_BITS)
+
+#define ZLIB_HEADER_SIZE        2
+
+typedef struct HTTP_CONTENT_DECODER_INFO_TAG
+{
+    z_stream stream;
+    bool stream_end;
+
+    // Some servers send deflate without the zlib wrapper, the first bytes of a
+    // deflate body are held until it is known which of the two it is
+    bool is_wrapper_known;
+    unsigned char header[ZLIB_HEADER_SIZE];
+    size_t header_len;
+
+    unsigned char decode_block[DECODE_BLOCK_SIZE];
+} HTTP_CONTENT_DECODER_INFO;
+#endif
+
+static bool is_value_equal(const char* known_value, const char* value, size_t value_len)
+{
+    bool result = strlen(known_value) == value_len;
+    for (size_t index = 0; index < value_len && result; index++)
+    {
+        unsigned char curr = (unsigned char)value[index];
+        if (curr >= 'A' && curr <= 'Z')
+        {
+            curr = (unsigned char)(curr + ('a' - 'A'));
+        }
+        result = (unsigned char)known_value[index] == curr;
+    }
+    return result;
+}
+
+#ifdef HTTP_CLIENT_USE_ZLIB
+// zlib allocates its state and window through the library allocator as well
+static voidpf zlib_alloc(voidpf opaque, uInt items, uInt size)
+{
+    (void)opaque;
+    return http_alloc_malloc(NULL, (size_t)items * size);
+}
+
+static void zlib_free(voidpf opaque, voidpf address)
+{
+    (void)opaque;
+    http_alloc_free(NULL, address);
+}
+
+static int get_window_bits(HTTP_CONTENT_ENCODING encoding)
+{
+    return encoding == HTTP_CONTENT_ENCODING_GZIP ? GZIP_WINDOW_BITS : ZLIB_WINDOW_BITS;
+}
+
+static bool is_zlib_header(const unsigned char header[ZLIB_HEADER_SIZE])
+{
+    // Deflate compression method with a check value that makes the pair a multiple of 31
+    return (header[0] & 0x0F) == Z_DEFLATED && ((((unsigned int)header[0]) << 8) | header[1]) % 31 == 0;
+}
+
+static int inflate_input(HTTP_CONTENT_DECODER_INFO* decoder, const unsigned char* encoded, size_t encoded_len, ON_CONTENT_DECODED on_decoded, void* user_ctx)
+{
+    int result = 0;
+    decoder->stream.next_in = (Bytef*)encoded;
+    decoder->stream.avail_in = (uInt)encoded_len;
+    do
+    {
+        decoder->stream.next_out = decoder->decode_block;
+        decoder->stream.avail_out = DECODE_BLOCK_SIZE;
+
+        int inflate_res = inflate(&decoder->stream, Z_NO_FLUSH);
+        size_t decoded_len = DECODE_BLOCK_SIZE - decoder->stream.avail_out;
+        if (decoded_len > 0)
+        {
+            on_decoded(user_ctx, decoder->decode_block, decoded_len);
+        }
+
+        if (inflate_res == Z_STREAM_END)
+        {
+            decoder->stream_end = true;
+        }
+        else if (inflate_res != Z_OK && inflate_res != Z_BUF_ERROR)
+        {
+            log_error("Failure decoding content %d: %s", inflate_res, decoder->stream.msg != NULL ? decoder->stream.msg : "");
+            result = __LINE__;
+        }
+    } while (result == 0 && !decoder->stream_end && (decoder->stream.avail_in > 0 || decoder->stream.avail_out == 0));
+    return result;
+}
+
+static int inflate_header(HTTP_CONTENT_DECODER_INFO* decoder, unsigned char encoded, ON_CONTENT_DECODED on_decoded, void* user_ctx)
+{
+    int result = 0;
+    decoder->header[decoder->header_len++] = encoded;
+    if (decoder->header_len == ZLIB_HEADER_SIZE)
+    {
+        decoder->is_wrapper_known = true;
+        if (!is_zlib_header(decoder->header) && inflateReset2(&decoder->stream, RAW_WINDOW_BITS) != Z_OK)
+        {
+            log_error("Failure resetting the inflate stream");
+            result = __LINE__;
+        }
+        else
+        {
+            result = inflate_input(decoder, decoder->header, ZLIB_HEADER_SIZE, on_decoded, user_ctx);
+        }
+    }
+    return result;
+}
+#endif
+
+bool http_content_decoder_is_available(void)
+{
+#ifdef HTTP_CLIENT_USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+HTTP_CONTENT_ENCODING http_content_decoder_get_encoding(const char* encoding_value)
+{
+    HTTP_CONTENT_ENCODING result;
+    if (encoding_value == NULL)
+    {
+        result = HTTP_CONTENT_ENCODING_IDENTITY;
+    }
+    else
+    {
+        while (*encoding_value == ' ' || *encoding_value == '\t')
+        {
+            encoding_value++;
+        }
+        size_t value_len = strlen(encoding_value);
+        while (value_len > 0 && (encoding_value[value_len - 1] == ' ' || encoding_value[value_len - 1] == '\t'))
+        {
+            value_len--;
+        }
+
+        if (value_len == 0 || is_value_equal("identity", encoding_value, value_len))
+        {
+            result = HTTP_CONTENT_ENCODING_IDENTITY;
+        }
+        else if (is_value_equal("gzip", encoding_value, value_len) || is_value_equal("x-gzip", encoding_value, value_len))
+        {
+            result = HTTP_CONTENT_ENCODING_GZIP;
+        }
+        else if (is_value_equal("deflate", encoding_value, value_len))
+        {
+            result = HTTP_CONTENT_ENCODING_DEFLATE;
+        }
+        else
+        {
+            // Includes a list of stacked encodings
+            result = HTTP_CONTENT_ENCODING_UNSUPPORTED;
+        }
+    }
+    return result;
+}
+
+HTTP_CONTENT_DECODER_HANDLE http_content_decoder_create(HTTP_CONTENT_ENCODING encoding)
+{
+    HTTP_CONTENT_DECODER_HANDLE result;
+#ifdef HTTP_CLIENT_USE_ZLIB
+    if (encoding != HTTP_CONTENT_ENCODING_GZIP && encoding != HTTP_CONTENT_ENCODING_DEFLATE)
+    {
+        log_error("Invalid argument encoding %d can not be decoded", (int)encoding);
+        result = NULL;
+    }
+    else if ((result = (HTTP_CONTENT_DECODER_INFO*)http_alloc_malloc(NULL, sizeof(HTTP_CONTENT_DECODER_INFO))) == NULL)
+    {
+        log_error("Failure allocating content decoder");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_CONTENT_DECODER_INFO));
+        result->stream.zalloc = zlib_alloc;
+        result->stream.zfree = zlib_free;
+        if (inflateInit2(&result->stream, get_window_bits(encoding)) != Z_OK)
+        {
+            log_error("Failure initializing the inflate stream");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            result->is_wrapper_known = encoding == HTTP_CONTENT_ENCODING_GZIP;
+        }
+    }
+#else
+    (void)encoding;
+    log_error("Content decoding is not available, the library was built without zlib");
+    result = NULL;
+#endif
+    return result;
+}
+
+void http_content_decoder_destroy(HTTP_CONTENT_DECODER_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_ZLIB
+    if (handle != NULL)
+    {
+        (void)inflateEnd(&handle->stream);
+        http_alloc_free(NULL, handle);
+    }
+#else
+    (void)handle;
+#endif
+}
+
+int http_content_decoder_reset(HTTP_CONTENT_DECODER_HANDLE handle, HTTP_CONTENT_ENCODING encoding)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_ZLIB
+    if (handle == NULL || (encoding != HTTP_CONTENT_ENCODING_GZIP && encoding != HTTP_CONTENT_ENCODING_DEFLATE))
+    {
+        log_error("Invalid argument specified handle: %p, encoding: %d", handle, (int)encoding);
+        result = __LINE__;
+    }
+    else if (inflateReset2(&handle->stream, get_window_bits(encoding)) != Z_OK)
+    {
+        log_error("Failure resetting the inflate stream");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->stream_end = false;
+        handle->is_wrapper_known = encoding == HTTP_CONTENT_ENCODING_GZIP;
+        handle->header_len = 0;
+        result = 0;
+    }
+#else
+    (void)handle;
+    (void)encoding;
+    log_error("Content decoding is not available, the library was built without zlib");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+int http_content_decoder_decode(HTTP_CONTENT_DECODER_HANDLE handle, const unsigned char* encoded, size_t encoded_len, ON_CONTENT_DECODED on_decoded, void* user_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_ZLIB
+    if (handle == NULL || (encoded == NULL && encoded_len > 0) || on_decoded == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, encoded: %p, on_decoded: %p", handle, encoded, on_decoded);
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+        // zlib counts input in uInt, larger input is fed in parts
+        while (result == 0 && encoded_len > 0 && !handle->stream_end)
+        {
+            size_t part_len;
+            if (!handle->is_wrapper_known)
+            {
+                part_len = 1;
+                result = inflate_header(handle, *encoded, on_decoded, user_ctx);
+            }
+            else
+            {
+                part_len = encoded_len > UINT_MAX ? UINT_MAX : encoded_len;
+                result = inflate_input(handle, encoded, part_len, on_decoded, user_ctx);
+            }
+            encoded += part_len;
+            encoded_len -= part_len;
+        }
+    }
+#else
+    (void)handle;
+    (void)encoded;
+    (void)encoded_len;
+    (void)on_decoded;
+    (void)user_ctx;
+    log_error("Content decoding is not available, the library was built without zlib");
+    result = __LINE__;
+#endif
+    return result;
+}
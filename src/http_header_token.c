@@ -0,0 +1,79 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "http_client/http_header_token.h"
+
+#define KNOWN_HEADER_TABLE_SIZE     32
+
+// The length and the first and last character of every known name land on a
+// different slot.  The table is laid out by the compiler from this hash, two
+// names on one slot override each other and fail the build with -Werror
+#define KNOWN_HEADER_HASH(name_len, first, last)                                    \
+    ((((size_t)(name_len)) + (((size_t)((unsigned char)(first) | 0x20)) * 9) +        \
+    (((size_t)((unsigned char)(last) | 0x20)) * 3)) & (KNOWN_HEADER_TABLE_SIZE - 1))
+
+#define KNOWN_HEADER_ENTRY(name, first, last, token) \
+    [KNOWN_HEADER_HASH(sizeof(name) - 1, first, last)] = { name, sizeof(name) - 1, token }
+
+typedef struct KNOWN_HEADER_TAG
+{
+    const char* name;
+    size_t name_len;
+    HTTP_HEADER_TOKEN token;
+} KNOWN_HEADER;
+
+static const KNOWN_HEADER KNOWN_HEADER_TABLE[KNOWN_HEADER_TABLE_SIZE] =
+{
+    KNOWN_HEADER_ENTRY("cache-control", 'c', 'l', HTTP_HEADER_TOKEN_CACHE_CONTROL),
+    KNOWN_HEADER_ENTRY("connection", 'c', 'n', HTTP_HEADER_TOKEN_CONNECTION),
+    KNOWN_HEADER_ENTRY("content-encoding", 'c', 'g', HTTP_HEADER_TOKEN_CONTENT_ENCODING),
+    KNOWN_HEADER_ENTRY("content-length", 'c', 'h', HTTP_HEADER_TOKEN_CONTENT_LENGTH),
+    KNOWN_HEADER_ENTRY("content-type", 'c', 'e', HTTP_HEADER_TOKEN_CONTENT_TYPE),
+    KNOWN_HEADER_ENTRY("date", 'd', 'e', HTTP_HEADER_TOKEN_DATE),
+    KNOWN_HEADER_ENTRY("etag", 'e', 'g', HTTP_HEADER_TOKEN_ETAG),
+    KNOWN_HEADER_ENTRY("expires", 'e', 's', HTTP_HEADER_TOKEN_EXPIRES),
+    KNOWN_HEADER_ENTRY("keep-alive", 'k', 'e', HTTP_HEADER_TOKEN_KEEP_ALIVE),
+    KNOWN_HEADER_ENTRY("last-modified", 'l', 'd', HTTP_HEADER_TOKEN_LAST_MODIFIED),
+    KNOWN_HEADER_ENTRY("location", 'l', 'n', HTTP_HEADER_TOKEN_LOCATION),
+    KNOWN_HEADER_ENTRY("retry-after", 'r', 'r', HTTP_HEADER_TOKEN_RETRY_AFTER),
+    KNOWN_HEADER_ENTRY("server", 's', 'r', HTTP_HEADER_TOKEN_SERVER),
+    KNOWN_HEADER_ENTRY("set-cookie", 's', 'e', HTTP_HEADER_TOKEN_SET_COOKIE),
+    KNOWN_HEADER_ENTRY("transfer-encoding", 't', 'g', HTTP_HEADER_TOKEN_TRANSFER_ENCODING),
+    KNOWN_HEADER_ENTRY("www-authenticate", 'w', 'e', HTTP_HEADER_TOKEN_WWW_AUTHENTICATE)
+};
+
+static bool is_name_equal(const char* known_name, const char* name, size_t name_len)
+{
+    bool result = true;
+    for (size_t index = 0; index < name_len; index++)
+    {
+        unsigned char value = (unsigned char)name[index];
+        if (value >= 'A' && value <= 'Z')
+        {
+            value = (unsigned char)(value + ('a' - 'A'));
+        }
+        if ((unsigned char)known_name[index] != value)
+        {
+            result = false;
+            break;
+        }
+    }
+    return result;
+}
+
+HTTP_HEADER_TOKEN http_header_token_lookup(const char* name, size_t name_len)
+{
+    HTTP_HEADER_TOKEN result = HTTP_HEADER_TOKEN_UNKNOWN;
+    if (name != NULL && name_len > 0)
+    {
+        const KNOWN_HEADER* known = &KNOWN_HEADER_TABLE[KNOWN_HEADER_HASH(name_len, name[0], name[name_len - 1])];
+        if (known->name_len == name_len && is_name_equal(known->name, name, name_len))
+        {
+            result = known->token;
+        }
+    }
+    return result;
+}
@@ -2,146 +2,397 @@
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/app_logging.h"
-#include "lib-util-c/item_list.h"
-#include "lib-util-c/crt_extensions.h"
 
+#include "http_client/http_alloc.h"
 #include "http_client/http_headers.h"
 
-typedef struct HTTP_HEADERS_INFO_TAG
-{
-    ITEM_LIST_HANDLE list_items;
-} HTTP_HEADERS_INFO;
+#define INITIAL_ENTRY_COUNT     32
+#define ARENA_BLOCK_SIZE        1024
+#define SLOT_EMPTY              0
+#define SLOT_TOMBSTONE          SIZE_MAX
+
+#define FNV_OFFSET_BASIS        2166136261u
+#define FNV_PRIME               16777619u
 
 typedef struct NAME_VALUE_PAIR_TAG
 {
     char* name;
     char* value;
+    uint32_t hash;
+    HTTP_HEADER_TOKEN token;
 } NAME_VALUE_PAIR;
 
-static void destroy_list_item(void* user_ctx, void* remove_item)
+// Names and values are packed into arena blocks that are never moved, so the
+// strings handed out stay valid until the header is cleared or destroyed.
+typedef struct ARENA_BLOCK_TAG
+{
+    struct ARENA_BLOCK_TAG* next;
+    size_t block_size;
+    size_t used;
+    char data[];
+} ARENA_BLOCK;
+
+// Headers are kept in an insertion ordered array of entries, the slots are an
+// open addressing table over that array holding entry index + 1 so that zero
+// marks an empty slot.  Removed entries leave a hole (name == NULL) that is
+// squeezed out the next time the headers are walked by index.
+//
+// The entries and slots share one allocation with twice as many slots as
+// entries, which keeps the table at most half full.  The initial one lives
+// directly behind the header info.
+typedef struct HTTP_HEADERS_INFO_TAG
+{
+    NAME_VALUE_PAIR* entries;
+    size_t entry_count;
+    size_t entry_alloc;
+    size_t removed_count;
+
+    size_t* slots;
+    size_t slot_count;
+
+    // Entry index + 1 of the first entry of each well known header, zero when absent
+    size_t known_entries[HTTP_HEADER_TOKEN_COUNT];
+
+    ARENA_BLOCK* arena_head;
+    ARENA_BLOCK* arena_curr;
+
+    HTTP_ALLOCATOR allocator;
+} HTTP_HEADERS_INFO;
+
+static size_t calculate_index_size(size_t entry_alloc)
 {
-    (void)user_ctx;
-    NAME_VALUE_PAIR* nvp = (NAME_VALUE_PAIR*)remove_item;
-    free(nvp->name);
-    free(nvp->value);
-    free(nvp);
+    return entry_alloc*sizeof(NAME_VALUE_PAIR) + entry_alloc*2*sizeof(size_t);
 }
 
-HTTP_HEADERS_HANDLE http_header_create(void)
+static void assign_index(HTTP_HEADERS_INFO* header_info, unsigned char* index_block, size_t entry_alloc)
 {
-    HTTP_HEADERS_INFO* result;
-    if ((result = (HTTP_HEADERS_INFO*)malloc(sizeof(HTTP_HEADERS_INFO))) == NULL)
+    header_info->entries = (NAME_VALUE_PAIR*)index_block;
+    header_info->entry_alloc = entry_alloc;
+    header_info->slots = (size_t*)(index_block + entry_alloc*sizeof(NAME_VALUE_PAIR));
+    header_info->slot_count = entry_alloc*2;
+}
+
+static bool is_index_inline(const HTTP_HEADERS_INFO* header_info)
+{
+    return (const unsigned char*)header_info->entries == (const unsigned char*)(header_info + 1);
+}
+
+static unsigned char to_lower_char(unsigned char value)
+{
+    return (value >= 'A' && value <= 'Z') ? (unsigned char)(value + ('a' - 'A')) : value;
+}
+
+static uint32_t calculate_hash(const char* name)
+{
+    uint32_t result = FNV_OFFSET_BASIS;
+    for (const unsigned char* iterator = (const unsigned char*)name; *iterator != '\0'; iterator++)
     {
-        log_error("Failure allocating http header");
+        result ^= to_lower_char(*iterator);
+        result *= FNV_PRIME;
     }
-    else if ((result->list_items = item_list_create(destroy_list_item, result)) == NULL)
+    return result;
+}
+
+static bool is_name_equal(const char* left, const char* right)
+{
+    const unsigned char* left_pos = (const unsigned char*)left;
+    const unsigned char* right_pos = (const unsigned char*)right;
+    while (*left_pos != '\0' && to_lower_char(*left_pos) == to_lower_char(*right_pos))
     {
-        log_error("Failure creating http header list");
-        free(result);
-        result = NULL;
+        left_pos++;
+        right_pos++;
     }
-    return result;
+    return *left_pos == '\0' && *right_pos == '\0';
 }
 
-void http_header_destroy(HTTP_HEADERS_HANDLE handle)
+static void insert_slot(HTTP_HEADERS_INFO* header_info, size_t entry_index)
 {
-    if (handle != NULL)
+    size_t mask = header_info->slot_count - 1;
+    size_t position = header_info->entries[entry_index].hash & mask;
+    while (header_info->slots[position] != SLOT_EMPTY && header_info->slots[position] != SLOT_TOMBSTONE)
     {
-        item_list_destroy(handle->list_items);
-        free(handle);
+        position = (position + 1) & mask;
     }
+    header_info->slots[position] = entry_index + 1;
 }
 
-int http_header_add(HTTP_HEADERS_HANDLE handle, const char* name, const char* value)
+static size_t find_slot(const HTTP_HEADERS_INFO* header_info, const char* name)
 {
-    int result;
-    if (handle == NULL || name == NULL || value == NULL)
+    size_t result = SIZE_MAX;
+    uint32_t hash = calculate_hash(name);
+    size_t mask = header_info->slot_count - 1;
+    size_t position = hash & mask;
+    while (header_info->slots[position] != SLOT_EMPTY)
     {
-            log_error("Failure invalid parameter specified handle: %p, name: %p, value: %p", handle, name, value);
-            result = __LINE__;
+        if (header_info->slots[position] != SLOT_TOMBSTONE)
+        {
+            const NAME_VALUE_PAIR* nvp = &header_info->entries[header_info->slots[position] - 1];
+            if (nvp->hash == hash && is_name_equal(nvp->name, name))
+            {
+                result = position;
+                break;
+            }
+        }
+        position = (position + 1) & mask;
     }
-    else
+    return result;
+}
+
+static void refresh_known_entry(HTTP_HEADERS_INFO* header_info, HTTP_HEADER_TOKEN token)
+{
+    header_info->known_entries[token] = 0;
+    for (size_t index = 0; index < header_info->entry_count; index++)
     {
-        NAME_VALUE_PAIR* nvp = (NAME_VALUE_PAIR*)malloc(sizeof(NAME_VALUE_PAIR));
-        if (nvp == NULL)
+        if (header_info->entries[index].name != NULL && header_info->entries[index].token == token)
         {
-            log_error("Failure invalid parameter specified nvp: %p", nvp);
-            result = __LINE__;
+            header_info->known_entries[token] = index + 1;
+            break;
         }
-        // todo validate header name
-        else if (clone_string(&nvp->name, name) != 0)
+    }
+}
+
+static void rebuild_slots(HTTP_HEADERS_INFO* header_info)
+{
+    // Squeeze out removed entries so the array index matches the public index
+    if (header_info->removed_count > 0)
+    {
+        size_t target = 0;
+        for (size_t index = 0; index < header_info->entry_count; index++)
         {
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            if (header_info->entries[index].name != NULL)
+            {
+                header_info->entries[target++] = header_info->entries[index];
+            }
         }
-        else if (clone_string(&nvp->value, value) != 0)
+        header_info->entry_count = target;
+        header_info->removed_count = 0;
+    }
+
+    memset(header_info->slots, 0, header_info->slot_count*sizeof(size_t));
+    memset(header_info->known_entries, 0, sizeof(header_info->known_entries));
+    for (size_t index = 0; index < header_info->entry_count; index++)
+    {
+        HTTP_HEADER_TOKEN token = header_info->entries[index].token;
+        insert_slot(header_info, index);
+        if (token != HTTP_HEADER_TOKEN_UNKNOWN && header_info->known_entries[token] == 0)
         {
-            free(nvp->name);
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            header_info->known_entries[token] = index + 1;
         }
-        else if (item_list_add_item(handle->list_items, nvp) )
+    }
+}
+
+static int ensure_capacity(HTTP_HEADERS_INFO* header_info)
+{
+    int result = 0;
+    if (header_info->entry_count == header_info->entry_alloc)
+    {
+        if (header_info->removed_count > 0)
         {
-            free(nvp->name);
-            free(nvp->value);
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            // Reclaim the holes left by removed entries before growing
+            rebuild_slots(header_info);
         }
         else
         {
-            result = 0;
+            size_t new_alloc = header_info->entry_alloc*2;
+            unsigned char* index_block = (unsigned char*)http_alloc_malloc(&header_info->allocator, calculate_index_size(new_alloc));
+            if (index_block == NULL)
+            {
+                log_error("Failure growing header entries");
+                result = __LINE__;
+            }
+            else
+            {
+                NAME_VALUE_PAIR* prev_entries = header_info->entries;
+                bool prev_inline = is_index_inline(header_info);
+                memcpy(index_block, prev_entries, header_info->entry_count*sizeof(NAME_VALUE_PAIR));
+                if (!prev_inline)
+                {
+                    http_alloc_free(&header_info->allocator, prev_entries);
+                }
+                assign_index(header_info, index_block, new_alloc);
+                rebuild_slots(header_info);
+            }
         }
     }
     return result;
 }
 
-int http_header_add_partial(HTTP_HEADERS_HANDLE handle, const char* name, size_t name_len, const char* value, size_t value_len)
+static char* arena_store(HTTP_HEADERS_INFO* header_info, const char* source, size_t source_len, size_t reserve_len)
 {
-    int result;
-    if (handle == NULL || name == NULL || name_len == 0 || value == NULL || value_len == 0)
+    char* result;
+    // Reserve room for what follows so the name and value land in the same block
+    size_t needed = source_len + 1 + reserve_len;
+    ARENA_BLOCK* block = header_info->arena_curr;
+    if (block != NULL && block->block_size - block->used < needed && block->next != NULL && block->next->block_size >= needed)
     {
-            log_error("Failure invalid parameter specified handle: %p, name: %p, value: %p", handle, name, value);
-            result = __LINE__;
+        // Blocks behind the current one are left over from a clear
+        block = block->next;
+        block->used = 0;
+        header_info->arena_curr = block;
     }
-    else
+    if (block == NULL || block->block_size - block->used < needed)
     {
-        NAME_VALUE_PAIR* nvp = (NAME_VALUE_PAIR*)malloc(sizeof(NAME_VALUE_PAIR));
-        if (nvp == NULL)
+        size_t block_size = needed > ARENA_BLOCK_SIZE ? needed : ARENA_BLOCK_SIZE;
+        ARENA_BLOCK* new_block = (ARENA_BLOCK*)http_alloc_malloc(&header_info->allocator, sizeof(ARENA_BLOCK) + block_size);
+        if (new_block == NULL)
         {
-            log_error("Failure invalid parameter specified nvp: %p", nvp);
-            result = __LINE__;
+            log_error("Failure allocating header arena");
+            block = NULL;
         }
-        else if (clone_string_with_size(&nvp->name, name, name_len) != 0)
+        else
         {
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            new_block->block_size = block_size;
+            new_block->used = 0;
+            if (header_info->arena_curr == NULL)
+            {
+                new_block->next = NULL;
+                header_info->arena_head = new_block;
+            }
+            else
+            {
+                new_block->next = header_info->arena_curr->next;
+                header_info->arena_curr->next = new_block;
+            }
+            header_info->arena_curr = block = new_block;
         }
-        else if (clone_string_with_size(&nvp->value, value, value_len) != 0)
+    }
+    if (block == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = block->data + block->used;
+        memcpy(result, source, source_len);
+        result[source_len] = '\0';
+        block->used += source_len + 1;
+    }
+    return result;
+}
+
+static int add_name_value_pair(HTTP_HEADERS_INFO* header_info, const char* name, size_t name_len, const char* value, size_t value_len)
+{
+    int result;
+    char* name_copy;
+    char* value_copy;
+    if (ensure_capacity(header_info) != 0)
+    {
+        log_error("Failure allocating name value");
+        result = __LINE__;
+    }
+    else if ((name_copy = arena_store(header_info, name, name_len, value_len + 1)) == NULL ||
+        (value_copy = arena_store(header_info, value, value_len, 0)) == NULL)
+    {
+        log_error("Failure allocating name value");
+        result = __LINE__;
+    }
+    else
+    {
+        NAME_VALUE_PAIR* nvp = &header_info->entries[header_info->entry_count];
+        nvp->name = name_copy;
+        nvp->value = value_copy;
+        nvp->hash = calculate_hash(name_copy);
+        nvp->token = http_header_token_lookup(name_copy, name_len);
+        insert_slot(header_info, header_info->entry_count);
+        header_info->entry_count++;
+        if (nvp->token != HTTP_HEADER_TOKEN_UNKNOWN && header_info->known_entries[nvp->token] == 0)
         {
-            free(nvp->name);
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            header_info->known_entries[nvp->token] = header_info->entry_count;
         }
-        else if (item_list_add_item(handle->list_items, nvp) )
+        result = 0;
+    }
+    return result;
+}
+
+HTTP_HEADERS_HANDLE http_header_create(void)
+{
+    return http_header_create_with_allocator(NULL);
+}
+
+HTTP_HEADERS_HANDLE http_header_create_with_allocator(const HTTP_ALLOCATOR* allocator)
+{
+    HTTP_HEADERS_INFO* result;
+    if (allocator == NULL)
+    {
+        allocator = http_alloc_get_default();
+    }
+    if ((result = (HTTP_HEADERS_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_HEADERS_INFO) + calculate_index_size(INITIAL_ENTRY_COUNT))) == NULL)
+    {
+        log_error("Failure allocating http header");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_HEADERS_INFO));
+        result->allocator = *allocator;
+        assign_index(result, (unsigned char*)(result + 1), INITIAL_ENTRY_COUNT);
+        memset(result->slots, 0, result->slot_count*sizeof(size_t));
+    }
+    return result;
+}
+
+void http_header_destroy(HTTP_HEADERS_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        HTTP_ALLOCATOR allocator = handle->allocator;
+        ARENA_BLOCK* block = handle->arena_head;
+        while (block != NULL)
         {
-            free(nvp->name);
-            free(nvp->value);
-            free(nvp);
-            log_error("Failure allocating name value");
-            result = __LINE__;
+            ARENA_BLOCK* next = block->next;
+            http_alloc_free(&allocator, block);
+            block = next;
         }
-        else
+        if (!is_index_inline(handle))
         {
-            result = 0;
+            http_alloc_free(&allocator, handle->entries);
         }
+        http_alloc_free(&allocator, handle);
+    }
+}
+
+int http_header_add(HTTP_HEADERS_HANDLE handle, const char* name, const char* value)
+{
+    int result;
+    if (handle == NULL || name == NULL || value == NULL)
+    {
+            log_error("Failure invalid parameter specified handle: %p, name: %p, value: %p", handle, name, value);
+            result = __LINE__;
+    }
+    // todo validate header name
+    else if (add_name_value_pair(handle, name, strlen(name), value, strlen(value)) != 0)
+    {
+        log_error("Failure allocating name value");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int http_header_add_partial(HTTP_HEADERS_HANDLE handle, const char* name, size_t name_len, const char* value, size_t value_len)
+{
+    int result;
+    if (handle == NULL || name == NULL || name_len == 0 || value == NULL || value_len == 0)
+    {
+            log_error("Failure invalid parameter specified handle: %p, name: %p, value: %p", handle, name, value);
+            result = __LINE__;
+    }
+    else if (add_name_value_pair(handle, name, name_len, value, value_len) != 0)
+    {
+        log_error("Failure allocating name value");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
     }
     return result;
 }
@@ -156,18 +407,21 @@ int http_header_remove(HTTP_HEADERS_HANDLE handle, const char* name)
     }
     else
     {
-        result = 0;
-        const NAME_VALUE_PAIR* nvp;
-        size_t list_count = item_list_item_count(handle->list_items);
-        for (size_t index = 0; index < list_count; index++)
+        size_t position = find_slot(handle, name);
+        if (position != SIZE_MAX)
         {
-            nvp = item_list_get_item(handle->list_items, index);
-            if (strcmp(nvp->name, name) == 0)
+            // The strings stay in the arena until the header is cleared
+            NAME_VALUE_PAIR* nvp = &handle->entries[handle->slots[position] - 1];
+            nvp->name = NULL;
+            nvp->value = NULL;
+            handle->slots[position] = SLOT_TOMBSTONE;
+            handle->removed_count++;
+            if (nvp->token != HTTP_HEADER_TOKEN_UNKNOWN)
             {
-                item_list_remove_item(handle->list_items, index);
-                break;
+                refresh_known_entry(handle, nvp->token);
             }
         }
+        result = 0;
     }
     return result;
 }
@@ -182,24 +436,46 @@ const char* http_header_get_value(HTTP_HEADERS_HANDLE handle, const char* name)
     }
     else
     {
-        result = NULL;
-        const NAME_VALUE_PAIR* nvp;
-        size_t list_count = item_list_item_count(handle->list_items);
-        for (size_t index = 0; index < list_count; index++)
+        HTTP_HEADER_TOKEN token = http_header_token_lookup(name, strlen(name));
+        if (token != HTTP_HEADER_TOKEN_UNKNOWN)
+        {
+            result = http_header_get_known_value(handle, token);
+        }
+        else
         {
-            if ((nvp = item_list_get_item(handle->list_items, index)) != NULL)
+            size_t position = find_slot(handle, name);
+            if (position != SIZE_MAX)
             {
-                if (strcmp(nvp->name, name) == 0)
-                {
-                    result = nvp->value;
-                    break;
-                }
+                result = handle->entries[handle->slots[position] - 1].value;
+            }
+            else
+            {
+                result = NULL;
             }
         }
     }
     return result;
 }
 
+const char* http_header_get_known_value(HTTP_HEADERS_HANDLE handle, HTTP_HEADER_TOKEN token)
+{
+    const char* result;
+    if (handle == NULL || token == HTTP_HEADER_TOKEN_UNKNOWN || (size_t)token >= HTTP_HEADER_TOKEN_COUNT)
+    {
+        log_error("Invalid parameter specified handle: %p, token: %d", handle, (int)token);
+        result = NULL;
+    }
+    else if (handle->known_entries[token] == 0)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = handle->entries[handle->known_entries[token] - 1].value;
+    }
+    return result;
+}
+
 size_t http_header_get_count(HTTP_HEADERS_HANDLE handle)
 {
     size_t result;
@@ -210,7 +486,7 @@ size_t http_header_get_count(HTTP_HEADERS_HANDLE handle)
     }
     else
     {
-        result = item_list_item_count(handle->list_items);
+        result = handle->entry_count - handle->removed_count;
     }
     return result;
 }
@@ -225,12 +501,15 @@ int http_header_get_name_value_pair(HTTP_HEADERS_HANDLE handle, size_t index, co
     }
     else
     {
-        const NAME_VALUE_PAIR* nvp;
-        nvp = item_list_get_item(handle->list_items, index);
-        if (nvp != NULL)
+        if (handle->removed_count > 0)
+        {
+            rebuild_slots(handle);
+        }
+
+        if (index < handle->entry_count)
         {
-            *name = nvp->name;
-            *value = nvp->value;
+            *name = handle->entries[index].name;
+            *value = handle->entries[index].value;
             result = 0;
         }
         else
@@ -252,7 +531,18 @@ int http_header_clear(HTTP_HEADERS_HANDLE handle)
     }
     else
     {
-        result = item_list_clear(handle->list_items);
+        handle->entry_count = 0;
+        handle->removed_count = 0;
+        memset(handle->slots, 0, handle->slot_count*sizeof(size_t));
+        memset(handle->known_entries, 0, sizeof(handle->known_entries));
+
+        // Keep the arena blocks for the next set of headers
+        handle->arena_curr = handle->arena_head;
+        if (handle->arena_curr != NULL)
+        {
+            handle->arena_curr->used = 0;
+        }
+        result = 0;
     }
     return result;
 }
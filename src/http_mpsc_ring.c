@@ -0,0 +1,198 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_atomic.h"
+#include "http_client/http_mpsc_ring.h"
+
+// Keeps the producer and consumer positions off each other's cache line
+#define CACHE_LINE_SIZE     64
+
+// Each slot is a sequence number followed by the item.  A slot is free for the producer
+// claiming position pos when its sequence equals pos and holds an item for the consumer
+// when it equals pos + 1
+typedef struct HTTP_MPSC_RING_INFO_TAG
+{
+    size_t enqueue_pos;
+    unsigned char enqueue_pad[CACHE_LINE_SIZE - sizeof(size_t)];
+
+    // Only touched by the consumer
+    size_t dequeue_pos;
+    unsigned char dequeue_pad[CACHE_LINE_SIZE - sizeof(size_t)];
+
+    size_t capacity_mask;
+    size_t item_size;
+    size_t slot_size;
+    unsigned char* slot_list;
+
+    HTTP_ALLOCATOR allocator;
+} HTTP_MPSC_RING_INFO;
+
+static size_t* get_slot_sequence(const HTTP_MPSC_RING_INFO* ring, size_t pos)
+{
+    return (size_t*)(ring->slot_list + (pos & ring->capacity_mask) * ring->slot_size);
+}
+
+static unsigned char* get_slot_item(const HTTP_MPSC_RING_INFO* ring, size_t pos)
+{
+    return (unsigned char*)get_slot_sequence(ring, pos) + sizeof(size_t);
+}
+
+HTTP_MPSC_RING_HANDLE http_mpsc_ring_create(size_t capacity, size_t item_size, const HTTP_ALLOCATOR* allocator)
+{
+    HTTP_MPSC_RING_INFO* result;
+    if (capacity == 0 || capacity > (SIZE_MAX >> 1) || item_size == 0)
+    {
+        log_error("Invalid argument specified capacity: %zu, item_size: %zu", capacity, item_size);
+        result = NULL;
+    }
+    else
+    {
+        if (allocator == NULL)
+        {
+            allocator = http_alloc_get_default();
+        }
+
+        size_t slot_count = 2;
+        while (slot_count < capacity)
+        {
+            slot_count <<= 1;
+        }
+        // The sequence of the next slot stays aligned
+        size_t slot_size = (sizeof(size_t) + item_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+
+        if ((result = (HTTP_MPSC_RING_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_MPSC_RING_INFO))) == NULL)
+        {
+            log_error("Failure allocating ring");
+        }
+        else if (slot_size > SIZE_MAX / slot_count ||
+            (result->slot_list = (unsigned char*)http_alloc_malloc(allocator, slot_count * slot_size)) == NULL)
+        {
+            log_error("Failure allocating ring slots");
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+        else
+        {
+            result->enqueue_pos = 0;
+            result->dequeue_pos = 0;
+            result->capacity_mask = slot_count - 1;
+            result->item_size = item_size;
+            result->slot_size = slot_size;
+            result->allocator = *allocator;
+            for (size_t pos = 0; pos < slot_count; pos++)
+            {
+                *get_slot_sequence(result, pos) = pos;
+            }
+        }
+    }
+    return result;
+}
+
+void http_mpsc_ring_destroy(HTTP_MPSC_RING_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        HTTP_ALLOCATOR allocator = handle->allocator;
+        http_alloc_free(&allocator, handle->slot_list);
+        http_alloc_free(&allocator, handle);
+    }
+}
+
+int http_mpsc_ring_push(HTTP_MPSC_RING_HANDLE handle, const void* item)
+{
+    int result;
+    if (handle == NULL || item == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, item: %p", handle, item);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t pos = http_atomic_load_relaxed(&handle->enqueue_pos);
+        size_t* sequence;
+        result = __LINE__;
+        for (;;)
+        {
+            sequence = get_slot_sequence(handle, pos);
+            intptr_t diff = (intptr_t)http_atomic_load_acquire(sequence) - (intptr_t)pos;
+            if (diff == 0)
+            {
+                // The slot is free, claim it unless another producer got there first
+                if (http_atomic_compare_exchange(&handle->enqueue_pos, &pos, pos + 1))
+                {
+                    result = 0;
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The consumer has not freed the slot a lap behind
+                break;
+            }
+            else
+            {
+                pos = http_atomic_load_relaxed(&handle->enqueue_pos);
+            }
+        }
+
+        if (result == 0)
+        {
+            memcpy(get_slot_item(handle, pos), item, handle->item_size);
+            http_atomic_store_release(sequence, pos + 1);
+        }
+    }
+    return result;
+}
+
+bool http_mpsc_ring_pop(HTTP_MPSC_RING_HANDLE handle, void* item)
+{
+    bool result;
+    if (handle == NULL || item == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, item: %p", handle, item);
+        result = false;
+    }
+    else
+    {
+        size_t pos = handle->dequeue_pos;
+        size_t* sequence = get_slot_sequence(handle, pos);
+
+        // A producer that claimed the slot but has not finished copying counts as empty
+        if (http_atomic_load_acquire(sequence) != pos + 1)
+        {
+            result = false;
+        }
+        else
+        {
+            memcpy(item, get_slot_item(handle, pos), handle->item_size);
+            http_atomic_store_release(sequence, pos + handle->capacity_mask + 1);
+            handle->dequeue_pos = pos + 1;
+            result = true;
+        }
+    }
+    return result;
+}
+
+bool http_mpsc_ring_is_empty(HTTP_MPSC_RING_HANDLE handle)
+{
+    bool result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = true;
+    }
+    else
+    {
+        result = http_atomic_load_acquire(get_slot_sequence(handle, handle->dequeue_pos)) != handle->dequeue_pos + 1;
+    }
+    return result;
+}
@@ -0,0 +1,777 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_atomic.h"
+#include "http_client/http_mpsc_ring.h"
+#include "http_client/http_client.h"
+#include "http_client/http_reactor.h"
+
+#define INITIAL_CLIENT_CAPACITY     16
+#define INITIAL_RING_CAPACITY       4
+#define READY_EVENT_COUNT           16
+#define WAKE_QUEUE_SIZE             1024
+#define NO_HEAP_INDEX               SIZE_MAX
+
+typedef struct REACTOR_CLIENT_TAG
+{
+    struct HTTP_REACTOR_INFO_TAG* reactor;
+    HTTP_CLIENT_HANDLE client;
+    // The client's ring, shared with the other clients on the same ring, -1 on the socket cord
+    int wait_fd;
+
+    // Set by the submitting thread while the client sits in the wake queue
+    volatile size_t wake_pending;
+
+    bool is_ready;
+    struct REACTOR_CLIENT_TAG* ready_next;
+
+    // Position in the deadline heap, NO_HEAP_INDEX while the client only waits on its ring or for work
+    size_t heap_index;
+    uint64_t deadline_ms;
+} REACTOR_CLIENT;
+
+typedef struct REACTOR_RING_TAG
+{
+    int wait_fd;
+    // Any client on the ring, flushing it processes the ring for all of them
+    HTTP_CLIENT_HANDLE client;
+    size_t client_count;
+} REACTOR_RING;
+
+typedef struct HTTP_REACTOR_INFO_TAG
+{
+    int epoll_fd;
+    int wake_fd;
+
+    // The deadline heap shares the allocation of the client list, both hold client_capacity entries
+    REACTOR_CLIENT** client_list;
+    REACTOR_CLIENT** deadline_heap;
+    size_t client_count;
+    size_t heap_count;
+    size_t client_capacity;
+
+    REACTOR_RING* ring_list;
+    size_t ring_count;
+    size_t ring_capacity;
+
+    // Clients to run on the next pass in the order they became ready
+    REACTOR_CLIENT* ready_head;
+    REACTOR_CLIENT* ready_tail;
+    size_t ready_count;
+
+    // Clients woken by requests submitted from other threads, wake_overflow is set
+    // when the queue was full and every client has to be run
+    HTTP_MPSC_RING_HANDLE wake_queue;
+    volatile size_t wake_overflow;
+
+    // The client being run, unregistering it from its own callback defers its release
+    REACTOR_CLIENT* running;
+    bool running_released;
+} HTTP_REACTOR_INFO;
+
+static int find_client(const HTTP_REACTOR_INFO* reactor, HTTP_CLIENT_HANDLE client, size_t* index)
+{
+    int result = __LINE__;
+    for (size_t curr = 0; curr < reactor->client_count; curr++)
+    {
+        if (reactor->client_list[curr]->client == client)
+        {
+            *index = curr;
+            result = 0;
+            break;
+        }
+    }
+    return result;
+}
+
+static int find_ring(const HTTP_REACTOR_INFO* reactor, int wait_fd, size_t* index)
+{
+    int result = __LINE__;
+    for (size_t curr = 0; curr < reactor->ring_count; curr++)
+    {
+        if (reactor->ring_list[curr].wait_fd == wait_fd)
+        {
+            *index = curr;
+            result = 0;
+            break;
+        }
+    }
+    return result;
+}
+
+static uint64_t get_monotonic_ms(void)
+{
+    struct timespec curr_time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return (uint64_t)curr_time.tv_sec * 1000 + (uint64_t)curr_time.tv_nsec / 1000000;
+}
+
+static void drain_wake_fd(HTTP_REACTOR_INFO* reactor)
+{
+    uint64_t wake_count;
+    if (read(reactor->wake_fd, &wake_count, sizeof(wake_count)) != (ssize_t)sizeof(wake_count))
+    {
+        log_warning("Reactor wake up could not be read");
+    }
+}
+
+static void swap_heap_entries(HTTP_REACTOR_INFO* reactor, size_t left, size_t right)
+{
+    REACTOR_CLIENT* entry = reactor->deadline_heap[left];
+    reactor->deadline_heap[left] = reactor->deadline_heap[right];
+    reactor->deadline_heap[right] = entry;
+    reactor->deadline_heap[left]->heap_index = left;
+    reactor->deadline_heap[right]->heap_index = right;
+}
+
+static void sift_heap(HTTP_REACTOR_INFO* reactor, size_t index)
+{
+    while (index > 0 && reactor->deadline_heap[(index - 1) / 2]->deadline_ms > reactor->deadline_heap[index]->deadline_ms)
+    {
+        swap_heap_entries(reactor, index, (index - 1) / 2);
+        index = (index - 1) / 2;
+    }
+    for (;;)
+    {
+        size_t smallest = index;
+        size_t child = index * 2 + 1;
+        if (child < reactor->heap_count && reactor->deadline_heap[child]->deadline_ms < reactor->deadline_heap[smallest]->deadline_ms)
+        {
+            smallest = child;
+        }
+        if (child + 1 < reactor->heap_count && reactor->deadline_heap[child + 1]->deadline_ms < reactor->deadline_heap[smallest]->deadline_ms)
+        {
+            smallest = child + 1;
+        }
+        if (smallest == index)
+        {
+            break;
+        }
+        swap_heap_entries(reactor, index, smallest);
+        index = smallest;
+    }
+}
+
+static void remove_deadline(HTTP_REACTOR_INFO* reactor, REACTOR_CLIENT* entry)
+{
+    if (entry->heap_index != NO_HEAP_INDEX)
+    {
+        size_t index = entry->heap_index;
+        reactor->heap_count--;
+        if (index != reactor->heap_count)
+        {
+            reactor->deadline_heap[index] = reactor->deadline_heap[reactor->heap_count];
+            reactor->deadline_heap[index]->heap_index = index;
+            sift_heap(reactor, index);
+        }
+        entry->heap_index = NO_HEAP_INDEX;
+    }
+}
+
+static void set_deadline(HTTP_REACTOR_INFO* reactor, REACTOR_CLIENT* entry, uint64_t deadline_ms)
+{
+    entry->deadline_ms = deadline_ms;
+    if (entry->heap_index == NO_HEAP_INDEX)
+    {
+        entry->heap_index = reactor->heap_count;
+        reactor->deadline_heap[reactor->heap_count++] = entry;
+    }
+    sift_heap(reactor, entry->heap_index);
+}
+
+static void mark_ready(HTTP_REACTOR_INFO* reactor, REACTOR_CLIENT* entry)
+{
+    // The client being run is asked for its wait time once it returns
+    if (!entry->is_ready && entry != reactor->running)
+    {
+        entry->is_ready = true;
+        entry->ready_next = NULL;
+        if (reactor->ready_tail == NULL)
+        {
+            reactor->ready_head = entry;
+        }
+        else
+        {
+            reactor->ready_tail->ready_next = entry;
+        }
+        reactor->ready_tail = entry;
+        reactor->ready_count++;
+    }
+}
+
+static void remove_ready(HTTP_REACTOR_INFO* reactor, REACTOR_CLIENT* entry)
+{
+    if (entry->is_ready)
+    {
+        REACTOR_CLIENT* prev = NULL;
+        REACTOR_CLIENT* curr = reactor->ready_head;
+        while (curr != entry)
+        {
+            prev = curr;
+            curr = curr->ready_next;
+        }
+        if (prev == NULL)
+        {
+            reactor->ready_head = entry->ready_next;
+        }
+        else
+        {
+            prev->ready_next = entry->ready_next;
+        }
+        if (reactor->ready_tail == entry)
+        {
+            reactor->ready_tail = prev;
+        }
+        reactor->ready_count--;
+        entry->is_ready = false;
+    }
+}
+
+// Called on the thread driving the client for completions and work queued on it
+static void on_client_ready(void* ready_ctx)
+{
+    REACTOR_CLIENT* entry = (REACTOR_CLIENT*)ready_ctx;
+    mark_ready(entry->reactor, entry);
+}
+
+// Called on the submitting thread.  The fence pairs with the one in drain_wake_queue, either the
+// reactor sees the request when it runs the client or this thread sees wake_pending cleared
+static void on_client_wake(void* wake_ctx)
+{
+    REACTOR_CLIENT* entry = (REACTOR_CLIENT*)wake_ctx;
+    HTTP_REACTOR_INFO* reactor = entry->reactor;
+    size_t expected = 0;
+    bool is_queued;
+
+    http_atomic_thread_fence();
+    while (!(is_queued = http_atomic_compare_exchange(&entry->wake_pending, &expected, 1)) && expected == 0)
+    {
+    }
+
+    // A client already in the queue is run without another wake up
+    if (is_queued)
+    {
+        if (http_mpsc_ring_push(reactor->wake_queue, &entry) != 0)
+        {
+            http_atomic_store_release(&entry->wake_pending, 0);
+            http_atomic_thread_fence();
+            http_atomic_store_release(&reactor->wake_overflow, 1);
+        }
+        (void)http_reactor_wake(reactor);
+    }
+}
+
+static void drain_wake_queue(HTTP_REACTOR_INFO* reactor)
+{
+    REACTOR_CLIENT* entry;
+    while (http_mpsc_ring_pop(reactor->wake_queue, &entry))
+    {
+        http_atomic_store_release(&entry->wake_pending, 0);
+        mark_ready(reactor, entry);
+    }
+    if (http_atomic_load_acquire(&reactor->wake_overflow) != 0)
+    {
+        http_atomic_store_release(&reactor->wake_overflow, 0);
+        for (size_t index = 0; index < reactor->client_count; index++)
+        {
+            mark_ready(reactor, reactor->client_list[index]);
+        }
+    }
+    http_atomic_thread_fence();
+}
+
+static void expire_deadlines(HTTP_REACTOR_INFO* reactor, uint64_t now_ms)
+{
+    while (reactor->heap_count > 0 && reactor->deadline_heap[0]->deadline_ms <= now_ms)
+    {
+        REACTOR_CLIENT* entry = reactor->deadline_heap[0];
+        remove_deadline(reactor, entry);
+        mark_ready(reactor, entry);
+    }
+}
+
+static void release_client(REACTOR_CLIENT* entry)
+{
+    http_alloc_free(NULL, entry);
+}
+
+static void run_ready_clients(HTTP_REACTOR_INFO* reactor, uint64_t now_ms)
+{
+    // Clients made ready by the ones run in this pass wait for the next
+    size_t run_count = reactor->ready_count;
+    while (run_count > 0 && reactor->ready_head != NULL)
+    {
+        REACTOR_CLIENT* entry = reactor->ready_head;
+        reactor->ready_head = entry->ready_next;
+        if (reactor->ready_head == NULL)
+        {
+            reactor->ready_tail = NULL;
+        }
+        reactor->ready_count--;
+        entry->is_ready = false;
+        run_count--;
+
+        // The ring of a ring client is flushed once for all of its clients
+        reactor->running = entry;
+        reactor->running_released = false;
+        if (entry->wait_fd >= 0)
+        {
+            http_client_process_work(entry->client);
+        }
+        else
+        {
+            http_client_process_item(entry->client);
+        }
+        reactor->running = NULL;
+
+        if (reactor->running_released)
+        {
+            release_client(entry);
+        }
+        else
+        {
+            // A client on the socket cord asks again within a millisecond while it waits on the network
+            int client_wait = http_client_get_wait_time(entry->client, UINT32_MAX);
+            if (client_wait == 0)
+            {
+                mark_ready(reactor, entry);
+            }
+            else if (client_wait == INT_MAX)
+            {
+                remove_deadline(reactor, entry);
+            }
+            else
+            {
+                set_deadline(reactor, entry, now_ms + (uint64_t)client_wait);
+            }
+        }
+    }
+}
+
+// Submits the sends queued by the clients that ran and dispatches the completions, the clients
+// they belong to are marked ready through their ready callback
+static void flush_rings(HTTP_REACTOR_INFO* reactor)
+{
+    for (size_t index = 0; index < reactor->ring_count; index++)
+    {
+        (void)http_client_flush(reactor->ring_list[index].client);
+    }
+}
+
+static int get_reactor_wait_time(const HTTP_REACTOR_INFO* reactor, uint32_t timeout_ms, uint64_t now_ms)
+{
+    int result = timeout_ms > INT_MAX ? INT_MAX : (int)timeout_ms;
+    if (reactor->ready_count > 0)
+    {
+        result = 0;
+    }
+    else if (reactor->heap_count > 0)
+    {
+        uint64_t deadline_ms = reactor->deadline_heap[0]->deadline_ms;
+        uint64_t deadline_wait = deadline_ms > now_ms ? deadline_ms - now_ms : 0;
+        if (deadline_wait < (uint64_t)result)
+        {
+            result = (int)deadline_wait;
+        }
+    }
+    return result;
+}
+
+static int add_ring(HTTP_REACTOR_INFO* reactor, int wait_fd, HTTP_CLIENT_HANDLE client)
+{
+    int result;
+    size_t index;
+    if (find_ring(reactor, wait_fd, &index) == 0)
+    {
+        reactor->ring_list[index].client_count++;
+        result = 0;
+    }
+    else
+    {
+        if (reactor->ring_count == reactor->ring_capacity)
+        {
+            size_t new_capacity = reactor->ring_capacity == 0 ? INITIAL_RING_CAPACITY : reactor->ring_capacity * 2;
+            REACTOR_RING* new_list;
+            if ((new_list = (REACTOR_RING*)http_alloc_malloc(NULL, new_capacity * sizeof(REACTOR_RING))) == NULL)
+            {
+                log_error("Failure growing reactor ring list");
+                result = __LINE__;
+            }
+            else
+            {
+                if (reactor->ring_list != NULL)
+                {
+                    memcpy(new_list, reactor->ring_list, reactor->ring_count * sizeof(REACTOR_RING));
+                    http_alloc_free(NULL, reactor->ring_list);
+                }
+                reactor->ring_list = new_list;
+                reactor->ring_capacity = new_capacity;
+                result = 0;
+            }
+        }
+        else
+        {
+            result = 0;
+        }
+
+        if (result == 0)
+        {
+            // Clients sharing a ring share its fd, it is added to epoll once
+            struct epoll_event ring_event = {0};
+            ring_event.events = EPOLLIN;
+            ring_event.data.fd = wait_fd;
+            if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, wait_fd, &ring_event) != 0)
+            {
+                log_error("Failure adding the client ring to epoll");
+                result = __LINE__;
+            }
+            else
+            {
+                reactor->ring_list[reactor->ring_count].wait_fd = wait_fd;
+                reactor->ring_list[reactor->ring_count].client = client;
+                reactor->ring_list[reactor->ring_count].client_count = 1;
+                reactor->ring_count++;
+            }
+        }
+    }
+    return result;
+}
+
+static void remove_ring(HTTP_REACTOR_INFO* reactor, int wait_fd, HTTP_CLIENT_HANDLE client)
+{
+    size_t index;
+    if (find_ring(reactor, wait_fd, &index) == 0)
+    {
+        REACTOR_RING* ring = &reactor->ring_list[index];
+        if (--ring->client_count == 0)
+        {
+            if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, wait_fd, NULL) != 0)
+            {
+                log_warning("Failure removing the client ring from epoll");
+            }
+            reactor->ring_count--;
+            reactor->ring_list[index] = reactor->ring_list[reactor->ring_count];
+        }
+        else if (ring->client == client)
+        {
+            // Another client on the ring flushes it from now on
+            for (size_t curr = 0; curr < reactor->client_count; curr++)
+            {
+                if (reactor->client_list[curr]->wait_fd == wait_fd)
+                {
+                    ring->client = reactor->client_list[curr]->client;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static int grow_client_list(HTTP_REACTOR_INFO* reactor)
+{
+    int result;
+    size_t new_capacity = reactor->client_capacity * 2;
+    REACTOR_CLIENT** new_list;
+    if ((new_list = (REACTOR_CLIENT**)http_alloc_malloc(NULL, new_capacity * 2 * sizeof(REACTOR_CLIENT*))) == NULL)
+    {
+        log_error("Failure growing reactor client list");
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(new_list, reactor->client_list, reactor->client_count * sizeof(REACTOR_CLIENT*));
+        memcpy(new_list + new_capacity, reactor->deadline_heap, reactor->heap_count * sizeof(REACTOR_CLIENT*));
+        http_alloc_free(NULL, reactor->client_list);
+        reactor->client_list = new_list;
+        reactor->deadline_heap = new_list + new_capacity;
+        reactor->client_capacity = new_capacity;
+        result = 0;
+    }
+    return result;
+}
+
+HTTP_REACTOR_HANDLE http_reactor_create(void)
+{
+    HTTP_REACTOR_INFO* result;
+    if ((result = (HTTP_REACTOR_INFO*)http_alloc_malloc(NULL, sizeof(HTTP_REACTOR_INFO))) == NULL)
+    {
+        log_error("Failure allocating reactor");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_REACTOR_INFO));
+        if ((result->client_list = (REACTOR_CLIENT**)http_alloc_malloc(NULL, INITIAL_CLIENT_CAPACITY * 2 * sizeof(REACTOR_CLIENT*))) == NULL)
+        {
+            log_error("Failure allocating reactor client list");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if ((result->wake_queue = http_mpsc_ring_create(WAKE_QUEUE_SIZE, sizeof(REACTOR_CLIENT*), NULL)) == NULL)
+        {
+            log_error("Failure allocating reactor wake queue");
+            http_alloc_free(NULL, result->client_list);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if ((result->epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+        {
+            log_error("Failure creating epoll instance");
+            http_mpsc_ring_destroy(result->wake_queue);
+            http_alloc_free(NULL, result->client_list);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if ((result->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+        {
+            log_error("Failure creating reactor wake up event");
+            close(result->epoll_fd);
+            http_mpsc_ring_destroy(result->wake_queue);
+            http_alloc_free(NULL, result->client_list);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            struct epoll_event wake_event = {0};
+            wake_event.events = EPOLLIN;
+            wake_event.data.fd = result->wake_fd;
+            if (epoll_ctl(result->epoll_fd, EPOLL_CTL_ADD, result->wake_fd, &wake_event) != 0)
+            {
+                log_error("Failure adding wake up event to epoll");
+                close(result->wake_fd);
+                close(result->epoll_fd);
+                http_mpsc_ring_destroy(result->wake_queue);
+                http_alloc_free(NULL, result->client_list);
+                http_alloc_free(NULL, result);
+                result = NULL;
+            }
+            else
+            {
+                result->client_capacity = INITIAL_CLIENT_CAPACITY;
+                result->deadline_heap = result->client_list + INITIAL_CLIENT_CAPACITY;
+            }
+        }
+    }
+    return result;
+}
+
+void http_reactor_destroy(HTTP_REACTOR_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        for (size_t index = 0; index < handle->client_count; index++)
+        {
+            release_client(handle->client_list[index]);
+        }
+        close(handle->wake_fd);
+        close(handle->epoll_fd);
+        http_mpsc_ring_destroy(handle->wake_queue);
+        http_alloc_free(NULL, handle->ring_list);
+        http_alloc_free(NULL, handle->client_list);
+        http_alloc_free(NULL, handle);
+    }
+}
+
+int http_reactor_register(HTTP_REACTOR_HANDLE handle, HTTP_CLIENT_HANDLE client)
+{
+    int result;
+    size_t index;
+    REACTOR_CLIENT* entry;
+    if (handle == NULL || client == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, client: %p", handle, client);
+        result = __LINE__;
+    }
+    else if (find_client(handle, client, &index) == 0)
+    {
+        log_error("Client is already registered with the reactor");
+        result = __LINE__;
+    }
+    else if (handle->client_count == handle->client_capacity && grow_client_list(handle) != 0)
+    {
+        log_error("Failure growing reactor client list");
+        result = __LINE__;
+    }
+    else if ((entry = (REACTOR_CLIENT*)http_alloc_malloc(NULL, sizeof(REACTOR_CLIENT))) == NULL)
+    {
+        log_error("Failure allocating reactor client");
+        result = __LINE__;
+    }
+    else
+    {
+        memset(entry, 0, sizeof(REACTOR_CLIENT));
+        entry->reactor = handle;
+        entry->client = client;
+        entry->heap_index = NO_HEAP_INDEX;
+        entry->wait_fd = http_client_get_wait_fd(client);
+        if (entry->wait_fd >= 0 && add_ring(handle, entry->wait_fd, client) != 0)
+        {
+            log_error("Failure adding the client ring");
+            http_alloc_free(NULL, entry);
+            result = __LINE__;
+        }
+        // Requests submitted from other threads cut the sleep short, completions and work
+        // queued on the reactor thread put the client on the ready list
+        else if (http_client_set_wake_callback(client, on_client_wake, entry) != 0 ||
+            http_client_set_ready_callback(client, on_client_ready, entry) != 0)
+        {
+            log_error("Failure setting the client callbacks");
+            (void)http_client_set_wake_callback(client, NULL, NULL);
+            if (entry->wait_fd >= 0)
+            {
+                remove_ring(handle, entry->wait_fd, client);
+            }
+            http_alloc_free(NULL, entry);
+            result = __LINE__;
+        }
+        else
+        {
+            // Run once so the work the client already has is picked up
+            handle->client_list[handle->client_count++] = entry;
+            mark_ready(handle, entry);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int http_reactor_unregister(HTTP_REACTOR_HANDLE handle, HTTP_CLIENT_HANDLE client)
+{
+    int result;
+    size_t index;
+    if (handle == NULL || client == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, client: %p", handle, client);
+        result = __LINE__;
+    }
+    else if (find_client(handle, client, &index) != 0)
+    {
+        log_error("Client is not registered with the reactor");
+        result = __LINE__;
+    }
+    else
+    {
+        REACTOR_CLIENT* entry = handle->client_list[index];
+        (void)http_client_set_wake_callback(client, NULL, NULL);
+        (void)http_client_set_ready_callback(client, NULL, NULL);
+
+        // Nothing may be left pointing at the client once it is released
+        drain_wake_queue(handle);
+        remove_ready(handle, entry);
+        remove_deadline(handle, entry);
+        handle->client_count--;
+        handle->client_list[index] = handle->client_list[handle->client_count];
+        if (entry->wait_fd >= 0)
+        {
+            remove_ring(handle, entry->wait_fd, client);
+        }
+
+        if (entry == handle->running)
+        {
+            handle->running_released = true;
+        }
+        else
+        {
+            release_client(entry);
+        }
+        result = 0;
+    }
+    return result;
+}
+
+int http_reactor_run_once(HTTP_REACTOR_HANDLE handle, uint32_t timeout_ms)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        // Only the clients that were woken, had completions or reached their deadline run,
+        // then every ring is flushed once and the reactor sleeps until a ring is readable,
+        // a wake up, the nearest deadline or the timeout
+        uint64_t now_ms = get_monotonic_ms();
+        drain_wake_queue(handle);
+        expire_deadlines(handle, now_ms);
+        run_ready_clients(handle, now_ms);
+        flush_rings(handle);
+        int wait_ms = get_reactor_wait_time(handle, timeout_ms, now_ms);
+
+        struct epoll_event ready_list[READY_EVENT_COUNT];
+        int ready_count = epoll_wait(handle->epoll_fd, ready_list, READY_EVENT_COUNT, wait_ms);
+        if (ready_count < 0 && errno != EINTR)
+        {
+            log_error("Failure waiting on reactor events");
+            result = __LINE__;
+        }
+        else
+        {
+            // A readable ring is reaped by the flush of the next pass
+            for (int index = 0; index < ready_count; index++)
+            {
+                if (ready_list[index].data.fd == handle->wake_fd)
+                {
+                    drain_wake_fd(handle);
+                }
+            }
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int http_reactor_wake(HTTP_REACTOR_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        uint64_t wake_count = 1;
+        if (write(handle->wake_fd, &wake_count, sizeof(wake_count)) != (ssize_t)sizeof(wake_count))
+        {
+            log_error("Failure signaling the reactor");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+size_t http_reactor_get_client_count(HTTP_REACTOR_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle: NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->client_count;
+    }
+    return result;
+}
@@ -0,0 +1,251 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_scan.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HTTP_SCAN_X86
+#include <immintrin.h>
+#endif
+
+#define SSE_BLOCK_SIZE      16
+#define AVX_BLOCK_SIZE      32
+
+typedef size_t(*HTTP_SCAN_FUNCTION)(const HTTP_SCAN_SET* delim_set, const unsigned char* buffer, size_t length);
+
+static HTTP_SCAN_FUNCTION g_scan_function = NULL;
+static HTTP_SCAN_KERNEL g_scan_kernel = HTTP_SCAN_KERNEL_SCALAR;
+
+static size_t scan_scalar(const HTTP_SCAN_SET* delim_set, const unsigned char* buffer, size_t length)
+{
+    size_t index;
+    for (index = 0; index < length; index++)
+    {
+        bool is_delim = false;
+        for (size_t delim = 0; delim < delim_set->count; delim++)
+        {
+            if (buffer[index] == delim_set->delims[delim])
+            {
+                is_delim = true;
+                break;
+            }
+        }
+        if (is_delim)
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+#ifdef HTTP_SCAN_X86
+__attribute__((target("sse4.2")))
+static size_t scan_sse42(const HTTP_SCAN_SET* delim_set, const unsigned char* buffer, size_t length)
+{
+    size_t result = length;
+    if (length < SSE_BLOCK_SIZE)
+    {
+        result = scan_scalar(delim_set, buffer, length);
+    }
+    else
+    {
+        unsigned char set_bytes[SSE_BLOCK_SIZE] = {0};
+        for (size_t delim = 0; delim < delim_set->count; delim++)
+        {
+            set_bytes[delim] = delim_set->delims[delim];
+        }
+        __m128i set = _mm_loadu_si128((const __m128i*)set_bytes);
+        int set_len = (int)delim_set->count;
+
+        size_t index = 0;
+        for (; index + SSE_BLOCK_SIZE <= length; index += SSE_BLOCK_SIZE)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(buffer + index));
+            int found = _mm_cmpestri(set, set_len, block, SSE_BLOCK_SIZE, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+            if (found < SSE_BLOCK_SIZE)
+            {
+                result = index + (size_t)found;
+                break;
+            }
+        }
+
+        if (result == length && index < length)
+        {
+            // Scan the tail with a block that ends on the last byte, the bytes
+            // it shares with the previous block were already checked
+            size_t tail = length - index;
+            __m128i block = _mm_loadu_si128((const __m128i*)(buffer + length - SSE_BLOCK_SIZE));
+            unsigned int mask = (unsigned int)_mm_cvtsi128_si32(_mm_cmpestrm(set, set_len, block, SSE_BLOCK_SIZE, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK));
+            mask >>= (SSE_BLOCK_SIZE - tail);
+            if (mask != 0)
+            {
+                result = index + (size_t)__builtin_ctz(mask);
+            }
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx2")))
+static uint32_t match_avx2_block(const __m256i* delims, const unsigned char* block_start)
+{
+    __m256i block = _mm256_loadu_si256((const __m256i*)block_start);
+    __m256i match = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, delims[0]), _mm256_cmpeq_epi8(block, delims[1])),
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, delims[2]), _mm256_cmpeq_epi8(block, delims[3])));
+    return (uint32_t)_mm256_movemask_epi8(match);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const HTTP_SCAN_SET* delim_set, const unsigned char* buffer, size_t length)
+{
+    size_t result = length;
+    if (length < AVX_BLOCK_SIZE || delim_set->count == 0)
+    {
+        result = scan_scalar(delim_set, buffer, length);
+    }
+    else
+    {
+        // Unused slots repeat the first delimiter so every block costs the same compares
+        __m256i delims[HTTP_SCAN_MAX_DELIMS];
+        for (size_t delim = 0; delim < HTTP_SCAN_MAX_DELIMS; delim++)
+        {
+            delims[delim] = _mm256_set1_epi8((char)delim_set->delims[delim < delim_set->count ? delim : 0]);
+        }
+
+        size_t index = 0;
+        for (; index + AVX_BLOCK_SIZE <= length; index += AVX_BLOCK_SIZE)
+        {
+            uint32_t mask = match_avx2_block(delims, buffer + index);
+            if (mask != 0)
+            {
+                result = index + (size_t)__builtin_ctz(mask);
+                break;
+            }
+        }
+
+        if (result == length && index < length)
+        {
+            size_t tail = length - index;
+            uint32_t mask = match_avx2_block(delims, buffer + length - AVX_BLOCK_SIZE) >> (AVX_BLOCK_SIZE - tail);
+            if (mask != 0)
+            {
+                result = index + (size_t)__builtin_ctz(mask);
+            }
+        }
+    }
+    return result;
+}
+#endif
+
+static bool is_kernel_supported(HTTP_SCAN_KERNEL kernel)
+{
+    bool result;
+    switch (kernel)
+    {
+        case HTTP_SCAN_KERNEL_SCALAR:
+            result = true;
+            break;
+#ifdef HTTP_SCAN_X86
+        case HTTP_SCAN_KERNEL_SSE42:
+            __builtin_cpu_init();
+            result = __builtin_cpu_supports("sse4.2") != 0;
+            break;
+        case HTTP_SCAN_KERNEL_AVX2:
+            __builtin_cpu_init();
+            result = __builtin_cpu_supports("avx2") != 0;
+            break;
+#endif
+        default:
+            result = false;
+            break;
+    }
+    return result;
+}
+
+static void select_kernel(HTTP_SCAN_KERNEL kernel)
+{
+    switch (kernel)
+    {
+#ifdef HTTP_SCAN_X86
+        case HTTP_SCAN_KERNEL_SSE42:
+            g_scan_function = scan_sse42;
+            break;
+        case HTTP_SCAN_KERNEL_AVX2:
+            g_scan_function = scan_avx2;
+            break;
+#endif
+        case HTTP_SCAN_KERNEL_SCALAR:
+        default:
+            g_scan_function = scan_scalar;
+            break;
+    }
+    g_scan_kernel = kernel;
+}
+
+static void select_best_kernel(void)
+{
+    if (is_kernel_supported(HTTP_SCAN_KERNEL_AVX2))
+    {
+        select_kernel(HTTP_SCAN_KERNEL_AVX2);
+    }
+    else if (is_kernel_supported(HTTP_SCAN_KERNEL_SSE42))
+    {
+        select_kernel(HTTP_SCAN_KERNEL_SSE42);
+    }
+    else
+    {
+        select_kernel(HTTP_SCAN_KERNEL_SCALAR);
+    }
+}
+
+size_t http_scan_find(const HTTP_SCAN_SET* delim_set, const unsigned char* buffer, size_t length)
+{
+    size_t result;
+    if (delim_set == NULL || buffer == NULL || delim_set->count > HTTP_SCAN_MAX_DELIMS)
+    {
+        log_error("Invalid parameter specified delim_set: %p, buffer: %p", delim_set, buffer);
+        result = length;
+    }
+    else
+    {
+        // Every thread resolves to the same kernel so a racing first call is harmless
+        if (g_scan_function == NULL)
+        {
+            select_best_kernel();
+        }
+        result = g_scan_function(delim_set, buffer, length);
+    }
+    return result;
+}
+
+HTTP_SCAN_KERNEL http_scan_get_kernel(void)
+{
+    if (g_scan_function == NULL)
+    {
+        select_best_kernel();
+    }
+    return g_scan_kernel;
+}
+
+int http_scan_set_kernel(HTTP_SCAN_KERNEL kernel)
+{
+    int result;
+    if (!is_kernel_supported(kernel))
+    {
+        log_error("Scan kernel %d is not supported on this machine", (int)kernel);
+        result = __LINE__;
+    }
+    else
+    {
+        select_kernel(kernel);
+        result = 0;
+    }
+    return result;
+}
@@ -0,0 +1,321 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_timer_wheel.h"
+
+// Each level covers 64 times the span of the level below it, four levels
+// place a timer up to 4.6 hours ahead at a 1 millisecond resolution
+#define WHEEL_LEVEL_COUNT       4
+#define WHEEL_SLOT_BITS         6
+#define WHEEL_SLOT_COUNT        (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK         (WHEEL_SLOT_COUNT - 1)
+
+// Timers further out are parked in the last level and placed again when they get there
+#define WHEEL_MAX_DELTA         (((uint64_t)1 << (WHEEL_SLOT_BITS * WHEEL_LEVEL_COUNT)) - 1)
+
+typedef struct TIMER_LINK_TAG
+{
+    struct TIMER_LINK_TAG* prev;
+    struct TIMER_LINK_TAG* next;
+} TIMER_LINK;
+
+typedef struct HTTP_TIMER_INFO_TAG
+{
+    // Must stay first, a link is turned back into its timer with a cast
+    TIMER_LINK link;
+
+    uint64_t expire_ms;
+    ON_HTTP_TIMER_EXPIRED on_expired;
+    void* timer_ctx;
+} HTTP_TIMER_INFO;
+
+typedef struct HTTP_TIMER_WHEEL_INFO_TAG
+{
+    HTTP_ALLOCATOR allocator;
+
+    // The next tick to run, every timer before it has been called
+    uint64_t curr_tick;
+    size_t timer_count;
+
+    // Each slot is a circular list with the slot itself as the head
+    TIMER_LINK slot_list[WHEEL_LEVEL_COUNT][WHEEL_SLOT_COUNT];
+} HTTP_TIMER_WHEEL_INFO;
+
+static void init_list(TIMER_LINK* head)
+{
+    head->prev = head;
+    head->next = head;
+}
+
+static void append_link(TIMER_LINK* head, TIMER_LINK* link)
+{
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void remove_link(TIMER_LINK* link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = link;
+    link->next = link;
+}
+
+// Moves every link from one list to the other, the source list is left empty
+static void move_list(TIMER_LINK* from, TIMER_LINK* to)
+{
+    if (from->next == from)
+    {
+        init_list(to);
+    }
+    else
+    {
+        to->next = from->next;
+        to->prev = from->prev;
+        to->next->prev = to;
+        to->prev->next = to;
+        init_list(from);
+    }
+}
+
+static void place_timer(HTTP_TIMER_WHEEL_INFO* wheel, HTTP_TIMER_INFO* timer)
+{
+    size_t level = 0;
+    uint64_t delta;
+    if (timer->expire_ms < wheel->curr_tick)
+    {
+        // Already late, runs on the next tick
+        delta = 0;
+    }
+    else
+    {
+        delta = timer->expire_ms - wheel->curr_tick;
+        if (delta > WHEEL_MAX_DELTA)
+        {
+            delta = WHEEL_MAX_DELTA;
+        }
+    }
+
+    while (level < WHEEL_LEVEL_COUNT - 1 && delta >= ((uint64_t)1 << (WHEEL_SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    size_t slot = (size_t)(((wheel->curr_tick + delta) >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+    append_link(&wheel->slot_list[level][slot], &timer->link);
+}
+
+// Hands the timers of a slot down to the levels below, returns the slot index
+static size_t cascade_level(HTTP_TIMER_WHEEL_INFO* wheel, size_t level)
+{
+    TIMER_LINK cascade_list;
+    size_t slot = (size_t)((wheel->curr_tick >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+
+    move_list(&wheel->slot_list[level][slot], &cascade_list);
+    while (cascade_list.next != &cascade_list)
+    {
+        HTTP_TIMER_INFO* timer = (HTTP_TIMER_INFO*)cascade_list.next;
+        remove_link(&timer->link);
+        place_timer(wheel, timer);
+    }
+    return slot;
+}
+
+static void run_tick(HTTP_TIMER_WHEEL_INFO* wheel)
+{
+    TIMER_LINK expired_list;
+    size_t slot = (size_t)(wheel->curr_tick & WHEEL_SLOT_MASK);
+
+    // The lower level wrapped, bring the next span of timers down from above
+    if (slot == 0)
+    {
+        size_t level = 1;
+        while (level < WHEEL_LEVEL_COUNT && cascade_level(wheel, level) == 0)
+        {
+            level++;
+        }
+    }
+
+    // Timers added from a callback land on the following ticks
+    move_list(&wheel->slot_list[0][slot], &expired_list);
+    wheel->curr_tick++;
+
+    while (expired_list.next != &expired_list)
+    {
+        HTTP_TIMER_INFO* timer = (HTTP_TIMER_INFO*)expired_list.next;
+        ON_HTTP_TIMER_EXPIRED on_expired = timer->on_expired;
+        void* timer_ctx = timer->timer_ctx;
+
+        // A callback is free to cancel any other timer, including the ones left in this list
+        remove_link(&timer->link);
+        wheel->timer_count--;
+        http_alloc_free(&wheel->allocator, timer);
+        on_expired(timer_ctx);
+    }
+}
+
+HTTP_TIMER_WHEEL_HANDLE http_timer_wheel_create(uint64_t start_ms, const HTTP_ALLOCATOR* allocator)
+{
+    HTTP_TIMER_WHEEL_INFO* result;
+    if (allocator == NULL)
+    {
+        allocator = http_alloc_get_default();
+    }
+    if ((result = (HTTP_TIMER_WHEEL_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_TIMER_WHEEL_INFO))) == NULL)
+    {
+        log_error("Failure allocating timer wheel");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_TIMER_WHEEL_INFO));
+        result->allocator = *allocator;
+        result->curr_tick = start_ms;
+        for (size_t level = 0; level < WHEEL_LEVEL_COUNT; level++)
+        {
+            for (size_t slot = 0; slot < WHEEL_SLOT_COUNT; slot++)
+            {
+                init_list(&result->slot_list[level][slot]);
+            }
+        }
+    }
+    return result;
+}
+
+void http_timer_wheel_destroy(HTTP_TIMER_WHEEL_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        HTTP_ALLOCATOR allocator = handle->allocator;
+        for (size_t level = 0; level < WHEEL_LEVEL_COUNT && handle->timer_count > 0; level++)
+        {
+            for (size_t slot = 0; slot < WHEEL_SLOT_COUNT; slot++)
+            {
+                TIMER_LINK* head = &handle->slot_list[level][slot];
+                while (head->next != head)
+                {
+                    HTTP_TIMER_INFO* timer = (HTTP_TIMER_INFO*)head->next;
+                    remove_link(&timer->link);
+                    handle->timer_count--;
+                    http_alloc_free(&allocator, timer);
+                }
+            }
+        }
+        http_alloc_free(&allocator, handle);
+    }
+}
+
+HTTP_TIMER_HANDLE http_timer_wheel_add(HTTP_TIMER_WHEEL_HANDLE handle, uint64_t expire_ms, ON_HTTP_TIMER_EXPIRED on_expired, void* timer_ctx)
+{
+    HTTP_TIMER_INFO* result;
+    if (handle == NULL || on_expired == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, on_expired: %p", handle, on_expired);
+        result = NULL;
+    }
+    else if ((result = (HTTP_TIMER_INFO*)http_alloc_malloc(&handle->allocator, sizeof(HTTP_TIMER_INFO))) == NULL)
+    {
+        log_error("Failure allocating timer");
+    }
+    else
+    {
+        result->expire_ms = expire_ms;
+        result->on_expired = on_expired;
+        result->timer_ctx = timer_ctx;
+        place_timer(handle, result);
+        handle->timer_count++;
+    }
+    return result;
+}
+
+void http_timer_wheel_cancel(HTTP_TIMER_WHEEL_HANDLE handle, HTTP_TIMER_HANDLE timer)
+{
+    if (handle == NULL || timer == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, timer: %p", handle, timer);
+    }
+    else
+    {
+        remove_link(&timer->link);
+        handle->timer_count--;
+        http_alloc_free(&handle->allocator, timer);
+    }
+}
+
+void http_timer_wheel_advance(HTTP_TIMER_WHEEL_HANDLE handle, uint64_t now_ms)
+{
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+    }
+    else
+    {
+        while (handle->curr_tick <= now_ms)
+        {
+            if (handle->timer_count == 0)
+            {
+                // Nothing to call, skip the idle ticks
+                handle->curr_tick = now_ms + 1;
+            }
+            else
+            {
+                run_tick(handle);
+            }
+        }
+    }
+}
+
+size_t http_timer_wheel_get_count(HTTP_TIMER_WHEEL_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->timer_count;
+    }
+    return result;
+}
+
+uint64_t http_timer_wheel_get_next_expiry(HTTP_TIMER_WHEEL_HANDLE handle)
+{
+    uint64_t result = UINT64_MAX;
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+    }
+    else
+    {
+        // Timers sit in their slot by the time left when they were placed, not in expiry
+        // order, so every slot is looked at.  The scan stops once every timer is seen
+        size_t remaining = handle->timer_count;
+        for (size_t level = 0; level < WHEEL_LEVEL_COUNT && remaining > 0; level++)
+        {
+            for (size_t slot = 0; slot < WHEEL_SLOT_COUNT && remaining > 0; slot++)
+            {
+                const TIMER_LINK* head = &handle->slot_list[level][slot];
+                for (const TIMER_LINK* link = head->next; link != head; link = link->next)
+                {
+                    const HTTP_TIMER_INFO* timer = (const HTTP_TIMER_INFO*)link;
+                    if (timer->expire_ms < result)
+                    {
+                        result = timer->expire_ms;
+                    }
+                    remaining--;
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,707 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_tls.h"
+
+#ifdef HTTP_CLIENT_USE_OPENSSL
+#include <limits.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#define TLS_READ_BLOCK_SIZE         (16 * 1024)
+
+// Hosts with a session kept, the oldest one is replaced when it is full
+#define TLS_SESSION_CACHE_SIZE      32
+
+// A host name of up to 255 characters, the port and the separator
+#define TLS_SESSION_KEY_SIZE        264
+
+typedef enum TLS_STATE_TAG
+{
+    TLS_STATE_NOT_OPEN,
+    TLS_STATE_HANDSHAKE,
+    TLS_STATE_OPEN,
+    TLS_STATE_CLOSED,
+    TLS_STATE_ERROR
+} TLS_STATE;
+
+typedef struct TLS_SESSION_ENTRY_TAG
+{
+    char session_key[TLS_SESSION_KEY_SIZE];
+    SSL_SESSION* session;
+} TLS_SESSION_ENTRY;
+
+typedef struct HTTP_TLS_CACHE_INFO_TAG
+{
+    SSL_CTX* ssl_ctx;
+
+    // Held by the creator and every connection
+    size_t ref_count;
+
+    TLS_SESSION_ENTRY session_list[TLS_SESSION_CACHE_SIZE];
+    size_t session_count;
+    size_t next_replace;
+} HTTP_TLS_CACHE_INFO;
+
+typedef struct HTTP_TLS_INFO_TAG
+{
+    HTTP_TLS_CACHE_INFO* cache;
+    SSL* ssl;
+
+    // Network side of the connection, records received are written to in_bio and the
+    // records to send are taken from out_bio
+    BIO* in_bio;
+    BIO* out_bio;
+
+    TLS_STATE state;
+    HTTP_TLS_CALLBACK_INFO callback_info;
+    ON_IO_OPEN_COMPLETE on_open_complete;
+    void* on_open_complete_ctx;
+
+    char session_key[TLS_SESSION_KEY_SIZE];
+    unsigned char read_block[TLS_READ_BLOCK_SIZE];
+} HTTP_TLS_INFO;
+
+static void log_ssl_error(const char* message)
+{
+    unsigned long error_code = ERR_get_error();
+    char error_text[256];
+    if (error_code == 0)
+    {
+        log_error("%s", message);
+    }
+    else
+    {
+        ERR_error_string_n(error_code, error_text, sizeof(error_text));
+        log_error("%s: %s", message, error_text);
+    }
+    ERR_clear_error();
+}
+
+static TLS_SESSION_ENTRY* find_session(HTTP_TLS_CACHE_INFO* cache, const char* session_key)
+{
+    TLS_SESSION_ENTRY* result = NULL;
+    for (size_t index = 0; index < cache->session_count && result == NULL; index++)
+    {
+        if (strcmp(cache->session_list[index].session_key, session_key) == 0)
+        {
+            result = &cache->session_list[index];
+        }
+    }
+    return result;
+}
+
+static void remove_session(HTTP_TLS_CACHE_INFO* cache, const char* session_key)
+{
+    TLS_SESSION_ENTRY* entry = find_session(cache, session_key);
+    if (entry != NULL)
+    {
+        // Keeps the list packed, the order only matters for picking the one to replace
+        SSL_SESSION_free(entry->session);
+        *entry = cache->session_list[cache->session_count - 1];
+        cache->session_count--;
+        if (cache->next_replace >= cache->session_count)
+        {
+            cache->next_replace = 0;
+        }
+    }
+}
+
+// Called by OpenSSL for every session the server hands out, with TLS 1.3 that is after
+// the handshake when the ticket arrives
+static int on_new_session(SSL* ssl, SSL_SESSION* session)
+{
+    int result;
+    HTTP_TLS_INFO* tls_info = (HTTP_TLS_INFO*)SSL_get_app_data(ssl);
+    if (tls_info == NULL || !SSL_SESSION_is_resumable(session))
+    {
+        result = 0;
+    }
+    else
+    {
+        HTTP_TLS_CACHE_INFO* cache = tls_info->cache;
+        TLS_SESSION_ENTRY* entry = find_session(cache, tls_info->session_key);
+        if (entry != NULL)
+        {
+            SSL_SESSION_free(entry->session);
+        }
+        else if (cache->session_count < TLS_SESSION_CACHE_SIZE)
+        {
+            entry = &cache->session_list[cache->session_count++];
+        }
+        else
+        {
+            entry = &cache->session_list[cache->next_replace];
+            cache->next_replace = (cache->next_replace + 1) % TLS_SESSION_CACHE_SIZE;
+            SSL_SESSION_free(entry->session);
+        }
+        memcpy(entry->session_key, tls_info->session_key, TLS_SESSION_KEY_SIZE);
+        entry->session = session;
+
+        // The cache keeps the reference OpenSSL handed over
+        result = 1;
+    }
+    return result;
+}
+
+static int load_trusted_certs(SSL_CTX* ssl_ctx, const char* trusted_certs)
+{
+    int result;
+    if (trusted_certs == NULL)
+    {
+        result = SSL_CTX_set_default_verify_paths(ssl_ctx) == 1 ? 0 : __LINE__;
+    }
+    else
+    {
+        BIO* cert_bio;
+        if ((cert_bio = BIO_new_mem_buf(trusted_certs, -1)) == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            X509_STORE* cert_store = SSL_CTX_get_cert_store(ssl_ctx);
+            size_t cert_count = 0;
+            X509* cert;
+            result = 0;
+            while (result == 0 && (cert = PEM_read_bio_X509(cert_bio, NULL, NULL, NULL)) != NULL)
+            {
+                if (X509_STORE_add_cert(cert_store, cert) != 1)
+                {
+                    result = __LINE__;
+                }
+                cert_count++;
+                X509_free(cert);
+            }
+            if (result == 0 && cert_count == 0)
+            {
+                result = __LINE__;
+            }
+            else if (result == 0)
+            {
+                // Reading past the last certificate leaves an end of data error behind
+                ERR_clear_error();
+            }
+            BIO_free(cert_bio);
+        }
+    }
+    return result;
+}
+
+static int send_records(HTTP_TLS_INFO* tls_info, ON_SEND_COMPLETE on_send_complete, void* callback_ctx)
+{
+    int result;
+    char* data;
+    long length = BIO_get_mem_data(tls_info->out_bio, &data);
+    if (length <= 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        if (tls_info->callback_info.on_send(tls_info->callback_info.on_send_ctx, (const unsigned char*)data, (size_t)length, on_send_complete, callback_ctx) != 0)
+        {
+            log_error("Failure sending tls records");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+        (void)BIO_reset(tls_info->out_bio);
+    }
+    return result;
+}
+
+static void set_error(HTTP_TLS_INFO* tls_info, IO_ERROR_RESULT error_result)
+{
+    tls_info->state = error_result == IO_ERROR_ENDPOINT_DISCONN ? TLS_STATE_CLOSED : TLS_STATE_ERROR;
+    if (tls_info->callback_info.on_io_error != NULL)
+    {
+        tls_info->callback_info.on_io_error(tls_info->callback_info.on_io_error_ctx, error_result);
+    }
+}
+
+static void read_records(HTTP_TLS_INFO* tls_info)
+{
+    bool is_reading = true;
+    while (is_reading)
+    {
+        int read_len = SSL_read(tls_info->ssl, tls_info->read_block, TLS_READ_BLOCK_SIZE);
+        if (read_len > 0)
+        {
+            tls_info->callback_info.on_bytes_received(tls_info->callback_info.on_bytes_received_ctx, tls_info->read_block, (size_t)read_len);
+        }
+        else
+        {
+            int ssl_error = SSL_get_error(tls_info->ssl, read_len);
+            is_reading = false;
+            if (ssl_error == SSL_ERROR_ZERO_RETURN)
+            {
+                ERR_clear_error();
+                set_error(tls_info, IO_ERROR_ENDPOINT_DISCONN);
+            }
+            else if (ssl_error != SSL_ERROR_WANT_READ)
+            {
+                log_ssl_error("Failure reading tls records");
+                set_error(tls_info, IO_ERROR_GENERAL);
+            }
+        }
+    }
+
+    // Reading can produce records of its own such as a key update reply
+    if (tls_info->state == TLS_STATE_OPEN && send_records(tls_info, NULL, NULL) != 0)
+    {
+        set_error(tls_info, IO_ERROR_GENERAL);
+    }
+}
+
+static void continue_handshake(HTTP_TLS_INFO* tls_info)
+{
+    int handshake_result = SSL_do_handshake(tls_info->ssl);
+    int ssl_error = handshake_result == 1 ? SSL_ERROR_NONE : SSL_get_error(tls_info->ssl, handshake_result);
+
+    if (send_records(tls_info, NULL, NULL) != 0)
+    {
+        ssl_error = SSL_ERROR_SYSCALL;
+    }
+
+    if (ssl_error == SSL_ERROR_NONE)
+    {
+        tls_info->state = TLS_STATE_OPEN;
+        tls_info->on_open_complete(tls_info->on_open_complete_ctx, IO_OPEN_OK);
+        // Records that came in behind the server's last handshake message
+        if (tls_info->state == TLS_STATE_OPEN)
+        {
+            read_records(tls_info);
+        }
+    }
+    else if (ssl_error != SSL_ERROR_WANT_READ)
+    {
+        long verify_result = SSL_get_verify_result(tls_info->ssl);
+        if (verify_result != X509_V_OK)
+        {
+            log_error("Failure verifying the server certificate: %s", X509_verify_cert_error_string(verify_result));
+        }
+        log_ssl_error("Failure in tls handshake");
+
+        // Do not offer a session that may have caused the failure again
+        remove_session(tls_info->cache, tls_info->session_key);
+        tls_info->state = TLS_STATE_ERROR;
+        tls_info->on_open_complete(tls_info->on_open_complete_ctx, IO_OPEN_ERROR);
+    }
+}
+
+static int set_peer_name(SSL* ssl, const char* hostname)
+{
+    int result;
+    // Addresses are matched against the certificate's IP entries and are not sent as the server name
+    if (X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(ssl), hostname) == 1)
+    {
+        result = 0;
+    }
+    else
+    {
+        ERR_clear_error();
+        if (SSL_set_tlsext_host_name(ssl, hostname) != 1 || SSL_set1_host(ssl, hostname) != 1)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+#endif
+
+bool http_tls_is_available(void)
+{
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+}
+
+HTTP_TLS_CACHE_HANDLE http_tls_cache_create(const char* trusted_certs)
+{
+    HTTP_TLS_CACHE_HANDLE result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if ((result = (HTTP_TLS_CACHE_INFO*)http_alloc_malloc(NULL, sizeof(HTTP_TLS_CACHE_INFO))) == NULL)
+    {
+        log_error("Failure allocating tls cache");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_TLS_CACHE_INFO));
+        result->ref_count = 1;
+        if ((result->ssl_ctx = SSL_CTX_new(TLS_client_method())) == NULL)
+        {
+            log_ssl_error("Failure creating the tls context");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if (SSL_CTX_set_min_proto_version(result->ssl_ctx, TLS1_2_VERSION) != 1 ||
+            load_trusted_certs(result->ssl_ctx, trusted_certs) != 0)
+        {
+            log_ssl_error("Failure loading the trusted certificates");
+            SSL_CTX_free(result->ssl_ctx);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            SSL_CTX_set_verify(result->ssl_ctx, SSL_VERIFY_PEER, NULL);
+            // Sessions are only kept in this cache where they are looked up by host
+            SSL_CTX_set_session_cache_mode(result->ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(result->ssl_ctx, on_new_session);
+        }
+    }
+#else
+    (void)trusted_certs;
+    log_error("TLS is not available, the library was built without OpenSSL");
+    result = NULL;
+#endif
+    return result;
+}
+
+void http_tls_cache_destroy(HTTP_TLS_CACHE_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle != NULL && --handle->ref_count == 0)
+    {
+        for (size_t index = 0; index < handle->session_count; index++)
+        {
+            SSL_SESSION_free(handle->session_list[index].session);
+        }
+        SSL_CTX_free(handle->ssl_ctx);
+        http_alloc_free(NULL, handle);
+    }
+#else
+    (void)handle;
+#endif
+}
+
+int http_tls_cache_add_ref(HTTP_TLS_CACHE_HANDLE handle)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->ref_count++;
+        result = 0;
+    }
+#else
+    (void)handle;
+    log_error("TLS is not available, the library was built without OpenSSL");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+size_t http_tls_cache_get_count(HTTP_TLS_CACHE_HANDLE handle)
+{
+    size_t result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->session_count;
+    }
+#else
+    (void)handle;
+    result = 0;
+#endif
+    return result;
+}
+
+HTTP_TLS_HANDLE http_tls_create(HTTP_TLS_CACHE_HANDLE cache, const char* hostname, uint16_t port, const HTTP_TLS_CALLBACK_INFO* callback_info)
+{
+    HTTP_TLS_HANDLE result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (cache == NULL || hostname == NULL || callback_info == NULL || callback_info->on_send == NULL || callback_info->on_bytes_received == NULL)
+    {
+        log_error("Invalid argument specified cache: %p, hostname: %p, callback_info: %p", cache, hostname, callback_info);
+        result = NULL;
+    }
+    else if (strlen(hostname) > 255)
+    {
+        log_error("Invalid argument hostname is longer than 255 characters");
+        result = NULL;
+    }
+    else if ((result = (HTTP_TLS_INFO*)http_alloc_malloc(NULL, sizeof(HTTP_TLS_INFO))) == NULL)
+    {
+        log_error("Failure allocating tls connection");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_TLS_INFO));
+        result->cache = cache;
+        result->callback_info = *callback_info;
+        (void)snprintf(result->session_key, TLS_SESSION_KEY_SIZE, "%s:%u", hostname, (unsigned int)port);
+
+        if ((result->ssl = SSL_new(cache->ssl_ctx)) == NULL)
+        {
+            log_ssl_error("Failure creating the tls connection");
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else if ((result->in_bio = BIO_new(BIO_s_mem())) == NULL || (result->out_bio = BIO_new(BIO_s_mem())) == NULL)
+        {
+            log_ssl_error("Failure creating the tls buffers");
+            BIO_free(result->in_bio);
+            SSL_free(result->ssl);
+            http_alloc_free(NULL, result);
+            result = NULL;
+        }
+        else
+        {
+            // The connection owns both buffers from here on
+            SSL_set_bio(result->ssl, result->in_bio, result->out_bio);
+            SSL_set_connect_state(result->ssl);
+            SSL_set_app_data(result->ssl, result);
+            if (set_peer_name(result->ssl, hostname) != 0)
+            {
+                log_ssl_error("Failure setting the server name");
+                SSL_free(result->ssl);
+                http_alloc_free(NULL, result);
+                result = NULL;
+            }
+            else
+            {
+                cache->ref_count++;
+            }
+        }
+    }
+#else
+    (void)cache;
+    (void)hostname;
+    (void)port;
+    (void)callback_info;
+    log_error("TLS is not available, the library was built without OpenSSL");
+    result = NULL;
+#endif
+    return result;
+}
+
+void http_tls_destroy(HTTP_TLS_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle != NULL)
+    {
+        // OpenSSL stops offering the session of a connection freed without a shutdown,
+        // a connection that ended cleanly keeps it for the next one
+        if (handle->state == TLS_STATE_OPEN || handle->state == TLS_STATE_CLOSED)
+        {
+            SSL_set_shutdown(handle->ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
+        SSL_free(handle->ssl);
+        http_tls_cache_destroy(handle->cache);
+        http_alloc_free(NULL, handle);
+    }
+#else
+    (void)handle;
+#endif
+}
+
+int http_tls_open(HTTP_TLS_HANDLE handle, ON_IO_OPEN_COMPLETE on_open_complete, void* on_open_complete_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle == NULL || on_open_complete == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, on_open_complete: %p", handle, on_open_complete);
+        result = __LINE__;
+    }
+    else if (handle->state != TLS_STATE_NOT_OPEN)
+    {
+        log_error("Open attempt on a tls connection that was already opened");
+        result = __LINE__;
+    }
+    else
+    {
+        TLS_SESSION_ENTRY* entry = find_session(handle->cache, handle->session_key);
+        if (entry != NULL && SSL_set_session(handle->ssl, entry->session) != 1)
+        {
+            // Not fatal, the handshake is simply a full one
+            log_ssl_error("Failure offering the cached session");
+        }
+
+        handle->on_open_complete = on_open_complete;
+        handle->on_open_complete_ctx = on_open_complete_ctx;
+        handle->state = TLS_STATE_HANDSHAKE;
+        int handshake_result = SSL_do_handshake(handle->ssl);
+        if (handshake_result != 1 && SSL_get_error(handle->ssl, handshake_result) != SSL_ERROR_WANT_READ)
+        {
+            log_ssl_error("Failure starting the tls handshake");
+            handle->state = TLS_STATE_ERROR;
+            result = __LINE__;
+        }
+        else if (send_records(handle, NULL, NULL) != 0)
+        {
+            handle->state = TLS_STATE_ERROR;
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+#else
+    (void)handle;
+    (void)on_open_complete;
+    (void)on_open_complete_ctx;
+    log_error("TLS is not available, the library was built without OpenSSL");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+void http_tls_on_bytes_received(void* context, const unsigned char* buffer, size_t size)
+{
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    HTTP_TLS_INFO* tls_info = (HTTP_TLS_INFO*)context;
+    if (tls_info == NULL || buffer == NULL || size == 0)
+    {
+        log_error("Invalid argument specified context: %p, buffer: %p, size: %zu", context, buffer, size);
+    }
+    else if (tls_info->state == TLS_STATE_HANDSHAKE || tls_info->state == TLS_STATE_OPEN)
+    {
+        // Memory buffers take every byte, the only failure is running out of memory
+        bool is_buffered = true;
+        while (size > 0 && is_buffered)
+        {
+            int part_len = size > INT_MAX ? INT_MAX : (int)size;
+            if (BIO_write(tls_info->in_bio, buffer, part_len) != part_len)
+            {
+                is_buffered = false;
+            }
+            buffer += part_len;
+            size -= (size_t)part_len;
+        }
+
+        if (!is_buffered)
+        {
+            log_ssl_error("Failure buffering tls records");
+            if (tls_info->state == TLS_STATE_HANDSHAKE)
+            {
+                tls_info->state = TLS_STATE_ERROR;
+                tls_info->on_open_complete(tls_info->on_open_complete_ctx, IO_OPEN_ERROR);
+            }
+            else
+            {
+                set_error(tls_info, IO_ERROR_MEMORY);
+            }
+        }
+        else if (tls_info->state == TLS_STATE_HANDSHAKE)
+        {
+            continue_handshake(tls_info);
+        }
+        else
+        {
+            read_records(tls_info);
+        }
+    }
+#else
+    (void)context;
+    (void)buffer;
+    (void)size;
+#endif
+}
+
+int http_tls_send(HTTP_TLS_HANDLE handle, const unsigned char* data, size_t length, ON_SEND_COMPLETE on_send_complete, void* callback_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle == NULL || data == NULL || length == 0)
+    {
+        log_error("Invalid argument specified handle: %p, data: %p, length: %zu", handle, data, length);
+        result = __LINE__;
+    }
+    else if (handle->state != TLS_STATE_OPEN)
+    {
+        log_error("Send attempt on a tls connection that is not open");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+        while (result == 0 && length > 0)
+        {
+            int part_len = length > INT_MAX ? INT_MAX : (int)length;
+            if (SSL_write(handle->ssl, data, part_len) != part_len)
+            {
+                log_ssl_error("Failure encrypting data");
+                result = __LINE__;
+            }
+            else
+            {
+                data += part_len;
+                length -= (size_t)part_len;
+            }
+        }
+
+        // The records go out in one send so the completion matches the caller's data
+        if (result != 0)
+        {
+            (void)BIO_reset(handle->out_bio);
+        }
+        else if (send_records(handle, on_send_complete, callback_ctx) != 0)
+        {
+            result = __LINE__;
+        }
+    }
+#else
+    (void)handle;
+    (void)data;
+    (void)length;
+    (void)on_send_complete;
+    (void)callback_ctx;
+    log_error("TLS is not available, the library was built without OpenSSL");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+bool http_tls_is_resumed(HTTP_TLS_HANDLE handle)
+{
+    bool result;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = false;
+    }
+    else
+    {
+        result = handle->state == TLS_STATE_OPEN && SSL_session_reused(handle->ssl) == 1;
+    }
+#else
+    (void)handle;
+    result = false;
+#endif
+    return result;
+}
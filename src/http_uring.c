@@ -0,0 +1,1262 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+
+#include "http_client/http_alloc.h"
+#include "http_client/http_uring.h"
+
+#ifdef HTTP_CLIENT_USE_URING
+#include <errno.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/io_uring.h>
+
+// Completions outnumber submissions with multishot receive
+#define URING_CQ_MULTIPLIER         4
+#define URING_MIN_QUEUE_DEPTH       8
+#define URING_PROBE_OPS             256
+
+// Buffers the kernel picks from for every receive on the ring, the count is a power of 2
+#define URING_BUFFER_GROUP          1
+#define URING_RECV_BUFFER_SIZE      (16 * 1024)
+#define URING_RECV_BUFFER_COUNT     64
+
+// Sends of one connection linked into a single chain per submission
+#define URING_MAX_LINKED_SENDS      16
+
+// The operation is kept in the low bits of the user data next to the connection pointer
+#define URING_OP_MASK               ((uint64_t)0x7)
+
+typedef enum URING_OP_TAG
+{
+    URING_OP_CONNECT = 1,
+    URING_OP_RECV,
+    URING_OP_SEND,
+    URING_OP_CANCEL
+} URING_OP;
+
+typedef enum URING_CONN_STATE_TAG
+{
+    URING_CONN_STATE_NOT_OPEN,
+    URING_CONN_STATE_OPENING,
+    URING_CONN_STATE_OPEN,
+    URING_CONN_STATE_CLOSING,
+    URING_CONN_STATE_CLOSED,
+    URING_CONN_STATE_ERROR
+} URING_CONN_STATE;
+
+typedef struct URING_SEND_ITEM_TAG
+{
+    struct URING_SEND_ITEM_TAG* next;
+    ON_SEND_COMPLETE on_send_complete;
+    void* callback_ctx;
+    size_t length;
+    size_t offset;
+    unsigned char data[];
+} URING_SEND_ITEM;
+
+typedef struct HTTP_URING_CONN_INFO_TAG
+{
+    struct HTTP_URING_INFO_TAG* uring;
+    struct HTTP_URING_CONN_INFO_TAG* prev;
+    struct HTTP_URING_CONN_INFO_TAG* next;
+    struct HTTP_URING_CONN_INFO_TAG* next_dirty;
+    bool in_dirty_list;
+
+    int socket;
+    URING_CONN_STATE state;
+    char* hostname;
+    uint16_t port;
+    ADDRESS_TYPE address_type;
+
+    // Read by the kernel until the connect completes
+    struct sockaddr_storage address;
+    socklen_t address_len;
+
+    PATCHCORD_CALLBACK_INFO callback_info;
+    ON_IO_OPEN_COMPLETE on_open_complete;
+    void* on_open_complete_ctx;
+    ON_IO_CLOSE_COMPLETE on_close_complete;
+    void* on_close_complete_ctx;
+
+    // The first in_flight_sends items are submitted, send_cursor is the one the next send
+    // completion belongs to
+    URING_SEND_ITEM* send_head;
+    URING_SEND_ITEM* send_tail;
+    URING_SEND_ITEM* send_cursor;
+    size_t in_flight_sends;
+
+    // Operations the kernel still holds the connection for, it is only freed once they drain
+    size_t pending_ops;
+    size_t callback_depth;
+    bool destroyed;
+} HTTP_URING_CONN_INFO;
+
+typedef struct HTTP_URING_INFO_TAG
+{
+    HTTP_ALLOCATOR allocator;
+    int ring_fd;
+
+    // Held by the creator and every client the ring is set on
+    size_t ref_count;
+    bool processing;
+    bool free_pending;
+
+    void* ring_ptr;
+    size_t ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_flags;
+    unsigned* sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sqe_tail;
+
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe* cqes;
+
+    struct io_uring_buf_ring* buf_ring;
+    size_t buf_ring_size;
+    unsigned char* buffers;
+    uint16_t buf_tail;
+
+    HTTP_URING_CONN_INFO* conn_list;
+    HTTP_URING_CONN_INFO* dirty_list;
+} HTTP_URING_INFO;
+
+static int uring_setup(unsigned entries, struct io_uring_params* params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int ring_fd, unsigned to_submit, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, flags, NULL, 0);
+}
+
+static int uring_register(int ring_fd, unsigned opcode, void* arg, unsigned nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args);
+}
+
+static bool probe_uring(void)
+{
+    bool result = false;
+    struct io_uring_params params;
+    int ring_fd;
+
+    memset(&params, 0, sizeof(params));
+    if ((ring_fd = uring_setup(2, &params)) < 0)
+    {
+        log_error("io_uring is not available on this system: %d", errno);
+    }
+    else
+    {
+        uint64_t probe_space[(sizeof(struct io_uring_probe) + URING_PROBE_OPS * sizeof(struct io_uring_probe_op)) / sizeof(uint64_t)];
+        struct io_uring_probe* probe = (struct io_uring_probe*)probe_space;
+
+        memset(probe_space, 0, sizeof(probe_space));
+        // Multishot receive came in the same kernel release as zero copy send, which can be probed for
+        if (uring_register(ring_fd, IORING_REGISTER_PROBE, probe, URING_PROBE_OPS) == 0 && probe->last_op >= IORING_OP_SEND_ZC &&
+            (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED) != 0)
+        {
+            result = true;
+        }
+        close(ring_fd);
+    }
+    return result;
+}
+
+static int map_rings(HTTP_URING_INFO* uring, const struct io_uring_params* params)
+{
+    int result;
+    size_t sq_size = params->sq_off.array + params->sq_entries * sizeof(unsigned);
+    size_t cq_size = params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+
+    uring->ring_size = sq_size > cq_size ? sq_size : cq_size;
+    uring->sqes_size = params->sq_entries * sizeof(struct io_uring_sqe);
+    if ((uring->ring_ptr = mmap(NULL, uring->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->ring_fd, IORING_OFF_SQ_RING)) == MAP_FAILED)
+    {
+        log_error("Failure mapping the submission ring: %d", errno);
+        uring->ring_ptr = NULL;
+        result = __LINE__;
+    }
+    else if ((uring->sqes = (struct io_uring_sqe*)mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->ring_fd, IORING_OFF_SQES)) == MAP_FAILED)
+    {
+        log_error("Failure mapping the submission entries: %d", errno);
+        munmap(uring->ring_ptr, uring->ring_size);
+        uring->ring_ptr = NULL;
+        uring->sqes = NULL;
+        result = __LINE__;
+    }
+    else
+    {
+        unsigned char* ring_ptr = (unsigned char*)uring->ring_ptr;
+        uring->sq_head = (unsigned*)(ring_ptr + params->sq_off.head);
+        uring->sq_tail = (unsigned*)(ring_ptr + params->sq_off.tail);
+        uring->sq_flags = (unsigned*)(ring_ptr + params->sq_off.flags);
+        uring->sq_array = (unsigned*)(ring_ptr + params->sq_off.array);
+        uring->sq_mask = *(unsigned*)(ring_ptr + params->sq_off.ring_mask);
+        uring->sq_entries = params->sq_entries;
+        uring->sqe_tail = *uring->sq_tail;
+
+        uring->cq_head = (unsigned*)(ring_ptr + params->cq_off.head);
+        uring->cq_tail = (unsigned*)(ring_ptr + params->cq_off.tail);
+        uring->cq_mask = *(unsigned*)(ring_ptr + params->cq_off.ring_mask);
+        uring->cqes = (struct io_uring_cqe*)(ring_ptr + params->cq_off.cqes);
+        result = 0;
+    }
+    return result;
+}
+
+static void recycle_buffer(HTTP_URING_INFO* uring, uint16_t buffer_id)
+{
+    struct io_uring_buf* buffer = &uring->buf_ring->bufs[uring->buf_tail & (URING_RECV_BUFFER_COUNT - 1)];
+    buffer->addr = (uint64_t)(uintptr_t)(uring->buffers + (size_t)buffer_id * URING_RECV_BUFFER_SIZE);
+    buffer->len = URING_RECV_BUFFER_SIZE;
+    buffer->bid = buffer_id;
+    uring->buf_tail++;
+    __atomic_store_n(&uring->buf_ring->tail, uring->buf_tail, __ATOMIC_RELEASE);
+}
+
+static int register_buffers(HTTP_URING_INFO* uring)
+{
+    int result;
+    struct io_uring_buf_reg buf_reg;
+
+    uring->buf_ring_size = URING_RECV_BUFFER_COUNT * sizeof(struct io_uring_buf);
+    if ((uring->buffers = (unsigned char*)http_alloc_malloc(&uring->allocator, (size_t)URING_RECV_BUFFER_COUNT * URING_RECV_BUFFER_SIZE)) == NULL)
+    {
+        log_error("Failure allocating receive buffers");
+        result = __LINE__;
+    }
+    else if ((uring->buf_ring = (struct io_uring_buf_ring*)mmap(NULL, uring->buf_ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+    {
+        log_error("Failure mapping the buffer ring: %d", errno);
+        uring->buf_ring = NULL;
+        result = __LINE__;
+    }
+    else
+    {
+        memset(&buf_reg, 0, sizeof(buf_reg));
+        buf_reg.ring_addr = (uint64_t)(uintptr_t)uring->buf_ring;
+        buf_reg.ring_entries = URING_RECV_BUFFER_COUNT;
+        buf_reg.bgid = URING_BUFFER_GROUP;
+        if (uring_register(uring->ring_fd, IORING_REGISTER_PBUF_RING, &buf_reg, 1) != 0)
+        {
+            log_error("Failure registering the receive buffers: %d", errno);
+            result = __LINE__;
+        }
+        else
+        {
+            uring->buf_tail = 0;
+            for (uint16_t index = 0; index < URING_RECV_BUFFER_COUNT; index++)
+            {
+                recycle_buffer(uring, index);
+            }
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static void unmap_uring(HTTP_URING_INFO* uring)
+{
+    if (uring->ring_fd >= 0)
+    {
+        // Closing the ring cancels whatever the kernel still holds
+        close(uring->ring_fd);
+    }
+    if (uring->buf_ring != NULL)
+    {
+        munmap(uring->buf_ring, uring->buf_ring_size);
+    }
+    if (uring->sqes != NULL)
+    {
+        munmap(uring->sqes, uring->sqes_size);
+    }
+    if (uring->ring_ptr != NULL)
+    {
+        munmap(uring->ring_ptr, uring->ring_size);
+    }
+    http_alloc_free(&uring->allocator, uring->buffers);
+}
+
+static unsigned get_sq_space(HTTP_URING_INFO* uring)
+{
+    return uring->sq_entries - (uring->sqe_tail - __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE));
+}
+
+static int submit_pending(HTTP_URING_INFO* uring, unsigned enter_flags)
+{
+    int result;
+    unsigned to_submit = uring->sqe_tail - __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+
+    __atomic_store_n(uring->sq_tail, uring->sqe_tail, __ATOMIC_RELEASE);
+    if (to_submit == 0 && enter_flags == 0)
+    {
+        result = 0;
+    }
+    else if (uring_enter(uring->ring_fd, to_submit, enter_flags) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+    {
+        log_error("Failure submitting to the ring: %d", errno);
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+// Makes room for count entries, the entries of a chain must all be submitted together
+static bool reserve_sq_space(HTTP_URING_INFO* uring, unsigned count)
+{
+    if (get_sq_space(uring) < count)
+    {
+        (void)submit_pending(uring, 0);
+    }
+    return get_sq_space(uring) >= count;
+}
+
+static struct io_uring_sqe* get_sqe(HTTP_URING_CONN_INFO* conn, URING_OP op)
+{
+    HTTP_URING_INFO* uring = conn->uring;
+    unsigned index = uring->sqe_tail & uring->sq_mask;
+    struct io_uring_sqe* result = &uring->sqes[index];
+
+    memset(result, 0, sizeof(struct io_uring_sqe));
+    result->fd = conn->socket;
+    result->user_data = (uint64_t)(uintptr_t)conn | (uint64_t)op;
+    uring->sq_array[index] = index;
+    uring->sqe_tail++;
+    conn->pending_ops++;
+    return result;
+}
+
+static void add_dirty(HTTP_URING_CONN_INFO* conn)
+{
+    if (!conn->in_dirty_list)
+    {
+        conn->in_dirty_list = true;
+        conn->next_dirty = conn->uring->dirty_list;
+        conn->uring->dirty_list = conn;
+    }
+}
+
+static void free_conn(HTTP_URING_CONN_INFO* conn)
+{
+    HTTP_URING_INFO* uring = conn->uring;
+    URING_SEND_ITEM* item = conn->send_head;
+    while (item != NULL)
+    {
+        URING_SEND_ITEM* next = item->next;
+        http_alloc_free(&uring->allocator, item);
+        item = next;
+    }
+    if (conn->socket >= 0)
+    {
+        close(conn->socket);
+    }
+    if (conn->prev != NULL)
+    {
+        conn->prev->next = conn->next;
+    }
+    else
+    {
+        uring->conn_list = conn->next;
+    }
+    if (conn->next != NULL)
+    {
+        conn->next->prev = conn->prev;
+    }
+    http_alloc_free(&uring->allocator, conn->hostname);
+    http_alloc_free(&uring->allocator, conn);
+}
+
+static void release_if_idle(HTTP_URING_CONN_INFO* conn)
+{
+    if (conn->destroyed && conn->pending_ops == 0 && conn->callback_depth == 0 && !conn->in_dirty_list)
+    {
+        free_conn(conn);
+    }
+}
+
+// Returns false when the callback destroyed the connection, it must not be touched after that
+static bool end_callback(HTTP_URING_CONN_INFO* conn)
+{
+    bool result;
+    conn->callback_depth--;
+    if (conn->destroyed)
+    {
+        release_if_idle(conn);
+        result = false;
+    }
+    else
+    {
+        result = true;
+    }
+    return result;
+}
+
+static void report_io_error(HTTP_URING_CONN_INFO* conn, IO_ERROR_RESULT error_result)
+{
+    conn->state = URING_CONN_STATE_ERROR;
+    if (conn->callback_info.on_io_error != NULL)
+    {
+        conn->callback_depth++;
+        conn->callback_info.on_io_error(conn->callback_info.on_io_error_ctx, error_result);
+        (void)end_callback(conn);
+    }
+}
+
+static void cancel_operations(HTTP_URING_CONN_INFO* conn)
+{
+    if (conn->pending_ops > 0 && conn->socket >= 0)
+    {
+        if (reserve_sq_space(conn->uring, 1))
+        {
+            struct io_uring_sqe* sqe = get_sqe(conn, URING_OP_CANCEL);
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+        }
+        else
+        {
+            // The operations still end once the socket can no longer be used
+            (void)shutdown(conn->socket, SHUT_RDWR);
+        }
+    }
+}
+
+static int arm_receive(HTTP_URING_CONN_INFO* conn)
+{
+    int result;
+    if (!reserve_sq_space(conn->uring, 1))
+    {
+        log_error("Failure arming the receive, the ring is full");
+        result = __LINE__;
+    }
+    else
+    {
+        struct io_uring_sqe* sqe = get_sqe(conn, URING_OP_RECV);
+        sqe->opcode = IORING_OP_RECV;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = URING_BUFFER_GROUP;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        result = 0;
+    }
+    return result;
+}
+
+static void submit_send_chain(HTTP_URING_CONN_INFO* conn)
+{
+    unsigned count = 0;
+    struct io_uring_sqe* prev_sqe = NULL;
+
+    for (URING_SEND_ITEM* item = conn->send_head; item != NULL && count < URING_MAX_LINKED_SENDS; item = item->next)
+    {
+        count++;
+    }
+    if (!reserve_sq_space(conn->uring, count))
+    {
+        count = get_sq_space(conn->uring);
+    }
+    if (count == 0)
+    {
+        // Tried again on the next process once the kernel has taken the queued entries
+        add_dirty(conn);
+    }
+    else
+    {
+        URING_SEND_ITEM* item = conn->send_head;
+        conn->send_cursor = item;
+        conn->in_flight_sends = count;
+        for (unsigned index = 0; index < count; index++, item = item->next)
+        {
+            struct io_uring_sqe* sqe = get_sqe(conn, URING_OP_SEND);
+            sqe->opcode = IORING_OP_SEND;
+            sqe->addr = (uint64_t)(uintptr_t)(item->data + item->offset);
+            sqe->len = (uint32_t)(item->length - item->offset);
+            sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+            if (prev_sqe != NULL)
+            {
+                prev_sqe->flags |= IOSQE_IO_LINK;
+            }
+            prev_sqe = sqe;
+        }
+    }
+}
+
+static void fail_sends(HTTP_URING_CONN_INFO* conn, IO_SEND_RESULT send_result)
+{
+    HTTP_URING_INFO* uring = conn->uring;
+    bool alive = true;
+    while (alive && conn->send_head != NULL)
+    {
+        URING_SEND_ITEM* item = conn->send_head;
+        if ((conn->send_head = item->next) == NULL)
+        {
+            conn->send_tail = NULL;
+        }
+        if (item->on_send_complete != NULL)
+        {
+            conn->callback_depth++;
+            item->on_send_complete(item->callback_ctx, send_result);
+            alive = end_callback(conn);
+        }
+        http_alloc_free(&uring->allocator, item);
+    }
+}
+
+static void finish_close(HTTP_URING_CONN_INFO* conn)
+{
+    close(conn->socket);
+    conn->socket = -1;
+    conn->state = URING_CONN_STATE_CLOSED;
+    conn->callback_depth++;
+    fail_sends(conn, IO_SEND_CANCELLED);
+    if (end_callback(conn) && conn->on_close_complete != NULL)
+    {
+        conn->callback_depth++;
+        conn->on_close_complete(conn->on_close_complete_ctx);
+        (void)end_callback(conn);
+    }
+}
+
+static void process_dirty(HTTP_URING_INFO* uring)
+{
+    HTTP_URING_CONN_INFO* conn = uring->dirty_list;
+    uring->dirty_list = NULL;
+    while (conn != NULL)
+    {
+        HTTP_URING_CONN_INFO* next = conn->next_dirty;
+        conn->next_dirty = NULL;
+        conn->in_dirty_list = false;
+        if (conn->destroyed)
+        {
+            release_if_idle(conn);
+        }
+        else if (conn->state == URING_CONN_STATE_CLOSING)
+        {
+            if (conn->pending_ops == 0)
+            {
+                finish_close(conn);
+            }
+        }
+        else if (conn->in_flight_sends == 0 && conn->send_head != NULL)
+        {
+            if (conn->state == URING_CONN_STATE_OPEN)
+            {
+                submit_send_chain(conn);
+            }
+            else
+            {
+                fail_sends(conn, IO_SEND_ERROR);
+            }
+        }
+        conn = next;
+    }
+}
+
+static void on_connect_complete(HTTP_URING_CONN_INFO* conn, int32_t res)
+{
+    IO_OPEN_RESULT open_result;
+    if (conn->state == URING_CONN_STATE_CLOSING)
+    {
+        open_result = IO_OPEN_CANCELLED;
+    }
+    else if (res != 0)
+    {
+        log_error("Failure connecting to %s:%d: %d", conn->hostname, (int)conn->port, -res);
+        conn->state = URING_CONN_STATE_ERROR;
+        open_result = IO_OPEN_ERROR;
+    }
+    else if (arm_receive(conn) != 0)
+    {
+        conn->state = URING_CONN_STATE_ERROR;
+        open_result = IO_OPEN_ERROR;
+    }
+    else
+    {
+        conn->state = URING_CONN_STATE_OPEN;
+        open_result = IO_OPEN_OK;
+    }
+    conn->callback_depth++;
+    conn->on_open_complete(conn->on_open_complete_ctx, open_result);
+    (void)end_callback(conn);
+}
+
+static void on_receive_complete(HTTP_URING_CONN_INFO* conn, int32_t res, uint32_t flags)
+{
+    bool alive = true;
+    if ((flags & IORING_CQE_F_BUFFER) != 0)
+    {
+        HTTP_URING_INFO* uring = conn->uring;
+        uint16_t buffer_id = (uint16_t)(flags >> IORING_CQE_BUFFER_SHIFT);
+        if (res > 0 && conn->state == URING_CONN_STATE_OPEN)
+        {
+            conn->callback_depth++;
+            conn->callback_info.on_bytes_received(conn->callback_info.on_bytes_received_ctx, uring->buffers + (size_t)buffer_id * URING_RECV_BUFFER_SIZE, (size_t)res);
+            alive = end_callback(conn);
+        }
+        // The data was consumed by the callback, the buffer goes straight back to the kernel
+        recycle_buffer(uring, buffer_id);
+    }
+    if (alive && conn->state == URING_CONN_STATE_OPEN && (flags & IORING_CQE_F_MORE) == 0)
+    {
+        if (res == 0)
+        {
+            report_io_error(conn, IO_ERROR_ENDPOINT_DISCONN);
+        }
+        else if (res < 0 && res != -ENOBUFS)
+        {
+            log_error("Failure receiving from %s:%d: %d", conn->hostname, (int)conn->port, -res);
+            report_io_error(conn, IO_ERROR_GENERAL);
+        }
+        // The receive ends when the buffers run out or the completion ring overflows
+        else if (arm_receive(conn) != 0)
+        {
+            report_io_error(conn, IO_ERROR_GENERAL);
+        }
+    }
+}
+
+static void on_send_done(HTTP_URING_CONN_INFO* conn, int32_t res)
+{
+    URING_SEND_ITEM* item = conn->send_cursor;
+    conn->send_cursor = item->next;
+    conn->in_flight_sends--;
+
+    if (res >= 0 && item == conn->send_head && item->offset + (size_t)res == item->length)
+    {
+        if ((conn->send_head = item->next) == NULL)
+        {
+            conn->send_tail = NULL;
+        }
+        if (item->on_send_complete != NULL)
+        {
+            conn->callback_depth++;
+            item->on_send_complete(item->callback_ctx, IO_SEND_OK);
+            (void)end_callback(conn);
+        }
+        http_alloc_free(&conn->uring->allocator, item);
+    }
+    else if (res >= 0)
+    {
+        // A short send broke the chain, the rest is sent again from where it stopped
+        item->offset += (size_t)res;
+    }
+    else if (res != -ECANCELED && conn->state == URING_CONN_STATE_OPEN)
+    {
+        log_error("Failure sending to %s:%d: %d", conn->hostname, (int)conn->port, -res);
+        report_io_error(conn, IO_ERROR_GENERAL);
+    }
+}
+
+static void dispatch_completion(uint64_t user_data, int32_t res, uint32_t flags)
+{
+    HTTP_URING_CONN_INFO* conn = (HTTP_URING_CONN_INFO*)(uintptr_t)(user_data & ~URING_OP_MASK);
+    URING_OP op = (URING_OP)(user_data & URING_OP_MASK);
+
+    // Guards the connection while its callbacks run
+    conn->callback_depth++;
+    if (op != URING_OP_RECV || (flags & IORING_CQE_F_MORE) == 0)
+    {
+        conn->pending_ops--;
+    }
+    switch (op)
+    {
+        case URING_OP_CONNECT:
+            if (!conn->destroyed)
+            {
+                on_connect_complete(conn, res);
+            }
+            break;
+        case URING_OP_RECV:
+            if (conn->destroyed)
+            {
+                if ((flags & IORING_CQE_F_BUFFER) != 0)
+                {
+                    recycle_buffer(conn->uring, (uint16_t)(flags >> IORING_CQE_BUFFER_SHIFT));
+                }
+            }
+            else
+            {
+                on_receive_complete(conn, res, flags);
+            }
+            break;
+        case URING_OP_SEND:
+            if (!conn->destroyed)
+            {
+                on_send_done(conn, res);
+            }
+            break;
+        case URING_OP_CANCEL:
+        default:
+            break;
+    }
+    if (end_callback(conn))
+    {
+        if ((conn->in_flight_sends == 0 && conn->send_head != NULL) ||
+            (conn->state == URING_CONN_STATE_CLOSING && conn->pending_ops == 0))
+        {
+            add_dirty(conn);
+        }
+    }
+}
+
+static void reap_completions(HTTP_URING_INFO* uring)
+{
+    unsigned head = *uring->cq_head;
+    unsigned tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail)
+    {
+        struct io_uring_cqe* cqe = &uring->cqes[head & uring->cq_mask];
+        uint64_t user_data = cqe->user_data;
+        int32_t res = cqe->res;
+        uint32_t flags = cqe->flags;
+
+        // The entry is handed back before the callbacks run, they only see the copy
+        head++;
+        __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+        dispatch_completion(user_data, res, flags);
+        if (head == tail)
+        {
+            tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+        }
+    }
+}
+
+static void free_uring(HTTP_URING_INFO* uring)
+{
+    // Only connections destroyed while the kernel still held them are left
+    while (uring->conn_list != NULL)
+    {
+        uring->conn_list->pending_ops = 0;
+        uring->conn_list->callback_depth = 0;
+        uring->conn_list->in_dirty_list = false;
+        free_conn(uring->conn_list);
+    }
+    unmap_uring(uring);
+    http_alloc_free(&uring->allocator, uring);
+}
+
+static int resolve_address(HTTP_URING_CONN_INFO* conn)
+{
+    int result;
+    if (conn->address_type == ADDRESS_TYPE_DOMAIN_SOCKET)
+    {
+        struct sockaddr_un* address = (struct sockaddr_un*)&conn->address;
+        size_t path_len = strlen(conn->hostname);
+        if (path_len >= sizeof(address->sun_path))
+        {
+            log_error("Socket path is longer than %zu characters", sizeof(address->sun_path) - 1);
+            result = __LINE__;
+        }
+        else
+        {
+            memset(address, 0, sizeof(struct sockaddr_un));
+            address->sun_family = AF_UNIX;
+            memcpy(address->sun_path, conn->hostname, path_len + 1);
+            conn->address_len = (socklen_t)sizeof(struct sockaddr_un);
+            result = 0;
+        }
+    }
+    else
+    {
+        struct addrinfo hints;
+        struct addrinfo* addr_list;
+        char port_text[8];
+
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        (void)snprintf(port_text, sizeof(port_text), "%d", (int)conn->port);
+        if (getaddrinfo(conn->hostname, port_text, &hints, &addr_list) != 0 || addr_list == NULL)
+        {
+            log_error("Failure resolving %s", conn->hostname);
+            result = __LINE__;
+        }
+        else
+        {
+            memcpy(&conn->address, addr_list->ai_addr, addr_list->ai_addrlen);
+            conn->address_len = (socklen_t)addr_list->ai_addrlen;
+            freeaddrinfo(addr_list);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static int create_socket(HTTP_URING_CONN_INFO* conn)
+{
+    int result;
+    int domain = ((struct sockaddr*)&conn->address)->sa_family;
+    if ((conn->socket = socket(domain, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+    {
+        log_error("Failure creating socket: %d", errno);
+        result = __LINE__;
+    }
+    else
+    {
+        if (domain != AF_UNIX)
+        {
+            int enable = 1;
+            (void)setsockopt(conn->socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+        result = 0;
+    }
+    return result;
+}
+#endif
+
+bool http_uring_is_available(void)
+{
+#ifdef HTTP_CLIENT_USE_URING
+    // 0 until probed, then 1 when available and 2 when not
+    static int probe_result = 0;
+    int value = __atomic_load_n(&probe_result, __ATOMIC_ACQUIRE);
+    if (value == 0)
+    {
+        value = probe_uring() ? 1 : 2;
+        __atomic_store_n(&probe_result, value, __ATOMIC_RELEASE);
+    }
+    return value == 1;
+#else
+    return false;
+#endif
+}
+
+HTTP_URING_HANDLE http_uring_create(uint32_t queue_depth, const HTTP_ALLOCATOR* allocator)
+{
+    HTTP_URING_HANDLE result;
+#ifdef HTTP_CLIENT_USE_URING
+    struct io_uring_params params;
+    if (allocator == NULL)
+    {
+        allocator = http_alloc_get_default();
+    }
+    if (!http_uring_is_available())
+    {
+        log_error("io_uring is not available, the kernel does not support multishot receive");
+        result = NULL;
+    }
+    else if ((result = (HTTP_URING_INFO*)http_alloc_malloc(allocator, sizeof(HTTP_URING_INFO))) == NULL)
+    {
+        log_error("Failure allocating uring");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_URING_INFO));
+        result->allocator = *allocator;
+        result->ref_count = 1;
+        if (queue_depth < URING_MIN_QUEUE_DEPTH)
+        {
+            queue_depth = URING_MIN_QUEUE_DEPTH;
+        }
+
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = queue_depth * URING_CQ_MULTIPLIER;
+        if ((result->ring_fd = uring_setup(queue_depth, &params)) < 0)
+        {
+            log_error("Failure setting up the ring: %d", errno);
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+        else if (map_rings(result, &params) != 0 || register_buffers(result) != 0)
+        {
+            unmap_uring(result);
+            http_alloc_free(allocator, result);
+            result = NULL;
+        }
+    }
+#else
+    (void)queue_depth;
+    (void)allocator;
+    log_error("io_uring is not available, the library was built without it");
+    result = NULL;
+#endif
+    return result;
+}
+
+void http_uring_destroy(HTTP_URING_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle != NULL && --handle->ref_count == 0)
+    {
+        // Released from a callback, the ring is freed once the completions are dispatched
+        if (handle->processing)
+        {
+            handle->free_pending = true;
+        }
+        else
+        {
+            free_uring(handle);
+        }
+    }
+#else
+    (void)handle;
+#endif
+}
+
+int http_uring_add_ref(HTTP_URING_HANDLE handle)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->ref_count++;
+        result = 0;
+    }
+#else
+    (void)handle;
+    log_error("io_uring is not available, the library was built without it");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+int http_uring_process(HTTP_URING_HANDLE handle)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else if (handle->processing)
+    {
+        // Called again from a callback, the outer call picks up the new work
+        result = 0;
+    }
+    else
+    {
+        unsigned enter_flags = 0;
+        handle->processing = true;
+
+        process_dirty(handle);
+        // Completions that did not fit the ring are only moved over by the kernel
+        if ((__atomic_load_n(handle->sq_flags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0)
+        {
+            enter_flags |= IORING_ENTER_GETEVENTS;
+        }
+        result = submit_pending(handle, enter_flags);
+        reap_completions(handle);
+        process_dirty(handle);
+        // Entries queued by the completions go in now, the caller may sleep on the ring next
+        if (result == 0 && handle->sqe_tail != *handle->sq_tail)
+        {
+            result = submit_pending(handle, 0);
+        }
+
+        handle->processing = false;
+        if (handle->free_pending)
+        {
+            free_uring(handle);
+        }
+    }
+#else
+    (void)handle;
+    log_error("io_uring is not available, the library was built without it");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+int http_uring_get_fd(HTTP_URING_HANDLE handle)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = -1;
+    }
+    else
+    {
+        result = handle->ring_fd;
+    }
+#else
+    (void)handle;
+    result = -1;
+#endif
+    return result;
+}
+
+HTTP_URING_CONN_HANDLE http_uring_conn_create(HTTP_URING_HANDLE uring, const SOCKETIO_CONFIG* config, const PATCHCORD_CALLBACK_INFO* callback_info)
+{
+    HTTP_URING_CONN_HANDLE result;
+#ifdef HTTP_CLIENT_USE_URING
+    size_t host_len;
+    if (uring == NULL || config == NULL || config->hostname == NULL || callback_info == NULL || callback_info->on_bytes_received == NULL)
+    {
+        log_error("Invalid argument specified uring: %p, config: %p, callback_info: %p", uring, config, callback_info);
+        result = NULL;
+    }
+    else if (config->address_type == ADDRESS_TYPE_UDP)
+    {
+        log_error("Invalid argument udp connections are not supported");
+        result = NULL;
+    }
+    else if ((result = (HTTP_URING_CONN_INFO*)http_alloc_malloc(&uring->allocator, sizeof(HTTP_URING_CONN_INFO))) == NULL)
+    {
+        log_error("Failure allocating uring connection");
+    }
+    else
+    {
+        memset(result, 0, sizeof(HTTP_URING_CONN_INFO));
+        host_len = strlen(config->hostname);
+        if ((result->hostname = (char*)http_alloc_malloc(&uring->allocator, host_len + 1)) == NULL)
+        {
+            log_error("Failure allocating hostname");
+            http_alloc_free(&uring->allocator, result);
+            result = NULL;
+        }
+        else
+        {
+            memcpy(result->hostname, config->hostname, host_len + 1);
+            result->uring = uring;
+            result->socket = -1;
+            result->port = config->port;
+            result->address_type = config->address_type;
+            result->callback_info = *callback_info;
+            result->state = URING_CONN_STATE_NOT_OPEN;
+
+            if ((result->next = uring->conn_list) != NULL)
+            {
+                result->next->prev = result;
+            }
+            uring->conn_list = result;
+        }
+    }
+#else
+    (void)uring;
+    (void)config;
+    (void)callback_info;
+    log_error("io_uring is not available, the library was built without it");
+    result = NULL;
+#endif
+    return result;
+}
+
+void http_uring_conn_destroy(HTTP_URING_CONN_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle != NULL && !handle->destroyed)
+    {
+        handle->destroyed = true;
+        cancel_operations(handle);
+        if (handle->pending_ops > 0 || handle->callback_depth > 0 || handle->in_dirty_list)
+        {
+            // Freed once the kernel hands the connection back
+            add_dirty(handle);
+        }
+        else
+        {
+            free_conn(handle);
+        }
+    }
+#else
+    (void)handle;
+#endif
+}
+
+int http_uring_conn_open(HTTP_URING_CONN_HANDLE handle, ON_IO_OPEN_COMPLETE on_open_complete, void* on_open_complete_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL || on_open_complete == NULL)
+    {
+        log_error("Invalid argument specified handle: %p, on_open_complete: %p", handle, on_open_complete);
+        result = __LINE__;
+    }
+    else if (handle->state != URING_CONN_STATE_NOT_OPEN && handle->state != URING_CONN_STATE_CLOSED)
+    {
+        log_error("Invalid state connection is already open");
+        result = __LINE__;
+    }
+    else if (resolve_address(handle) != 0 || create_socket(handle) != 0)
+    {
+        result = __LINE__;
+    }
+    else if (!reserve_sq_space(handle->uring, 1))
+    {
+        log_error("Failure opening the connection, the ring is full");
+        close(handle->socket);
+        handle->socket = -1;
+        result = __LINE__;
+    }
+    else
+    {
+        struct io_uring_sqe* sqe = get_sqe(handle, URING_OP_CONNECT);
+        sqe->opcode = IORING_OP_CONNECT;
+        sqe->addr = (uint64_t)(uintptr_t)&handle->address;
+        sqe->off = handle->address_len;
+
+        handle->on_open_complete = on_open_complete;
+        handle->on_open_complete_ctx = on_open_complete_ctx;
+        handle->state = URING_CONN_STATE_OPENING;
+        result = 0;
+    }
+#else
+    (void)handle;
+    (void)on_open_complete;
+    (void)on_open_complete_ctx;
+    log_error("io_uring is not available, the library was built without it");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+int http_uring_conn_close(HTTP_URING_CONN_HANDLE handle, ON_IO_CLOSE_COMPLETE on_close_complete, void* on_close_complete_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = __LINE__;
+    }
+    else if (handle->socket < 0 || handle->state == URING_CONN_STATE_CLOSING)
+    {
+        log_error("Invalid state connection is not open");
+        result = __LINE__;
+    }
+    else
+    {
+        handle->on_close_complete = on_close_complete;
+        handle->on_close_complete_ctx = on_close_complete_ctx;
+        handle->state = URING_CONN_STATE_CLOSING;
+        cancel_operations(handle);
+        // The close completes from process once the kernel is done with the socket
+        add_dirty(handle);
+        result = 0;
+    }
+#else
+    (void)handle;
+    (void)on_close_complete;
+    (void)on_close_complete_ctx;
+    log_error("io_uring is not available, the library was built without it");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+int http_uring_conn_send(HTTP_URING_CONN_HANDLE handle, const void* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_ctx)
+{
+    int result;
+#ifdef HTTP_CLIENT_USE_URING
+    URING_SEND_ITEM* item;
+    if (handle == NULL || buffer == NULL || size == 0 || size > UINT32_MAX)
+    {
+        log_error("Invalid argument specified handle: %p, buffer: %p, size: %zu", handle, buffer, size);
+        result = __LINE__;
+    }
+    else if (handle->state != URING_CONN_STATE_OPEN)
+    {
+        log_error("Invalid state connection is not open");
+        result = __LINE__;
+    }
+    else if ((item = (URING_SEND_ITEM*)http_alloc_malloc(&handle->uring->allocator, sizeof(URING_SEND_ITEM) + size)) == NULL)
+    {
+        log_error("Failure allocating send item");
+        result = __LINE__;
+    }
+    else
+    {
+        item->next = NULL;
+        item->on_send_complete = on_send_complete;
+        item->callback_ctx = callback_ctx;
+        item->length = size;
+        item->offset = 0;
+        memcpy(item->data, buffer, size);
+        if (handle->send_tail != NULL)
+        {
+            handle->send_tail->next = item;
+        }
+        else
+        {
+            handle->send_head = item;
+        }
+        handle->send_tail = item;
+        // Chained with the other sends of the connection on the next process
+        if (handle->in_flight_sends == 0)
+        {
+            add_dirty(handle);
+        }
+        result = 0;
+    }
+#else
+    (void)handle;
+    (void)buffer;
+    (void)size;
+    (void)on_send_complete;
+    (void)callback_ctx;
+    log_error("io_uring is not available, the library was built without it");
+    result = __LINE__;
+#endif
+    return result;
+}
+
+void http_uring_conn_process_item(HTTP_URING_CONN_HANDLE handle)
+{
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle != NULL)
+    {
+        (void)http_uring_process(handle->uring);
+    }
+#else
+    (void)handle;
+#endif
+}
+
+const char* http_uring_conn_query_endpoint(HTTP_URING_CONN_HANDLE handle, uint16_t* port)
+{
+    const char* result;
+#ifdef HTTP_CLIENT_USE_URING
+    if (handle == NULL)
+    {
+        log_error("Invalid argument specified handle: NULL");
+        result = NULL;
+    }
+    else
+    {
+        if (port != NULL)
+        {
+            *port = handle->port;
+        }
+        result = handle->hostname;
+    }
+#else
+    (void)handle;
+    (void)port;
+    result = NULL;
+#endif
+    return result;
+}
@@ -0,0 +1,216 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mem_shim_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_alloc.h"
+
+#define TEST_ALLOC_SIZE     16
+
+static void* TEST_ALLOC_CTX = (void*)0x1234;
+
+static void* g_alloc_ctx;
+static size_t g_alloc_count;
+static size_t g_realloc_count;
+static size_t g_free_count;
+
+static void* test_alloc(void* alloc_ctx, size_t size)
+{
+    g_alloc_ctx = alloc_ctx;
+    g_alloc_count++;
+    return my_mem_shim_malloc(size);
+}
+
+static void* test_realloc(void* alloc_ctx, void* ptr, size_t size)
+{
+    g_alloc_ctx = alloc_ctx;
+    g_realloc_count++;
+    return my_mem_shim_realloc(ptr, size);
+}
+
+static void test_free(void* alloc_ctx, void* ptr)
+{
+    g_alloc_ctx = alloc_ctx;
+    g_free_count++;
+    my_mem_shim_free(ptr);
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_alloc_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_realloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_alloc_ctx = NULL;
+    g_alloc_count = 0;
+    g_realloc_count = 0;
+    g_free_count = 0;
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+    (void)http_alloc_set_default(NULL);
+}
+
+CTEST_FUNCTION(http_alloc_set_default_missing_function_fail)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, NULL, test_free, TEST_ALLOC_CTX };
+
+    // act
+    int result = http_alloc_set_default(&allocator);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, (void*)test_alloc, (void*)http_alloc_get_default()->alloc_func);
+}
+
+CTEST_FUNCTION(http_alloc_set_default_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, TEST_ALLOC_CTX };
+
+    // act
+    int result = http_alloc_set_default(&allocator);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, (void*)test_alloc, (void*)http_alloc_get_default()->alloc_func);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_CTX, http_alloc_get_default()->alloc_ctx);
+}
+
+CTEST_FUNCTION(http_alloc_set_default_NULL_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, TEST_ALLOC_CTX };
+    (void)http_alloc_set_default(&allocator);
+
+    // act
+    int result = http_alloc_set_default(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, (void*)test_alloc, (void*)http_alloc_get_default()->alloc_func);
+}
+
+CTEST_FUNCTION(http_alloc_malloc_crt_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(TEST_ALLOC_SIZE));
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, TEST_ALLOC_SIZE*2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    void* result = http_alloc_malloc(NULL, TEST_ALLOC_SIZE);
+    result = http_alloc_realloc(NULL, result, TEST_ALLOC_SIZE*2);
+    http_alloc_free(NULL, result);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_alloc_malloc_default_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, TEST_ALLOC_CTX };
+    (void)http_alloc_set_default(&allocator);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = http_alloc_malloc(NULL, TEST_ALLOC_SIZE);
+    result = http_alloc_realloc(NULL, result, TEST_ALLOC_SIZE*2);
+    http_alloc_free(NULL, result);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_alloc_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_realloc_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_free_count);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_CTX, g_alloc_ctx);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_alloc_malloc_allocator_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, TEST_ALLOC_CTX };
+
+    // act
+    void* result = http_alloc_malloc(&allocator, TEST_ALLOC_SIZE);
+    http_alloc_free(&allocator, result);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_alloc_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_free_count);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_CTX, g_alloc_ctx);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_alloc_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(TEST_ALLOC_SIZE)).SetReturn(NULL);
+
+    // act
+    void* result = http_alloc_malloc(NULL, TEST_ALLOC_SIZE);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_END_TEST_SUITE(http_alloc_ut)
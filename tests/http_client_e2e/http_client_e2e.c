@@ -15,7 +15,6 @@
 
 #include "lib-util-c/buffer_alloc.h"
 #include "lib-util-c/app_logging.h"
-#include "lib-util-c/thread_mgr.h"
 #include "lib-util-c/alarm_timer.h"
 
 #include "http_client/http_client.h"
@@ -26,6 +25,9 @@ static const char* APP_JSON_HEADER = "application/json";
 
 #define OPERATION_TIMEOUT_SEC       30
 
+// Longest a step waits on the client, the state machine moves on between waits
+#define CLIENT_WAIT_TIMEOUT_MS      100
+
 typedef enum CLIENT_E2E_STATE_TAG
 {
     CLIENT_STATE_CONN,
@@ -206,9 +208,8 @@ CTEST_FUNCTION(http_client_send_get_create_succeed)
                 CTEST_ASSERT_FAIL("Failure http client encountered %d", (int)e2e_data.error_result);
                 break;
         }
-        http_client_process_item(e2e_data.http_client);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_client_wait(e2e_data.http_client, CLIENT_WAIT_TIMEOUT_MS));
         CTEST_ASSERT_IS_FALSE(alarm_timer_is_expired(&e2e_data.timer), "Failure http client has timed out on operation %d", (int)e2e_data.client_state);
-        thread_mgr_sleep(5);
     } while (!e2e_data.test_complete);
 
     http_client_destroy(e2e_data.http_client);
@@ -277,10 +278,9 @@ CTEST_FUNCTION(http_client_send_delete_create_succeed)
                 CTEST_ASSERT_FAIL("Failure http client encountered %d", (int)e2e_data.error_result);
                 break;
         }
-        http_client_process_item(e2e_data.http_client);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_client_wait(e2e_data.http_client, CLIENT_WAIT_TIMEOUT_MS));
 
         CTEST_ASSERT_IS_FALSE(alarm_timer_is_expired(&e2e_data.timer), "Failure http client has timed out on operation %d", (int)e2e_data.client_state);
-        thread_mgr_sleep(5);
     } while (!e2e_data.test_complete);
 
     http_client_destroy(e2e_data.http_client);
@@ -345,9 +345,8 @@ CTEST_FUNCTION(http_client_status_code_404_succeed)
                 CTEST_ASSERT_FAIL("Failure http client encountered %d", (int)e2e_data.error_result);
                 break;
         }
-        http_client_process_item(e2e_data.http_client);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_client_wait(e2e_data.http_client, CLIENT_WAIT_TIMEOUT_MS));
         CTEST_ASSERT_IS_FALSE(alarm_timer_is_expired(&e2e_data.timer), "Failure http client has timed out on operation %d", (int)e2e_data.client_state);
-        thread_mgr_sleep(5);
     } while (!e2e_data.test_complete);
 
     http_client_destroy(e2e_data.http_client);
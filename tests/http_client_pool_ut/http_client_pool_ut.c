@@ -0,0 +1,1332 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/crt_extensions.h"
+#include "lib-util-c/buffer_alloc.h"
+#include "lib-util-c/alarm_timer.h"
+#include "http_client/http_headers.h"
+#include "http_client/http_tls.h"
+#include "http_client/http_uring.h"
+#include "http_client/http_client.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_client_pool.h"
+
+static const char* TEST_RELATIVE_PATH = "/";
+static const char* TEST_HOSTNAME = "test.hostname.com";
+static const char* TEST_OTHER_HOSTNAME = "other.hostname.com";
+static const char* TEST_HEADER_NAME_1 = "TEST_HEADER_NAME_1";
+static const char* TEST_HEADER_VALUE_1 = "TEST_HEADER_VALUE_1";
+static const char* TEST_CONNECTION_CLOSE = "close";
+
+static HTTP_HEADERS_HANDLE TEST_HTTP_HEADER = (HTTP_HEADERS_HANDLE)0x67890;
+static HTTP_HEADERS_HANDLE TEST_RESPONSE_HEADER = (HTTP_HEADERS_HANDLE)0x67891;
+
+static unsigned char TEST_SEND_CONTENT[] = { 0x33, 0x34, 0x35 };
+static size_t TEST_CONTENT_LENGTH = 3;
+static uint16_t TEST_PORT = 8080;
+static HTTP_ADDRESS TEST_HTTP_ADDRESS = {0};
+static HTTP_ADDRESS TEST_OTHER_HTTP_ADDRESS = {0};
+static HTTP_ADDRESS TEST_SECURE_HTTP_ADDRESS = {0};
+static HTTP_ADDRESS TEST_SOCKET_HTTP_ADDRESS = {0};
+static const char* TEST_SOCKET_PATH = "/run/test_sidecar.sock";
+static HTTP_TLS_CACHE_HANDLE TEST_TLS_CACHE = (HTTP_TLS_CACHE_HANDLE)0x5678;
+static HTTP_URING_HANDLE TEST_URING = (HTTP_URING_HANDLE)0x6789;
+
+#define TEST_NEGATIVE_POOL_COUNT    16
+
+static ON_HTTP_ERROR_CALLBACK g_on_error_cb;
+static void* g_on_error_ctx;
+static ON_HTTP_REQUEST_CALLBACK g_on_request_cb;
+static void* g_on_request_ctx;
+static size_t g_request_cb_count;
+static HTTP_CLIENT_RESULT g_request_result;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    static void test_on_request_callback(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+        HTTP_HEADERS_HANDLE response_headers)
+    {
+        (void)callback_ctx;
+        (void)content;
+        (void)content_length;
+        (void)status_code;
+        (void)response_headers;
+        g_request_cb_count++;
+        g_request_result = request_result;
+    }
+
+    static int my_clone_string(char** target, const char* source)
+    {
+        size_t len = strlen(source);
+        *target = my_mem_shim_malloc(len+1);
+        strcpy(*target, source);
+        return 0;
+    }
+
+    static int my_byte_buffer_construct(BYTE_BUFFER* buffer, const unsigned char* payload, size_t length)
+    {
+        (void)payload;
+        buffer->payload = my_mem_shim_malloc(length);
+        buffer->payload_size = length;
+        return 0;
+    }
+
+    static HTTP_HEADERS_HANDLE my_http_header_create(void)
+    {
+        return (HTTP_HEADERS_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_header_destroy(HTTP_HEADERS_HANDLE handle)
+    {
+        my_mem_shim_free(handle);
+    }
+
+    static HTTP_CLIENT_HANDLE my_http_client_create(void)
+    {
+        return (HTTP_CLIENT_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_client_destroy(HTTP_CLIENT_HANDLE handle)
+    {
+        my_mem_shim_free(handle);
+    }
+
+    static int my_http_client_open(HTTP_CLIENT_HANDLE handle, const HTTP_ADDRESS* http_address, ON_HTTP_OPEN_COMPLETE_CALLBACK on_open_complete_cb, void* user_ctx, ON_HTTP_ERROR_CALLBACK on_error_cb, void* err_user_ctx)
+    {
+        (void)handle;
+        (void)http_address;
+        (void)on_open_complete_cb;
+        (void)user_ctx;
+        g_on_error_cb = on_error_cb;
+        g_on_error_ctx = err_user_ctx;
+        return 0;
+    }
+
+    static int my_http_client_execute_request(HTTP_CLIENT_HANDLE handle, HTTP_CLIENT_REQUEST_TYPE request_type, const char* relative_path,
+        HTTP_HEADERS_HANDLE http_header, const unsigned char* content, size_t content_length, ON_HTTP_REQUEST_CALLBACK on_request_callback, void* callback_ctx)
+    {
+        (void)handle;
+        (void)request_type;
+        (void)relative_path;
+        (void)http_header;
+        (void)content;
+        (void)content_length;
+        g_on_request_cb = on_request_callback;
+        g_on_request_ctx = callback_ctx;
+        return 0;
+    }
+#ifdef __cplusplus
+}
+#endif
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_client_pool_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types());
+
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADER_TOKEN, int);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_CLIENT_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ALARM_TIMER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_CLIENT_REQUEST_TYPE, int);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_OPEN_COMPLETE_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_ERROR_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_REQUEST_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_TLS_CACHE_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_URING_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const HTTP_ALLOCATOR*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(clone_string, my_clone_string);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clone_string, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(byte_buffer_construct, my_byte_buffer_construct);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(byte_buffer_construct, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_RETURN(alarm_timer_init, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(alarm_timer_init, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(alarm_timer_start, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(alarm_timer_start, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(alarm_timer_is_expired, false);
+
+    REGISTER_GLOBAL_MOCK_HOOK(http_header_create, my_http_header_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_header_destroy, my_http_header_destroy);
+    REGISTER_GLOBAL_MOCK_RETURN(http_header_get_known_value, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(http_header_get_count, 1);
+    REGISTER_GLOBAL_MOCK_RETURN(http_header_get_name_value_pair, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_get_name_value_pair, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_header_add, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_add, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_create, my_http_client_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_destroy, my_http_client_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_open, my_http_client_open);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_open, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_execute_request, my_http_client_execute_request);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_execute_request, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_client_set_tls_cache, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_set_tls_cache, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_client_set_uring, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_set_uring, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_RETURN(http_tls_cache_create, TEST_TLS_CACHE);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_cache_create, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(http_tls_cache_add_ref, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_cache_add_ref, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_is_available, true);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_create, TEST_URING);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_create, NULL);
+
+    TEST_HTTP_ADDRESS.hostname = TEST_HOSTNAME;
+    TEST_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_OTHER_HTTP_ADDRESS.hostname = TEST_OTHER_HOSTNAME;
+    TEST_OTHER_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_SECURE_HTTP_ADDRESS.hostname = TEST_HOSTNAME;
+    TEST_SECURE_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_SECURE_HTTP_ADDRESS.is_secure = true;
+    TEST_SOCKET_HTTP_ADDRESS.hostname = TEST_HOSTNAME;
+    TEST_SOCKET_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_SOCKET_HTTP_ADDRESS.socket_path = TEST_SOCKET_PATH;
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_on_error_cb = NULL;
+    g_on_error_ctx = NULL;
+    g_on_request_cb = NULL;
+    g_on_request_ctx = NULL;
+    g_request_cb_count = 0;
+    g_request_result = HTTP_CLIENT_OK;
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+static void setup_open_connection_mocks(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(alarm_timer_init(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_open(IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG, IGNORED_ARG));
+}
+
+static void setup_http_client_pool_execute_request_mocks(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    setup_open_connection_mocks();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION)).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+}
+
+static void setup_queue_pending_request_mocks(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_RELATIVE_PATH));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH));
+    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_get_count(TEST_HTTP_HEADER)).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(TEST_HTTP_HEADER, 0, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(http_header_add(IGNORED_ARG, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+}
+
+static HTTP_CLIENT_POOL_HANDLE create_pool(size_t max_per_host, size_t max_connections)
+{
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.max_connections_per_host = max_per_host;
+    config.max_connections = max_connections;
+    return http_client_pool_create(&config);
+}
+
+CTEST_FUNCTION(http_client_pool_create_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_config_NULL_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_client_pool_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_destroy_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_pool_execute_request(NULL, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_http_address_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_pool_execute_request(handle, NULL, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_hostname_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    HTTP_ADDRESS http_address = TEST_HTTP_ADDRESS;
+    http_address.hostname = NULL;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_pool_execute_request(handle, &http_address, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_relative_path_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, NULL, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_callback_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_pool_execute_request_mocks();
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_fail)
+{
+    // arrange
+    // Every attempt gets its own pool so hosts left by an earlier attempt do not change the calls
+    HTTP_CLIENT_POOL_HANDLE handle_list[TEST_NEGATIVE_POOL_COUNT];
+    for (size_t index = 0; index < TEST_NEGATIVE_POOL_COUNT; index++)
+    {
+        handle_list[index] = http_client_pool_create(NULL);
+    }
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_client_pool_execute_request_mocks();
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    CTEST_ASSERT_IS_TRUE(count <= TEST_NEGATIVE_POOL_COUNT);
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_pool_execute_request(handle_list[index], &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_pool_execute_request failure %d/%d", (int)index, (int)count);
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+    for (size_t index = 0; index < TEST_NEGATIVE_POOL_COUNT; index++)
+    {
+        http_client_pool_destroy(handle_list[index]);
+    }
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_reuse_idle_connection_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_host_limit_queued_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(1, 0);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_queue_pending_request_mocks();
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_host_limit_queued_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(1, 0);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_queue_pending_request_mocks();
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_pool_execute_request failure %d/%d", (int)index, (int)count);
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_global_limit_evicts_idle_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(0, 1);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_OTHER_HOSTNAME));
+    setup_open_connection_mocks();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_OTHER_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_request_complete_keep_alive_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_RESPONSE_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(alarm_timer_start(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_request_complete_connection_close_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_RESPONSE_HEADER, HTTP_HEADER_TOKEN_CONNECTION)).SetReturn(TEST_CONNECTION_CLOSE);
+
+    // act
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_request_complete_request_close_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION)).SetReturn(TEST_CONNECTION_CLOSE);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_request_complete_error_result_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_ERROR, NULL, 0, 0, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_ERROR, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_error_fails_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_error_cb(g_on_error_ctx, HTTP_CLIENT_DISCONNECTION);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_DISCONNECTION, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(on_connection_error_ctx_NULL_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_error_cb(NULL, HTTP_CLIENT_DISCONNECTION);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_client_pool_process_item(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_leased_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_process_item(IGNORED_ARG));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_idle_expired_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(alarm_timer_is_expired(IGNORED_ARG)).SetReturn(true);
+    STRICT_EXPECTED_CALL(http_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_closed_connection_destroyed_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_error_cb(g_on_error_ctx, HTTP_CLIENT_DISCONNECTION);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_dispatch_pending_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(1, 0);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(alarm_timer_is_expired(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_known_value(IGNORED_ARG, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, IGNORED_ARG, IGNORED_ARG, TEST_CONTENT_LENGTH, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_dispatch_pending_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(1, 0);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+    g_request_cb_count = 0;
+
+    STRICT_EXPECTED_CALL(http_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(alarm_timer_is_expired(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_known_value(IGNORED_ARG, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, IGNORED_ARG, IGNORED_ARG, TEST_CONTENT_LENGTH, IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(alarm_timer_start(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_request_cb_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_ERROR, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_get_connection_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_client_pool_get_connection_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_get_idle_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_client_pool_get_idle_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_create_tls_cache_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.tls_cache = TEST_TLS_CACHE;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_tls_cache_add_ref(TEST_TLS_CACHE));
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_tls_cache_add_ref_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.tls_cache = TEST_TLS_CACHE;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_tls_cache_add_ref(TEST_TLS_CACHE)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_destroy_tls_cache_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.tls_cache = TEST_TLS_CACHE;
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_cache_destroy(TEST_TLS_CACHE));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_secure_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(http_tls_cache_create(NULL));
+    STRICT_EXPECTED_CALL(http_client_set_tls_cache(IGNORED_ARG, TEST_TLS_CACHE));
+    STRICT_EXPECTED_CALL(alarm_timer_init(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_open(IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_SECURE_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_secure_shares_tls_cache_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = create_pool(2, 0);
+    (void)http_client_pool_execute_request(handle, &TEST_SECURE_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(http_client_set_tls_cache(IGNORED_ARG, TEST_TLS_CACHE));
+    STRICT_EXPECTED_CALL(alarm_timer_init(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_open(IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_SECURE_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_secure_set_tls_cache_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(http_tls_cache_create(NULL));
+    STRICT_EXPECTED_CALL(http_client_set_tls_cache(IGNORED_ARG, TEST_TLS_CACHE)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(http_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_SECURE_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_unix_socket_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_SOCKET_PATH));
+    setup_open_connection_mocks();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_SOCKET_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_unix_socket_hostname_NULL_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    HTTP_ADDRESS http_address = TEST_SOCKET_HTTP_ADDRESS;
+    http_address.hostname = NULL;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_SOCKET_PATH));
+    setup_open_connection_mocks();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &http_address, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_unix_socket_hostname_NULL_reuse_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    HTTP_ADDRESS http_address = TEST_SOCKET_HTTP_ADDRESS;
+    http_address.hostname = NULL;
+    (void)http_client_pool_execute_request(handle, &http_address, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    // Keyed on the socket path, the idle connection is used again
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &http_address, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_unix_socket_separate_host_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(NULL);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    g_on_request_cb(g_on_request_ctx, HTTP_CLIENT_OK, NULL, 0, 200, TEST_RESPONSE_HEADER);
+    umock_c_reset_all_calls();
+
+    // The idle tcp connection to the same hostname is not used
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_SOCKET_PATH));
+    setup_open_connection_mocks();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_SOCKET_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_idle_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_is_available());
+    STRICT_EXPECTED_CALL(http_uring_create(IGNORED_ARG, NULL));
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_uring_not_available_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_is_available()).SetReturn(false);
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_create_uring_create_fail_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_is_available());
+    STRICT_EXPECTED_CALL(http_uring_create(IGNORED_ARG, NULL)).SetReturn(NULL);
+
+    // act
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_destroy_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_destroy(TEST_URING));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_pool_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(http_client_set_uring(IGNORED_ARG, TEST_URING));
+    STRICT_EXPECTED_CALL(alarm_timer_init(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_open(IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_known_value(TEST_HTTP_HEADER, HTTP_HEADER_TOKEN_CONNECTION));
+    STRICT_EXPECTED_CALL(http_client_execute_request(IGNORED_ARG, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_execute_request_set_uring_fail)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_create());
+    STRICT_EXPECTED_CALL(http_client_set_uring(IGNORED_ARG, TEST_URING)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(http_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_client_pool_get_connection_count(handle));
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_pool_process_item_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_POOL_CONFIG config = {0};
+    config.use_uring = true;
+    HTTP_CLIENT_POOL_HANDLE handle = http_client_pool_create(&config);
+    (void)http_client_pool_execute_request(handle, &TEST_HTTP_ADDRESS, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_process(TEST_URING));
+
+    // act
+    http_client_pool_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_client_pool_get_connection_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_pool_destroy(handle);
+}
+
+CTEST_END_TEST_SUITE(http_client_pool_ut)
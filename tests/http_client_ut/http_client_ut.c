@@ -15,6 +15,7 @@
 #include "umock_c/umock_c_negative_tests.h"
 #include "umock_c/umocktypes_charptr.h"
 #include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
 
 static void* my_mem_shim_malloc(size_t size)
 {
@@ -35,6 +36,10 @@ static void my_mem_shim_free(void* ptr)
 #include "lib-util-c/buffer_alloc.h"
 #include "http_client/http_headers.h"
 #include "http_client/http_codec.h"
+#include "http_client/http_timer_wheel.h"
+#include "http_client/http_mpsc_ring.h"
+#include "http_client/http_tls.h"
+#include "http_client/http_uring.h"
 #include "patchcords/patchcord_client.h"
 #include "patchcords/cord_socket_client.h"
 #undef ENABLE_MOCKS
@@ -69,8 +74,19 @@ static HTTP_CODEC_HANDLE TEST_CODEC_HEADER = (HTTP_CODEC_HANDLE)0x987654;
 
 static unsigned char TEST_SEND_CONTENT[] = { 0x33, 0x34, 0x35 };
 static size_t TEST_CONTENT_LENGTH = 3;
+static unsigned char TEST_LARGE_CONTENT[8192];
+// Copy of the last buffer given to the transport, it is freed as soon as the send returns
+static unsigned char g_sent_data[sizeof(TEST_LARGE_CONTENT) + 1024];
+static size_t g_sent_length;
 static uint16_t TEST_PORT = 8080;
 static HTTP_ADDRESS TEST_HTTP_ADDRESS = {0};
+static HTTP_ADDRESS TEST_SECURE_HTTP_ADDRESS = {0};
+static HTTP_ADDRESS TEST_SOCKET_HTTP_ADDRESS = {0};
+static const char* TEST_SOCKET_PATH = "/run/test_sidecar.sock";
+static HTTP_TLS_CACHE_HANDLE TEST_TLS_CACHE = (HTTP_TLS_CACHE_HANDLE)0x5678;
+static HTTP_TLS_CACHE_HANDLE TEST_OTHER_TLS_CACHE = (HTTP_TLS_CACHE_HANDLE)0x5679;
+static HTTP_URING_HANDLE TEST_URING = (HTTP_URING_HANDLE)0x6789;
+static HTTP_URING_HANDLE TEST_OTHER_URING = (HTTP_URING_HANDLE)0x678A;
 
 static void* g_add_copy_item;
 static void* g_destroy_user_ctx;
@@ -85,7 +101,43 @@ static ON_HTTP_DATA_CALLBACK g_data_callback;
 static void* data_cb_user_ctx;
 static BYTE_BUFFER g_buffer_data;
 static ON_IO_ERROR g_on_io_error_cb;
+static ADDRESS_TYPE g_cord_address_type;
+static const char* g_cord_hostname;
 static void* g_on_io_error_ctx;
+static ON_HTTP_HEADERS_CALLBACK g_codec_headers_cb;
+static ON_HTTP_BODY_FRAGMENT_CALLBACK g_codec_body_fragment_cb;
+static ON_HTTP_MESSAGE_BEGIN_CALLBACK g_codec_message_begin_cb;
+static ON_HTTP_TIMER_EXPIRED g_timer_expired_cb;
+static void* g_timer_ctx;
+static size_t g_ring_item_size;
+static void* g_ring_item;
+static size_t g_wake_count;
+static size_t g_ready_count;
+static HTTP_CLIENT_RESULT g_request_result;
+static HTTP_CLIENT_RESULT g_error_result;
+static HTTP_TLS_CALLBACK_INFO g_tls_callback_info;
+static ON_IO_OPEN_COMPLETE g_on_tls_open_complete;
+static void* g_tls_open_ctx;
+static PATCHCORD_CALLBACK_INFO g_uring_callback_info;
+
+#define TEST_SUBMIT_QUEUE_SIZE  64
+// Long enough that a wait that sleeps instead of returning shows in the test time
+#define TEST_WAIT_TIMEOUT_MS    1000
+#define TEST_URING_FD           17
+
+static HTTP_TIMER_HANDLE TEST_TIMER_HANDLE = (HTTP_TIMER_HANDLE)0x4321;
+static HTTP_CLIENT_HANDLE g_timing_client;
+static int g_request_timing_result;
+static HTTP_REQUEST_TIMING g_request_timing;
+static size_t g_headers_complete_count;
+static size_t g_body_fragment_len;
+static size_t g_message_complete_count;
+static size_t g_test_alloc_count;
+static size_t g_test_free_count;
+static size_t g_batch_complete_count;
+static size_t g_batch_request_count;
+static size_t g_batch_failed_count;
+static size_t g_open_complete_count;
 
 
 #ifdef __cplusplus
@@ -123,10 +175,97 @@ extern "C" {
     {
     }
 
+    static void test_on_timed_request_callback(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+        HTTP_HEADERS_HANDLE response_headers)
+    {
+        (void)callback_ctx;
+        (void)request_result;
+        (void)content;
+        (void)content_length;
+        (void)status_code;
+        (void)response_headers;
+        g_request_timing_result = http_client_get_request_timing(g_timing_client, &g_request_timing);
+    }
+
+    static void test_on_result_request_callback(void* callback_ctx, HTTP_CLIENT_RESULT request_result, const unsigned char* content, size_t content_length, unsigned int status_code,
+        HTTP_HEADERS_HANDLE response_headers)
+    {
+        (void)callback_ctx;
+        (void)content;
+        (void)content_length;
+        (void)status_code;
+        (void)response_headers;
+        g_request_result = request_result;
+    }
+
+    static void test_on_counted_open_complete(void* context, HTTP_CLIENT_RESULT open_result)
+    {
+        (void)context;
+        (void)open_result;
+        g_open_complete_count++;
+    }
+
+    static void test_on_result_error(void* context, HTTP_CLIENT_RESULT error_result)
+    {
+        (void)context;
+        g_error_result = error_result;
+    }
+
+    static void test_on_headers_complete(void* callback_ctx, unsigned int status_code, HTTP_HEADERS_HANDLE response_headers)
+    {
+        (void)callback_ctx;
+        (void)status_code;
+        (void)response_headers;
+        g_headers_complete_count++;
+    }
+
+    static void test_on_body_fragment(void* callback_ctx, const unsigned char* fragment, size_t fragment_len)
+    {
+        (void)callback_ctx;
+        (void)fragment;
+        g_body_fragment_len += fragment_len;
+    }
+
+    static void test_on_message_complete(void* callback_ctx, HTTP_CLIENT_RESULT request_result)
+    {
+        (void)callback_ctx;
+        (void)request_result;
+        g_message_complete_count++;
+    }
+
+    static void test_on_batch_complete(void* callback_ctx, size_t request_count, size_t failed_count)
+    {
+        (void)callback_ctx;
+        g_batch_complete_count++;
+        g_batch_request_count = request_count;
+        g_batch_failed_count = failed_count;
+    }
+
+    static void* test_alloc(void* alloc_ctx, size_t size)
+    {
+        (void)alloc_ctx;
+        g_test_alloc_count++;
+        return my_mem_shim_malloc(size);
+    }
+
+    static void* test_realloc(void* alloc_ctx, void* ptr, size_t size)
+    {
+        (void)alloc_ctx;
+        return realloc(ptr, size);
+    }
+
+    static void test_free(void* alloc_ctx, void* ptr)
+    {
+        (void)alloc_ctx;
+        g_test_free_count++;
+        my_mem_shim_free(ptr);
+    }
+
     static int my_byte_buffer_construct(BYTE_BUFFER* buffer, const unsigned char* payload, size_t length)
     {
-        buffer->payload = my_mem_shim_malloc(1);
-        buffer->payload_size = 1;
+        buffer->payload = my_mem_shim_malloc(length);
+        memcpy(buffer->payload, payload, length);
+        buffer->payload_size = length;
         return 0;
     }
 
@@ -165,6 +304,10 @@ extern "C" {
     static int my_item_list_add_copy(ITEM_LIST_HANDLE handle, const void* item, size_t item_size)
     {
         g_do_not_delete_items = handle;
+        if (g_add_copy_item != NULL)
+        {
+            my_mem_shim_free(g_add_copy_item);
+        }
         g_add_copy_item = my_mem_shim_malloc(item_size);
         memcpy(g_add_copy_item, item, item_size);
         return 0;
@@ -190,8 +333,8 @@ extern "C" {
 
     static const void* my_item_list_get_item(ITEM_LIST_HANDLE handle, size_t item_index)
     {
-        (void)handle;
-        return g_list_added_item;
+        (void)item_index;
+        return handle == g_do_not_delete_items ? g_add_copy_item : g_list_added_item;
     }
 
     static const void* my_item_list_get_front(ITEM_LIST_HANDLE handle)
@@ -210,7 +353,9 @@ extern "C" {
 
     PATCH_INSTANCE_HANDLE my_patchcord_client_create(const IO_INTERFACE_DESCRIPTION* io_interface_description, const void* parameters, const PATCHCORD_CALLBACK_INFO* client_cb)
     {
-        (void)parameters;
+        const SOCKETIO_CONFIG* config = (const SOCKETIO_CONFIG*)parameters;
+        g_cord_address_type = config->address_type;
+        g_cord_hostname = config->hostname;
         g_on_io_error_cb = client_cb->on_io_error;
         g_on_io_error_ctx = client_cb->on_io_error_ctx;
         return (PATCH_INSTANCE_HANDLE)my_mem_shim_malloc(1);
@@ -240,8 +385,9 @@ extern "C" {
         return (HTTP_HEADERS_HANDLE)my_mem_shim_malloc(1);
     }
 
-    static HTTP_CODEC_HANDLE my_http_codec_create(ON_HTTP_DATA_CALLBACK data_callback, void* user_ctx)
+    static HTTP_CODEC_HANDLE my_http_codec_create_with_allocator(ON_HTTP_DATA_CALLBACK data_callback, void* user_ctx, const HTTP_ALLOCATOR* allocator)
     {
+        (void)allocator;
         g_data_callback = data_callback;
         data_cb_user_ctx = user_ctx;
         return (HTTP_CODEC_HANDLE)my_mem_shim_malloc(1);
@@ -251,6 +397,165 @@ extern "C" {
     {
         my_mem_shim_free(handle);
     }
+
+    static int my_http_codec_set_stream_callbacks(HTTP_CODEC_HANDLE handle, ON_HTTP_HEADERS_CALLBACK headers_callback, ON_HTTP_BODY_FRAGMENT_CALLBACK body_fragment_callback)
+    {
+        (void)handle;
+        g_codec_headers_cb = headers_callback;
+        g_codec_body_fragment_cb = body_fragment_callback;
+        return 0;
+    }
+
+    static HTTP_TIMER_WHEEL_HANDLE my_http_timer_wheel_create(uint64_t start_ms, const HTTP_ALLOCATOR* allocator)
+    {
+        (void)start_ms;
+        (void)allocator;
+        return (HTTP_TIMER_WHEEL_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_timer_wheel_destroy(HTTP_TIMER_WHEEL_HANDLE handle)
+    {
+        my_mem_shim_free(handle);
+    }
+
+    static HTTP_TIMER_HANDLE my_http_timer_wheel_add(HTTP_TIMER_WHEEL_HANDLE handle, uint64_t expire_ms, ON_HTTP_TIMER_EXPIRED on_expired, void* timer_ctx)
+    {
+        (void)handle;
+        (void)expire_ms;
+        g_timer_expired_cb = on_expired;
+        g_timer_ctx = timer_ctx;
+        return TEST_TIMER_HANDLE;
+    }
+
+    static HTTP_MPSC_RING_HANDLE my_http_mpsc_ring_create(size_t capacity, size_t item_size, const HTTP_ALLOCATOR* allocator)
+    {
+        (void)capacity;
+        (void)allocator;
+        g_ring_item_size = item_size;
+        return (HTTP_MPSC_RING_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_mpsc_ring_destroy(HTTP_MPSC_RING_HANDLE handle)
+    {
+        my_mem_shim_free(g_ring_item);
+        g_ring_item = NULL;
+        my_mem_shim_free(handle);
+    }
+
+    // The ring holds a single item in the tests
+    static int my_http_mpsc_ring_push(HTTP_MPSC_RING_HANDLE handle, const void* item)
+    {
+        int result;
+        (void)handle;
+        if (g_ring_item != NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            g_ring_item = my_mem_shim_malloc(g_ring_item_size);
+            memcpy(g_ring_item, item, g_ring_item_size);
+            result = 0;
+        }
+        return result;
+    }
+
+    static bool my_http_mpsc_ring_pop(HTTP_MPSC_RING_HANDLE handle, void* item)
+    {
+        bool result;
+        (void)handle;
+        if (g_ring_item == NULL)
+        {
+            result = false;
+        }
+        else
+        {
+            memcpy(item, g_ring_item, g_ring_item_size);
+            my_mem_shim_free(g_ring_item);
+            g_ring_item = NULL;
+            result = true;
+        }
+        return result;
+    }
+
+    static bool my_http_mpsc_ring_is_empty(HTTP_MPSC_RING_HANDLE handle)
+    {
+        (void)handle;
+        return g_ring_item == NULL;
+    }
+
+    static void test_on_wake(void* wake_ctx)
+    {
+        (void)wake_ctx;
+        g_wake_count++;
+    }
+
+    static void test_on_ready(void* ready_ctx)
+    {
+        (void)ready_ctx;
+        g_ready_count++;
+    }
+
+    static int my_http_codec_set_message_begin_callback(HTTP_CODEC_HANDLE handle, ON_HTTP_MESSAGE_BEGIN_CALLBACK message_begin_callback)
+    {
+        (void)handle;
+        g_codec_message_begin_cb = message_begin_callback;
+        return 0;
+    }
+
+    static HTTP_TLS_HANDLE my_http_tls_create(HTTP_TLS_CACHE_HANDLE cache, const char* hostname, uint16_t port, const HTTP_TLS_CALLBACK_INFO* callback_info)
+    {
+        (void)cache;
+        (void)hostname;
+        (void)port;
+        g_tls_callback_info = *callback_info;
+        return (HTTP_TLS_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_tls_destroy(HTTP_TLS_HANDLE handle)
+    {
+        my_mem_shim_free(handle);
+    }
+
+    static int my_patchcord_client_send(PATCH_INSTANCE_HANDLE handle, const void* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+    {
+        (void)handle;
+        (void)on_send_complete;
+        (void)callback_context;
+        g_sent_length = size;
+        memcpy(g_sent_data, buffer, size < sizeof(g_sent_data) ? size : sizeof(g_sent_data));
+        return 0;
+    }
+
+    static HTTP_URING_CONN_HANDLE my_http_uring_conn_create(HTTP_URING_HANDLE uring, const SOCKETIO_CONFIG* config, const PATCHCORD_CALLBACK_INFO* callback_info)
+    {
+        (void)uring;
+        g_cord_address_type = config->address_type;
+        g_cord_hostname = config->hostname;
+        g_uring_callback_info = *callback_info;
+        return (HTTP_URING_CONN_HANDLE)my_mem_shim_malloc(1);
+    }
+
+    static void my_http_uring_conn_destroy(HTTP_URING_CONN_HANDLE handle)
+    {
+        my_mem_shim_free(handle);
+    }
+
+    static int my_http_uring_conn_open(HTTP_URING_CONN_HANDLE handle, ON_IO_OPEN_COMPLETE on_open_complete, void* on_open_complete_ctx)
+    {
+        (void)handle;
+        g_on_open_complete = on_open_complete;
+        g_open_user_ctx = on_open_complete_ctx;
+        return 0;
+    }
+
+    static int my_http_tls_open(HTTP_TLS_HANDLE handle, ON_IO_OPEN_COMPLETE on_open_complete, void* on_open_complete_ctx)
+    {
+        (void)handle;
+        g_on_tls_open_complete = on_open_complete;
+        g_tls_open_ctx = on_open_complete_ctx;
+        return 0;
+    }
 #ifdef __cplusplus
 }
 #endif
@@ -267,12 +572,15 @@ CTEST_SUITE_INITIALIZE()
 {
     umock_c_init(on_umock_c_error);
 
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
     CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types());
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types());
 
     REGISTER_UMOCK_ALIAS_TYPE(ITEM_LIST_DESTROY_ITEM, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADERS_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ITEM_LIST_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_CLIENT_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_PREPARED_REQUEST_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(PATCH_INSTANCE_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_OPEN_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_CLOSE_COMPLETE, void*);
@@ -281,6 +589,20 @@ CTEST_SUITE_INITIALIZE()
     REGISTER_UMOCK_ALIAS_TYPE(ON_SEND_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_DATA_CALLBACK, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_CODEC_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const HTTP_ALLOCATOR*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_HEADERS_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_BODY_FRAGMENT_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_MESSAGE_BEGIN_CALLBACK, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_TIMER_WHEEL_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_MPSC_RING_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_TIMER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_TIMER_EXPIRED, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_TLS_CACHE_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_TLS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const HTTP_TLS_CALLBACK_INFO*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_URING_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_URING_CONN_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const SOCKETIO_CONFIG*, void*);
 
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
@@ -315,7 +637,8 @@ CTEST_SUITE_INITIALIZE()
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(patchcord_client_open, __LINE__);
     REGISTER_GLOBAL_MOCK_HOOK(patchcord_client_close, my_patchcord_client_close);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(patchcord_client_close, __LINE__);
-    REGISTER_GLOBAL_MOCK_RETURN(patchcord_client_send, 0);
+    REGISTER_GLOBAL_MOCK_HOOK(patchcord_client_send, my_patchcord_client_send);
+    REGISTER_GLOBAL_MOCK_RETURN(patchcord_client_query_endpoint, TEST_HEADER_HOSTNAME);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(patchcord_client_send, __LINE__);
 
     REGISTER_GLOBAL_MOCK_HOOK(http_header_create, my_http_header_create);
@@ -323,14 +646,64 @@ CTEST_SUITE_INITIALIZE()
     REGISTER_GLOBAL_MOCK_RETURN(http_header_get_name_value_pair, 0);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_get_name_value_pair, __LINE__);
 
-    REGISTER_GLOBAL_MOCK_HOOK(http_codec_create, my_http_codec_create);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_codec_create_with_allocator, my_http_codec_create_with_allocator);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_create_with_allocator, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(http_codec_destroy, my_http_codec_destroy);
     REGISTER_GLOBAL_MOCK_RETURN(http_codec_set_trace, 0);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_set_trace, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_codec_set_buffer_retention, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_set_buffer_retention, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_codec_set_content_decoding, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_set_content_decoding, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_codec_set_stream_callbacks, my_http_codec_set_stream_callbacks);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_set_stream_callbacks, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_codec_set_message_begin_callback, my_http_codec_set_message_begin_callback);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_codec_set_message_begin_callback, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_create, my_http_mpsc_ring_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_mpsc_ring_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_destroy, my_http_mpsc_ring_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_push, my_http_mpsc_ring_push);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_mpsc_ring_push, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_pop, my_http_mpsc_ring_pop);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_is_empty, my_http_mpsc_ring_is_empty);
+    REGISTER_GLOBAL_MOCK_HOOK(http_timer_wheel_create, my_http_timer_wheel_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_timer_wheel_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_timer_wheel_destroy, my_http_timer_wheel_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_timer_wheel_add, my_http_timer_wheel_add);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_timer_wheel_add, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(http_timer_wheel_get_next_expiry, UINT64_MAX);
+    REGISTER_GLOBAL_MOCK_RETURN(http_tls_cache_create, TEST_TLS_CACHE);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_cache_create, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(http_tls_cache_add_ref, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_cache_add_ref, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_tls_create, my_http_tls_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_tls_destroy, my_http_tls_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_tls_open, my_http_tls_open);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_open, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_tls_send, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_tls_send, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_add_ref, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_add_ref, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_uring_conn_create, my_http_uring_conn_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_conn_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_uring_conn_destroy, my_http_uring_conn_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_uring_conn_open, my_http_uring_conn_open);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_conn_open, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_conn_close, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_conn_close, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_conn_send, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_uring_conn_send, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_conn_query_endpoint, TEST_HEADER_HOSTNAME);
+    REGISTER_GLOBAL_MOCK_RETURN(http_uring_get_fd, -1);
 
     TEST_HTTP_ADDRESS.hostname = TEST_HEADER_HOSTNAME;
     TEST_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_SECURE_HTTP_ADDRESS.hostname = TEST_HEADER_HOSTNAME;
+    TEST_SECURE_HTTP_ADDRESS.port = TEST_PORT;
+    TEST_SECURE_HTTP_ADDRESS.is_secure = true;
+    TEST_SOCKET_HTTP_ADDRESS.hostname = TEST_HEADER_HOSTNAME;
+    TEST_SOCKET_HTTP_ADDRESS.socket_path = TEST_SOCKET_PATH;
 }
 
 CTEST_SUITE_CLEANUP()
@@ -349,7 +722,36 @@ CTEST_FUNCTION_INITIALIZE()
     g_add_copy_item = NULL;
     g_on_io_error_cb = NULL;
     g_on_io_error_ctx = NULL;
-
+    g_cord_address_type = ADDRESS_TYPE_IP;
+    g_cord_hostname = NULL;
+    g_codec_headers_cb = NULL;
+    g_codec_body_fragment_cb = NULL;
+    g_codec_message_begin_cb = NULL;
+    g_timer_expired_cb = NULL;
+    g_timer_ctx = NULL;
+    g_ring_item_size = 0;
+    g_ring_item = NULL;
+    g_wake_count = 0;
+    g_ready_count = 0;
+    g_sent_length = 0;
+    g_request_result = HTTP_CLIENT_OK;
+    g_error_result = HTTP_CLIENT_OK;
+    memset(&g_tls_callback_info, 0, sizeof(g_tls_callback_info));
+    g_on_tls_open_complete = NULL;
+    g_tls_open_ctx = NULL;
+    memset(&g_uring_callback_info, 0, sizeof(g_uring_callback_info));
+    g_timing_client = NULL;
+    g_request_timing_result = 0;
+    memset(&g_request_timing, 0, sizeof(g_request_timing));
+    g_headers_complete_count = 0;
+    g_body_fragment_len = 0;
+    g_message_complete_count = 0;
+    g_test_alloc_count = 0;
+    g_test_free_count = 0;
+    g_batch_complete_count = 0;
+    g_batch_request_count = 0;
+    g_batch_failed_count = 0;
+    g_open_complete_count = 0;
 }
 
 CTEST_FUNCTION_CLEANUP()
@@ -359,7 +761,8 @@ CTEST_FUNCTION_CLEANUP()
 static void setup_http_client_create_mocks(void)
 {
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_codec_create(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_create_with_allocator(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_set_stream_callbacks(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_create(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_create(IGNORED_ARG, IGNORED_ARG));
 }
@@ -377,6 +780,7 @@ static void setup_http_client_execute_request_mocks(bool add_content)
     STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
         .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
         .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
 }
@@ -394,19 +798,55 @@ static void setup_http_client_execute_request_hostname_header_mocks(bool add_con
     STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
         .CopyOutArgumentBuffer(3, &TEST_HEADER_HOSTNAME, sizeof(TEST_HEADER_HOSTNAME))
         .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
 }
 
-static void setup_http_client_process_item_mocks(bool add_content)
+static void setup_http_client_prepare_request_mocks(void)
 {
-    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(patchcord_client_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+}
+
+static void setup_http_client_execute_prepared_request_mocks(bool add_content)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     if (add_content)
     {
-        STRICT_EXPECTED_CALL(patchcord_client_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     }
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+}
+
+static void setup_http_client_execute_batch_mocks(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG)).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+}
+
+static void setup_http_client_process_item_mocks(void)
+{
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
     STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
@@ -460,6 +900,71 @@ CTEST_FUNCTION(http_client_create_fail)
     umock_c_negative_tests_deinit();
 }
 
+CTEST_FUNCTION(http_client_create_with_allocator_NULL_succeed)
+{
+    // arrange
+    setup_http_client_create_mocks();
+
+    // act
+    HTTP_CLIENT_HANDLE handle = http_client_create_with_allocator(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_create_with_allocator_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, NULL };
+
+    STRICT_EXPECTED_CALL(http_codec_create_with_allocator(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_set_stream_callbacks(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_create(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_create(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    HTTP_CLIENT_HANDLE handle = http_client_create_with_allocator(&allocator);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_test_alloc_count);
+
+    // cleanup
+    http_client_destroy(handle);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_test_free_count);
+}
+
+CTEST_FUNCTION(http_client_create_with_allocator_execute_request_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, NULL };
+    HTTP_CLIENT_HANDLE handle = http_client_create_with_allocator(&allocator);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+    g_test_alloc_count = 0;
+
+    // act
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    // The request, its header block and its send buffer
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, g_test_alloc_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, g_test_free_count);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
 CTEST_FUNCTION(http_client_destroy_handle_NULL_succeed)
 {
     // arrange
@@ -532,6 +1037,7 @@ CTEST_FUNCTION(http_client_open_succeed)
     HTTP_CLIENT_HANDLE handle = http_client_create();
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
     STRICT_EXPECTED_CALL(http_codec_get_recv_function());
     STRICT_EXPECTED_CALL(cord_socket_get_interface());
     STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -578,6 +1084,7 @@ CTEST_FUNCTION(http_client_open_fail)
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
     STRICT_EXPECTED_CALL(http_codec_get_recv_function()).CallCannotFail();
     STRICT_EXPECTED_CALL(cord_socket_get_interface()).CallCannotFail();
     STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -705,6 +1212,10 @@ CTEST_FUNCTION(http_client_on_socket_error_success)
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(http_codec_reintialize(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_clear(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG));
+
     // act
     g_on_io_error_cb(g_on_io_error_ctx, IO_ERROR_GENERAL);
 
@@ -716,6 +1227,34 @@ CTEST_FUNCTION(http_client_on_socket_error_success)
     http_client_destroy(handle);
 }
 
+CTEST_FUNCTION(http_client_on_socket_error_fails_pending_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0,
+        test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_reintialize(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_clear(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_on_io_error_cb(g_on_io_error_ctx, IO_ERROR_ENDPOINT_DISCONN);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(int, 1, g_message_complete_count);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
 CTEST_FUNCTION(http_client_close_on_error_succeed)
 {
     // arrange
@@ -792,6 +1331,28 @@ CTEST_FUNCTION(http_client_execute_request_hostname_header_succeed)
     http_client_destroy(handle);
 }
 
+CTEST_FUNCTION(http_client_execute_request_content_decoding_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    (void)http_client_set_content_decoding(handle, true);
+    umock_c_reset_all_calls();
+
+    setup_http_client_execute_request_mocks(false);
+
+    // act
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
 CTEST_FUNCTION(http_client_execute_request_content_succeed)
 {
     // arrange
@@ -925,19 +1486,31 @@ CTEST_FUNCTION(http_client_execute_request_w_content_fail)
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_opening_succeed)
+CTEST_FUNCTION(http_client_execute_request_endpoint_unknown_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
-
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
     // act
-    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
 
     // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -945,35 +1518,68 @@ CTEST_FUNCTION(http_client_process_item_opening_succeed)
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_handle_succeed)
+CTEST_FUNCTION(http_client_execute_stream_request_handle_NULL_fail)
 {
     // arrange
 
     // act
-    http_client_process_item(NULL);
+    int result = http_client_execute_stream_request(NULL, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
 
     // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
 }
 
-CTEST_FUNCTION(http_client_process_item_no_items_succeed)
+CTEST_FUNCTION(http_client_execute_stream_request_body_fragment_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, NULL, test_on_message_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_stream_request_message_complete_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_stream_request_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+    setup_http_client_execute_request_mocks(false);
 
     // act
-    http_client_process_item(handle);
+    int result = http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
 
     // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -981,22 +1587,20 @@ CTEST_FUNCTION(http_client_process_item_no_items_succeed)
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_open_post_fail)
+CTEST_FUNCTION(http_client_execute_stream_request_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-    setup_http_client_process_item_mocks(true);
-
+    setup_http_client_execute_request_mocks(true);
     umock_c_negative_tests_snapshot();
 
+    // act
     size_t count = umock_c_negative_tests_call_count();
     for (size_t index = 0; index < count; index++)
     {
@@ -1005,35 +1609,46 @@ CTEST_FUNCTION(http_client_process_item_open_post_fail)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            // act
-            http_client_process_item(handle);
+            int result = http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH,
+                test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
 
             // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_execute_stream_request failure %d/%d", (int)index, (int)count);
         }
     }
-
     // cleanup
+    umock_c_negative_tests_deinit();
+
     (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
-    umock_c_negative_tests_deinit();
 }
 
-CTEST_FUNCTION(http_client_process_item_open_post_succeed)
+CTEST_FUNCTION(http_client_prepare_request_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(NULL, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_prepare_request_relative_path_NULL_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    setup_http_client_process_item_mocks(true);
-
     // act
-    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, NULL, TEST_HTTP_HEADER);
 
     // assert
+    CTEST_ASSERT_IS_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -1041,22 +1656,18 @@ CTEST_FUNCTION(http_client_process_item_open_post_succeed)
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_open_get_succeed)
+CTEST_FUNCTION(http_client_prepare_request_invalid_type_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    setup_http_client_process_item_mocks(false);
-
     // act
-    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_TYPE_INVALID, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
 
     // assert
+    CTEST_ASSERT_IS_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -1064,200 +1675,3368 @@ CTEST_FUNCTION(http_client_process_item_open_get_succeed)
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_open_option_succeed)
+CTEST_FUNCTION(http_client_prepare_request_endpoint_NULL_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
-    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_OPTIONS, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    setup_http_client_process_item_mocks(false);
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
 
     // act
-    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
 
     // assert
+    CTEST_ASSERT_IS_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_open_put_succeed)
+CTEST_FUNCTION(http_client_prepare_request_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_PUT, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    setup_http_client_process_item_mocks(false);
+    setup_http_client_prepare_request_mocks();
 
     // act
-    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
 
     // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_client_destroy_prepared_request(result);
     (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_open_get_item_fail_succeed)
+CTEST_FUNCTION(http_client_prepare_request_header_NULL_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    http_client_process_item(handle);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
-    //STRICT_EXPECTED_CALL(test_on_open_complete(IGNORED_ARG, HTTP_CLIENT_OK));
-    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(0);
+    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
 
     // act
-    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL);
 
     // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_client_destroy_prepared_request(result);
     (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_process_item_not_connected_succeed)
+CTEST_FUNCTION(http_client_prepare_request_fail)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_client_prepare_request_mocks();
+    umock_c_negative_tests_snapshot();
 
     // act
-    http_client_process_item(handle);
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            HTTP_PREPARED_REQUEST_HANDLE result = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+
+            // assert
+            CTEST_ASSERT_IS_NULL(result, "http_client_prepare_request failure %d/%d", (int)index, (int)count);
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_prepared_request_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_client_destroy_prepared_request(NULL);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_set_trace_succeed)
+CTEST_FUNCTION(http_client_destroy_prepared_request_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_codec_set_trace(IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(prepared));
 
     // act
-    int result = http_client_set_trace(handle, true);
+    http_client_destroy_prepared_request(prepared);
 
     // assert
-    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_set_trace_fail)
+CTEST_FUNCTION(http_client_destroy_prepared_request_queued_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+    (void)http_client_execute_prepared_request(handle, prepared, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_codec_set_trace(IGNORED_ARG, true)).SetReturn(__LINE__);
+    // act
+    http_client_destroy_prepared_request(prepared);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_prepared_request_handle_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+    umock_c_reset_all_calls();
 
     // act
-    int result = http_client_set_trace(handle, true);
+    int result = http_client_execute_prepared_request(NULL, prepared, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_client_destroy_prepared_request(prepared);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(http_client_set_trace_handle_NULL_fail)
+CTEST_FUNCTION(http_client_execute_prepared_request_prepared_NULL_fail)
 {
     // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
 
     // act
-    int result = http_client_set_trace(NULL, true);
+    int result = http_client_execute_prepared_request(handle, NULL, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(on_codec_recv_callback_succeed)
+CTEST_FUNCTION(http_client_execute_prepared_request_NULL_content_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
     umock_c_reset_all_calls();
 
-    HTTP_RECV_DATA recv_data;
-    recv_data.status_code = 201;
-    recv_data.recv_header = TEST_HTTP_HEADER;
-    recv_data.http_content = g_buffer_data;
-
-    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
-    //STRICT_EXPECTED_CALL(test_on_request_callback(IGNORED_ARG, HTTP_CLIENT_OK, IGNORED_ARG, IGNORED_ARG, recv_data.status_code, recv_data.recv_header));
+    setup_http_client_execute_prepared_request_mocks(false);
 
     // act
-    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+    int result = http_client_execute_prepared_request(handle, prepared, NULL, 0, test_on_request_callback, NULL);
 
     // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_client_destroy_prepared_request(prepared);
     (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
-CTEST_FUNCTION(on_codec_recv_callback_get_front_NULL_fail)
+CTEST_FUNCTION(http_client_execute_prepared_request_content_succeed)
 {
     // arrange
     HTTP_CLIENT_HANDLE handle = http_client_create();
     (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
-    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
-    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
     umock_c_reset_all_calls();
 
-    HTTP_RECV_DATA recv_data;
-    recv_data.status_code = 201;
-    recv_data.recv_header = TEST_HTTP_HEADER;
-    recv_data.http_content = g_buffer_data;
-
-    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(NULL);
+    setup_http_client_execute_prepared_request_mocks(true);
 
     // act
-    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+    int result = http_client_execute_prepared_request(handle, prepared, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
 
     // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_client_destroy_prepared_request(prepared);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_prepared_request_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_client_execute_prepared_request_mocks(true);
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_execute_prepared_request(handle, prepared, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_execute_prepared_request failure %d/%d", (int)index, (int)count);
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+
+    http_client_destroy_prepared_request(prepared);
     (void)http_client_close(handle, test_on_close_complete, NULL);
     http_client_destroy(handle);
 }
 
+CTEST_FUNCTION(http_client_execute_batch_handle_NULL_fail)
+{
+    // arrange
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL }
+    };
+
+    // act
+    int result = http_client_execute_batch(NULL, requests, 1, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_execute_batch_requests_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_batch(handle, NULL, 1, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_request_count_0_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_batch(handle, requests, 0, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_relative_path_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL },
+        { HTTP_CLIENT_REQUEST_GET, NULL, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_batch(handle, requests, 2, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_content_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, TEST_CONTENT_LENGTH, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_execute_batch(handle, requests, 1, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL },
+        { HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    // The second request shares the headers of the first so they are only walked once
+    setup_http_client_execute_batch_mocks();
+
+    // act
+    int result = http_client_execute_batch(handle, requests, 2, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_batch_complete_count);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_add_item_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL },
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // The first request is taken back off both lists
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_client_execute_batch(handle, requests, 2, test_on_batch_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_batch_complete_count);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL },
+        { HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL }
+    };
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_client_execute_batch_mocks();
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_execute_batch(handle, requests, 2, test_on_batch_complete, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_execute_batch failure %d/%d", (int)index, (int)count);
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_batch_complete_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    HTTP_BATCH_REQUEST requests[] = {
+        { HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL }
+    };
+    (void)http_client_execute_batch(handle, requests, 1, test_on_batch_complete, NULL);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_ERROR, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_ERROR, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_batch_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_batch_request_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_batch_failed_count);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_opening_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_handle_succeed)
+{
+    // arrange
+
+    // act
+    http_client_process_item(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_process_item_no_items_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_work_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_client_process_work(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_process_work_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    // The connection is left to the caller flushing its ring
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_work(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_post_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_client_process_item_mocks();
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            http_client_process_item(handle);
+
+            // assert
+        }
+    }
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(http_client_process_item_open_post_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_post_large_content_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, TEST_LARGE_CONTENT, sizeof(TEST_LARGE_CONTENT), test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // The body is copied behind the head so the request is a single send
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    const char* head_end = strstr((const char*)g_sent_data, "\r\n\r\n");
+    CTEST_ASSERT_IS_NOT_NULL(head_end);
+    size_t head_len = (size_t)(head_end - (const char*)g_sent_data) + 4;
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, head_len + sizeof(TEST_LARGE_CONTENT), g_sent_length);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_sent_data + head_len, TEST_LARGE_CONTENT, sizeof(TEST_LARGE_CONTENT)));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_prepared_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    HTTP_PREPARED_REQUEST_HANDLE prepared = http_client_prepare_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER);
+    (void)http_client_execute_prepared_request(handle, prepared, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy_prepared_request(prepared);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_get_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_option_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_OPTIONS, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_put_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_PUT, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_open_get_item_fail_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_POST, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    //STRICT_EXPECTED_CALL(test_on_open_complete(IGNORED_ARG, HTTP_CLIENT_OK));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_pipeline_depth_reached_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // The first request has not been answered so the second one waits
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_pipelined_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_pipeline_depth(handle, 2);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    setup_http_client_process_item_mocks();
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_not_connected_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_trace_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_trace(IGNORED_ARG, true));
+
+    // act
+    int result = http_client_set_trace(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_trace_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_trace(IGNORED_ARG, true)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_trace(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_trace_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_trace(NULL, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    bool result = http_client_has_pending_work(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_not_connected_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    bool result = http_client_has_pending_work(handle);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_opening_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    bool result = http_client_has_pending_work(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_open_idle_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(0);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(0);
+
+    // act
+    bool result = http_client_has_pending_work(handle);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_open_waiting_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(0);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+
+    // act
+    bool result = http_client_has_pending_work(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_wait_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_wait(NULL, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_wait_not_connected_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+
+    // act
+    int result = http_client_wait(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_wait_queued_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // The queued request is sent without sleeping
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    setup_http_client_process_item_mocks();
+
+    // act
+    int result = http_client_wait(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_wait_submitted_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_is_empty(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_wait(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_wait_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // Queued sends are submitted before the ring is waited on
+    STRICT_EXPECTED_CALL(http_uring_conn_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_get_fd(TEST_URING));
+    STRICT_EXPECTED_CALL(http_uring_conn_process_item(IGNORED_ARG));
+
+    // act
+    int result = http_client_wait(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_wait_timer_expired_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // The connect deadline has passed so the wait returns to run it
+    STRICT_EXPECTED_CALL(http_uring_conn_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_timer_wheel_get_next_expiry(IGNORED_ARG)).SetReturn(0);
+    STRICT_EXPECTED_CALL(http_uring_get_fd(TEST_URING));
+    STRICT_EXPECTED_CALL(http_uring_conn_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_timer_wheel_advance(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_wait(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_fd_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_get_wait_fd(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, -1, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_get_wait_fd_socket_cord_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_wait_fd(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, -1, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_fd_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_get_fd(TEST_URING)).SetReturn(TEST_URING_FD);
+
+    // act
+    int result = http_client_get_wait_fd(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, TEST_URING_FD, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_flush_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_flush(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_flush_socket_cord_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_flush(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_flush_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_process(TEST_URING));
+
+    // act
+    int result = http_client_flush(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_flush_uring_not_open_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_process(TEST_URING));
+
+    // act
+    int result = http_client_flush(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_time_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_get_wait_time(NULL, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_get_wait_time_not_connected_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_wait_time(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, TEST_WAIT_TIMEOUT_MS, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_time_queued_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+
+    // act
+    int result = http_client_get_wait_time(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_time_socket_cord_opening_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_wait_time(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 1, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_wait_time_uring_opening_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_wait_time(handle, TEST_WAIT_TIMEOUT_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, TEST_WAIT_TIMEOUT_MS, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_pipeline_depth_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_pipeline_depth(NULL, 4);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_pipeline_depth_zero_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_pipeline_depth(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_pipeline_depth_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_pipeline_depth(handle, 4);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_buffer_retention_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_buffer_retention(NULL, 1024);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_buffer_retention_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_buffer_retention(IGNORED_ARG, 1024));
+
+    // act
+    int result = http_client_set_buffer_retention(handle, 1024);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_buffer_retention_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_buffer_retention(IGNORED_ARG, 1024)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_buffer_retention(handle, 1024);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_content_decoding_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_content_decoding(NULL, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_content_decoding_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_content_decoding(IGNORED_ARG, true));
+
+    // act
+    int result = http_client_set_content_decoding(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_content_decoding_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_content_decoding(IGNORED_ARG, true)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_content_decoding(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_timeouts_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_timeouts(NULL, 1000, 1000);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_timeouts_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_timer_wheel_create(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_set_timeouts(handle, 1000, 1000);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_timeouts_disabled_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_timeouts(handle, 0, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_timeouts_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_timer_wheel_create(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_client_set_timeouts(handle, 1000, 1000);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_timeouts_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 1000);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_timer_wheel_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_open_connect_timeout_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_timer_wheel_add(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(cord_socket_get_interface());
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(g_timer_expired_cb);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_connect_timer_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_timer_wheel_add(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_on_open_complete_cancels_connect_timer_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_timer_wheel_cancel(IGNORED_ARG, TEST_TIMER_HANDLE));
+
+    // act
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_connect_timeout_expired_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    g_timer_expired_cb(g_timer_ctx);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_TIMEOUT, g_error_result);
+    CTEST_ASSERT_IS_FALSE(http_client_has_pending_work(handle));
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_request_request_timeout_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(http_timer_wheel_add(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_add_copy_item, g_timer_ctx);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_request_timeout_expired_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    // Only the request sent on the connection fails, the connection opens again
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_reintialize(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_timer_wheel_advance(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(cord_socket_get_interface());
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    g_timer_expired_cb(g_timer_ctx);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_TIMEOUT, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_error_result);
+    CTEST_ASSERT_IS_TRUE(http_client_has_pending_work(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_request_timeout_reopen_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_counted_open_complete, NULL, test_on_result_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL);
+    http_client_process_item(handle);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    g_timer_expired_cb(g_timer_ctx);
+    http_client_process_item(handle);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 1, g_open_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_error_result);
+    CTEST_ASSERT_IS_FALSE(http_client_has_pending_work(handle));
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_request_timeout_queued_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // The request was never sent so it fails alone and the connection is kept
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_timer_expired_cb(g_timer_ctx);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_TIMEOUT, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_error_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_connect_timeout_late_open_ignored_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 1000, 0);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_counted_open_complete, NULL, test_on_result_error, NULL);
+    ON_IO_OPEN_COMPLETE late_open_complete = g_on_open_complete;
+    void* late_open_ctx = g_open_user_ctx;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_reintialize(IGNORED_ARG));
+
+    // act
+    g_timer_expired_cb(g_timer_ctx);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    http_client_process_item(handle);
+    late_open_complete(late_open_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_TIMEOUT, g_error_result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, g_open_complete_count);
+    CTEST_ASSERT_IS_FALSE(http_client_has_pending_work(handle));
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_request_timeout_late_response_ignored_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL);
+    http_client_process_item(handle);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    g_timer_expired_cb(g_timer_ctx);
+    http_client_process_item(handle);
+    g_request_result = HTTP_CLIENT_OK;
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    // The timeout failed the request sent on the dropped connection
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_error_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_cancels_request_timer_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_timeouts(handle, 0, 1000);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_result_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(http_timer_wheel_cancel(IGNORED_ARG, TEST_TIMER_HANDLE));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_enable_submit_queue_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_enable_submit_queue(NULL, TEST_SUBMIT_QUEUE_SIZE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_enable_submit_queue_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_create(TEST_SUBMIT_QUEUE_SIZE, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_enable_submit_queue_twice_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_enable_submit_queue_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_create(TEST_SUBMIT_QUEUE_SIZE, IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_wake_callback_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_wake_callback(NULL, test_on_wake, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_ready_callback_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_ready_callback(NULL, test_on_ready, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_ready_callback_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_close(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_set_ready_callback(handle, test_on_ready, NULL);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    // The close is finished by process_item
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_ready_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_submit_request_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_submit_request(NULL, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_submit_request_not_enabled_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_submit_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_set_wake_callback(handle, test_on_wake, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_push(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_wake_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_submit_request_queue_full_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_set_wake_callback(handle, test_on_wake, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_push(IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_wake_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_has_pending_work_submitted_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_is_empty(IGNORED_ARG));
+
+    // act
+    bool result = http_client_has_pending_work(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_drains_submit_queue_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_submitted_request_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_result_request_callback, NULL);
+    g_request_result = HTTP_CLIENT_OK;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_query_endpoint(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_ERROR, g_request_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_submitted_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_enable_submit_queue(handle, TEST_SUBMIT_QUEUE_SIZE);
+    (void)http_client_submit_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, NULL, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_request_timing_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_request_timing(NULL, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_request_timing_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_message_begin_callback(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_set_request_timing(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(g_codec_message_begin_cb);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_request_timing_disable_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_request_timing(handle, true);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_message_begin_callback(IGNORED_ARG, NULL));
+
+    // act
+    int result = http_client_set_request_timing(handle, false);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(g_codec_message_begin_cb);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_request_timing_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_codec_set_message_begin_callback(IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_request_timing(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_request_timing_handle_NULL_fail)
+{
+    // arrange
+    HTTP_REQUEST_TIMING timing;
+
+    // act
+    int result = http_client_get_request_timing(NULL, &timing);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_get_request_timing_timing_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_request_timing(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_get_request_timing_outside_callback_fail)
+{
+    // arrange
+    HTTP_REQUEST_TIMING timing;
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_request_timing(handle, true);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_get_request_timing(handle, &timing);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_request_timing_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    g_timing_client = handle;
+    (void)http_client_set_request_timing(handle, true);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_timed_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_codec_message_begin_cb(data_cb_user_ctx);
+    (void)g_codec_headers_cb(data_cb_user_ctx, &recv_data);
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, g_request_timing_result);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.enqueued != 0);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.first_byte >= g_request_timing.enqueued);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.headers_complete >= g_request_timing.first_byte);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.body_complete >= g_request_timing.headers_complete);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_request_timing_disabled_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    g_timing_client = handle;
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_timed_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, g_request_timing_result);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.enqueued == 0);
+    CTEST_ASSERT_IS_TRUE(g_request_timing.body_complete == 0);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data;
+    recv_data.status_code = 201;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+    recv_data.http_content = g_buffer_data;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    //STRICT_EXPECTED_CALL(test_on_request_callback(IGNORED_ARG, HTTP_CLIENT_OK, IGNORED_ARG, IGNORED_ARG, recv_data.status_code, recv_data.recv_header));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_get_front_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data;
+    recv_data.status_code = 201;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+    recv_data.http_content = g_buffer_data;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_headers_callback_stream_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+
+    // act
+    bool result = g_codec_headers_cb(data_cb_user_ctx, &recv_data);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_headers_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_headers_callback_buffered_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+
+    // act
+    bool result = g_codec_headers_cb(data_cb_user_ctx, &recv_data);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_headers_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_body_fragment_callback_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+
+    // act
+    g_codec_body_fragment_cb(data_cb_user_ctx, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_CONTENT_LENGTH, g_body_fragment_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_codec_recv_callback_stream_request_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_stream_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_headers_complete, test_on_body_fragment, test_on_message_complete, NULL);
+    umock_c_reset_all_calls();
+
+    HTTP_RECV_DATA recv_data = {0};
+    recv_data.status_code = 200;
+    recv_data.recv_header = TEST_HTTP_HEADER;
+
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG)).SetReturn(g_add_copy_item);
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
+
+    // act
+    g_data_callback(data_cb_user_ctx, HTTP_CODEC_CB_RESULT_OK, &recv_data);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_message_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_tls_cache_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_tls_cache(NULL, TEST_TLS_CACHE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_tls_cache_cache_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_tls_cache(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_tls_cache_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_cache_add_ref(TEST_TLS_CACHE));
+
+    // act
+    int result = http_client_set_tls_cache(handle, TEST_TLS_CACHE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_tls_cache_add_ref_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_cache_add_ref(TEST_TLS_CACHE)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_tls_cache(handle, TEST_TLS_CACHE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_tls_cache_replace_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_tls_cache(handle, TEST_TLS_CACHE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_cache_add_ref(TEST_OTHER_TLS_CACHE));
+    STRICT_EXPECTED_CALL(http_tls_cache_destroy(TEST_TLS_CACHE));
+
+    // act
+    int result = http_client_set_tls_cache(handle, TEST_OTHER_TLS_CACHE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_secure_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(http_tls_cache_create(NULL));
+    STRICT_EXPECTED_CALL(http_tls_create(TEST_TLS_CACHE, TEST_HEADER_HOSTNAME, TEST_PORT, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(cord_socket_get_interface());
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(g_tls_callback_info.on_send);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_secure_shared_cache_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_tls_cache(handle, TEST_OTHER_TLS_CACHE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(http_tls_create(TEST_OTHER_TLS_CACHE, TEST_HEADER_HOSTNAME, TEST_PORT, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(cord_socket_get_interface());
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_secure_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function()).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_tls_cache_create(NULL));
+    STRICT_EXPECTED_CALL(http_tls_create(TEST_TLS_CACHE, TEST_HEADER_HOSTNAME, TEST_PORT, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(cord_socket_get_interface()).CallCannotFail();
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            HTTP_CLIENT_HANDLE handle = http_client_create();
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_open failure %d/%d", (int)index, (int)count);
+
+            // cleanup
+            http_client_destroy(handle);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(on_open_complete_secure_starts_handshake_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+
+    // act
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(g_on_tls_open_complete);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OK, g_error_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_open_complete_secure_tls_open_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_tls_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+
+    // act
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OPEN_FAILED, g_error_result);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_tls_open_complete_handshake_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_result_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    // act
+    g_on_tls_open_complete(g_tls_open_ctx, IO_OPEN_ERROR);
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CLIENT_OPEN_FAILED, g_error_result);
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_process_item_secure_get_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    g_on_tls_open_complete(g_tls_open_ctx, IO_OPEN_OK);
+    http_client_process_item(handle);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_tls_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(on_tls_send_records_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_send(IGNORED_ARG, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = g_tls_callback_info.on_send(g_tls_callback_info.on_send_ctx, TEST_SEND_CONTENT, TEST_CONTENT_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_secure_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SECURE_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_tls_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_tls_cache_destroy(TEST_TLS_CACHE));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_open_unix_socket_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_SOCKET_PATH));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(cord_socket_get_interface());
+    STRICT_EXPECTED_CALL(patchcord_client_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(patchcord_client_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_open(handle, &TEST_SOCKET_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, ADDRESS_TYPE_DOMAIN_SOCKET, g_cord_address_type);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_SOCKET_PATH, g_cord_hostname);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_unix_socket_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_SOCKET_PATH));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_open(handle, &TEST_SOCKET_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_execute_request_unix_socket_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SOCKET_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // The Host header comes from the address instead of the cord endpoint
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_header_get_count(IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_header_get_name_value_pair(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CopyOutArgumentBuffer(3, &TEST_HEADER_NAME_1, sizeof(TEST_HEADER_NAME_1))
+        .CopyOutArgumentBuffer(4, &TEST_HEADER_VALUE_1, sizeof(TEST_HEADER_VALUE_1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_copy(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_unix_socket_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_open(handle, &TEST_SOCKET_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_uring_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_client_set_uring(NULL, TEST_URING);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_client_set_uring_uring_NULL_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_uring(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_add_ref(TEST_URING));
+
+    // act
+    int result = http_client_set_uring(handle, TEST_URING);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_uring_add_ref_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_add_ref(TEST_URING)).SetReturn(__LINE__);
+
+    // act
+    int result = http_client_set_uring(handle, TEST_URING);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_uring_replace_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_add_ref(TEST_OTHER_URING));
+    STRICT_EXPECTED_CALL(http_uring_destroy(TEST_URING));
+
+    // act
+    int result = http_client_set_uring(handle, TEST_OTHER_URING);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_set_uring_opened_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_client_set_uring(handle, TEST_OTHER_URING);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function());
+    STRICT_EXPECTED_CALL(http_uring_conn_create(TEST_URING, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_conn_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(g_uring_callback_info.on_bytes_received);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_HOSTNAME, g_cord_hostname);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_open_uring_fail)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_HOSTNAME));
+    STRICT_EXPECTED_CALL(http_codec_get_recv_function()).CallCannotFail();
+    STRICT_EXPECTED_CALL(http_uring_conn_create(TEST_URING, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_conn_open(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_client_open failure %d/%d", (int)index, (int)count);
+        }
+    }
+
+    // cleanup
+    http_client_destroy(handle);    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(http_client_process_item_uring_send_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    (void)http_client_execute_request(handle, HTTP_CLIENT_REQUEST_GET, TEST_RELATIVE_PATH, TEST_HTTP_HEADER, NULL, 0, test_on_request_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_conn_process_item(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_conn_send(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_get_front(IGNORED_ARG));
+
+    // act
+    http_client_process_item(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_close_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    g_on_open_complete(g_open_user_ctx, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_uring_conn_close(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_client_close(handle, test_on_close_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_client_destroy(handle);
+}
+
+CTEST_FUNCTION(http_client_destroy_uring_succeed)
+{
+    // arrange
+    HTTP_CLIENT_HANDLE handle = http_client_create();
+    (void)http_client_set_uring(handle, TEST_URING);
+    (void)http_client_open(handle, &TEST_HTTP_ADDRESS, test_on_open_complete, NULL, test_on_error, NULL);
+    (void)http_client_close(handle, test_on_close_complete, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(patchcord_client_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_conn_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_uring_destroy(TEST_URING));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_codec_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_client_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
 CTEST_END_TEST_SUITE(http_client_ut)
@@ -14,6 +14,7 @@
 
 #include "umock_c/umock_c_negative_tests.h"
 #include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
 
 static void* my_mem_shim_malloc(size_t size)
 {
@@ -30,11 +31,15 @@ static void my_mem_shim_free(void* ptr)
     free(ptr);
 }
 
+// The token lookup is a pure table probe, the parser uses the real one
+#include "http_client/http_header_token.h"
+
 #define ENABLE_MOCKS
 #include "umock_c/umock_c_prod.h"
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/buffer_alloc.h"
 #include "http_client/http_headers.h"
+#include "http_client/http_content_decoder.h"
 #undef ENABLE_MOCKS
 
 #include "http_client/http_codec.h"
@@ -119,6 +124,9 @@ static const char* TEST_HTTP_CHUNK_EXAMPLE_IRL_4[] =
     "0\r\n\r\n"
 };
 static const char* TEST_HTTP_CHUNK_EXAMPLE_IRL_4_BODY = "{\"enrollmentGroupId\":\"RIoT_Device\",\"attestation\":{\"x509\":{}},\"etag\":\"\\\"14009e7f-0000-0000-0000-5914dd230000\\\"\",\"generationId\":\"9d546a85-5e8a-44c3-8946-c8ce4f54e5b6\"}";
+static const char* TEST_HTTP_CHUNK_EXAMPLE_IRL_BODY = "ABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890123456"
+    "1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF"
+    "1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF";
 #define CHUNK_IRL_LENGTH_1      26
 #define CHUNK_IRL_LENGTH_2      16
 #define CHUNK_IRL_LENGTH_3      256
@@ -153,8 +161,27 @@ static const char* TEST_SMALL_HTTP_EXAMPLE = "HTTP/1.1 200 OK\r\nDate: Mon, 23 M
 
 static const char* TEST_HTTP_BODY = "<html><head><title>An Example Page</title></head><body>Hello World, this is a very simple HTML document.</body></html>\r\n\r\n";
 
+// A content length response followed by a chunked one in the same read
+static const char* TEST_HTTP_PIPELINED_EXAMPLE = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhelloHTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n";
+static const char* TEST_HTTP_PIPELINED_BODY = "hello";
+
+// The decoder is mocked, the body only stands in for compressed bytes
+static const char* TEST_HTTP_GZIP_EXAMPLE = "HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\nContent-Length: 10\r\n\r\n0123456789";
+static const char* TEST_HTTP_GZIP_DECODED_BODY = "{\"id\": 1842, \"name\": \"sensor-17\", \"status\": \"online\"}";
+static HTTP_CONTENT_DECODER_HANDLE TEST_CONTENT_DECODER = (HTTP_CONTENT_DECODER_HANDLE)0x12345;
+
 static HTTP_HEADERS_HANDLE TEST_HTTP_HEADER = (HTTP_HEADERS_HANDLE)0x67890;
 
+static unsigned char g_stream_body[1024];
+static size_t g_stream_body_len;
+static size_t g_stream_headers_count;
+static size_t g_stream_complete_count;
+static size_t g_message_begin_count;
+static size_t g_data_recv_count;
+static HTTP_CODEC_CB_RESULT g_data_recv_result;
+static bool g_decode_fail;
+static void* g_header_alloc_ctx;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -174,6 +201,7 @@ extern "C" {
     {
         HTTP_CODEC_VALIDATE* validate = (HTTP_CODEC_VALIDATE*)callback_ctx;
         CTEST_ASSERT_IS_NOT_NULL(validate);
+        g_data_recv_count++;
         if (result == HTTP_CODEC_CB_RESULT_OK)
         {
             if (validate->content == NULL)
@@ -192,6 +220,38 @@ extern "C" {
         }
     }
 
+    static bool test_on_stream_headers(void* callback_ctx, const HTTP_RECV_DATA* http_recv_data)
+    {
+        HTTP_CODEC_VALIDATE* validate = (HTTP_CODEC_VALIDATE*)callback_ctx;
+        CTEST_ASSERT_ARE_EQUAL(uint32_t, validate->status_code, http_recv_data->status_code);
+        g_stream_headers_count++;
+        return true;
+    }
+
+    static void test_on_stream_body_fragment(void* callback_ctx, const unsigned char* fragment, size_t fragment_len)
+    {
+        (void)callback_ctx;
+        CTEST_ASSERT_IS_TRUE(g_stream_body_len + fragment_len <= sizeof(g_stream_body));
+        memcpy(g_stream_body + g_stream_body_len, fragment, fragment_len);
+        g_stream_body_len += fragment_len;
+    }
+
+    static void test_on_stream_complete(void* callback_ctx, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data)
+    {
+        HTTP_CODEC_VALIDATE* validate = (HTTP_CODEC_VALIDATE*)callback_ctx;
+        CTEST_ASSERT_ARE_EQUAL(int, HTTP_CODEC_CB_RESULT_OK, result);
+        CTEST_ASSERT_ARE_EQUAL(uint32_t, validate->status_code, http_recv_data->status_code);
+        CTEST_ASSERT_ARE_EQUAL(size_t, strlen(validate->content), g_stream_body_len);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_stream_body, validate->content, g_stream_body_len));
+        g_stream_complete_count++;
+    }
+
+    static void test_on_message_begin(void* callback_ctx)
+    {
+        CTEST_ASSERT_IS_NOT_NULL(callback_ctx);
+        g_message_begin_count++;
+    }
+
     static int my_byte_buffer_construct(BYTE_BUFFER* buffer, const unsigned char* payload, size_t length)
     {
         if (buffer->payload == NULL)
@@ -199,10 +259,15 @@ extern "C" {
             buffer->payload = my_mem_shim_malloc(length);
             memcpy(buffer->payload, payload, length);
             buffer->payload_size = length;
+            buffer->alloc_size = length;
         }
         else
         {
-            buffer->payload = my_mem_shim_realloc(buffer->payload, buffer->payload_size+length);
+            if (buffer->payload_size+length > buffer->alloc_size)
+            {
+                buffer->payload = my_mem_shim_realloc(buffer->payload, buffer->payload_size+length);
+                buffer->alloc_size = buffer->payload_size+length;
+            }
             memcpy(buffer->payload+buffer->payload_size, payload, length);
             buffer->payload_size += length;
         }
@@ -218,8 +283,56 @@ extern "C" {
         return 0;
     }
 
-    static HTTP_HEADERS_HANDLE my_http_header_create(void)
+    static int my_http_content_decoder_decode(HTTP_CONTENT_DECODER_HANDLE handle, const unsigned char* encoded, size_t encoded_len, ON_CONTENT_DECODED on_decoded, void* user_ctx)
+    {
+        int result;
+        (void)handle;
+        (void)encoded;
+        (void)encoded_len;
+        if (g_decode_fail)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            // Hand the decoded body over in two blocks
+            size_t decoded_len = strlen(TEST_HTTP_GZIP_DECODED_BODY);
+            on_decoded(user_ctx, (const unsigned char*)TEST_HTTP_GZIP_DECODED_BODY, decoded_len/2);
+            on_decoded(user_ctx, (const unsigned char*)TEST_HTTP_GZIP_DECODED_BODY + decoded_len/2, decoded_len - decoded_len/2);
+            result = 0;
+        }
+        return result;
+    }
+
+    static void test_on_decode_result_callback(void* callback_ctx, HTTP_CODEC_CB_RESULT result, const HTTP_RECV_DATA* http_recv_data)
+    {
+        (void)callback_ctx;
+        (void)http_recv_data;
+        g_data_recv_result = result;
+        g_data_recv_count++;
+    }
+
+    static void* test_alloc(void* alloc_ctx, size_t size)
+    {
+        (void)alloc_ctx;
+        return my_mem_shim_malloc(size);
+    }
+
+    static void* test_realloc(void* alloc_ctx, void* ptr, size_t size)
+    {
+        (void)alloc_ctx;
+        return my_mem_shim_realloc(ptr, size);
+    }
+
+    static void test_free(void* alloc_ctx, void* ptr)
+    {
+        (void)alloc_ctx;
+        my_mem_shim_free(ptr);
+    }
+
+    static HTTP_HEADERS_HANDLE my_http_header_create_with_allocator(const HTTP_ALLOCATOR* allocator)
     {
+        g_header_alloc_ctx = allocator != NULL ? allocator->alloc_ctx : NULL;
         return (HTTP_HEADERS_HANDLE)my_mem_shim_malloc(1);
     }
 
@@ -244,13 +357,21 @@ CTEST_SUITE_INITIALIZE()
 {
     umock_c_init(on_umock_c_error);
 
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types());
+
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const HTTP_ALLOCATOR*, void*);
     REGISTER_UMOCK_ALIAS_TYPE(PATCH_INSTANCE_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_OPEN_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_CLOSE_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_BYTES_RECEIVED, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_ERROR, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_SEND_COMPLETE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_CONTENT_DECODER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_CONTENT_DECODED, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_CONTENT_ENCODING, int);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADER_TOKEN, int);
 
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
@@ -259,12 +380,20 @@ CTEST_SUITE_INITIALIZE()
     REGISTER_GLOBAL_MOCK_HOOK(byte_buffer_construct, my_byte_buffer_construct);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(byte_buffer_construct, __LINE__);
 
-    REGISTER_GLOBAL_MOCK_HOOK(http_header_create, my_http_header_create);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_header_create_with_allocator, my_http_header_create_with_allocator);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_create_with_allocator, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(http_header_destroy, my_http_header_destroy);
 
     REGISTER_GLOBAL_MOCK_RETURN(http_header_get_name_value_pair, 0);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_header_get_name_value_pair, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_RETURN(http_content_decoder_is_available, true);
+    REGISTER_GLOBAL_MOCK_RETURN(http_content_decoder_create, TEST_CONTENT_DECODER);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_content_decoder_create, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(http_content_decoder_reset, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_content_decoder_reset, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_content_decoder_decode, my_http_content_decoder_decode);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_content_decoder_decode, __LINE__);
 }
 
 CTEST_SUITE_CLEANUP()
@@ -275,7 +404,14 @@ CTEST_SUITE_CLEANUP()
 CTEST_FUNCTION_INITIALIZE()
 {
     umock_c_reset_all_calls();
-
+    g_stream_body_len = 0;
+    g_stream_headers_count = 0;
+    g_stream_complete_count = 0;
+    g_message_begin_count = 0;
+    g_data_recv_count = 0;
+    g_data_recv_result = HTTP_CODEC_CB_RESULT_OK;
+    g_decode_fail = false;
+    g_header_alloc_ctx = NULL;
 }
 
 CTEST_FUNCTION_CLEANUP()
@@ -286,7 +422,12 @@ static void setup_deinit_data_mocks(void)
 {
     STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+}
+
+static void setup_content_encoding_mocks(const char* encoding_value, HTTP_CONTENT_ENCODING encoding)
+{
+    STRICT_EXPECTED_CALL(http_header_get_known_value(IGNORED_ARG, HTTP_HEADER_TOKEN_CONTENT_ENCODING)).SetReturn(encoding_value);
+    STRICT_EXPECTED_CALL(http_content_decoder_get_encoding(encoding_value)).SetReturn(encoding);
 }
 
 static void setup_http_header_item(const char* header_name)
@@ -347,6 +488,7 @@ CTEST_FUNCTION(http_codec_destroy_succeed)
 
     setup_deinit_data_mocks();
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     http_codec_destroy(handle);
@@ -414,7 +556,7 @@ CTEST_FUNCTION(on_http_bytes_recv_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     STRICT_EXPECTED_CALL(http_header_add_partial(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -435,8 +577,6 @@ CTEST_FUNCTION(on_http_bytes_recv_succeed)
     STRICT_EXPECTED_CALL(http_header_add_partial(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(http_header_add_partial(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     size_t count = sizeof(TEST_HTTP_EXAMPLE)/sizeof(TEST_HTTP_EXAMPLE[0]);
@@ -454,6 +594,27 @@ CTEST_FUNCTION(on_http_bytes_recv_succeed)
     http_codec_destroy(handle);
 }
 
+CTEST_FUNCTION(on_http_bytes_recv_header_uses_codec_allocator_succeed)
+{
+    // arrange
+    int alloc_ctx;
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, &alloc_ctx };
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_BODY, 200};
+
+    HTTP_CODEC_HANDLE handle = http_codec_create_with_allocator(test_on_data_recv_callback, &validate, &allocator);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_SMALL_HTTP_EXAMPLE, strlen(TEST_SMALL_HTTP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &alloc_ctx, g_header_alloc_ctx);
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
 CTEST_FUNCTION(on_http_bytes_recv_small_example_succeed)
 {
     // arrange
@@ -462,15 +623,13 @@ CTEST_FUNCTION(on_http_bytes_recv_small_example_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     setup_http_header_item("Date");
     setup_http_header_item("Accept-Ranges");
     setup_http_header_item("Content-Type");
     setup_http_header_item("content-length");
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     const char* test_value = TEST_SMALL_HTTP_EXAMPLE;
@@ -495,15 +654,13 @@ CTEST_FUNCTION(on_http_bytes_recv_small_example_fail)
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     setup_http_header_item("Date");
     setup_http_header_item("Accept-Ranges");
     setup_http_header_item("Content-Type");
     setup_http_header_item("content-length");
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     umock_c_negative_tests_snapshot();
 
@@ -538,7 +695,7 @@ CTEST_FUNCTION(on_http_bytes_recv_example_2_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     setup_http_header_item("Date");
     setup_http_header_item("X-Content-Type-Options");
@@ -559,8 +716,6 @@ CTEST_FUNCTION(on_http_bytes_recv_example_2_succeed)
     setup_http_header_item("content-length");
     setup_http_header_item("Server");
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     size_t count = sizeof(TEST_HTTP_EXAMPLE_2)/sizeof(TEST_HTTP_EXAMPLE_2[0]);
@@ -586,15 +741,13 @@ CTEST_FUNCTION(on_http_bytes_recv_no_content_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     setup_http_header_item("content-length");
     setup_http_header_item("Server");
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     setup_http_header_item("date");
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     size_t count = sizeof(TEST_HTTP_NO_CONTENT_EXAMPLE)/sizeof(TEST_HTTP_NO_CONTENT_EXAMPLE[0]);
@@ -620,7 +773,7 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_content_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     setup_http_header_item("date");
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -628,12 +781,6 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_content_succeed)
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     setup_http_header_item("Transfer-Encoding");
 
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, 18));
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, 9));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-
     // act
     size_t count = sizeof(TEST_HTTP_CHUNK_EXAMPLE)/sizeof(TEST_HTTP_CHUNK_EXAMPLE[0]);
     for (size_t index = 0; index < count; index++)
@@ -658,7 +805,7 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_IRL_content_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -671,13 +818,7 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_IRL_content_succeed)
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     size_t count = sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL_2)/sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL_2[0]);
@@ -703,7 +844,7 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_IRL_4_content_succeed)
     ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(http_header_create());
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -716,13 +857,7 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_IRL_4_content_succeed)
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(http_header_destroy(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
     size_t count = sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL_4)/sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL_4[0]);
@@ -740,30 +875,217 @@ CTEST_FUNCTION(on_http_bytes_recv_chunked_IRL_4_content_succeed)
     http_codec_destroy(handle);
 }
 
-CTEST_FUNCTION(http_codec_set_trace_handle_NULL_fail)
+CTEST_FUNCTION(on_http_bytes_recv_chunked_split_crlf_succeed)
 {
     // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_EXAMPLE_IRL_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Date");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Type");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Transfer-Encoding");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
     // act
-    int result = http_codec_set_trace(NULL, true);
+    size_t count = sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL)/sizeof(TEST_HTTP_CHUNK_EXAMPLE_IRL[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        const char* test_value = TEST_HTTP_CHUNK_EXAMPLE_IRL[index];
+        size_t test_len = strlen(test_value);
+        on_bytes_recv(handle, (const unsigned char*)test_value, test_len);
+    }
 
     // assert
-    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    http_codec_destroy(handle);
 }
 
-CTEST_FUNCTION(http_codec_set_trace_succeed)
+CTEST_FUNCTION(on_http_bytes_recv_chunked_split_data_succeed)
 {
     // arrange
-    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_EXAMPLE_IRL_2_BODY, 200};
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_SPLIT_EXAMPLE_BODY, 200};
     HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Date");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Type");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Transfer-Encoding");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
     // act
-    int result = http_codec_set_trace(handle, true);
+    size_t count = sizeof(TEST_HTTP_CHUNK_SPLIT_EXAMPLE)/sizeof(TEST_HTTP_CHUNK_SPLIT_EXAMPLE[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        const char* test_value = TEST_HTTP_CHUNK_SPLIT_EXAMPLE[index];
+        size_t test_len = strlen(test_value);
+        on_bytes_recv(handle, (const unsigned char*)test_value, test_len);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_pipelined_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_PIPELINED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Length");
+
+    // The header set and buffer of the first response are reused
+    STRICT_EXPECTED_CALL(http_header_clear(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Transfer-Encoding");
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_PIPELINED_EXAMPLE, strlen(TEST_HTTP_PIPELINED_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_stream_content_length_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_stream_complete, (void*)&validate);
+    (void)http_codec_set_stream_callbacks(handle, test_on_stream_headers, test_on_stream_body_fragment);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Date");
+    setup_http_header_item("Accept-Ranges");
+    setup_http_header_item("Content-Type");
+    setup_http_header_item("content-length");
+
+    // act
+    const char* test_value = TEST_SMALL_HTTP_EXAMPLE;
+    size_t test_len = strlen(test_value);
+    on_bytes_recv(handle, (const unsigned char*)test_value, test_len);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_headers_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_stream_content_length_split_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_2_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_stream_complete, &validate);
+    (void)http_codec_set_stream_callbacks(handle, test_on_stream_headers, test_on_stream_body_fragment);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    // act
+    size_t count = sizeof(TEST_HTTP_EXAMPLE_2)/sizeof(TEST_HTTP_EXAMPLE_2[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        const char* test_value = TEST_HTTP_EXAMPLE_2[index];
+        size_t test_len = strlen(test_value);
+        on_bytes_recv(handle, (const unsigned char*)test_value, test_len);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_headers_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_complete_count);
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_stream_chunked_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_stream_complete, &validate);
+    (void)http_codec_set_stream_callbacks(handle, test_on_stream_headers, test_on_stream_body_fragment);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("date");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("content-type");
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Transfer-Encoding");
+
+    // act
+    size_t count = sizeof(TEST_HTTP_CHUNK_EXAMPLE)/sizeof(TEST_HTTP_CHUNK_EXAMPLE[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        const char* test_value = TEST_HTTP_CHUNK_EXAMPLE[index];
+        size_t test_len = strlen(test_value);
+        on_bytes_recv(handle, (const unsigned char*)test_value, test_len);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_headers_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_stream_callbacks_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_codec_set_stream_callbacks(NULL, test_on_stream_headers, test_on_stream_body_fragment);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_codec_set_stream_callbacks_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_stream_complete, &validate);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_stream_callbacks(handle, test_on_stream_headers, test_on_stream_body_fragment);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
@@ -773,4 +1095,421 @@ CTEST_FUNCTION(http_codec_set_trace_succeed)
     http_codec_destroy(handle);
 }
 
+CTEST_FUNCTION(http_codec_set_message_begin_callback_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_codec_set_message_begin_callback(NULL, test_on_message_begin);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_codec_set_message_begin_callback_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_PIPELINED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_message_begin_callback(handle, test_on_message_begin);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_message_begin_pipelined_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_PIPELINED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    (void)http_codec_set_message_begin_callback(handle, test_on_message_begin);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_PIPELINED_EXAMPLE, strlen(TEST_HTTP_PIPELINED_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_message_begin_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_data_recv_count);
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_trace_handle_NULL_fail)
+{
+    // arrange
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_trace(NULL, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_codec_set_trace_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_CHUNK_EXAMPLE_IRL_2_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_trace(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_buffer_retention_handle_NULL_fail)
+{
+    // arrange
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_buffer_retention(NULL, 1024);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_codec_set_buffer_retention_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, &validate);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_buffer_retention(handle, 1024);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_reuse_buffers_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, (void*)&validate);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    on_bytes_recv(handle, (const unsigned char*)TEST_SMALL_HTTP_EXAMPLE, strlen(TEST_SMALL_HTTP_EXAMPLE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_clear(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Date");
+    setup_http_header_item("Accept-Ranges");
+    setup_http_header_item("Content-Type");
+    setup_http_header_item("content-length");
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_SMALL_HTTP_EXAMPLE, strlen(TEST_SMALL_HTTP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_buffer_over_retention_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_EXAMPLE_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, (void*)&validate);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    (void)http_codec_set_buffer_retention(handle, 0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Date");
+    setup_http_header_item("Accept-Ranges");
+    setup_http_header_item("Content-Type");
+    setup_http_header_item("content-length");
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_SMALL_HTTP_EXAMPLE, strlen(TEST_SMALL_HTTP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_content_decoding_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_codec_set_content_decoding(NULL, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_codec_set_content_decoding_not_available_fail)
+{
+    // arrange
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_content_decoder_is_available()).SetReturn(false);
+
+    // act
+    int result = http_codec_set_content_decoding(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_content_decoding_succeed)
+{
+    // arrange
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_content_decoder_is_available());
+
+    // act
+    int result = http_codec_set_content_decoding(handle, true);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(http_codec_set_content_decoding_disable_succeed)
+{
+    // arrange
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_codec_set_content_decoding(handle, false);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_content_decoded_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_GZIP_DECODED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, (void*)&validate);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("gzip", HTTP_CONTENT_ENCODING_GZIP);
+    STRICT_EXPECTED_CALL(http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP));
+    STRICT_EXPECTED_CALL(http_content_decoder_decode(TEST_CONTENT_DECODER, IGNORED_ARG, 10, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_content_decoder_reused_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_GZIP_DECODED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, (void*)&validate);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    STRICT_EXPECTED_CALL(http_header_get_known_value(IGNORED_ARG, HTTP_HEADER_TOKEN_CONTENT_ENCODING)).SetReturn("gzip");
+    STRICT_EXPECTED_CALL(http_content_decoder_get_encoding(IGNORED_ARG)).SetReturn(HTTP_CONTENT_ENCODING_GZIP);
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_clear(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("gzip", HTTP_CONTENT_ENCODING_GZIP);
+    STRICT_EXPECTED_CALL(http_content_decoder_reset(TEST_CONTENT_DECODER, HTTP_CONTENT_ENCODING_GZIP));
+    STRICT_EXPECTED_CALL(http_content_decoder_decode(TEST_CONTENT_DECODER, IGNORED_ARG, 10, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_content_identity_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {"0123456789", 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_data_recv_callback, (void*)&validate);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("br", HTTP_CONTENT_ENCODING_UNSUPPORTED);
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_content_decode_fail)
+{
+    // arrange
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_decode_result_callback, NULL);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("gzip", HTTP_CONTENT_ENCODING_GZIP);
+    STRICT_EXPECTED_CALL(http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP));
+    STRICT_EXPECTED_CALL(http_content_decoder_decode(TEST_CONTENT_DECODER, IGNORED_ARG, 10, IGNORED_ARG, IGNORED_ARG));
+    g_decode_fail = true;
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CODEC_CB_RESULT_ERROR, g_data_recv_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_content_decoder_create_fail)
+{
+    // arrange
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_decode_result_callback, NULL);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("gzip", HTTP_CONTENT_ENCODING_GZIP);
+    STRICT_EXPECTED_CALL(http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP)).SetReturn(NULL);
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_data_recv_count);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CODEC_CB_RESULT_ERROR, g_data_recv_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
+CTEST_FUNCTION(on_http_bytes_recv_stream_content_decoded_succeed)
+{
+    // arrange
+    HTTP_CODEC_VALIDATE validate = {TEST_HTTP_GZIP_DECODED_BODY, 200};
+    HTTP_CODEC_HANDLE handle = http_codec_create(test_on_stream_complete, (void*)&validate);
+    (void)http_codec_set_stream_callbacks(handle, test_on_stream_headers, test_on_stream_body_fragment);
+    (void)http_codec_set_content_decoding(handle, true);
+    ON_BYTES_RECEIVED on_bytes_recv = http_codec_get_recv_function();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_header_create_with_allocator(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(byte_buffer_construct(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    setup_http_header_item("Content-Encoding");
+    setup_http_header_item("Content-Length");
+    setup_content_encoding_mocks("gzip", HTTP_CONTENT_ENCODING_GZIP);
+    STRICT_EXPECTED_CALL(http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP));
+    STRICT_EXPECTED_CALL(http_content_decoder_decode(TEST_CONTENT_DECODER, IGNORED_ARG, 10, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    on_bytes_recv(handle, (const unsigned char*)TEST_HTTP_GZIP_EXAMPLE, strlen(TEST_HTTP_GZIP_EXAMPLE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_headers_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_stream_complete_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_codec_destroy(handle);
+}
+
 CTEST_END_TEST_SUITE(http_codec_ut)
@@ -0,0 +1,492 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+#ifdef HTTP_CLIENT_USE_ZLIB
+#include <zlib.h>
+#endif
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_content_decoder.h"
+
+#define TEST_PLAIN_SIZE         4096
+#define TEST_ENCODED_SIZE       8192
+
+// zlib window bits for the test bodies
+#define TEST_GZIP_BITS          31
+#define TEST_ZLIB_BITS          15
+#define TEST_RAW_BITS           -15
+
+static unsigned char g_plain[TEST_PLAIN_SIZE];
+static unsigned char g_encoded[TEST_ENCODED_SIZE];
+static unsigned char g_decoded[TEST_PLAIN_SIZE * 2];
+static size_t g_decoded_len;
+static size_t g_decoded_calls;
+
+static void test_on_decoded(void* user_ctx, const unsigned char* decoded, size_t decoded_len)
+{
+    (void)user_ctx;
+    CTEST_ASSERT_IS_TRUE(g_decoded_len + decoded_len <= sizeof(g_decoded));
+    memcpy(g_decoded + g_decoded_len, decoded, decoded_len);
+    g_decoded_len += decoded_len;
+    g_decoded_calls++;
+}
+
+#ifdef HTTP_CLIENT_USE_ZLIB
+static size_t encode_plain(int window_bits)
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    CTEST_ASSERT_ARE_EQUAL(int, Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY));
+    stream.next_in = g_plain;
+    stream.avail_in = TEST_PLAIN_SIZE;
+    stream.next_out = g_encoded;
+    stream.avail_out = TEST_ENCODED_SIZE;
+    CTEST_ASSERT_ARE_EQUAL(int, Z_STREAM_END, deflate(&stream, Z_FINISH));
+    size_t result = (size_t)stream.total_out;
+    (void)deflateEnd(&stream);
+    return result;
+}
+
+static void assert_plain_decoded(void)
+{
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PLAIN_SIZE, g_decoded_len);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_plain, g_decoded, TEST_PLAIN_SIZE));
+}
+#endif
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_content_decoder_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    // Repetitive json with a little noise so the body compresses but not to nothing
+    for (size_t index = 0; index < TEST_PLAIN_SIZE; index++)
+    {
+        g_plain[index] = (unsigned char)("{\"id\": 1842, \"status\": \"online\"}, "[index % 34] + (index % 97 == 0 ? 1 : 0));
+    }
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_decoded_len = 0;
+    g_decoded_calls = 0;
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(http_content_decoder_get_encoding_NULL_succeed)
+{
+    // arrange
+
+    // act
+    HTTP_CONTENT_ENCODING result = http_content_decoder_get_encoding(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CONTENT_ENCODING_IDENTITY, result);
+}
+
+CTEST_FUNCTION(http_content_decoder_get_encoding_succeed)
+{
+    // arrange
+    const char* gzip_list[] = { "gzip", "GZIP", " gzip ", "x-gzip" };
+    const char* identity_list[] = { "", "  ", "identity", "Identity" };
+    const char* unsupported_list[] = { "br", "compress", "gzip, br", "gzipx", "deflat" };
+
+    // act
+    // assert
+    for (size_t index = 0; index < sizeof(gzip_list)/sizeof(gzip_list[0]); index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, HTTP_CONTENT_ENCODING_GZIP, http_content_decoder_get_encoding(gzip_list[index]), "value '%s'", gzip_list[index]);
+    }
+    for (size_t index = 0; index < sizeof(identity_list)/sizeof(identity_list[0]); index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, HTTP_CONTENT_ENCODING_IDENTITY, http_content_decoder_get_encoding(identity_list[index]), "value '%s'", identity_list[index]);
+    }
+    for (size_t index = 0; index < sizeof(unsupported_list)/sizeof(unsupported_list[0]); index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, HTTP_CONTENT_ENCODING_UNSUPPORTED, http_content_decoder_get_encoding(unsupported_list[index]), "value '%s'", unsupported_list[index]);
+    }
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_CONTENT_ENCODING_DEFLATE, http_content_decoder_get_encoding("Deflate"));
+}
+
+#ifdef HTTP_CLIENT_USE_ZLIB
+CTEST_FUNCTION(http_content_decoder_is_available_succeed)
+{
+    // arrange
+
+    // act
+    bool result = http_content_decoder_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+}
+
+CTEST_FUNCTION(http_content_decoder_create_identity_fail)
+{
+    // arrange
+
+    // act
+    HTTP_CONTENT_DECODER_HANDLE result = http_content_decoder_create(HTTP_CONTENT_ENCODING_IDENTITY);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_create_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_CONTENT_DECODER_HANDLE result = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    // The inflate state, zlib allocates through the library allocator
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_CONTENT_DECODER_HANDLE result = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_content_decoder_destroy(result);
+}
+
+CTEST_FUNCTION(http_content_decoder_create_inflate_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_CONTENT_DECODER_HANDLE result = http_content_decoder_create(HTTP_CONTENT_ENCODING_DEFLATE);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_content_decoder_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_destroy_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_DEFLATE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(handle));
+
+    // act
+    http_content_decoder_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_handle_NULL_fail)
+{
+    // arrange
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+
+    // act
+    int result = http_content_decoder_decode(NULL, g_encoded, encoded_len, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_decoded_calls);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_on_decoded_NULL_fail)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+
+    // act
+    int result = http_content_decoder_decode(handle, g_encoded, encoded_len, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_gzip_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+
+    // act
+    int result = http_content_decoder_decode(handle, g_encoded, encoded_len, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    assert_plain_decoded();
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_gzip_split_succeed)
+{
+    // arrange
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+
+    for (size_t split = 1; split <= 17; split += 4)
+    {
+        HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+        g_decoded_len = 0;
+
+        // act
+        int result = 0;
+        for (size_t offset = 0; offset < encoded_len && result == 0; offset += split)
+        {
+            result = http_content_decoder_decode(handle, g_encoded + offset, encoded_len - offset < split ? encoded_len - offset : split, test_on_decoded, NULL);
+        }
+
+        // assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result, "split %d", (int)split);
+        assert_plain_decoded();
+
+        // cleanup
+        http_content_decoder_destroy(handle);
+    }
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_deflate_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_DEFLATE);
+    size_t encoded_len = encode_plain(TEST_ZLIB_BITS);
+
+    // act
+    int result = http_content_decoder_decode(handle, g_encoded, encoded_len, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    assert_plain_decoded();
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_raw_deflate_split_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_DEFLATE);
+    size_t encoded_len = encode_plain(TEST_RAW_BITS);
+
+    // act
+    int result = 0;
+    for (size_t offset = 0; offset < encoded_len && result == 0; offset++)
+    {
+        result = http_content_decoder_decode(handle, g_encoded + offset, 1, test_on_decoded, NULL);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    assert_plain_decoded();
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_trailing_bytes_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+    memset(g_encoded + encoded_len, 'x', 8);
+
+    // act
+    int result = http_content_decoder_decode(handle, g_encoded, encoded_len + 8, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    assert_plain_decoded();
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_corrupt_fail)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+    // Breaks the crc32 in the gzip trailer
+    g_encoded[encoded_len - 8] ^= 0x55;
+
+    // act
+    int result = http_content_decoder_decode(handle, g_encoded, encoded_len, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_reset_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_content_decoder_reset(NULL, HTTP_CONTENT_ENCODING_GZIP);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_content_decoder_reset_unsupported_fail)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+
+    // act
+    int result = http_content_decoder_reset(handle, HTTP_CONTENT_ENCODING_UNSUPPORTED);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+
+CTEST_FUNCTION(http_content_decoder_reset_succeed)
+{
+    // arrange
+    HTTP_CONTENT_DECODER_HANDLE handle = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+    size_t encoded_len = encode_plain(TEST_GZIP_BITS);
+    (void)http_content_decoder_decode(handle, g_encoded, encoded_len, test_on_decoded, NULL);
+    g_decoded_len = 0;
+    encoded_len = encode_plain(TEST_RAW_BITS);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_content_decoder_reset(handle, HTTP_CONTENT_ENCODING_DEFLATE);
+    int decode_result = http_content_decoder_decode(handle, g_encoded, encoded_len, test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, decode_result);
+    assert_plain_decoded();
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_content_decoder_destroy(handle);
+}
+#else
+CTEST_FUNCTION(http_content_decoder_is_available_fail)
+{
+    // arrange
+
+    // act
+    bool result = http_content_decoder_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+}
+
+CTEST_FUNCTION(http_content_decoder_create_fail)
+{
+    // arrange
+
+    // act
+    HTTP_CONTENT_DECODER_HANDLE result = http_content_decoder_create(HTTP_CONTENT_ENCODING_GZIP);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_content_decoder_decode_fail)
+{
+    // arrange
+    const unsigned char encoded[] = { 0x1f, 0x8b };
+
+    // act
+    int result = http_content_decoder_decode(NULL, encoded, sizeof(encoded), test_on_decoded, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_decoded_calls);
+}
+#endif
+
+CTEST_END_TEST_SUITE(http_content_decoder_ut)
@@ -0,0 +1,151 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+#include "http_client/http_header_token.h"
+
+typedef struct TEST_KNOWN_HEADER_TAG
+{
+    const char* name;
+    HTTP_HEADER_TOKEN token;
+} TEST_KNOWN_HEADER;
+
+static const TEST_KNOWN_HEADER TEST_KNOWN_HEADER_LIST[] =
+{
+    { "Cache-Control", HTTP_HEADER_TOKEN_CACHE_CONTROL },
+    { "Connection", HTTP_HEADER_TOKEN_CONNECTION },
+    { "Content-Encoding", HTTP_HEADER_TOKEN_CONTENT_ENCODING },
+    { "Content-Length", HTTP_HEADER_TOKEN_CONTENT_LENGTH },
+    { "Content-Type", HTTP_HEADER_TOKEN_CONTENT_TYPE },
+    { "Date", HTTP_HEADER_TOKEN_DATE },
+    { "ETag", HTTP_HEADER_TOKEN_ETAG },
+    { "Expires", HTTP_HEADER_TOKEN_EXPIRES },
+    { "Keep-Alive", HTTP_HEADER_TOKEN_KEEP_ALIVE },
+    { "Last-Modified", HTTP_HEADER_TOKEN_LAST_MODIFIED },
+    { "Location", HTTP_HEADER_TOKEN_LOCATION },
+    { "Retry-After", HTTP_HEADER_TOKEN_RETRY_AFTER },
+    { "Server", HTTP_HEADER_TOKEN_SERVER },
+    { "Set-Cookie", HTTP_HEADER_TOKEN_SET_COOKIE },
+    { "Transfer-Encoding", HTTP_HEADER_TOKEN_TRANSFER_ENCODING },
+    { "WWW-Authenticate", HTTP_HEADER_TOKEN_WWW_AUTHENTICATE }
+};
+#define TEST_KNOWN_HEADER_COUNT     (sizeof(TEST_KNOWN_HEADER_LIST)/sizeof(TEST_KNOWN_HEADER_LIST[0]))
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_header_token_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(http_header_token_lookup_name_NULL_fail)
+{
+    // arrange
+
+    // act
+    HTTP_HEADER_TOKEN result = http_header_token_lookup(NULL, 14);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_UNKNOWN, result);
+}
+
+CTEST_FUNCTION(http_header_token_lookup_name_len_0_fail)
+{
+    // arrange
+
+    // act
+    HTTP_HEADER_TOKEN result = http_header_token_lookup("content-length", 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_UNKNOWN, result);
+}
+
+CTEST_FUNCTION(http_header_token_lookup_every_known_header_succeed)
+{
+    // arrange
+    CTEST_ASSERT_ARE_EQUAL(size_t, HTTP_HEADER_TOKEN_COUNT - 1, TEST_KNOWN_HEADER_COUNT);
+
+    for (size_t index = 0; index < TEST_KNOWN_HEADER_COUNT; index++)
+    {
+        // act
+        HTTP_HEADER_TOKEN result = http_header_token_lookup(TEST_KNOWN_HEADER_LIST[index].name, strlen(TEST_KNOWN_HEADER_LIST[index].name));
+
+        // assert
+        CTEST_ASSERT_ARE_EQUAL(int, TEST_KNOWN_HEADER_LIST[index].token, result, "header %s", TEST_KNOWN_HEADER_LIST[index].name);
+    }
+}
+
+CTEST_FUNCTION(http_header_token_lookup_case_insensitive_succeed)
+{
+    // arrange
+
+    // act
+    HTTP_HEADER_TOKEN result = http_header_token_lookup("tRaNsFeR-eNcOdInG", 17);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_TRANSFER_ENCODING, result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_CONTENT_LENGTH, http_header_token_lookup("CONTENT-LENGTH", 14));
+}
+
+CTEST_FUNCTION(http_header_token_lookup_partial_name_succeed)
+{
+    // arrange
+    const char* header_line = "Content-Length: 125\r\n";
+
+    // act
+    HTTP_HEADER_TOKEN result = http_header_token_lookup(header_line, 14);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_CONTENT_LENGTH, result);
+}
+
+CTEST_FUNCTION(http_header_token_lookup_unknown_succeed)
+{
+    // arrange
+    const char* unknown_list[] = { "content-lengt", "content-length2", "x-content-length", "Accept-Ranges", "X-Request-Id", "a", "dat3", "keep_alive" };
+
+    for (size_t index = 0; index < sizeof(unknown_list)/sizeof(unknown_list[0]); index++)
+    {
+        // act
+        HTTP_HEADER_TOKEN result = http_header_token_lookup(unknown_list[index], strlen(unknown_list[index]));
+
+        // assert
+        CTEST_ASSERT_ARE_EQUAL(int, HTTP_HEADER_TOKEN_UNKNOWN, result, "header %s", unknown_list[index]);
+    }
+}
+
+CTEST_END_TEST_SUITE(http_header_token_ut)
@@ -3,9 +3,11 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstdio>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdio.h>
 #endif
 
 #include "ctest.h"
@@ -28,8 +30,6 @@ static void my_mem_shim_free(void* ptr)
 #define ENABLE_MOCKS
 #include "umock_c/umock_c_prod.h"
 #include "lib-util-c/sys_debug_shim.h"
-#include "lib-util-c/item_list.h"
-#include "lib-util-c/crt_extensions.h"
 #undef ENABLE_MOCKS
 
 #include "http_client/http_headers.h"
@@ -44,57 +44,35 @@ static const char* TEST_HEADER_VALUE_3 = "TEST_HEADER_VALUE_3";
 static size_t PARTIAL_TEST_HEADER_LEN = 16;
 static size_t PARTIAL_TEST_HEADER_VAL_LEN = 17;
 
-static ITEM_LIST_DESTROY_ITEM g_list_destroy_cb;
-static void* g_destroy_user_ctx;
-static const void* g_list_added_item;
+// Matches the initial entry allocation in http_headers.c
+#define TEST_INITIAL_ENTRY_COUNT    32
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-    static ITEM_LIST_HANDLE my_item_list_create(ITEM_LIST_DESTROY_ITEM destroy_cb, void* user_ctx)
-    {
-        g_list_destroy_cb = destroy_cb;
-        g_destroy_user_ctx = user_ctx;
-        return my_mem_shim_malloc(1);
-    }
-
-    static void my_item_list_destroy(ITEM_LIST_HANDLE handle)
-    {
-        if (g_list_added_item != NULL)
-        {
-            g_list_destroy_cb(g_destroy_user_ctx, (void*)g_list_added_item);
-        }
-        my_mem_shim_free(handle);
-    }
+static size_t g_test_alloc_count;
+static size_t g_test_free_count;
 
-    static int my_item_list_add_item(ITEM_LIST_HANDLE handle, const void* item)
-    {
-        (void)handle;
-        g_list_added_item = item;
-        return 0;
-    }
+static void* test_alloc(void* alloc_ctx, size_t size)
+{
+    (void)alloc_ctx;
+    g_test_alloc_count++;
+    return my_mem_shim_malloc(size);
+}
 
-    static const void* my_item_list_get_item(ITEM_LIST_HANDLE handle, size_t item_index)
-    {
-        (void)handle;
-        return g_list_added_item;
-    }
+static void* test_realloc(void* alloc_ctx, void* ptr, size_t size)
+{
+    (void)alloc_ctx;
+    return realloc(ptr, size);
+}
 
-    static int my_clone_string(char** target, const char* source)
-    {
-        size_t len = strlen(source);
-        *target = my_mem_shim_malloc(len+1);
-        strcpy(*target, source);
-        return 0;
-    }
+static void test_free(void* alloc_ctx, void* ptr)
+{
+    (void)alloc_ctx;
+    g_test_free_count++;
+    my_mem_shim_free(ptr);
+}
 
-    static int my_clone_string_with_size(char** target, const char* source, size_t len)
-    {
-        *target = my_mem_shim_malloc(len+1);
-        strncpy(*target, source, len);
-        return 0;
-    }
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #ifdef __cplusplus
 }
@@ -112,29 +90,11 @@ CTEST_SUITE_INITIALIZE()
 {
     umock_c_init(on_umock_c_error);
 
-    REGISTER_UMOCK_ALIAS_TYPE(ITEM_LIST_DESTROY_ITEM, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADERS_HANDLE, void*);
-    REGISTER_UMOCK_ALIAS_TYPE(ITEM_LIST_HANDLE, void*);
 
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
-
-    REGISTER_GLOBAL_MOCK_HOOK(item_list_create, my_item_list_create);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_list_create, NULL);
-    REGISTER_GLOBAL_MOCK_HOOK(item_list_destroy, my_item_list_destroy);
-    //REGISTER_GLOBAL_MOCK_HOOK(item_destroy_callback, my_item_destroy_cb);
-    REGISTER_GLOBAL_MOCK_HOOK(item_list_add_item, my_item_list_add_item);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_list_add_item, __LINE__);
-    REGISTER_GLOBAL_MOCK_RETURN(item_list_item_count, 0);
-    REGISTER_GLOBAL_MOCK_HOOK(item_list_get_item, my_item_list_get_item);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_list_get_item, NULL);
-    REGISTER_GLOBAL_MOCK_RETURN(item_list_clear, 0);
-
-    REGISTER_GLOBAL_MOCK_HOOK(clone_string, my_clone_string);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clone_string, __LINE__);
-    REGISTER_GLOBAL_MOCK_HOOK(clone_string_with_size, my_clone_string_with_size);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clone_string_with_size, __LINE__);
 }
 
 CTEST_SUITE_CLEANUP()
@@ -145,7 +105,8 @@ CTEST_SUITE_CLEANUP()
 CTEST_FUNCTION_INITIALIZE()
 {
     umock_c_reset_all_calls();
-    g_list_added_item = NULL;
+    g_test_alloc_count = 0;
+    g_test_free_count = 0;
 }
 
 CTEST_FUNCTION_CLEANUP()
@@ -155,23 +116,34 @@ CTEST_FUNCTION_CLEANUP()
 static void http_header_create_mocks(void)
 {
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(item_list_create(IGNORED_ARG, IGNORED_ARG));
 }
 
 static void setup_http_header_add_mocks(void)
 {
+    // First header allocates the string arena
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_NAME_1));
-    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, TEST_HEADER_VALUE_1));
-    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
 }
 
 static void setup_http_header_add_partial_mocks(void)
 {
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clone_string_with_size(IGNORED_ARG, TEST_HEADER_NAME_1, PARTIAL_TEST_HEADER_LEN));
-    STRICT_EXPECTED_CALL(clone_string_with_size(IGNORED_ARG, TEST_HEADER_VALUE_1, PARTIAL_TEST_HEADER_VAL_LEN));
-    STRICT_EXPECTED_CALL(item_list_add_item(IGNORED_ARG, IGNORED_ARG));
+}
+
+static void setup_http_header_add_grow_mocks(void)
+{
+    // The filler headers use up the initial entries and the first arena block
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+}
+
+static void add_filler_headers(HTTP_HEADERS_HANDLE handle, size_t count)
+{
+    char name[32];
+    for (size_t index = 0; index < count; index++)
+    {
+        sprintf(name, "X-Filler-%d", (int)index);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, name, TEST_HEADER_VALUE_2));
+    }
 }
 
 CTEST_FUNCTION(http_header_create_succeed)
@@ -218,13 +190,52 @@ CTEST_FUNCTION(http_header_create_fail)
     umock_c_negative_tests_deinit();
 }
 
+CTEST_FUNCTION(http_header_create_with_allocator_succeed)
+{
+    // arrange
+    HTTP_ALLOCATOR allocator = { test_alloc, test_realloc, test_free, NULL };
+
+    // act
+    HTTP_HEADERS_HANDLE handle = http_header_create_with_allocator(&allocator);
+    int result = http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    // The header and its string arena
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_test_alloc_count);
+
+    // cleanup
+    http_header_destroy(handle);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_test_free_count);
+}
+
 CTEST_FUNCTION(http_header_destroy_succeed)
 {
     // arrange
     HTTP_HEADERS_HANDLE handle = http_header_create();
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_header_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_header_destroy_with_items_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
@@ -348,6 +359,63 @@ CTEST_FUNCTION(http_header_add_succeed)
     http_header_destroy(handle);
 }
 
+CTEST_FUNCTION(http_header_add_grow_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    add_filler_headers(handle, TEST_INITIAL_ENTRY_COUNT);
+    umock_c_reset_all_calls();
+
+    setup_http_header_add_grow_mocks();
+
+    // act
+    int result = http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_INITIAL_ENTRY_COUNT+1, http_header_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_1, http_header_get_value(handle, TEST_HEADER_NAME_1));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, http_header_get_value(handle, "X-Filler-3"));
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_add_grow_fail)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    add_filler_headers(handle, TEST_INITIAL_ENTRY_COUNT);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_header_add_grow_mocks();
+    umock_c_negative_tests_snapshot();
+
+    // act
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1);
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "http_header_add failure %d/%d", (int)index, (int)count);
+            CTEST_ASSERT_ARE_EQUAL(size_t, TEST_INITIAL_ENTRY_COUNT, http_header_get_count(handle));
+        }
+    }
+    // cleanup
+    umock_c_negative_tests_deinit();
+    http_header_destroy(handle);
+}
+
 CTEST_FUNCTION(http_header_add_partial_handle_NULL_fail)
 {
     // arrange
@@ -422,10 +490,8 @@ CTEST_FUNCTION(http_header_remove_no_items_succeed)
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG));
-
     // act
-    result = http_header_remove(handle, TEST_HEADER_NAME_1);
+    result = http_header_remove(handle, TEST_HEADER_NAME_2);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
@@ -457,21 +523,66 @@ CTEST_FUNCTION(http_header_remove_items_succeed)
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
-    STRICT_EXPECTED_CALL(item_list_remove_item(IGNORED_ARG, 0));
-
     // act
     result = http_header_remove(handle, TEST_HEADER_NAME_1);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_header_get_count(handle));
+    CTEST_ASSERT_IS_NULL(http_header_get_value(handle, TEST_HEADER_NAME_1));
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
     http_header_destroy(handle);
 }
 
+CTEST_FUNCTION(http_header_remove_case_insensitive_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "Content-Type", TEST_HEADER_VALUE_1));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_header_remove(handle, "content-TYPE");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_header_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_remove_keeps_order_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_2, TEST_HEADER_VALUE_2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_3, TEST_HEADER_VALUE_3));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_header_remove(handle, TEST_HEADER_NAME_2);
+
+    // assert
+    const char* name;
+    const char* value;
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_header_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_get_name_value_pair(handle, 0, &name, &value));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_NAME_1, name);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_get_name_value_pair(handle, 1, &name, &value));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_NAME_3, name);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_3, http_header_get_value(handle, TEST_HEADER_NAME_3));
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, http_header_get_name_value_pair(handle, 2, &name, &value));
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
 CTEST_FUNCTION(http_header_get_value_handle_NULL_fail)
 {
     // arrange
@@ -510,9 +621,6 @@ CTEST_FUNCTION(http_header_get_value_succeed)
     CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
-
     // act
     const char* result = http_header_get_value(handle, TEST_HEADER_NAME_1);
 
@@ -524,22 +632,164 @@ CTEST_FUNCTION(http_header_get_value_succeed)
     http_header_destroy(handle);
 }
 
-CTEST_FUNCTION(http_header_get_value_2_loop_succeed)
+CTEST_FUNCTION(http_header_get_value_case_insensitive_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "Content-Length", TEST_HEADER_VALUE_1));
+    umock_c_reset_all_calls();
+
+    // act
+    const char* result = http_header_get_value(handle, "content-length");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_1, result);
+    CTEST_ASSERT_IS_NULL(http_header_get_value(handle, "content-lengt"));
+    CTEST_ASSERT_IS_NULL(http_header_get_value(handle, "content-length2"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_value_not_found_succeed)
 {
     // arrange
     HTTP_HEADERS_HANDLE handle = http_header_create();
     CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(2);
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0)).SetReturn(NULL);
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 1));
+    // act
+    const char* result = http_header_get_value(handle, TEST_HEADER_NAME_2);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_value_after_remove_and_add_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    char name[32];
+    for (size_t index = 0; index < TEST_INITIAL_ENTRY_COUNT*4; index++)
+    {
+        sprintf(name, "X-Churn-%d", (int)index);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, name, TEST_HEADER_VALUE_2));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_remove(handle, name));
+    }
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    umock_c_reset_all_calls();
 
     // act
     const char* result = http_header_get_value(handle, TEST_HEADER_NAME_1);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_1, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_header_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_known_value_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    const char* result = http_header_get_known_value(NULL, HTTP_HEADER_TOKEN_CONTENT_LENGTH);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_header_get_known_value_unknown_token_fail)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    umock_c_reset_all_calls();
+
+    // act
+    const char* result = http_header_get_known_value(handle, HTTP_HEADER_TOKEN_UNKNOWN);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_known_value_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add_partial(handle, "Content-Length: 12", 14, "12", 2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "ETag", TEST_HEADER_VALUE_2));
+    umock_c_reset_all_calls();
+
+    // act
+    const char* result = http_header_get_known_value(handle, HTTP_HEADER_TOKEN_CONTENT_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "12", result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, http_header_get_known_value(handle, HTTP_HEADER_TOKEN_ETAG));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, http_header_get_value(handle, "etag"));
+    CTEST_ASSERT_IS_NULL(http_header_get_known_value(handle, HTTP_HEADER_TOKEN_RETRY_AFTER));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_known_value_after_remove_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "Set-Cookie", TEST_HEADER_VALUE_1));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_3, TEST_HEADER_VALUE_3));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "set-cookie", TEST_HEADER_VALUE_2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_remove(handle, "SET-COOKIE"));
+    umock_c_reset_all_calls();
+
+    // act
+    const char* result = http_header_get_known_value(handle, HTTP_HEADER_TOKEN_SET_COOKIE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_header_get_count(handle));
+
+    // Walking by index squeezes out the removed entry
+    const char* name;
+    const char* value;
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_get_name_value_pair(handle, 1, &name, &value));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, http_header_get_known_value(handle, HTTP_HEADER_TOKEN_SET_COOKIE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
+CTEST_FUNCTION(http_header_get_known_value_after_clear_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, "Transfer-Encoding", "chunked"));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_clear(handle));
+    umock_c_reset_all_calls();
+
+    // act
+    const char* result = http_header_get_known_value(handle, HTTP_HEADER_TOKEN_TRANSFER_ENCODING);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -567,10 +817,9 @@ CTEST_FUNCTION(http_header_get_count_succeed)
 {
     // arrange
     HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_item_count(IGNORED_ARG)).SetReturn(1);
-
     // act
     size_t result = http_header_get_count(handle);
 
@@ -642,8 +891,6 @@ CTEST_FUNCTION(http_header_get_name_value_pair_succeed)
     CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0));
-
     // act
     const char* name;
     const char* value;
@@ -659,19 +906,17 @@ CTEST_FUNCTION(http_header_get_name_value_pair_succeed)
     http_header_destroy(handle);
 }
 
-CTEST_FUNCTION(http_header_get_name_value_pair_get_item_fail)
+CTEST_FUNCTION(http_header_get_name_value_pair_index_fail)
 {
     // arrange
     HTTP_HEADERS_HANDLE handle = http_header_create();
     CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_get_item(IGNORED_ARG, 0)).SetReturn(NULL);
-
     // act
     const char* name;
     const char* value;
-    int result = http_header_get_name_value_pair(handle, 0, &name, &value);
+    int result = http_header_get_name_value_pair(handle, 1, &name, &value);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
@@ -681,6 +926,26 @@ CTEST_FUNCTION(http_header_get_name_value_pair_get_item_fail)
     http_header_destroy(handle);
 }
 
+CTEST_FUNCTION(http_header_clear_reuses_arena_succeed)
+{
+    // arrange
+    HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_clear(handle));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_header_add(handle, TEST_HEADER_NAME_2, TEST_HEADER_VALUE_2);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HEADER_VALUE_2, http_header_get_value(handle, TEST_HEADER_NAME_2));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_header_destroy(handle);
+}
+
 CTEST_FUNCTION(http_header_clear_handle_NULL_fail)
 {
     // arrange
@@ -699,15 +964,16 @@ CTEST_FUNCTION(http_header_clear_succeed)
 {
     // arrange
     HTTP_HEADERS_HANDLE handle = http_header_create();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_header_add(handle, TEST_HEADER_NAME_1, TEST_HEADER_VALUE_1));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(item_list_clear(IGNORED_ARG));
-
     // act
     int result = http_header_clear(handle);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_header_get_count(handle));
+    CTEST_ASSERT_IS_NULL(http_header_get_value(handle, TEST_HEADER_NAME_1));
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
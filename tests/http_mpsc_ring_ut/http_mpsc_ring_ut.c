@@ -0,0 +1,417 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_mpsc_ring.h"
+
+#define TEST_RING_CAPACITY      4
+
+typedef struct TEST_ITEM_TAG
+{
+    size_t value;
+    unsigned char tag;
+} TEST_ITEM;
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_mpsc_ring_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(http_mpsc_ring_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_is_empty(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_create_capacity_0_fail)
+{
+    // arrange
+
+    // act
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(0, sizeof(TEST_ITEM), NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_create_item_size_0_fail)
+{
+    // arrange
+
+    // act
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, 0, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_create_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_create_slots_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_mpsc_ring_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_destroy_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_mpsc_ring_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_handle_NULL_fail)
+{
+    // arrange
+    TEST_ITEM item = { 1, 'a' };
+
+    // act
+    int result = http_mpsc_ring_push(NULL, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_item_NULL_fail)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_mpsc_ring_push(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_is_empty(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item = { 1, 'a' };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_mpsc_ring_push(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_FALSE(http_mpsc_ring_is_empty(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_full_fail)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item = { 1, 'a' };
+    for (size_t index = 0; index < TEST_RING_CAPACITY; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_mpsc_ring_push(handle, &item));
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_mpsc_ring_push(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_capacity_rounded_up_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY - 1, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item = { 1, 'a' };
+    for (size_t index = 0; index < TEST_RING_CAPACITY - 1; index++)
+    {
+        (void)http_mpsc_ring_push(handle, &item);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_mpsc_ring_push(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, http_mpsc_ring_push(handle, &item));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_pop_handle_NULL_fail)
+{
+    // arrange
+    TEST_ITEM item;
+
+    // act
+    bool result = http_mpsc_ring_pop(NULL, &item);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_mpsc_ring_pop_empty_fail)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item;
+    umock_c_reset_all_calls();
+
+    // act
+    bool result = http_mpsc_ring_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_pop_in_order_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM first = { 1, 'a' };
+    TEST_ITEM second = { 2, 'b' };
+    TEST_ITEM item;
+    (void)http_mpsc_ring_push(handle, &first);
+    (void)http_mpsc_ring_push(handle, &second);
+    umock_c_reset_all_calls();
+
+    // act
+    bool result = http_mpsc_ring_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item.value);
+    CTEST_ASSERT_ARE_EQUAL(int, 'a', item.tag);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_pop(handle, &item));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, item.value);
+    CTEST_ASSERT_ARE_EQUAL(int, 'b', item.tag);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_is_empty(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_pop_wraps_around_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item;
+    size_t popped = 0;
+    bool in_order = true;
+    umock_c_reset_all_calls();
+
+    // act
+    for (size_t index = 0; index < TEST_RING_CAPACITY * 3; index++)
+    {
+        TEST_ITEM pushed = { index, (unsigned char)index };
+        if (http_mpsc_ring_push(handle, &pushed) != 0)
+        {
+            in_order = false;
+        }
+        // Stay one item behind so every slot is reused while holding an item
+        if (index > 0)
+        {
+            in_order = in_order && http_mpsc_ring_pop(handle, &item) && item.value == popped++;
+        }
+    }
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(in_order);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_pop(handle, &item));
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_RING_CAPACITY * 3 - 1, item.value);
+    CTEST_ASSERT_IS_TRUE(http_mpsc_ring_is_empty(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_push_after_pop_full_succeed)
+{
+    // arrange
+    HTTP_MPSC_RING_HANDLE handle = http_mpsc_ring_create(TEST_RING_CAPACITY, sizeof(TEST_ITEM), NULL);
+    TEST_ITEM item = { 1, 'a' };
+    for (size_t index = 0; index < TEST_RING_CAPACITY; index++)
+    {
+        (void)http_mpsc_ring_push(handle, &item);
+    }
+    (void)http_mpsc_ring_pop(handle, &item);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_mpsc_ring_push(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_mpsc_ring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_mpsc_ring_is_empty_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    bool result = http_mpsc_ring_is_empty(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_END_TEST_SUITE(http_mpsc_ring_ut)
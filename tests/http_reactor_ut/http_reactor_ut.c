@@ -0,0 +1,987 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+#include <limits.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#include "http_client/http_client.h"
+#include "http_client/http_mpsc_ring.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_reactor.h"
+
+static HTTP_CLIENT_HANDLE TEST_CLIENT_HANDLE = (HTTP_CLIENT_HANDLE)0x11111;
+static HTTP_CLIENT_HANDLE TEST_OTHER_CLIENT_HANDLE = (HTTP_CLIENT_HANDLE)0x22222;
+
+#define TEST_GROW_CLIENT_COUNT      17
+// Not an open descriptor, epoll refuses it
+#define TEST_BAD_WAIT_FD            0x7FFF
+// Stands in for the ring the clients share
+static int g_ring_fd;
+
+static ON_HTTP_CLIENT_WAKE g_on_wake;
+static void* g_wake_ctx;
+static ON_HTTP_CLIENT_WAKE g_on_ready;
+static void* g_ready_ctx;
+static void* g_other_ready_ctx;
+static void* g_queue_item;
+static size_t g_queue_item_size;
+
+static int my_http_client_set_wake_callback(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_WAKE on_wake, void* wake_ctx)
+{
+    (void)handle;
+    g_on_wake = on_wake;
+    g_wake_ctx = wake_ctx;
+    return 0;
+}
+
+static int my_http_client_set_ready_callback(HTTP_CLIENT_HANDLE handle, ON_HTTP_CLIENT_WAKE on_ready, void* ready_ctx)
+{
+    if (on_ready != NULL)
+    {
+        g_on_ready = on_ready;
+    }
+    if (handle == TEST_OTHER_CLIENT_HANDLE)
+    {
+        g_other_ready_ctx = ready_ctx;
+    }
+    else
+    {
+        g_ready_ctx = ready_ctx;
+    }
+    return 0;
+}
+
+static HTTP_MPSC_RING_HANDLE my_http_mpsc_ring_create(size_t capacity, size_t item_size, const HTTP_ALLOCATOR* allocator)
+{
+    (void)capacity;
+    (void)allocator;
+    g_queue_item_size = item_size;
+    return (HTTP_MPSC_RING_HANDLE)my_mem_shim_malloc(1);
+}
+
+static void my_http_mpsc_ring_destroy(HTTP_MPSC_RING_HANDLE handle)
+{
+    my_mem_shim_free(g_queue_item);
+    g_queue_item = NULL;
+    my_mem_shim_free(handle);
+}
+
+// The wake queue holds a single client in the tests
+static int my_http_mpsc_ring_push(HTTP_MPSC_RING_HANDLE handle, const void* item)
+{
+    int result;
+    (void)handle;
+    if (g_queue_item != NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        g_queue_item = my_mem_shim_malloc(g_queue_item_size);
+        memcpy(g_queue_item, item, g_queue_item_size);
+        result = 0;
+    }
+    return result;
+}
+
+static bool my_http_mpsc_ring_pop(HTTP_MPSC_RING_HANDLE handle, void* item)
+{
+    bool result;
+    (void)handle;
+    if (g_queue_item == NULL)
+    {
+        result = false;
+    }
+    else
+    {
+        memcpy(item, g_queue_item, g_queue_item_size);
+        my_mem_shim_free(g_queue_item);
+        g_queue_item = NULL;
+        result = true;
+    }
+    return result;
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_reactor_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types());
+
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_CLIENT_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_CLIENT_WAKE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_MPSC_RING_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const HTTP_ALLOCATOR*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    REGISTER_GLOBAL_MOCK_RETURN(http_client_get_wait_fd, -1);
+    REGISTER_GLOBAL_MOCK_RETURN(http_client_flush, 0);
+    REGISTER_GLOBAL_MOCK_RETURN(http_client_get_wait_time, INT_MAX);
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_set_wake_callback, my_http_client_set_wake_callback);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_set_wake_callback, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_client_set_ready_callback, my_http_client_set_ready_callback);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_client_set_ready_callback, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_create, my_http_mpsc_ring_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_mpsc_ring_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_destroy, my_http_mpsc_ring_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_push, my_http_mpsc_ring_push);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(http_mpsc_ring_push, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(http_mpsc_ring_pop, my_http_mpsc_ring_pop);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_on_wake = NULL;
+    g_wake_ctx = NULL;
+    g_on_ready = NULL;
+    g_ready_ctx = NULL;
+    g_other_ready_ctx = NULL;
+    g_ring_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    CTEST_ASSERT_IS_TRUE(g_ring_fd >= 0);
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+    close(g_ring_fd);
+}
+
+static void signal_ring(void)
+{
+    uint64_t completion_count = 1;
+    CTEST_ASSERT_ARE_EQUAL(int, (int)sizeof(completion_count), (int)write(g_ring_fd, &completion_count, sizeof(completion_count)));
+}
+
+static void setup_http_reactor_create_mocks(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_create(IGNORED_ARG, sizeof(void*), IGNORED_ARG));
+}
+
+static void setup_http_reactor_register_mocks(HTTP_CLIENT_HANDLE client)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(client));
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(client, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(client, IGNORED_ARG, IGNORED_ARG));
+}
+
+// Runs the clients once so they are only run again when they have work
+static void run_registered_clients(HTTP_REACTOR_HANDLE handle)
+{
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 0));
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION(http_reactor_create_succeed)
+{
+    // arrange
+    setup_http_reactor_create_mocks();
+
+    // act
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_create_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_http_reactor_create_mocks();
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            HTTP_REACTOR_HANDLE handle = http_reactor_create();
+
+            // assert
+            CTEST_ASSERT_IS_NULL(handle, "http_reactor_create failure %d/%d", (int)index, (int)count);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(http_reactor_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_reactor_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_destroy_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_reactor_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_register_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_reactor_register(NULL, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_register_client_NULL_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_reactor_register(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    setup_http_reactor_register_mocks(TEST_CLIENT_HANDLE);
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_wake_callback_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_ready_callback_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(TEST_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_malloc_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_wait_fd_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(TEST_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_shared_wait_fd_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // The ring is already in epoll
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_OTHER_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_wait_fd_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(TEST_BAD_WAIT_FD);
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_client_wake_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_push(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    g_on_wake(g_wake_ctx);
+
+    // assert
+    // A request submitted from another thread returns the run without waiting the timeout out
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 60000));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_client_wake_queued_once_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // A client already in the wake queue is not queued again
+    STRICT_EXPECTED_CALL(http_mpsc_ring_push(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    g_on_wake(g_wake_ctx);
+    g_on_wake(g_wake_ctx);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 60000));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_client_wake_queue_full_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // Every client is run when the wake queue had no room
+    STRICT_EXPECTED_CALL(http_mpsc_ring_push(IGNORED_ARG, IGNORED_ARG)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_OTHER_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    g_on_wake(g_wake_ctx);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 60000));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_twice_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_grow_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    for (size_t index = 1; index < TEST_GROW_CLIENT_COUNT; index++)
+    {
+        (void)http_reactor_register(handle, (HTTP_CLIENT_HANDLE)(uintptr_t)(0x1000 + index));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    setup_http_reactor_register_mocks(TEST_CLIENT_HANDLE);
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_GROW_CLIENT_COUNT, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_register_grow_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    for (size_t index = 1; index < TEST_GROW_CLIENT_COUNT; index++)
+    {
+        (void)http_reactor_register(handle, (HTTP_CLIENT_HANDLE)(uintptr_t)(0x1000 + index));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_reactor_register(handle, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_GROW_CLIENT_COUNT - 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_unregister_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_reactor_unregister(NULL, TEST_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_unregister_not_registered_fail)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_reactor_unregister(handle, TEST_OTHER_CLIENT_HANDLE);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_unregister_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // The unregistered client is no longer run
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_OTHER_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_unregister(handle, TEST_CLIENT_HANDLE);
+    (void)http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_reactor_get_client_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_unregister_shared_wait_fd_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_OTHER_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // The client left on the ring flushes it
+    STRICT_EXPECTED_CALL(http_client_set_wake_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(http_client_set_ready_callback(TEST_CLIENT_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_flush(TEST_OTHER_CLIENT_HANDLE));
+
+    // act
+    int result = http_reactor_unregister(handle, TEST_CLIENT_HANDLE);
+    signal_ring();
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    // The ring stays in epoll for the client still on it, the run returns without waiting the timeout out
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 60000));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_reactor_run_once(NULL, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_run_once_registered_client_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // A new client is run once to pick up the work it already has
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_idle_client_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // A client without work or a deadline is not touched
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_pending_client_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // Only the client with work left is run again on the next pass
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG)).SetReturn(0);
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_OTHER_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_run_once(handle, 0);
+    int pending_result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, pending_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_ring_ready_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_OTHER_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // Only the client the flush dispatched a completion to runs, the shared ring is flushed once
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_work(TEST_OTHER_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_flush(TEST_CLIENT_HANDLE));
+
+    // act
+    g_on_ready(g_other_ready_ctx);
+    int result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_ring_idle_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    STRICT_EXPECTED_CALL(http_client_get_wait_fd(TEST_OTHER_CLIENT_HANDLE)).SetReturn(g_ring_fd);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // The readable ring is flushed, no client runs until it is handed a completion
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_flush(TEST_CLIENT_HANDLE));
+
+    // act
+    signal_ring();
+    int result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_client_ready_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    (void)http_reactor_register(handle, TEST_OTHER_CLIENT_HANDLE);
+    run_registered_clients(handle);
+
+    // Work queued on the reactor thread runs the client it was queued on
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_OTHER_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_OTHER_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    g_on_ready(g_other_ready_ctx);
+    g_on_ready(g_other_ready_ctx);
+    int result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_run_once_deadline_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    (void)http_reactor_register(handle, TEST_CLIENT_HANDLE);
+    umock_c_reset_all_calls();
+
+    // A client waiting on the socket cord asks to be run again after a millisecond
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG)).SetReturn(1);
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(http_client_process_item(TEST_CLIENT_HANDLE));
+    STRICT_EXPECTED_CALL(http_client_get_wait_time(TEST_CLIENT_HANDLE, IGNORED_ARG));
+
+    // act
+    // The first run sleeps until the deadline instead of the timeout, the second runs the client
+    int result = http_reactor_run_once(handle, 60000);
+    int deadline_result = http_reactor_run_once(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, deadline_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_wake_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_reactor_wake(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_reactor_wake_succeed)
+{
+    // arrange
+    HTTP_REACTOR_HANDLE handle = http_reactor_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(http_mpsc_ring_pop(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = http_reactor_wake(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    // The pending wake up returns the run without waiting the timeout out
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_reactor_run_once(handle, 60000));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_reactor_destroy(handle);
+}
+
+CTEST_FUNCTION(http_reactor_get_client_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_reactor_get_client_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_END_TEST_SUITE(http_reactor_ut)
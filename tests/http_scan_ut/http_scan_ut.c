@@ -0,0 +1,242 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+#include "http_client/http_scan.h"
+
+#define TEST_BUFFER_SIZE        100
+#define TEST_FILL_BYTE          'a'
+
+static const HTTP_SCAN_SET TEST_HEADER_DELIMS = { { ':', '\r', '\n' }, 3 };
+static const HTTP_SCAN_SET TEST_EMPTY_DELIMS = { { 0 }, 0 };
+
+static const HTTP_SCAN_KERNEL TEST_KERNEL_LIST[] = { HTTP_SCAN_KERNEL_SCALAR, HTTP_SCAN_KERNEL_SSE42, HTTP_SCAN_KERNEL_AVX2 };
+#define TEST_KERNEL_COUNT       (sizeof(TEST_KERNEL_LIST)/sizeof(TEST_KERNEL_LIST[0]))
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_scan_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+    (void)http_scan_set_kernel(HTTP_SCAN_KERNEL_SCALAR);
+}
+
+CTEST_FUNCTION(http_scan_find_delim_set_NULL_fail)
+{
+    // arrange
+    const unsigned char buffer[] = "key: value\r\n";
+
+    // act
+    size_t result = http_scan_find(NULL, buffer, sizeof(buffer) - 1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(buffer) - 1, result);
+}
+
+CTEST_FUNCTION(http_scan_find_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_scan_find(&TEST_HEADER_DELIMS, NULL, 12);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 12, result);
+}
+
+CTEST_FUNCTION(http_scan_find_too_many_delims_fail)
+{
+    // arrange
+    const unsigned char buffer[] = "key: value\r\n";
+    HTTP_SCAN_SET delim_set = { { ':', '\r', '\n', ' ' }, HTTP_SCAN_MAX_DELIMS + 1 };
+
+    // act
+    size_t result = http_scan_find(&delim_set, buffer, sizeof(buffer) - 1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(buffer) - 1, result);
+}
+
+CTEST_FUNCTION(http_scan_find_length_0_succeed)
+{
+    // arrange
+    const unsigned char buffer[] = "\r\n";
+
+    // act
+    size_t result = http_scan_find(&TEST_HEADER_DELIMS, buffer, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+}
+
+CTEST_FUNCTION(http_scan_find_empty_set_succeed)
+{
+    // arrange
+    unsigned char buffer[TEST_BUFFER_SIZE];
+    memset(buffer, '\n', TEST_BUFFER_SIZE);
+
+    for (size_t kernel = 0; kernel < TEST_KERNEL_COUNT; kernel++)
+    {
+        if (http_scan_set_kernel(TEST_KERNEL_LIST[kernel]) == 0)
+        {
+            // act
+            size_t result = http_scan_find(&TEST_EMPTY_DELIMS, buffer, TEST_BUFFER_SIZE);
+
+            // assert
+            CTEST_ASSERT_ARE_EQUAL(size_t, TEST_BUFFER_SIZE, result, "kernel %d", (int)TEST_KERNEL_LIST[kernel]);
+        }
+    }
+}
+
+CTEST_FUNCTION(http_scan_find_no_delim_succeed)
+{
+    // arrange
+    unsigned char buffer[TEST_BUFFER_SIZE];
+    memset(buffer, TEST_FILL_BYTE, TEST_BUFFER_SIZE);
+
+    for (size_t kernel = 0; kernel < TEST_KERNEL_COUNT; kernel++)
+    {
+        if (http_scan_set_kernel(TEST_KERNEL_LIST[kernel]) == 0)
+        {
+            for (size_t length = 0; length <= TEST_BUFFER_SIZE; length++)
+            {
+                // act
+                size_t result = http_scan_find(&TEST_HEADER_DELIMS, buffer, length);
+
+                // assert
+                CTEST_ASSERT_ARE_EQUAL(size_t, length, result, "kernel %d length %d", (int)TEST_KERNEL_LIST[kernel], (int)length);
+            }
+        }
+    }
+}
+
+CTEST_FUNCTION(http_scan_find_every_position_succeed)
+{
+    // arrange
+    unsigned char buffer[TEST_BUFFER_SIZE];
+
+    for (size_t kernel = 0; kernel < TEST_KERNEL_COUNT; kernel++)
+    {
+        if (http_scan_set_kernel(TEST_KERNEL_LIST[kernel]) == 0)
+        {
+            for (size_t delim = 0; delim < TEST_HEADER_DELIMS.count; delim++)
+            {
+                for (size_t position = 0; position < TEST_BUFFER_SIZE; position++)
+                {
+                    memset(buffer, TEST_FILL_BYTE, TEST_BUFFER_SIZE);
+                    buffer[position] = TEST_HEADER_DELIMS.delims[delim];
+
+                    // Every length that ends before, on and after the delimiter
+                    for (size_t length = 0; length <= TEST_BUFFER_SIZE; length++)
+                    {
+                        // act
+                        size_t result = http_scan_find(&TEST_HEADER_DELIMS, buffer, length);
+
+                        // assert
+                        size_t expected = position < length ? position : length;
+                        CTEST_ASSERT_ARE_EQUAL(size_t, expected, result, "kernel %d position %d length %d", (int)TEST_KERNEL_LIST[kernel], (int)position, (int)length);
+                    }
+                }
+            }
+        }
+    }
+}
+
+CTEST_FUNCTION(http_scan_find_first_of_many_succeed)
+{
+    // arrange
+    const unsigned char buffer[] = "Content-Type: application/json; charset=utf-8; boundary=xyz:abc\r\nServer: test\r\n\r\n";
+
+    for (size_t kernel = 0; kernel < TEST_KERNEL_COUNT; kernel++)
+    {
+        if (http_scan_set_kernel(TEST_KERNEL_LIST[kernel]) == 0)
+        {
+            // act
+            size_t result = http_scan_find(&TEST_HEADER_DELIMS, buffer, sizeof(buffer) - 1);
+
+            // assert
+            CTEST_ASSERT_ARE_EQUAL(size_t, 12, result, "kernel %d", (int)TEST_KERNEL_LIST[kernel]);
+        }
+    }
+}
+
+CTEST_FUNCTION(http_scan_find_high_bytes_succeed)
+{
+    // arrange
+    unsigned char buffer[TEST_BUFFER_SIZE];
+    memset(buffer, 0xFF, TEST_BUFFER_SIZE);
+    buffer[TEST_BUFFER_SIZE - 1] = '\n';
+
+    for (size_t kernel = 0; kernel < TEST_KERNEL_COUNT; kernel++)
+    {
+        if (http_scan_set_kernel(TEST_KERNEL_LIST[kernel]) == 0)
+        {
+            // act
+            size_t result = http_scan_find(&TEST_HEADER_DELIMS, buffer, TEST_BUFFER_SIZE);
+
+            // assert
+            CTEST_ASSERT_ARE_EQUAL(size_t, TEST_BUFFER_SIZE - 1, result, "kernel %d", (int)TEST_KERNEL_LIST[kernel]);
+        }
+    }
+}
+
+CTEST_FUNCTION(http_scan_set_kernel_scalar_succeed)
+{
+    // arrange
+
+    // act
+    int result = http_scan_set_kernel(HTTP_SCAN_KERNEL_SCALAR);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_SCAN_KERNEL_SCALAR, http_scan_get_kernel());
+}
+
+CTEST_FUNCTION(http_scan_set_kernel_invalid_fail)
+{
+    // arrange
+    (void)http_scan_set_kernel(HTTP_SCAN_KERNEL_SCALAR);
+
+    // act
+    int result = http_scan_set_kernel((HTTP_SCAN_KERNEL)(HTTP_SCAN_KERNEL_AVX2 + 1));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, HTTP_SCAN_KERNEL_SCALAR, http_scan_get_kernel());
+}
+
+CTEST_END_TEST_SUITE(http_scan_ut)
@@ -0,0 +1,493 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_timer_wheel.h"
+
+#define TEST_START_MS       1000
+#define TEST_MAX_EXPIRED    8
+
+static size_t g_expired_count;
+static size_t g_expired_list[TEST_MAX_EXPIRED];
+static HTTP_TIMER_WHEEL_HANDLE g_cancel_wheel;
+static HTTP_TIMER_HANDLE g_cancel_timer;
+
+static void test_on_expired(void* timer_ctx)
+{
+    if (g_expired_count < TEST_MAX_EXPIRED)
+    {
+        g_expired_list[g_expired_count] = (size_t)timer_ctx;
+    }
+    g_expired_count++;
+}
+
+static void test_on_expired_cancel(void* timer_ctx)
+{
+    test_on_expired(timer_ctx);
+    http_timer_wheel_cancel(g_cancel_wheel, g_cancel_timer);
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_timer_wheel_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_expired_count = 0;
+    g_cancel_wheel = NULL;
+    g_cancel_timer = NULL;
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(http_timer_wheel_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_create_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_timer_wheel_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_destroy_pending_timers_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, (void*)1);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 100000, test_on_expired, (void*)2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_timer_wheel_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_add_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(NULL, TEST_START_MS + 10, test_on_expired, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(timer);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_add_on_expired_NULL_fail)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(handle, TEST_START_MS + 10, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(timer);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_add_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(timer);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_add_fail)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(timer);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_cancel_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(timer));
+
+    // act
+    http_timer_wheel_cancel(handle, timer);
+    http_timer_wheel_advance(handle, TEST_START_MS + 20);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_timer_wheel_advance(NULL, TEST_START_MS);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_not_expired_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 9);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_expired_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, (void*)1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 10);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_list[0]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_already_late_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    http_timer_wheel_advance(handle, TEST_START_MS + 100);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 50, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 101);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_in_order_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 3000, test_on_expired, (void*)3);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, (void*)1);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 200, test_on_expired, (void*)2);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 5000);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_list[0]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, g_expired_list[1]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, g_expired_list[2]);
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_cascade_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 300000, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 299999);
+    size_t before_expiry = g_expired_count;
+    http_timer_wheel_advance(handle, TEST_START_MS + 300000);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, before_expiry);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_count);
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_beyond_wheel_span_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 20000000, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 19999999);
+    size_t before_expiry = g_expired_count;
+    http_timer_wheel_advance(handle, TEST_START_MS + 20000000);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, before_expiry);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_count);
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_advance_cancel_from_callback_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired_cancel, (void*)1);
+    g_cancel_wheel = handle;
+    g_cancel_timer = http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, (void*)2);
+    umock_c_reset_all_calls();
+
+    // act
+    http_timer_wheel_advance(handle, TEST_START_MS + 10);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_count);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_expired_list[0]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_timer_wheel_get_count(handle));
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_get_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_timer_wheel_get_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_get_next_expiry_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    uint64_t result = http_timer_wheel_get_next_expiry(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result == UINT64_MAX);
+
+    // cleanup
+}
+
+CTEST_FUNCTION(http_timer_wheel_get_next_expiry_no_timers_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    uint64_t result = http_timer_wheel_get_next_expiry(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result == UINT64_MAX);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_get_next_expiry_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 300000, test_on_expired, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 100, test_on_expired, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 5000, test_on_expired, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    uint64_t result = http_timer_wheel_get_next_expiry(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result == TEST_START_MS + 100);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_FUNCTION(http_timer_wheel_get_next_expiry_after_cancel_succeed)
+{
+    // arrange
+    HTTP_TIMER_WHEEL_HANDLE handle = http_timer_wheel_create(TEST_START_MS, NULL);
+    HTTP_TIMER_HANDLE timer = http_timer_wheel_add(handle, TEST_START_MS + 10, test_on_expired, NULL);
+    (void)http_timer_wheel_add(handle, TEST_START_MS + 70, test_on_expired, NULL);
+    http_timer_wheel_cancel(handle, timer);
+    umock_c_reset_all_calls();
+
+    // act
+    uint64_t result = http_timer_wheel_get_next_expiry(handle);
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result == TEST_START_MS + 70);
+
+    // cleanup
+    http_timer_wheel_destroy(handle);
+}
+
+CTEST_END_TEST_SUITE(http_timer_wheel_ut)
@@ -0,0 +1,966 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+#ifdef HTTP_CLIENT_USE_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+#endif
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_tls.h"
+
+static const char* TEST_REQUEST = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+#define TEST_DATA_SIZE          1024
+
+static IO_OPEN_RESULT g_open_result;
+static size_t g_open_calls;
+static IO_ERROR_RESULT g_io_error;
+static size_t g_io_error_calls;
+static IO_SEND_RESULT g_send_result;
+static size_t g_send_complete_calls;
+static void* g_send_complete_ctx;
+static size_t g_received_len;
+
+static void test_on_open_complete(void* context, IO_OPEN_RESULT open_result)
+{
+    (void)context;
+    g_open_result = open_result;
+    g_open_calls++;
+}
+
+static void test_on_send_complete(void* context, IO_SEND_RESULT send_result)
+{
+    g_send_complete_ctx = context;
+    g_send_result = send_result;
+    g_send_complete_calls++;
+}
+
+#ifdef HTTP_CLIENT_USE_OPENSSL
+static const char* TEST_HOSTNAME = "localhost";
+static const char* TEST_IP_ADDRESS = "127.0.0.1";
+static const char* TEST_OTHER_HOSTNAME = "other.hostname.com";
+static const char* TEST_RESPONSE = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+static uint16_t TEST_PORT = 8443;
+static uint16_t TEST_OTHER_PORT = 9443;
+
+#define TEST_PEM_SIZE           4096
+
+static void* TEST_SEND_COMPLETE_CTX = (void*)0x1234;
+
+static unsigned char g_received[TEST_DATA_SIZE];
+
+static void test_on_io_error(void* context, IO_ERROR_RESULT error_result)
+{
+    (void)context;
+    g_io_error = error_result;
+    g_io_error_calls++;
+}
+
+static void test_on_bytes_received(void* context, const unsigned char* buffer, size_t size)
+{
+    (void)context;
+    CTEST_ASSERT_IS_TRUE(g_received_len + size <= sizeof(g_received));
+    memcpy(g_received + g_received_len, buffer, size);
+    g_received_len += size;
+}
+
+// The server end of the connection lives in memory, records the client sends are written
+// to in_bio and the server's records are fed back with pump_server
+typedef struct TEST_SERVER_TAG
+{
+    SSL* ssl;
+    BIO* in_bio;
+    BIO* out_bio;
+    unsigned char received[TEST_DATA_SIZE];
+    size_t received_len;
+} TEST_SERVER;
+
+static SSL_CTX* g_server_ctx;
+static char g_server_cert_pem[TEST_PEM_SIZE];
+static char g_untrusted_cert_pem[TEST_PEM_SIZE];
+static TEST_SERVER g_server;
+static int g_on_send_return;
+
+static EVP_PKEY* create_key(void)
+{
+    EVP_PKEY* result = NULL;
+    EVP_PKEY_CTX* key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+    CTEST_ASSERT_IS_NOT_NULL(key_ctx);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, EVP_PKEY_keygen_init(key_ctx));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_ctx, NID_X9_62_prime256v1));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, EVP_PKEY_keygen(key_ctx, &result));
+    EVP_PKEY_CTX_free(key_ctx);
+    return result;
+}
+
+// Self signed certificate for localhost and 127.0.0.1, written out as PEM to cert_pem
+static X509* create_cert(EVP_PKEY* key, char cert_pem[TEST_PEM_SIZE])
+{
+    X509* result = X509_new();
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, X509_set_version(result, 2));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, ASN1_INTEGER_set(X509_get_serialNumber(result), 1));
+    CTEST_ASSERT_IS_NOT_NULL(X509_gmtime_adj(X509_getm_notBefore(result), -60));
+    CTEST_ASSERT_IS_NOT_NULL(X509_gmtime_adj(X509_getm_notAfter(result), 3600));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, X509_set_pubkey(result, key));
+
+    X509_NAME* name = X509_get_subject_name(result);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*)TEST_HOSTNAME, -1, -1, 0));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, X509_set_issuer_name(result, name));
+
+    X509_EXTENSION* alt_name = X509V3_EXT_conf_nid(NULL, NULL, NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1");
+    CTEST_ASSERT_IS_NOT_NULL(alt_name);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, X509_add_ext(result, alt_name, -1));
+    X509_EXTENSION_free(alt_name);
+    CTEST_ASSERT_IS_TRUE(X509_sign(result, key, EVP_sha256()) > 0);
+
+    BIO* pem_bio = BIO_new(BIO_s_mem());
+    CTEST_ASSERT_ARE_EQUAL(int, 1, PEM_write_bio_X509(pem_bio, result));
+    int pem_len = BIO_read(pem_bio, cert_pem, TEST_PEM_SIZE - 1);
+    CTEST_ASSERT_IS_TRUE(pem_len > 0);
+    cert_pem[pem_len] = '\0';
+    BIO_free(pem_bio);
+    return result;
+}
+
+static void start_server(void)
+{
+    memset(&g_server, 0, sizeof(g_server));
+    g_server.ssl = SSL_new(g_server_ctx);
+    g_server.in_bio = BIO_new(BIO_s_mem());
+    g_server.out_bio = BIO_new(BIO_s_mem());
+    SSL_set_bio(g_server.ssl, g_server.in_bio, g_server.out_bio);
+    SSL_set_accept_state(g_server.ssl);
+}
+
+static void stop_server(void)
+{
+    if (g_server.ssl != NULL)
+    {
+        SSL_free(g_server.ssl);
+        g_server.ssl = NULL;
+    }
+}
+
+// Runs the server on what the client sent and hands its records to the client until
+// neither side has anything left to say
+static void pump_server(HTTP_TLS_HANDLE handle)
+{
+    unsigned char record[TEST_DATA_SIZE * 4];
+    bool is_pumping = true;
+    while (is_pumping)
+    {
+        if (!SSL_is_init_finished(g_server.ssl))
+        {
+            (void)SSL_do_handshake(g_server.ssl);
+        }
+        if (SSL_is_init_finished(g_server.ssl))
+        {
+            int read_len;
+            while ((read_len = SSL_read(g_server.ssl, g_server.received + g_server.received_len, (int)(TEST_DATA_SIZE - g_server.received_len))) > 0)
+            {
+                g_server.received_len += (size_t)read_len;
+            }
+        }
+        ERR_clear_error();
+
+        int record_len = BIO_read(g_server.out_bio, record, (int)sizeof(record));
+        if (record_len > 0)
+        {
+            http_tls_on_bytes_received(handle, record, (size_t)record_len);
+        }
+        else
+        {
+            is_pumping = false;
+        }
+    }
+}
+
+static int test_on_send(void* send_ctx, const unsigned char* data, size_t length, ON_SEND_COMPLETE on_send_complete, void* callback_ctx)
+{
+    (void)send_ctx;
+    if (g_on_send_return == 0)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, (int)length, BIO_write(g_server.in_bio, data, (int)length));
+        if (on_send_complete != NULL)
+        {
+            on_send_complete(callback_ctx, IO_SEND_OK);
+        }
+    }
+    return g_on_send_return;
+}
+
+static HTTP_TLS_CALLBACK_INFO get_callback_info(void)
+{
+    HTTP_TLS_CALLBACK_INFO result;
+    result.on_send = test_on_send;
+    result.on_send_ctx = NULL;
+    result.on_bytes_received = test_on_bytes_received;
+    result.on_bytes_received_ctx = NULL;
+    result.on_io_error = test_on_io_error;
+    result.on_io_error_ctx = NULL;
+    return result;
+}
+
+// Opens a connection to the in memory server and runs the handshake to its end
+static HTTP_TLS_HANDLE open_connection(HTTP_TLS_CACHE_HANDLE cache, const char* hostname, uint16_t port)
+{
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    HTTP_TLS_HANDLE result = http_tls_create(cache, hostname, port, &callback_info);
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    start_server();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_tls_open(result, test_on_open_complete, NULL));
+    pump_server(result);
+    return result;
+}
+
+static void close_connection(HTTP_TLS_HANDLE handle)
+{
+    http_tls_destroy(handle);
+    stop_server();
+}
+#endif
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_tls_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    EVP_PKEY* server_key = create_key();
+    X509* server_cert = create_cert(server_key, g_server_cert_pem);
+    EVP_PKEY* untrusted_key = create_key();
+    X509_free(create_cert(untrusted_key, g_untrusted_cert_pem));
+    EVP_PKEY_free(untrusted_key);
+
+    g_server_ctx = SSL_CTX_new(TLS_server_method());
+    CTEST_ASSERT_IS_NOT_NULL(g_server_ctx);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, SSL_CTX_use_certificate(g_server_ctx, server_cert));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, SSL_CTX_use_PrivateKey(g_server_ctx, server_key));
+    X509_free(server_cert);
+    EVP_PKEY_free(server_key);
+#endif
+}
+
+CTEST_SUITE_CLEANUP()
+{
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    SSL_CTX_free(g_server_ctx);
+#endif
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_open_result = IO_OPEN_CANCELLED;
+    g_open_calls = 0;
+    g_io_error = IO_ERROR_OK;
+    g_io_error_calls = 0;
+    g_send_result = IO_SEND_CANCELLED;
+    g_send_complete_calls = 0;
+    g_send_complete_ctx = NULL;
+    g_received_len = 0;
+#ifdef HTTP_CLIENT_USE_OPENSSL
+    g_on_send_return = 0;
+#endif
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+#ifdef HTTP_CLIENT_USE_OPENSSL
+CTEST_FUNCTION(http_tls_is_available_succeed)
+{
+    // arrange
+
+    // act
+    bool result = http_tls_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+}
+
+CTEST_FUNCTION(http_tls_cache_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_TLS_CACHE_HANDLE result = http_tls_cache_create(g_server_cert_pem);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_tls_cache_get_count(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(result);
+}
+
+CTEST_FUNCTION(http_tls_cache_create_system_certs_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_TLS_CACHE_HANDLE result = http_tls_cache_create(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(result);
+}
+
+CTEST_FUNCTION(http_tls_cache_create_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_TLS_CACHE_HANDLE result = http_tls_cache_create(g_server_cert_pem);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_cache_create_invalid_certs_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_TLS_CACHE_HANDLE result = http_tls_cache_create("not a certificate");
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_cache_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_tls_cache_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_cache_destroy_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(cache));
+
+    // act
+    http_tls_cache_destroy(cache);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_cache_destroy_referenced_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_tls_cache_add_ref(cache));
+    umock_c_reset_all_calls();
+
+    // act
+    http_tls_cache_destroy(cache);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_cache_add_ref_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_tls_cache_add_ref(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_tls_cache_get_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = http_tls_cache_get_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+}
+
+CTEST_FUNCTION(http_tls_create_cache_NULL_fail)
+{
+    // arrange
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+
+    // act
+    HTTP_TLS_HANDLE result = http_tls_create(NULL, TEST_HOSTNAME, TEST_PORT, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_create_hostname_NULL_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    umock_c_reset_all_calls();
+
+    // act
+    HTTP_TLS_HANDLE result = http_tls_create(cache, NULL, TEST_PORT, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_create_on_send_NULL_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    callback_info.on_send = NULL;
+    umock_c_reset_all_calls();
+
+    // act
+    HTTP_TLS_HANDLE result = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_create_malloc_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_TLS_HANDLE result = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_create_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_TLS_HANDLE result = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_IS_FALSE(http_tls_is_resumed(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_tls_destroy(result);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_tls_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_destroy_releases_cache_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    HTTP_TLS_HANDLE handle = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+    // The connection keeps the cache alive
+    http_tls_cache_destroy(cache);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(cache));
+    STRICT_EXPECTED_CALL(free(handle));
+
+    // act
+    http_tls_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_open_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_tls_open(NULL, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_open_calls);
+}
+
+CTEST_FUNCTION(http_tls_open_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    CTEST_ASSERT_IS_FALSE(http_tls_is_resumed(handle));
+    // The server's session ticket was kept for the next connection
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_tls_cache_get_count(cache));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_ip_address_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_IP_ADDRESS, TEST_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_twice_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // act
+    int result = http_tls_open(handle, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_send_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    HTTP_TLS_HANDLE handle = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+    g_on_send_return = __LINE__;
+
+    // act
+    int result = http_tls_open(handle, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_open_calls);
+
+    // cleanup
+    http_tls_destroy(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_resumes_session_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    close_connection(open_connection(cache, TEST_HOSTNAME, TEST_PORT));
+    g_open_calls = 0;
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    CTEST_ASSERT_IS_TRUE(http_tls_is_resumed(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 1, SSL_session_reused(g_server.ssl));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, http_tls_cache_get_count(cache));
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_other_port_full_handshake_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    close_connection(open_connection(cache, TEST_HOSTNAME, TEST_PORT));
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_OTHER_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    CTEST_ASSERT_IS_FALSE(http_tls_is_resumed(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, http_tls_cache_get_count(cache));
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_untrusted_cert_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_untrusted_cert_pem);
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_ERROR, g_open_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, http_tls_cache_get_count(cache));
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, http_tls_send(handle, (const unsigned char*)TEST_REQUEST, strlen(TEST_REQUEST), test_on_send_complete, NULL));
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_open_hostname_mismatch_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+
+    // act
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_OTHER_HOSTNAME, TEST_PORT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_ERROR, g_open_result);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_send_not_open_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    HTTP_TLS_HANDLE handle = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+
+    // act
+    int result = http_tls_send(handle, (const unsigned char*)TEST_REQUEST, strlen(TEST_REQUEST), test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+
+    // cleanup
+    http_tls_destroy(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_send_data_NULL_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // act
+    int result = http_tls_send(handle, NULL, 1, test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_send_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+
+    // act
+    int result = http_tls_send(handle, (const unsigned char*)TEST_REQUEST, strlen(TEST_REQUEST), test_on_send_complete, TEST_SEND_COMPLETE_CTX);
+    pump_server(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_send_complete_calls);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_SEND_COMPLETE_CTX, g_send_complete_ctx);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_SEND_OK, g_send_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(TEST_REQUEST), g_server.received_len);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_REQUEST, g_server.received, g_server.received_len));
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_send_transport_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+    g_on_send_return = __LINE__;
+
+    // act
+    int result = http_tls_send(handle, (const unsigned char*)TEST_REQUEST, strlen(TEST_REQUEST), test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_on_bytes_received_context_NULL_succeed)
+{
+    // arrange
+    unsigned char record[] = { 0x17, 0x03, 0x03 };
+
+    // act
+    http_tls_on_bytes_received(NULL, record, sizeof(record));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_received_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_on_bytes_received_decrypt_succeed)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+    CTEST_ASSERT_ARE_EQUAL(int, (int)strlen(TEST_RESPONSE), SSL_write(g_server.ssl, TEST_RESPONSE, (int)strlen(TEST_RESPONSE)));
+
+    // act
+    pump_server(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(TEST_RESPONSE), g_received_len);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_RESPONSE, g_received, g_received_len));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_on_bytes_received_close_notify_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+    (void)SSL_shutdown(g_server.ssl);
+
+    // act
+    pump_server(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_io_error_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_ERROR_ENDPOINT_DISCONN, g_io_error);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_on_bytes_received_corrupt_record_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_HANDLE handle = open_connection(cache, TEST_HOSTNAME, TEST_PORT);
+    unsigned char record[] = { 0x17, 0x03, 0x03, 0x00, 0x04, 0xde, 0xad, 0xbe, 0xef };
+
+    // act
+    http_tls_on_bytes_received(handle, record, sizeof(record));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_io_error_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_ERROR_GENERAL, g_io_error);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_received_len);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+
+CTEST_FUNCTION(http_tls_on_bytes_received_corrupt_handshake_fail)
+{
+    // arrange
+    HTTP_TLS_CACHE_HANDLE cache = http_tls_cache_create(g_server_cert_pem);
+    HTTP_TLS_CALLBACK_INFO callback_info = get_callback_info();
+    HTTP_TLS_HANDLE handle = http_tls_create(cache, TEST_HOSTNAME, TEST_PORT, &callback_info);
+    start_server();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_tls_open(handle, test_on_open_complete, NULL));
+    unsigned char record[] = { 0x16, 0x03, 0x03, 0x00, 0x04, 0xde, 0xad, 0xbe, 0xef };
+
+    // act
+    http_tls_on_bytes_received(handle, record, sizeof(record));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_ERROR, g_open_result);
+
+    // cleanup
+    close_connection(handle);
+    http_tls_cache_destroy(cache);
+}
+#else
+CTEST_FUNCTION(http_tls_is_available_fail)
+{
+    // arrange
+
+    // act
+    bool result = http_tls_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+}
+
+CTEST_FUNCTION(http_tls_cache_create_fail)
+{
+    // arrange
+
+    // act
+    HTTP_TLS_CACHE_HANDLE result = http_tls_cache_create(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_tls_open_fail)
+{
+    // arrange
+
+    // act
+    int result = http_tls_open(NULL, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_open_calls);
+}
+
+CTEST_FUNCTION(http_tls_send_fail)
+{
+    // arrange
+
+    // act
+    int result = http_tls_send(NULL, (const unsigned char*)TEST_REQUEST, strlen(TEST_REQUEST), test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+}
+#endif
+
+CTEST_END_TEST_SUITE(http_tls_ut)
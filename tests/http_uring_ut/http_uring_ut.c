@@ -0,0 +1,1021 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+
+#include "umock_c/umocktypes_charptr.h"
+
+#ifdef HTTP_CLIENT_USE_URING
+#include <stdio.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "http_client/http_uring.h"
+
+static const char* TEST_HOSTNAME = "127.0.0.1";
+static const char* TEST_SEND_DATA = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+static void* TEST_SEND_COMPLETE_CTX = (void*)0x1234;
+
+#define TEST_QUEUE_DEPTH        16
+#define TEST_DATA_SIZE          4096
+
+static IO_OPEN_RESULT g_open_result;
+static size_t g_open_calls;
+static IO_ERROR_RESULT g_io_error;
+static size_t g_io_error_calls;
+static IO_SEND_RESULT g_send_result;
+static size_t g_send_complete_calls;
+static void* g_send_complete_ctx;
+static size_t g_close_calls;
+static unsigned char g_received[TEST_DATA_SIZE];
+static size_t g_received_len;
+
+static void test_on_open_complete(void* context, IO_OPEN_RESULT open_result)
+{
+    (void)context;
+    g_open_result = open_result;
+    g_open_calls++;
+}
+
+static void test_on_send_complete(void* context, IO_SEND_RESULT send_result)
+{
+    g_send_complete_ctx = context;
+    g_send_result = send_result;
+    g_send_complete_calls++;
+}
+
+static void test_on_io_error(void* context, IO_ERROR_RESULT error_result)
+{
+    (void)context;
+    g_io_error = error_result;
+    g_io_error_calls++;
+}
+
+static void test_on_bytes_received(void* context, const unsigned char* buffer, size_t size)
+{
+    (void)context;
+    CTEST_ASSERT_IS_TRUE(g_received_len + size <= sizeof(g_received));
+    memcpy(g_received + g_received_len, buffer, size);
+    g_received_len += size;
+}
+
+static PATCHCORD_CALLBACK_INFO get_callback_info(void)
+{
+    PATCHCORD_CALLBACK_INFO result;
+    memset(&result, 0, sizeof(result));
+    result.on_bytes_received = test_on_bytes_received;
+    result.on_io_error = test_on_io_error;
+    return result;
+}
+
+#ifdef HTTP_CLIENT_USE_URING
+static const char* TEST_BODY_DATA = "0123456789";
+
+#define TEST_PROCESS_LIMIT      2000
+#define TEST_POLL_TIMEOUT_MS    5
+
+static int g_listen_socket;
+static uint16_t g_listen_port;
+static char g_socket_path[64];
+
+static void test_on_close_complete(void* context)
+{
+    (void)context;
+    g_close_calls++;
+}
+
+static void start_listener(void)
+{
+    struct sockaddr_in address;
+    socklen_t address_len = sizeof(address);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    g_listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+    CTEST_ASSERT_IS_TRUE(g_listen_socket >= 0);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bind(g_listen_socket, (struct sockaddr*)&address, sizeof(address)));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, listen(g_listen_socket, 4));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, getsockname(g_listen_socket, (struct sockaddr*)&address, &address_len));
+    g_listen_port = ntohs(address.sin_port);
+}
+
+static void start_unix_listener(void)
+{
+    struct sockaddr_un address;
+
+    (void)snprintf(g_socket_path, sizeof(g_socket_path), "/tmp/http_uring_ut_%d.sock", (int)getpid());
+    (void)unlink(g_socket_path);
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, g_socket_path);
+    g_listen_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    CTEST_ASSERT_IS_TRUE(g_listen_socket >= 0);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bind(g_listen_socket, (struct sockaddr*)&address, sizeof(address)));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, listen(g_listen_socket, 4));
+}
+
+static void stop_listener(void)
+{
+    if (g_listen_socket >= 0)
+    {
+        close(g_listen_socket);
+        g_listen_socket = -1;
+    }
+    if (g_socket_path[0] != '\0')
+    {
+        (void)unlink(g_socket_path);
+        g_socket_path[0] = '\0';
+    }
+}
+
+// Processes the ring until the counter reaches expected, sleeping on the ring's descriptor
+static void process_until(HTTP_URING_HANDLE handle, const size_t* counter, size_t expected)
+{
+    for (size_t index = 0; index < TEST_PROCESS_LIMIT && *counter < expected; index++)
+    {
+        struct pollfd poll_item;
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_process(handle));
+        if (*counter < expected)
+        {
+            poll_item.fd = http_uring_get_fd(handle);
+            poll_item.events = POLLIN;
+            poll_item.revents = 0;
+            (void)poll(&poll_item, 1, TEST_POLL_TIMEOUT_MS);
+        }
+    }
+    CTEST_ASSERT_ARE_EQUAL(size_t, expected, *counter);
+}
+
+// Reads from the peer until length bytes arrived
+static void peer_receive(int peer, unsigned char* buffer, size_t length)
+{
+    size_t received = 0;
+    while (received < length)
+    {
+        ssize_t read_len = recv(peer, buffer + received, length - received, 0);
+        CTEST_ASSERT_IS_TRUE(read_len > 0);
+        received += (size_t)read_len;
+    }
+}
+
+// Opens a connection to the listener and returns the accepted end of it
+static HTTP_URING_CONN_HANDLE open_connection(HTTP_URING_HANDLE uring, int* peer)
+{
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    config.port = g_listen_port;
+    config.address_type = ADDRESS_TYPE_IP;
+
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(uring, &config, &callback_info);
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_open(result, test_on_open_complete, NULL));
+    process_until(uring, &g_open_calls, 1);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    *peer = accept(g_listen_socket, NULL, NULL);
+    CTEST_ASSERT_IS_TRUE(*peer >= 0);
+    return result;
+}
+#endif
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(http_uring_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types());
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+    g_open_result = IO_OPEN_CANCELLED;
+    g_open_calls = 0;
+    g_io_error = IO_ERROR_OK;
+    g_io_error_calls = 0;
+    g_send_result = IO_SEND_CANCELLED;
+    g_send_complete_calls = 0;
+    g_send_complete_ctx = NULL;
+    g_close_calls = 0;
+    g_received_len = 0;
+#ifdef HTTP_CLIENT_USE_URING
+    g_listen_socket = -1;
+    g_socket_path[0] = '\0';
+#endif
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+#ifdef HTTP_CLIENT_USE_URING
+    stop_listener();
+#endif
+}
+
+#ifdef HTTP_CLIENT_USE_URING
+// The tests run on a kernel with multishot receive, Linux 6.0 or later
+CTEST_FUNCTION(http_uring_is_available_succeed)
+{
+    // arrange
+
+    // act
+    bool result = http_uring_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_TRUE(result);
+}
+
+CTEST_FUNCTION(http_uring_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_URING_HANDLE result = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_IS_TRUE(http_uring_get_fd(result) >= 0);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_destroy(result);
+}
+
+CTEST_FUNCTION(http_uring_create_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    HTTP_URING_HANDLE result = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_create_buffer_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_URING_HANDLE result = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_uring_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_destroy_referenced_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE handle = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_add_ref(handle));
+    umock_c_reset_all_calls();
+
+    // act
+    http_uring_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_process(handle));
+
+    // cleanup
+    http_uring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_uring_add_ref_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_add_ref(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_uring_process_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_process(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_uring_process_nothing_queued_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE handle = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_uring_process(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_destroy(handle);
+}
+
+CTEST_FUNCTION(http_uring_get_fd_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_get_fd(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, -1, result);
+}
+
+CTEST_FUNCTION(http_uring_conn_create_uring_NULL_fail)
+{
+    // arrange
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(NULL, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_conn_create_on_bytes_received_NULL_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    callback_info.on_bytes_received = NULL;
+    umock_c_reset_all_calls();
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(uring, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_create_udp_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    config.address_type = ADDRESS_TYPE_UDP;
+    umock_c_reset_all_calls();
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(uring, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_create_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    uint16_t port = 0;
+    config.hostname = TEST_HOSTNAME;
+    config.port = 8080;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(uring, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, TEST_HOSTNAME, http_uring_conn_query_endpoint(result, &port));
+    CTEST_ASSERT_ARE_EQUAL(int, 8080, port);
+
+    // cleanup
+    http_uring_conn_destroy(result);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_create_malloc_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create(uring, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_uring_conn_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_conn_open_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_conn_open(NULL, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_uring_conn_open_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+
+    // act
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, g_open_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_open_twice_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // act
+    int result = http_uring_conn_open(handle, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_open_refused_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    start_listener();
+    stop_listener();
+    config.hostname = TEST_HOSTNAME;
+    config.port = g_listen_port;
+    HTTP_URING_CONN_HANDLE handle = http_uring_conn_create(uring, &config, &callback_info);
+
+    // act
+    int result = http_uring_conn_open(handle, test_on_open_complete, NULL);
+    process_until(uring, &g_open_calls, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_ERROR, g_open_result);
+
+    // cleanup
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_open_unix_socket_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    unsigned char peer_data[16];
+    start_unix_listener();
+    config.hostname = g_socket_path;
+    config.address_type = ADDRESS_TYPE_DOMAIN_SOCKET;
+    HTTP_URING_CONN_HANDLE handle = http_uring_conn_create(uring, &config, &callback_info);
+
+    // act
+    int result = http_uring_conn_open(handle, test_on_open_complete, NULL);
+    process_until(uring, &g_open_calls, 1);
+    int peer = accept(g_listen_socket, NULL, NULL);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_send(handle, TEST_BODY_DATA, strlen(TEST_BODY_DATA), test_on_send_complete, NULL));
+    process_until(uring, &g_send_complete_calls, 1);
+    peer_receive(peer, peer_data, strlen(TEST_BODY_DATA));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(peer_data, TEST_BODY_DATA, strlen(TEST_BODY_DATA)));
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_not_open_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    HTTP_URING_CONN_HANDLE handle = http_uring_conn_create(uring, &config, &callback_info);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_uring_conn_send(handle, TEST_SEND_DATA, strlen(TEST_SEND_DATA), test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_buffer_NULL_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = http_uring_conn_send(handle, NULL, 10, test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_malloc_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = http_uring_conn_send(handle, TEST_SEND_DATA, strlen(TEST_SEND_DATA), test_on_send_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    unsigned char peer_data[TEST_DATA_SIZE];
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = http_uring_conn_send(handle, TEST_SEND_DATA, strlen(TEST_SEND_DATA), test_on_send_complete, TEST_SEND_COMPLETE_CTX);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    // Nothing is handed to the kernel until the ring is processed
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+    process_until(uring, &g_send_complete_calls, 1);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_SEND_OK, g_send_result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_SEND_COMPLETE_CTX, g_send_complete_ctx);
+    peer_receive(peer, peer_data, strlen(TEST_SEND_DATA));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(peer_data, TEST_SEND_DATA, strlen(TEST_SEND_DATA)));
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_linked_in_order_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    unsigned char peer_data[TEST_DATA_SIZE];
+    size_t head_len = strlen(TEST_SEND_DATA);
+    size_t body_len = strlen(TEST_BODY_DATA);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // act
+    for (size_t index = 0; index < 20; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_send(handle, TEST_SEND_DATA, head_len, test_on_send_complete, NULL));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_send(handle, TEST_BODY_DATA, body_len, test_on_send_complete, NULL));
+    }
+    process_until(uring, &g_send_complete_calls, 40);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, IO_SEND_OK, g_send_result);
+    peer_receive(peer, peer_data, 20 * (head_len + body_len));
+    for (size_t index = 0; index < 20; index++)
+    {
+        const unsigned char* request = peer_data + index * (head_len + body_len);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(request, TEST_SEND_DATA, head_len));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(request + head_len, TEST_BODY_DATA, body_len));
+    }
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_receive_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // act
+    CTEST_ASSERT_ARE_EQUAL(int, (int)strlen(TEST_SEND_DATA), (int)send(peer, TEST_SEND_DATA, strlen(TEST_SEND_DATA), 0));
+    process_until(uring, &g_received_len, strlen(TEST_SEND_DATA));
+    // The receive stays armed for the next data
+    CTEST_ASSERT_ARE_EQUAL(int, (int)strlen(TEST_BODY_DATA), (int)send(peer, TEST_BODY_DATA, strlen(TEST_BODY_DATA), 0));
+    process_until(uring, &g_received_len, strlen(TEST_SEND_DATA) + strlen(TEST_BODY_DATA));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_received, TEST_SEND_DATA, strlen(TEST_SEND_DATA)));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_received + strlen(TEST_SEND_DATA), TEST_BODY_DATA, strlen(TEST_BODY_DATA)));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_receive_more_than_buffers_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    unsigned char peer_data[TEST_DATA_SIZE];
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    memset(peer_data, 'a', sizeof(peer_data));
+
+    // act
+    CTEST_ASSERT_ARE_EQUAL(int, (int)sizeof(peer_data), (int)send(peer, peer_data, sizeof(peer_data), 0));
+    process_until(uring, &g_received_len, sizeof(peer_data));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(g_received, peer_data, sizeof(peer_data)));
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_peer_close_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // act
+    close(peer);
+    process_until(uring, &g_io_error_calls, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, IO_ERROR_ENDPOINT_DISCONN, g_io_error);
+
+    // cleanup
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_close_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_conn_close(NULL, test_on_close_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_uring_conn_close_not_open_fail)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+    HTTP_URING_CONN_HANDLE handle = http_uring_conn_create(uring, &config, &callback_info);
+
+    // act
+    int result = http_uring_conn_close(handle, test_on_close_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_close_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    unsigned char peer_data[16];
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+
+    // act
+    int result = http_uring_conn_close(handle, test_on_close_complete, NULL);
+    process_until(uring, &g_close_calls, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, (int)recv(peer, peer_data, sizeof(peer_data), 0));
+
+    // cleanup
+    close(peer);
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_close_reopen_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_close(handle, test_on_close_complete, NULL));
+    process_until(uring, &g_close_calls, 1);
+    close(peer);
+
+    // act
+    int result = http_uring_conn_open(handle, test_on_open_complete, NULL);
+    process_until(uring, &g_open_calls, 2);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, IO_OPEN_OK, g_open_result);
+
+    // cleanup
+    http_uring_conn_destroy(handle);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_destroy_receive_armed_succeed)
+{
+    // arrange
+    HTTP_URING_HANDLE uring = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+    int peer;
+    start_listener();
+    HTTP_URING_CONN_HANDLE handle = open_connection(uring, &peer);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_conn_send(handle, TEST_SEND_DATA, strlen(TEST_SEND_DATA), test_on_send_complete, NULL));
+
+    // act
+    http_uring_conn_destroy(handle);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, http_uring_process(uring));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_io_error_calls);
+
+    // cleanup
+    close(peer);
+    http_uring_destroy(uring);
+}
+
+CTEST_FUNCTION(http_uring_conn_process_item_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    http_uring_conn_process_item(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_conn_query_endpoint_handle_NULL_fail)
+{
+    // arrange
+    uint16_t port;
+
+    // act
+    const char* result = http_uring_conn_query_endpoint(NULL, &port);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+}
+#else
+CTEST_FUNCTION(http_uring_is_available_fail)
+{
+    // arrange
+
+    // act
+    bool result = http_uring_is_available();
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(result);
+}
+
+CTEST_FUNCTION(http_uring_create_fail)
+{
+    // arrange
+
+    // act
+    HTTP_URING_HANDLE result = http_uring_create(TEST_QUEUE_DEPTH, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+CTEST_FUNCTION(http_uring_conn_create_fail)
+{
+    // arrange
+    SOCKETIO_CONFIG config = { 0 };
+    PATCHCORD_CALLBACK_INFO callback_info = get_callback_info();
+    config.hostname = TEST_HOSTNAME;
+
+    // act
+    HTTP_URING_CONN_HANDLE result = http_uring_conn_create((HTTP_URING_HANDLE)0x1234, &config, &callback_info);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+}
+
+CTEST_FUNCTION(http_uring_conn_open_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_conn_open((HTTP_URING_CONN_HANDLE)0x1234, test_on_open_complete, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+CTEST_FUNCTION(http_uring_conn_send_fail)
+{
+    // arrange
+
+    // act
+    int result = http_uring_conn_send((HTTP_URING_CONN_HANDLE)0x1234, TEST_SEND_DATA, strlen(TEST_SEND_DATA), test_on_send_complete, TEST_SEND_COMPLETE_CTX);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, g_send_complete_calls);
+}
+#endif
+
+CTEST_END_TEST_SUITE(http_uring_ut)